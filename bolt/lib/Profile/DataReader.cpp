@@ -838,14 +838,14 @@ ErrorOr<StringRef> DataReader::parseString(char EndChar, bool EndNl) {
     return make_error_code(llvm::errc::io_error);
   }
 
-  std::string EndChars(1, EndChar);
-  EndChars.push_back('\\');
-  if (EndNl)
-    EndChars.push_back('\n');
+  // This runs for every field of every sample, so avoid constructing a
+  // std::string for the delimiter set on each call.
+  char EndChars[3] = {EndChar, '\\', '\n'};
+  StringRef EndCharSet(EndChars, EndNl ? 3 : 2);
 
   size_t StringEnd = 0;
   do {
-    StringEnd = ParsingBuf.find_first_of(EndChars, StringEnd);
+    StringEnd = ParsingBuf.find_first_of(EndCharSet, StringEnd);
     if (StringEnd == StringRef::npos ||
         (StringEnd == 0 && ParsingBuf[StringEnd] != '\\')) {
       reportError("malformed field");
@@ -3360,32 +3360,47 @@ void RewriteInstance::disassembleFunctions() {
   BC->clearJumpTableTempData();
   BC->adjustCodePadding();
 
+  // Fill in CFI information for simple functions. Parsing a CFI program only
+  // writes into the function itself, so this can run in parallel. LSDA
+  // parsing below mutates shared BinaryContext state and stays sequential.
+  ParallelUtilities::WorkFuncTy FillCFIWorkFun = [&](BinaryFunction &Function) {
+    if (Function.trapsOnEntry() || CFIRdWrt->fillCFIInfoFor(Function))
+      return;
+    if (BC->HasRelocations) {
+      auto L = BC->scopeLock();
+      BC->errs() << BC->generateBugReportMessage("unable to fill CFI.",
+                                                 Function);
+      exit(1);
+    }
+    auto L = BC->scopeLock();
+    BC->errs() << "BOLT-WARNING: unable to fill CFI for function " << Function
+               << ". Skipping.\n";
+    Function.setSimple(false);
+  };
+
+  ParallelUtilities::PredicateTy SkipPredicate =
+      [&](const BinaryFunction &Function) {
+        if (!shouldDisassemble(Function))
+          return true;
+        if (!Function.isSimple()) {
+          assert((!BC->HasRelocations || Function.getSize() == 0 ||
+                  Function.hasIndirectTargetToSplitFragment()) &&
+                 "unexpected non-simple function in relocation mode");
+          return true;
+        }
+        return false;
+      };
+
+  ParallelUtilities::runOnEachFunction(
+      *BC, ParallelUtilities::SchedulingPolicy::SP_INST_LINEAR, FillCFIWorkFun,
+      SkipPredicate, "fillCFIInfo",
+      /*ForceSequential*/ opts::SequentialDisassembly);
+
   for (auto &BFI : BC->getBinaryFunctions()) {
     BinaryFunction &Function = BFI.second;
 
-    if (!shouldDisassemble(Function))
-      continue;
-
-    if (!Function.isSimple()) {
-      assert((!BC->HasRelocations || Function.getSize() == 0 ||
-              Function.hasIndirectTargetToSplitFragment()) &&
-             "unexpected non-simple function in relocation mode");
+    if (!shouldDisassemble(Function) || !Function.isSimple())
       continue;
-    }
-
-    // Fill in CFI information for this function
-    if (!Function.trapsOnEntry() && !CFIRdWrt->fillCFIInfoFor(Function)) {
-      if (BC->HasRelocations) {
-        BC->errs() << BC->generateBugReportMessage("unable to fill CFI.",
-                                                   Function);
-        exit(1);
-      } else {
-        BC->errs() << "BOLT-WARNING: unable to fill CFI for function "
-                   << Function << ". Skipping.\n";
-        Function.setSimple(false);
-        continue;
-      }
-    }
 
     // Parse LSDA.
     if (Function.getLSDAAddress() != 0 &&
@@ -330,19 +330,32 @@ std::string printObjCContainer(const ObjCContainerDecl &C) {
 
 SymbolID getSymbolID(const Decl *D) {
   llvm::SmallString<128> USR;
-  if (index::generateUSRForDecl(D, USR))
+  return getSymbolID(D, USR);
+}
+
+SymbolID getSymbolID(const Decl *D, llvm::SmallVectorImpl<char> &USRScratch) {
+  USRScratch.clear();
+  if (index::generateUSRForDecl(D, USRScratch))
     return {};
-  return SymbolID(USR);
+  return SymbolID(llvm::StringRef(USRScratch.data(), USRScratch.size()));
 }
 
 SymbolID getSymbolID(const llvm::StringRef MacroName, const MacroInfo *MI,
                      const SourceManager &SM) {
+  llvm::SmallString<128> USR;
+  return getSymbolID(MacroName, MI, SM, USR);
+}
+
+SymbolID getSymbolID(const llvm::StringRef MacroName, const MacroInfo *MI,
+                     const SourceManager &SM,
+                     llvm::SmallVectorImpl<char> &USRScratch) {
   if (MI == nullptr)
     return {};
-  llvm::SmallString<128> USR;
-  if (index::generateUSRForMacro(MacroName, MI->getDefinitionLoc(), SM, USR))
+  USRScratch.clear();
+  if (index::generateUSRForMacro(MacroName, MI->getDefinitionLoc(), SM,
+                                 USRScratch))
     return {};
-  return SymbolID(USR);
+  return SymbolID(llvm::StringRef(USRScratch.data(), USRScratch.size()));
 }
 
 const ObjCImplDecl *getCorrespondingObjCImpl(const ObjCContainerDecl *D) {
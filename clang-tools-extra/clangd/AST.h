@@ -86,6 +86,12 @@ bool hasReservedScope(const DeclContext &);
 /// Gets the symbol ID for a declaration. Returned SymbolID might be null.
 SymbolID getSymbolID(const Decl *D);
 
+/// Variant of getSymbolID() that generates the USR into \p USRScratch,
+/// clearing it first. Callers generating IDs in bulk (e.g. indexing) can pass
+/// the same buffer repeatedly to avoid a heap allocation for every USR that
+/// outgrows a fresh small buffer, which template-heavy code hits routinely.
+SymbolID getSymbolID(const Decl *D, llvm::SmallVectorImpl<char> &USRScratch);
+
 /// Gets the symbol ID for a macro. Returned SymbolID might be null.
 /// Currently, this is an encoded USR of the macro, which incorporates macro
 /// locations (e.g. file name, offset in file).
@@ -96,6 +102,11 @@ SymbolID getSymbolID(const Decl *D);
 SymbolID getSymbolID(const llvm::StringRef MacroName, const MacroInfo *MI,
                      const SourceManager &SM);
 
+/// Variant of the macro getSymbolID() reusing \p USRScratch, see above.
+SymbolID getSymbolID(const llvm::StringRef MacroName, const MacroInfo *MI,
+                     const SourceManager &SM,
+                     llvm::SmallVectorImpl<char> &USRScratch);
+
 /// Return the corresponding implementation/definition for the given ObjC
 /// container if it has one, otherwise, return nullptr.
 ///
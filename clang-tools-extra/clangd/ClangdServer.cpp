@@ -42,6 +42,8 @@
 #include "clang/Tooling/Core/Replacement.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
@@ -294,9 +296,43 @@ ClangdServer::~ClangdServer() {
   }
 }
 
+// If the edit from \p Old to \p New looks like typing a completion trigger
+// ("." / "->" / "::"), returns the offset right after it, where a completion
+// request is likely to follow.
+static std::optional<size_t> completionTriggerOffset(llvm::StringRef Old,
+                                                     llvm::StringRef New) {
+  if (New.size() <= Old.size())
+    return std::nullopt; // Deletions don't predict completion.
+  size_t Prefix = 0;
+  while (Prefix < Old.size() && Old[Prefix] == New[Prefix])
+    ++Prefix;
+  size_t Suffix = 0;
+  while (Suffix < Old.size() - Prefix &&
+         Old[Old.size() - 1 - Suffix] == New[New.size() - 1 - Suffix])
+    ++Suffix;
+  // The inserted text ends at End; the trigger may span the edit boundary
+  // (e.g. typing '>' after '-'), so look at the document prefix.
+  size_t End = New.size() - Suffix;
+  llvm::StringRef Head = New.take_front(End);
+  if (Head.ends_with("->") || Head.ends_with("::"))
+    return End;
+  if (Head.ends_with(".") && Head.size() >= 2) {
+    // Members follow an identifier or a closing bracket; this filters out
+    // most float literals and "...".
+    char C = Head[Head.size() - 2];
+    if (llvm::isAlnum(C) || C == '_' || C == ')' || C == ']')
+      return End;
+  }
+  return std::nullopt;
+}
+
 void ClangdServer::addDocument(PathRef File, llvm::StringRef Contents,
                                llvm::StringRef Version,
                                WantDiagnostics WantDiags, bool ForceRebuild) {
+  // Keep the previous draft to detect completion-trigger edits below.
+  std::shared_ptr<const std::string> PrevContents;
+  if (auto Prev = DraftMgr.getDraft(File))
+    PrevContents = std::move(Prev->Contents);
   std::string ActualVersion = DraftMgr.addDraft(File, Version, Contents);
   ParseOptions Opts;
   Opts.PreambleParseForwardingFunctions = PreambleParseForwardingFunctions;
@@ -306,7 +342,7 @@ void ClangdServer::addDocument(PathRef File, llvm::StringRef Contents,
   ParseInputs Inputs;
   Inputs.TFS = &getHeaderFS();
   Inputs.Contents = std::string(Contents);
-  Inputs.Version = std::move(ActualVersion);
+  Inputs.Version = ActualVersion;
   Inputs.ForceRebuild = ForceRebuild;
   Inputs.Opts = std::move(Opts);
   Inputs.Index = Index;
@@ -317,6 +353,11 @@ void ClangdServer::addDocument(PathRef File, llvm::StringRef Contents,
   // If we loaded Foo.h, we want to make sure Foo.cpp is indexed.
   if (NewFile && BackgroundIdx)
     BackgroundIdx->boostRelated(File);
+  // If the edit typed a completion trigger, a completion request is likely to
+  // follow; run the completion parse before it arrives.
+  if (PrevContents)
+    if (auto Offset = completionTriggerOffset(*PrevContents, Contents))
+      startSpeculativeCompletion(File, Contents, ActualVersion, *Offset);
 }
 
 void ClangdServer::reparseOpenFilesIfNeeded(
@@ -426,6 +467,45 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
   if (!CodeCompleteOpts.Index) // Respect overridden index.
     CodeCompleteOpts.Index = Index;
 
+  // If a speculative parse predicted this request, adopt its result instead
+  // of parsing again. The entry is one-shot either way.
+  std::optional<SpeculativeCompletion> Spec;
+  auto Draft = DraftMgr.getDraft(File);
+  {
+    std::lock_guard<std::mutex> Lock(SpeculativeCompletionMutex);
+    // Remember the options so later speculative parses can mirror them.
+    LastCodeCompleteOpts = CodeCompleteOpts;
+    auto It = SpeculativeCompletionByFile.find(File);
+    if (It != SpeculativeCompletionByFile.end()) {
+      if (Draft && It->second.Version == Draft->Version &&
+          It->second.Pos == Pos)
+        Spec = std::move(It->second);
+      SpeculativeCompletionByFile.erase(It);
+    }
+  }
+  if (Spec) {
+    // Join the speculative parse off the main thread; fall back to a regular
+    // parse if it failed.
+    WorkScheduler->run(
+        "CodeCompleteSpeculationJoin", File,
+        [this, Spec = std::move(*Spec), File = File.str(), Pos,
+         CodeCompleteOpts, CB = std::move(CB)]() mutable {
+          std::shared_ptr<const CodeCompleteResult> Result = Spec.Result.get();
+          if (Result) {
+            vlog("Code complete: using speculative parse for {0}", File);
+            return CB(CodeCompleteResult(*Result));
+          }
+          codeCompleteImpl(File, Pos, std::move(CodeCompleteOpts),
+                           std::move(CB));
+        });
+    return;
+  }
+  codeCompleteImpl(File, Pos, std::move(CodeCompleteOpts), std::move(CB));
+}
+
+void ClangdServer::codeCompleteImpl(PathRef File, Position Pos,
+                                    clangd::CodeCompleteOptions CodeCompleteOpts,
+                                    Callback<CodeCompleteResult> CB) {
   auto Task = [Pos, CodeCompleteOpts, File = File.str(), CB = std::move(CB),
                this](llvm::Expected<InputsAndPreamble> IP) mutable {
     if (!IP)
@@ -477,12 +557,69 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
   // We use a potentially-stale preamble because latency is critical here.
   WorkScheduler->runWithPreamble(
       "CodeComplete", File,
-      (Opts.RunParser == CodeCompleteOptions::AlwaysParse)
+      (CodeCompleteOpts.RunParser == CodeCompleteOptions::AlwaysParse)
           ? TUScheduler::Stale
           : TUScheduler::StaleOrAbsent,
       std::move(Task));
 }
 
+void ClangdServer::startSpeculativeCompletion(PathRef File,
+                                              llvm::StringRef Contents,
+                                              llvm::StringRef Version,
+                                              size_t Offset) {
+  clangd::CodeCompleteOptions CodeCompleteOpts;
+  {
+    std::lock_guard<std::mutex> Lock(SpeculativeCompletionMutex);
+    if (!LastCodeCompleteOpts)
+      return; // No completion request yet, so its options are unknown.
+    CodeCompleteOpts = *LastCodeCompleteOpts;
+  }
+  Position Pos = offsetToPosition(Contents, Offset);
+  auto Promise = std::make_shared<
+      std::promise<std::shared_ptr<const CodeCompleteResult>>>();
+  {
+    std::lock_guard<std::mutex> Lock(SpeculativeCompletionMutex);
+    auto &Entry = SpeculativeCompletionByFile[File];
+    Entry.Version = Version.str();
+    Entry.Pos = Pos;
+    Entry.Result = Promise->get_future().share();
+  }
+
+  auto Task = [Pos, CodeCompleteOpts, File = File.str(),
+               Contents = Contents.str(), Promise = std::move(Promise),
+               this](llvm::Expected<InputsAndPreamble> IP) mutable {
+    // The promise is always fulfilled: codeComplete() may block on it.
+    std::shared_ptr<const CodeCompleteResult> Result;
+    auto Fulfil = llvm::make_scope_exit(
+        [&] { Promise->set_value(std::move(Result)); });
+    if (!IP) {
+      llvm::consumeError(IP.takeError());
+      return;
+    }
+    if (!IP->Preamble)
+      return; // Speculating without a preamble is not worth it.
+    // The scheduler may have picked up a newer draft; the predicted position
+    // is only meaningful for the contents we speculated against.
+    if (IP->Contents != Contents)
+      return;
+    ParseInputs ParseInput{IP->Command, &getHeaderFS(), IP->Contents.str()};
+    if (!IP->Contents.ends_with("\n"))
+      ParseInput.Contents.append("\n");
+    ParseInput.Index = Index;
+
+    CodeCompleteOpts.MainFileSignals = IP->Signals;
+    CodeCompleteOpts.AllScopes = Config::current().Completion.AllScopes;
+    CodeCompleteOpts.ArgumentLists = Config::current().Completion.ArgumentLists;
+    Result = std::make_shared<const CodeCompleteResult>(
+        clangd::codeComplete(File, Pos, IP->Preamble, ParseInput,
+                             CodeCompleteOpts, /*SpecFuzzyFind=*/nullptr));
+  };
+  // Unlike explicit completion, never enter fallback mode: a speculative
+  // result without sema wouldn't save the request any work.
+  WorkScheduler->runWithPreamble("SpeculativeCodeComplete", File,
+                                 TUScheduler::Stale, std::move(Task));
+}
+
 void ClangdServer::signatureHelp(PathRef File, Position Pos,
                                  MarkupKind DocumentationFormat,
                                  Callback<SignatureHelp> CB) {
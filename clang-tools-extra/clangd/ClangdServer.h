@@ -35,7 +35,9 @@
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -470,6 +472,15 @@ public:
   void profile(MemoryTree &MT) const;
 
 private:
+  /// Schedules the regular (non-speculative) completion parse.
+  void codeCompleteImpl(PathRef File, Position Pos,
+                        clangd::CodeCompleteOptions CodeCompleteOpts,
+                        Callback<CodeCompleteResult> CB);
+  /// Starts a completion parse at \p Offset before any request arrives, when
+  /// an edit typed a completion trigger there (see codeComplete()).
+  void startSpeculativeCompletion(PathRef File, llvm::StringRef Contents,
+                                  llvm::StringRef Version, size_t Offset);
+
   FeatureModuleSet *FeatureModules;
   const GlobalCompilationDatabase &CDB;
   const ThreadsafeFS &getHeaderFS() const {
@@ -512,6 +523,23 @@ private:
       CachedCompletionFuzzyFindRequestByFile;
   mutable std::mutex CachedCompletionFuzzyFindRequestMutex;
 
+  // A completion parse started ahead of the request, when typing a trigger
+  // ('.', '->', '::') predicted an imminent completion. The result is null if
+  // the parse failed. codeComplete() adopts the entry if the document version
+  // and position still match.
+  struct SpeculativeCompletion {
+    std::string Version;
+    Position Pos;
+    std::shared_future<std::shared_ptr<const CodeCompleteResult>> Result;
+  };
+  // GUARDED_BY(SpeculativeCompletionMutex)
+  llvm::StringMap<SpeculativeCompletion> SpeculativeCompletionByFile;
+  // Options of the most recent completion request; speculative parses mirror
+  // them, assuming the client keeps its completion configuration stable.
+  // GUARDED_BY(SpeculativeCompletionMutex)
+  std::optional<clangd::CodeCompleteOptions> LastCodeCompleteOpts;
+  mutable std::mutex SpeculativeCompletionMutex;
+
   std::optional<std::string> WorkspaceRoot;
   std::optional<AsyncTaskRunner> IndexTasks; // for stdlib indexing.
   std::optional<TUScheduler> WorkScheduler;
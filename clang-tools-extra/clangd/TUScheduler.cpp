@@ -727,6 +727,13 @@ private:
   Semaphore &Barrier;
   /// Whether the 'onMainAST' callback ran for the current FileInputs.
   bool RanASTCallback = false;
+  /// The invocation built from the last compile command, along with the
+  /// diagnostics the driver emitted for it. Edits rarely change the compile
+  /// command, so updates clone this instead of re-running the driver, which
+  /// is a fixed cost on every keystroke burst. Only used by the worker thread.
+  std::unique_ptr<CompilerInvocation> CachedInvocation;
+  tooling::CompileCommand CachedInvocationCommand;
+  std::vector<Diag> CachedInvocationDiags;
   /// Guards members used by both TUScheduler and the worker thread.
   mutable std::mutex Mutex;
   /// File inputs, currently being used by the worker.
@@ -910,15 +917,31 @@ void ASTWorker::update(ParseInputs Inputs, WantDiagnostics WantDiags,
         Inputs.CompileCommand.Directory,
         printArgv(Inputs.CompileCommand.CommandLine));
 
-    StoreDiags CompilerInvocationDiagConsumer;
-    std::vector<std::string> CC1Args;
-    std::unique_ptr<CompilerInvocation> Invocation = buildCompilerInvocation(
-        Inputs, CompilerInvocationDiagConsumer, &CC1Args);
-    // Log cc1 args even (especially!) if creating invocation failed.
-    if (!CC1Args.empty())
-      vlog("Driver produced command: cc1 {0}", printArgv(CC1Args));
-    std::vector<Diag> CompilerInvocationDiags =
-        CompilerInvocationDiagConsumer.take();
+    std::unique_ptr<CompilerInvocation> Invocation;
+    std::vector<Diag> CompilerInvocationDiags;
+    if (CachedInvocation && !Inputs.ForceRebuild &&
+        Inputs.CompileCommand == CachedInvocationCommand) {
+      // Only the contents changed since the invocation was built; re-running
+      // the driver would produce the same result, so clone the cached one.
+      Invocation = std::make_unique<CompilerInvocation>(*CachedInvocation);
+      CompilerInvocationDiags = CachedInvocationDiags;
+    } else {
+      StoreDiags CompilerInvocationDiagConsumer;
+      std::vector<std::string> CC1Args;
+      Invocation = buildCompilerInvocation(Inputs, CompilerInvocationDiagConsumer,
+                                           &CC1Args);
+      // Log cc1 args even (especially!) if creating invocation failed.
+      if (!CC1Args.empty())
+        vlog("Driver produced command: cc1 {0}", printArgv(CC1Args));
+      CompilerInvocationDiags = CompilerInvocationDiagConsumer.take();
+      if (Invocation) {
+        CachedInvocation = std::make_unique<CompilerInvocation>(*Invocation);
+        CachedInvocationCommand = Inputs.CompileCommand;
+        CachedInvocationDiags = CompilerInvocationDiags;
+      } else {
+        CachedInvocation.reset();
+      }
+    }
     if (!Invocation) {
       elog("Could not build CompilerInvocation for file {0}", FileName);
       // Remove the old AST if it's still in cache.
@@ -17,6 +17,7 @@
 #include "support/Trace.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/bit.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
@@ -420,6 +421,48 @@ Relation readRelation(Reader &Data) {
   return {Subject, Predicate, Object};
 }
 
+// PREBUILT POSTINGS ENCODING
+// Prebuilt dex search tokens, so the reader can skip generating them. Only
+// meaningful together: "rank" fixes the DocID of each symbol and "post" maps
+// search tokens to DocIDs.
+// The rank section holds for each DocID, in order:
+//  - SymbolID: 8 bytes
+//  - quality: 4 bytes (float bits)
+// The post section holds for each search token:
+//  - token kind: 1 byte
+//  - token text: varint (index into the string table)
+//  - NumDocs: varint
+//  - sorted DocIDs, delta-encoded: varint[NumDocs]
+
+void writePostings(const dex::Token &Tok, llvm::StringRef CanonicalText,
+                   llvm::ArrayRef<uint32_t> Docs, const StringTableOut &Strings,
+                   llvm::raw_ostream &OS) {
+  OS.write(static_cast<uint8_t>(Tok.kind()));
+  writeVar(Strings.index(CanonicalText), OS);
+  writeVar(Docs.size(), OS);
+  uint32_t Prev = 0;
+  for (uint32_t Doc : Docs) {
+    writeVar(Doc - Prev, OS);
+    Prev = Doc;
+  }
+}
+
+std::pair<dex::Token, std::vector<uint32_t>>
+readPostings(Reader &Data, llvm::ArrayRef<llvm::StringRef> Strings) {
+  auto TokenKind = static_cast<dex::Token::Kind>(Data.consume8());
+  llvm::StringRef TokenText = Data.consumeString(Strings);
+  std::pair<dex::Token, std::vector<uint32_t>> Result{
+      dex::Token(TokenKind, TokenText), {}};
+  if (!Data.consumeSize(Result.second))
+    return Result;
+  uint32_t Doc = 0;
+  for (uint32_t &D : Result.second) {
+    Doc += Data.consumeVar();
+    D = Doc;
+  }
+  return Result;
+}
+
 struct InternedCompileCommand {
   llvm::StringRef Directory;
   std::vector<llvm::StringRef> CommandLine;
@@ -452,6 +495,8 @@ readCompileCommand(Reader CmdReader, llvm::ArrayRef<llvm::StringRef> Strings) {
 //   - srcs: information related to include graph
 //   - stri: string table
 //   - symb: symbols
+//   - rank: symbol ranking backing prebuilt postings (optional)
+//   - post: prebuilt dex posting lists (optional)
 //   - refs: references to symbols
 
 // The current versioning scheme is simple - non-current versions are rejected.
@@ -514,6 +559,23 @@ llvm::Expected<IndexFileIn> readRIFF(llvm::StringRef Data,
       return error("malformed or truncated symbol");
     Result.Symbols = std::move(Symbols).build();
   }
+  if (Chunks.count("rank") && Chunks.count("post")) {
+    Result.Postings.emplace();
+    Reader RankReader(Chunks.lookup("rank"));
+    while (!RankReader.eof()) {
+      SymbolID ID = RankReader.consumeID();
+      float Quality = llvm::bit_cast<float>(RankReader.consume32());
+      Result.Postings->Ranking.emplace_back(ID, Quality);
+    }
+    if (RankReader.err())
+      return error("malformed or truncated symbol ranking");
+    Reader PostReader(Chunks.lookup("post"));
+    while (!PostReader.eof())
+      Result.Postings->Postings.push_back(
+          readPostings(PostReader, Strings->Strings));
+    if (PostReader.err())
+      return error("malformed or truncated posting list");
+  }
   if (Chunks.count("refs")) {
     Reader RefsReader(Chunks.lookup("refs"));
     RefSlab::Builder Refs;
@@ -576,6 +638,51 @@ void writeRIFF(const IndexFileOut &Data, llvm::raw_ostream &OS) {
     visitStrings(Symbols.back(),
                  [&](llvm::StringRef &S) { Strings.intern(S); });
   }
+
+  // For prebuilt postings, symbols are written in quality-descending order so
+  // the posting lists can refer to them by rank (DocID).
+  std::vector<float> SymbolQuality;
+  std::vector<std::pair<dex::Token, std::vector<uint32_t>>> Postings;
+  // Canonical interned text of each posting's token, for Strings.index().
+  std::vector<llvm::StringRef> PostingTexts;
+  if (Data.DexPostings) {
+    std::vector<std::pair<float, size_t>> Scores(Symbols.size());
+    for (size_t I = 0; I < Symbols.size(); ++I)
+      Scores[I] = {quality(Symbols[I]), I};
+    // Sort by descending quality, breaking ties by ID for determinism.
+    llvm::sort(Scores, [&](const auto &L, const auto &R) {
+      if (L.first != R.first)
+        return L.first > R.first;
+      return Symbols[L.second].ID < Symbols[R.second].ID;
+    });
+    std::vector<Symbol> Ranked;
+    Ranked.reserve(Symbols.size());
+    SymbolQuality.reserve(Symbols.size());
+    for (const auto &[Quality, I] : Scores) {
+      Ranked.push_back(std::move(Symbols[I]));
+      SymbolQuality.push_back(Quality);
+    }
+    Symbols = std::move(Ranked);
+
+    std::vector<const Symbol *> RankedSymbols;
+    RankedSymbols.reserve(Symbols.size());
+    for (const auto &Sym : Symbols)
+      RankedSymbols.push_back(&Sym);
+    Postings = dex::generateSearchTokens(RankedSymbols);
+    // Sort for deterministic output; readers don't rely on the order.
+    llvm::sort(Postings, [](const auto &L, const auto &R) {
+      if (L.first.kind() != R.first.kind())
+        return L.first.kind() < R.first.kind();
+      return L.first.text() < R.first.text();
+    });
+    PostingTexts.reserve(Postings.size());
+    for (const auto &P : Postings) {
+      llvm::StringRef Text = P.first.text();
+      Strings.intern(Text);
+      PostingTexts.push_back(Text);
+    }
+  }
+
   std::vector<IncludeGraphNode> Sources;
   if (Data.Sources)
     for (const auto &Source : *Data.Sources) {
@@ -630,6 +737,26 @@ void writeRIFF(const IndexFileOut &Data, llvm::raw_ostream &OS) {
   }
   RIFF.Chunks.push_back({riff::fourCC("symb"), SymbolSection});
 
+  std::string RankSection;
+  std::string PostSection;
+  if (Data.DexPostings) {
+    {
+      llvm::raw_string_ostream RankOS(RankSection);
+      for (size_t I = 0; I < Symbols.size(); ++I) {
+        RankOS << Symbols[I].ID.raw();
+        write32(llvm::bit_cast<uint32_t>(SymbolQuality[I]), RankOS);
+      }
+    }
+    RIFF.Chunks.push_back({riff::fourCC("rank"), RankSection});
+    {
+      llvm::raw_string_ostream PostOS(PostSection);
+      for (size_t I = 0; I < Postings.size(); ++I)
+        writePostings(Postings[I].first, PostingTexts[I], Postings[I].second,
+                      Strings, PostOS);
+    }
+    RIFF.Chunks.push_back({riff::fourCC("post"), PostSection});
+  }
+
   std::string RefsSection;
   if (Data.Refs) {
     {
@@ -716,6 +843,7 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
   SymbolSlab Symbols;
   RefSlab Refs;
   RelationSlab Relations;
+  std::optional<DexPostings> Postings;
   {
     trace::Span Tracer("ParseIndex");
     if (auto I = readIndexFile(Buffer->get()->getBuffer(), Origin)) {
@@ -725,6 +853,8 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
         Refs = std::move(*I->Refs);
       if (I->Relations)
         Relations = std::move(*I->Relations);
+      if (I->Postings)
+        Postings = std::move(*I->Postings);
     } else {
       elog("Bad index file: {0}", I.takeError());
       return nullptr;
@@ -736,11 +866,18 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
   size_t NumRelations = Relations.size();
 
   trace::Span Tracer("BuildIndex");
-  auto Index = UseDex
-                   ? dex::Dex::build(std::move(Symbols), std::move(Refs),
-                                     std::move(Relations), SupportContainedRefs)
-                   : MemIndex::build(std::move(Symbols), std::move(Refs),
-                                     std::move(Relations));
+  std::unique_ptr<SymbolIndex> Index;
+  if (!UseDex)
+    Index = MemIndex::build(std::move(Symbols), std::move(Refs),
+                            std::move(Relations));
+  else if (Postings) // Prebuilt postings make the Dex build cheap.
+    Index = dex::Dex::build(std::move(Symbols), std::move(Refs),
+                            std::move(Relations), Postings->Ranking,
+                            std::move(Postings->Postings),
+                            SupportContainedRefs);
+  else
+    Index = dex::Dex::build(std::move(Symbols), std::move(Refs),
+                            std::move(Relations), SupportContainedRefs);
   vlog("Loaded {0} from {1} with estimated memory usage {2} bytes\n"
        "  - number of symbols: {3}\n"
        "  - number of refs: {4}\n"
@@ -27,6 +27,7 @@
 #include "Headers.h"
 #include "index/Index.h"
 #include "index/Symbol.h"
+#include "index/dex/Token.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include "llvm/Support/Error.h"
 #include <optional>
@@ -39,6 +40,16 @@ enum class IndexFileFormat {
   YAML, // Human-readable format, suitable for experiments and debugging.
 };
 
+// Prebuilt search tokens for dex::Dex, stored in an index file alongside the
+// symbols so that loading the index can skip the expensive build stage.
+struct DexPostings {
+  // ID and quality of each symbol, in quality-descending order. The DocIDs
+  // below are positions in this vector.
+  std::vector<std::pair<SymbolID, float>> Ranking;
+  // The sorted DocIDs matching each search token.
+  std::vector<std::pair<dex::Token, std::vector<uint32_t>>> Postings;
+};
+
 // Holds the contents of an index file that was read.
 struct IndexFileIn {
   std::optional<SymbolSlab> Symbols;
@@ -48,6 +59,8 @@ struct IndexFileIn {
   std::optional<IncludeGraph> Sources;
   // This contains only the Directory and CommandLine.
   std::optional<tooling::CompileCommand> Cmd;
+  // Prebuilt Dex postings, present if the file was written with DexPostings.
+  std::optional<DexPostings> Postings;
 };
 // Parse an index file. The input must be a RIFF or YAML file.
 llvm::Expected<IndexFileIn> readIndexFile(llvm::StringRef, SymbolOrigin);
@@ -59,7 +72,9 @@ struct IndexFileOut {
   const RelationSlab *Relations = nullptr;
   // Keys are URIs of the source files.
   const IncludeGraph *Sources = nullptr;
-  // TODO: Support serializing Dex posting lists.
+  // Write prebuilt Dex postings so loadIndex() can skip building the inverted
+  // index. Only worthwhile for monolithic indexes; RIFF only.
+  bool DexPostings = false;
   IndexFileFormat Format = IndexFileFormat::RIFF;
   const tooling::CompileCommand *Cmd = nullptr;
 
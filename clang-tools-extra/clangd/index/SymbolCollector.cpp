@@ -1204,7 +1204,7 @@ void SymbolCollector::addRef(SymbolID ID, const SymbolRef &SR) {
 SymbolID SymbolCollector::getSymbolIDCached(const Decl *D) {
   auto It = DeclToIDCache.try_emplace(D, SymbolID{});
   if (It.second)
-    It.first->second = getSymbolID(D);
+    It.first->second = getSymbolID(D, USRScratch);
   return It.first->second;
 }
 
@@ -1213,7 +1213,7 @@ SymbolID SymbolCollector::getSymbolIDCached(const llvm::StringRef MacroName,
                                             const SourceManager &SM) {
   auto It = MacroToIDCache.try_emplace(MI, SymbolID{});
   if (It.second)
-    It.first->second = getSymbolID(MacroName, MI, SM);
+    It.first->second = getSymbolID(MacroName, MI, SM, USRScratch);
   return It.first->second;
 }
 } // namespace clangd
@@ -82,45 +82,47 @@ public:
       TypeDocs[Sym.Type].push_back(D);
   }
 
-  // Assemble the final compressed posting lists for the added symbols.
-  llvm::DenseMap<Token, PostingList> build() && {
-    llvm::DenseMap<Token, PostingList> Result(/*InitialReserve=*/
-                                              TrigramDocs.size() +
-                                              RestrictedCCDocs.size() +
-                                              TypeDocs.size() +
-                                              ScopeDocs.size() +
-                                              ProximityDocs.size());
+  // Assemble the final posting lists for the added symbols, keyed by token.
+  std::vector<std::pair<Token, std::vector<DocID>>> build() && {
+    std::vector<std::pair<Token, std::vector<DocID>>> Result;
+    Result.reserve(TrigramDocs.size() + (RestrictedCCDocs.empty() ? 0 : 1) +
+                   TypeDocs.size() + ScopeDocs.size() + ProximityDocs.size());
     // Tear down intermediate structs as we go to reduce memory usage.
     // Since we're trying to get rid of underlying allocations, clearing the
     // containers is not enough.
-    auto CreatePostingList =
+    auto TakePostings =
         [&Result](Token::Kind TK, llvm::StringMap<std::vector<DocID>> &Docs) {
-          for (auto &E : Docs) {
-            Result.try_emplace(Token(TK, E.first()), E.second);
-            E.second = {};
-          }
+          for (auto &E : Docs)
+            Result.emplace_back(Token(TK, E.first()), std::move(E.second));
           Docs = {};
         };
-    CreatePostingList(Token::Kind::Type, TypeDocs);
-    CreatePostingList(Token::Kind::Scope, ScopeDocs);
-    CreatePostingList(Token::Kind::ProximityURI, ProximityDocs);
+    TakePostings(Token::Kind::Type, TypeDocs);
+    TakePostings(Token::Kind::Scope, ScopeDocs);
+    TakePostings(Token::Kind::ProximityURI, ProximityDocs);
 
     // TrigramDocs are stored in a DenseMap and RestrictedCCDocs is not even a
     // map, treat them specially.
-    for (auto &E : TrigramDocs) {
-      Result.try_emplace(Token(Token::Kind::Trigram, E.first.str()), E.second);
-      E.second = {};
-    }
+    for (auto &E : TrigramDocs)
+      Result.emplace_back(Token(Token::Kind::Trigram, E.first.str()),
+                          std::move(E.second));
     TrigramDocs = llvm::DenseMap<Trigram, std::vector<DocID>>{};
     if (!RestrictedCCDocs.empty())
-      Result.try_emplace(RestrictedForCodeCompletion,
-                         std::move(RestrictedCCDocs));
+      Result.emplace_back(RestrictedForCodeCompletion,
+                          std::move(RestrictedCCDocs));
     return Result;
   }
 };
 
 } // namespace
 
+std::vector<std::pair<Token, std::vector<DocID>>>
+generateSearchTokens(llvm::ArrayRef<const Symbol *> RankedSymbols) {
+  IndexBuilder Builder;
+  for (DocID SymbolRank = 0; SymbolRank < RankedSymbols.size(); ++SymbolRank)
+    Builder.add(*RankedSymbols[SymbolRank], SymbolRank);
+  return std::move(Builder).build();
+}
+
 void Dex::buildIndex(bool SupportContainedRefs) {
   this->Corpus = dex::Corpus(Symbols.size());
   std::vector<std::pair<float, const Symbol *>> ScoredSymbols(Symbols.size());
@@ -144,15 +146,32 @@ void Dex::buildIndex(bool SupportContainedRefs) {
   }
 
   // Build posting lists for symbols.
-  IndexBuilder Builder;
-  for (DocID SymbolRank = 0; SymbolRank < Symbols.size(); ++SymbolRank)
-    Builder.add(*Symbols[SymbolRank], SymbolRank);
-  InvertedIndex = std::move(Builder).build();
+  createInvertedIndex(generateSearchTokens(Symbols));
 
   // If the containedRefs() operation is supported, build the RevRefs
   // data structure used to implement it.
-  if (!SupportContainedRefs)
-    return;
+  if (SupportContainedRefs)
+    buildRevRefs();
+}
+
+void Dex::createInvertedIndex(
+    std::vector<std::pair<Token, std::vector<DocID>>> Postings) {
+  InvertedIndex =
+      llvm::DenseMap<Token, PostingList>(/*InitialReserve=*/Postings.size());
+  for (auto &[Tok, Docs] : Postings) {
+    // Cache the top documents of short trigram tokens separately; short
+    // queries consult only these (see shortIterator()).
+    if (Tok.kind() == Token::Kind::Trigram && Tok.text().size() < 3 &&
+        Docs.size() > ShortQueryTopDocs)
+      ShortIndex.try_emplace(Tok, PostingList(llvm::ArrayRef<DocID>(Docs)
+                                                  .take_front(
+                                                      ShortQueryTopDocs)));
+    InvertedIndex.try_emplace(std::move(Tok), PostingList(Docs));
+    Docs = {}; // Free eagerly to reduce peak memory usage.
+  }
+}
+
+void Dex::buildRevRefs() {
   for (const auto &[ID, RefList] : Refs)
     for (const auto &R : RefList)
       if ((R.Kind & ContainedRefsRequest::SupportedRefKinds) !=
@@ -164,12 +183,81 @@ void Dex::buildIndex(bool SupportContainedRefs) {
   });
 }
 
+Dex::Dex(PrebuiltTag, const SymbolSlab &Symbols, const RefSlab &Refs,
+         const RelationSlab &Relations)
+    : Corpus(Symbols.size()) {
+  for (const auto &Sym : Symbols)
+    LookupTable[Sym.ID] = &Sym;
+  for (const auto &Ref : Refs)
+    this->Refs.try_emplace(Ref.first, Ref.second);
+  for (const auto &Rel : Relations)
+    this->Relations[std::make_pair(Rel.Subject,
+                                   static_cast<uint8_t>(Rel.Predicate))]
+        .push_back(Rel.Object);
+}
+
+bool Dex::restorePostings(
+    llvm::ArrayRef<std::pair<SymbolID, float>> Ranking,
+    std::vector<std::pair<Token, std::vector<DocID>>> Postings,
+    bool SupportContainedRefs) {
+  if (Ranking.size() != LookupTable.size())
+    return false;
+  Symbols.reserve(Ranking.size());
+  SymbolQuality.reserve(Ranking.size());
+  for (const auto &[ID, Quality] : Ranking) {
+    auto It = LookupTable.find(ID);
+    if (It == LookupTable.end())
+      return false;
+    Symbols.push_back(It->second);
+    SymbolQuality.push_back(Quality);
+  }
+  // PostingList requires sorted DocIDs, and they must refer to symbols.
+  for (const auto &P : Postings) {
+    const auto &Docs = P.second;
+    for (size_t I = 0; I < Docs.size(); ++I)
+      if (Docs[I] >= Symbols.size() || (I > 0 && Docs[I] <= Docs[I - 1]))
+        return false;
+  }
+  createInvertedIndex(std::move(Postings));
+  if (SupportContainedRefs)
+    buildRevRefs();
+  return true;
+}
+
+std::unique_ptr<SymbolIndex>
+Dex::build(SymbolSlab Symbols, RefSlab Refs, RelationSlab Rels,
+           llvm::ArrayRef<std::pair<SymbolID, float>> Ranking,
+           std::vector<std::pair<Token, std::vector<DocID>>> Postings,
+           bool SupportContainedRefs) {
+  auto Size = Symbols.bytes() + Refs.bytes();
+  auto Data = std::make_pair(std::move(Symbols), std::move(Refs));
+  std::unique_ptr<Dex> Index(
+      new Dex(PrebuiltTag{}, Data.first, Data.second, Rels));
+  if (!Index->restorePostings(Ranking, std::move(Postings),
+                              SupportContainedRefs)) {
+    log("Prebuilt postings don't match the symbols, rebuilding the index.");
+    return std::make_unique<Dex>(Data.first, Data.second, Rels,
+                                 std::move(Data), Size, SupportContainedRefs);
+  }
+  Index->KeepAlive = std::shared_ptr<void>(
+      std::make_shared<decltype(Data)>(std::move(Data)), nullptr);
+  Index->BackingDataSize = Size;
+  return Index;
+}
+
 std::unique_ptr<Iterator> Dex::iterator(const Token &Tok) const {
   auto It = InvertedIndex.find(Tok);
   return It == InvertedIndex.end() ? Corpus.none()
                                    : It->second.iterator(&It->first);
 }
 
+std::unique_ptr<Iterator> Dex::shortIterator(const Token &Tok) const {
+  auto It = ShortIndex.find(Tok);
+  if (It != ShortIndex.end())
+    return It->second.iterator(&It->first);
+  return iterator(Tok);
+}
+
 // Constructs BOOST iterators for Path Proximities.
 std::unique_ptr<Iterator> Dex::createFileProximityIterator(
     llvm::ArrayRef<std::string> ProximityPaths) const {
@@ -238,10 +326,13 @@ bool Dex::fuzzyFind(const FuzzyFindRequest &Req,
   const auto TrigramTokens = generateQueryTrigrams(Req.Query);
 
   // Generate query trigrams and construct AND iterator over all query
-  // trigrams.
+  // trigrams. Short queries hit huge posting lists (e.g. every symbol whose
+  // name starts with one letter), so they retrieve only the top documents of
+  // each token; their results are reported incomplete (More) anyway.
   std::vector<std::unique_ptr<Iterator>> TrigramIterators;
   for (const auto &Trigram : TrigramTokens)
-    TrigramIterators.push_back(iterator(Trigram));
+    TrigramIterators.push_back(More ? shortIterator(Trigram)
+                                    : iterator(Trigram));
   Criteria.push_back(Corpus.intersect(std::move(TrigramIterators)));
 
   // Generate scope tokens for search query.
@@ -394,6 +485,9 @@ size_t Dex::estimateMemoryUsage() const {
   Bytes += InvertedIndex.getMemorySize();
   for (const auto &TokenToPostingList : InvertedIndex)
     Bytes += TokenToPostingList.second.bytes();
+  Bytes += ShortIndex.getMemorySize();
+  for (const auto &TokenToPostingList : ShortIndex)
+    Bytes += TokenToPostingList.second.bytes();
   Bytes += Refs.getMemorySize();
   Bytes += RevRefs.size() * sizeof(RevRef);
   Bytes += Relations.getMemorySize();
@@ -31,6 +31,11 @@ namespace clang {
 namespace clangd {
 namespace dex {
 
+/// Maximum number of documents a short (1-2 character) query token retrieves.
+/// Posting lists are sorted by symbol quality, so the truncated lists serving
+/// short queries keep each token's best documents. Exposed for testing.
+constexpr size_t ShortQueryTopDocs = 10000;
+
 /// In-memory Dex trigram-based index implementation.
 class Dex : public SymbolIndex {
 public:
@@ -78,6 +83,18 @@ public:
   static std::unique_ptr<SymbolIndex> build(SymbolSlab, RefSlab, RelationSlab,
                                             bool SupportContainedRefs);
 
+  /// Builds an index from slabs and prebuilt search tokens stored in an index
+  /// file (see DexPostings in Serialization.h), skipping the expensive
+  /// token-generation stage. \p Ranking holds the ID and quality of each
+  /// symbol in quality-descending order, and DocIDs in \p Postings refer to
+  /// positions in it. Falls back to a full build if the prebuilt data doesn't
+  /// describe the symbols in the slab.
+  static std::unique_ptr<SymbolIndex>
+  build(SymbolSlab, RefSlab, RelationSlab,
+        llvm::ArrayRef<std::pair<SymbolID, float>> Ranking,
+        std::vector<std::pair<Token, std::vector<DocID>>> Postings,
+        bool SupportContainedRefs);
+
   bool
   fuzzyFind(const FuzzyFindRequest &Req,
             llvm::function_ref<void(const Symbol &)> Callback) const override;
@@ -115,10 +132,31 @@ private:
     }
   };
 
+  /// Sets up the slab-derived lookup structures but leaves the search tokens
+  /// empty; used by the prebuilt-postings overload of build().
+  struct PrebuiltTag {};
+  Dex(PrebuiltTag, const SymbolSlab &Symbols, const RefSlab &Refs,
+      const RelationSlab &Relations);
+
   void buildIndex(bool EnableOutgoingCalls);
+  /// Populates the search tokens from prebuilt data instead of generating
+  /// them. Returns false (leaving the index unusable) if the data doesn't
+  /// match the symbols set up by the PrebuiltTag constructor.
+  [[nodiscard]] bool
+  restorePostings(llvm::ArrayRef<std::pair<SymbolID, float>> Ranking,
+                  std::vector<std::pair<Token, std::vector<DocID>>> Postings,
+                  bool SupportContainedRefs);
+  void buildRevRefs();
+  /// Moves \p Postings into the inverted index, additionally recording the
+  /// truncated top-document lists backing short queries.
+  void
+  createInvertedIndex(std::vector<std::pair<Token, std::vector<DocID>>>);
   llvm::iterator_range<std::vector<RevRef>::const_iterator>
   lookupRevRefs(const SymbolID &Container) const;
   std::unique_ptr<Iterator> iterator(const Token &Tok) const;
+  /// Like iterator(), but prefers the truncated top-document posting list of
+  /// a short trigram token, if one was recorded.
+  std::unique_ptr<Iterator> shortIterator(const Token &Tok) const;
   std::unique_ptr<Iterator>
   createFileProximityIterator(llvm::ArrayRef<std::string> ProximityPaths) const;
   std::unique_ptr<Iterator>
@@ -136,6 +174,11 @@ private:
   /// std. Inverted index is used to retrieve posting lists which are processed
   /// during the fuzzyFind process.
   llvm::DenseMap<Token, PostingList> InvertedIndex;
+  /// Truncated posting lists for short (1-2 character) trigram tokens whose
+  /// full lists exceed ShortQueryTopDocs. Posting lists are sorted by symbol
+  /// quality, so these hold each token's best documents and bound the work a
+  /// short query can do (see shortIterator()).
+  llvm::DenseMap<Token, PostingList> ShortIndex;
   dex::Corpus Corpus;
   llvm::DenseMap<SymbolID, llvm::ArrayRef<Ref>> Refs;
   std::vector<RevRef> RevRefs; // sorted by container ID
@@ -159,6 +202,14 @@ private:
 /// This function is exposed for testing only.
 llvm::SmallVector<llvm::StringRef, 5> generateProximityURIs(llvm::StringRef);
 
+/// Returns the search tokens characterizing \p RankedSymbols and the DocIDs
+/// matching each, where DocID I refers to RankedSymbols[I]. Symbols should be
+/// sorted in the descending order of symbol quality.
+///
+/// Exposed so the index serialization can store prebuilt postings.
+std::vector<std::pair<Token, std::vector<DocID>>>
+generateSearchTokens(llvm::ArrayRef<const Symbol *> RankedSymbols);
+
 } // namespace dex
 } // namespace clangd
 } // namespace clang
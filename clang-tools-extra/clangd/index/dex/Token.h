@@ -72,6 +72,10 @@ public:
   Token(Kind TokenKind, llvm::StringRef Data)
       : Data(Data), TokenKind(TokenKind) {}
 
+  Kind kind() const { return TokenKind; }
+  /// Returns the raw representation, unique among Tokens of the same Kind.
+  llvm::StringRef text() const { return Data; }
+
   bool operator==(const Token &Other) const {
     return TokenKind == Other.TokenKind && Data == Other.Data;
   }
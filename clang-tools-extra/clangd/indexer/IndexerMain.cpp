@@ -176,6 +176,8 @@ int main(int argc, const char **argv) {
   // Emit collected data.
   clang::clangd::IndexFileOut Out(Data);
   Out.Format = clang::clangd::Format;
+  // Prebuilt postings let clangd load the index without rebuilding Dex.
+  Out.DexPostings = Out.Format == clang::clangd::IndexFileFormat::RIFF;
   llvm::outs() << Out;
   return 0;
 }
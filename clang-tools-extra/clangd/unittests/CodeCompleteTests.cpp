@@ -2872,6 +2872,34 @@ TEST(CompletionTest, EnableSpeculativeIndexRequest) {
   ASSERT_EQ(Reqs3.size(), 2u);
 }
 
+TEST(CompletionTest, SpeculativeParseOnTriggerEdit) {
+  MockFS FS;
+  MockCompilationDatabase CDB;
+  ClangdServer Server(CDB, FS, ClangdServer::optsForTest());
+
+  auto File = testPath("foo.cpp");
+  Annotations Before(R"cpp(
+      struct S { int member; };
+      void f(S s) { s^; }
+  )cpp");
+  runAddDocument(Server, File, Before.code());
+  // An initial completion records the options mirrored by speculative parses.
+  cantFail(runCodeComplete(Server, File, Before.point(), {}));
+
+  Annotations After(R"cpp(
+      struct S { int member; };
+      void f(S s) { s.^; }
+  )cpp");
+  // Inserting "." after an identifier kicks off a speculative completion
+  // parse at the position right after it.
+  runAddDocument(Server, File, After.code());
+
+  // Results at the predicted point must be correct whether the request joined
+  // the speculative parse or fell back to a fresh one.
+  auto Results = cantFail(runCodeComplete(Server, File, After.point(), {}));
+  EXPECT_THAT(Results.Completions, Contains(named("member")));
+}
+
 TEST(CompletionTest, InsertTheMostPopularHeader) {
   std::string DeclFile = URI::create(testPath("foo")).toString();
   Symbol Sym = func("Func");
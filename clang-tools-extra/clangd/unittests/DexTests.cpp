@@ -579,6 +579,32 @@ TEST(DexTest, ShortQuery) {
   EXPECT_FALSE(Incomplete) << "3-char string is not a short query";
 }
 
+TEST(DexTest, ShortQueryUsesTopDocs) {
+  // More symbols matching "c" than a short query is willing to retrieve.
+  SymbolSlab::Builder Builder;
+  for (const auto &Sym : generateSymbols([] {
+         std::vector<std::string> Names;
+         for (size_t I = 0; I < ShortQueryTopDocs + 100; ++I)
+           Names.push_back("Common" + std::to_string(I));
+         return Names;
+       }()))
+    Builder.insert(Sym);
+  // A high-quality symbol must survive the top-docs truncation.
+  Symbol Hot = symbol("CommonHot");
+  Hot.References = 1000;
+  Builder.insert(Hot);
+  auto I =
+      Dex::build(std::move(Builder).build(), RefSlab(), RelationSlab(), true);
+
+  FuzzyFindRequest Req;
+  Req.Query = "c";
+  Req.AnyScope = true;
+  Req.Limit = 10;
+  bool Incomplete;
+  EXPECT_THAT(match(*I, Req, &Incomplete), ::testing::Contains("CommonHot"));
+  EXPECT_TRUE(Incomplete) << "Short queries are never complete";
+}
+
 TEST(DexTest, MatchQualifiedNamesWithoutSpecificScope) {
   auto I = Dex::build(generateSymbols({"a::y1", "b::y2", "y3"}), RefSlab(),
                       RelationSlab(), true);
@@ -253,6 +253,42 @@ TEST(SerializationTest, BinaryConversions) {
               UnorderedElementsAreArray(yamlFromRelations(*In->Relations)));
 }
 
+TEST(SerializationTest, PrebuiltPostingsRoundTrip) {
+  auto In = readIndexFile(YAML);
+  ASSERT_TRUE(bool(In)) << In.takeError();
+
+  IndexFileOut Out(*In);
+  Out.Format = IndexFileFormat::RIFF;
+  Out.DexPostings = true;
+  std::string Serialized = llvm::to_string(Out);
+
+  auto In2 = readIndexFile(Serialized);
+  ASSERT_TRUE(bool(In2)) << In2.takeError();
+  ASSERT_TRUE(In2->Symbols);
+  ASSERT_TRUE(In2->Postings);
+  // The ranking and postings must describe the symbols in the slab.
+  EXPECT_EQ(In2->Postings->Ranking.size(), In2->Symbols->size());
+  for (const auto &Entry : In2->Postings->Ranking)
+    EXPECT_NE(In2->Symbols->find(Entry.first), In2->Symbols->end());
+  ASSERT_FALSE(In2->Postings->Postings.empty());
+  for (const auto &[Tok, Docs] : In2->Postings->Postings) {
+    EXPECT_TRUE(std::is_sorted(Docs.begin(), Docs.end()));
+    for (uint32_t Doc : Docs)
+      EXPECT_LT(Doc, In2->Postings->Ranking.size());
+  }
+  // Trigrams of symbol names must be among the tokens.
+  EXPECT_THAT(In2->Postings->Postings,
+              ::testing::Contains(
+                  Pair(dex::Token(dex::Token::Kind::Trigram, "foo"),
+                       ::testing::Not(::testing::IsEmpty()))));
+
+  // The old format without postings still loads, just without them.
+  Out.DexPostings = false;
+  auto In3 = readIndexFile(llvm::to_string(Out));
+  ASSERT_TRUE(bool(In3)) << In3.takeError();
+  EXPECT_FALSE(In3->Postings);
+}
+
 TEST(SerializationTest, SrcsTest) {
   auto In = readIndexFile(YAML);
   EXPECT_TRUE(bool(In)) << In.takeError();
@@ -747,6 +747,16 @@ public:
   // longer need access to the AST.
   void cleanup();
 
+  /// Tear this context down in bulk when it is destroyed: the arena slabs
+  /// holding the AST are released wholesale and the per-node destructor
+  /// walks are skipped entirely.
+  ///
+  /// Heap side structures owned by individual nodes (APValues, template
+  /// specialization sets, record layouts, ...) are deliberately leaked, so
+  /// this is only appropriate for embedders that are about to exit or that
+  /// reclaim the process heap by other means.
+  void enableBulkTeardown() { BulkTeardownEnabled = true; }
+
   llvm::BumpPtrAllocator &getAllocator() const {
     return BumpAlloc;
   }
@@ -3522,6 +3532,10 @@ private:
       llvm::SmallVector<std::pair<void (*)(void *), void *>, 16>;
   mutable DeallocationFunctionsAndArguments Deallocations;
 
+  /// Whether cleanup() should release memory wholesale instead of walking
+  /// the registered deallocation functions and per-node side structures.
+  bool BulkTeardownEnabled = false;
+
   // FIXME: This currently contains the set of StoredDeclMaps used
   // by DeclContext objects.  This probably should not be in ASTContext,
   // but we include it here so that ASTContext can quickly deallocate them.
@@ -751,6 +751,11 @@ public:
   iterator end() const   { return HashTable.end(); }
   unsigned size() const  { return HashTable.size(); }
 
+  /// Grow the underlying table so it can hold at least \p NumEntries
+  /// identifiers without rehashing. Useful when the number of identifiers to
+  /// be added is known up front, e.g. when loading an AST file.
+  void reserve(unsigned NumEntries) { HashTable.reserve(NumEntries); }
+
   iterator find(StringRef Name) const { return HashTable.find(Name); }
 
   /// Print some statistics to stderr that indicate how well the
@@ -119,6 +119,12 @@ public:
   /// The directories used to load prebuilt module files.
   std::vector<std::string> PrebuiltModulePaths;
 
+  /// Prefix mappings of '-fmodule-file-prefix-map=OLD=NEW'. When writing a
+  /// PCH or module file, paths under OLD are recorded relative to NEW; when
+  /// loading one, recorded paths under NEW are resolved back to OLD. This
+  /// makes the serialized form independent of the local worktree location.
+  std::vector<std::pair<std::string, std::string>> ModuleFilePrefixMappings;
+
   /// The module/pch container format.
   std::string ModuleFormat;
 
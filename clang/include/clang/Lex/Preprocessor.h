@@ -1063,6 +1063,17 @@ private:
   /// reused for quick allocation.
   MacroArgs *MacroArgCache = nullptr;
 
+  /// Cached results of '##' concatenations in object-like macro bodies.
+  ///
+  /// The operands of a '##' group in an object-like macro are always the
+  /// same body tokens, so the concatenated token is identical on every
+  /// expansion. The key is the macro and the body index of the LHS token of
+  /// the group; the value is the formed token (spelled in the scratch
+  /// buffer) and the body index of the first token after the group.
+  llvm::DenseMap<std::pair<const MacroInfo *, unsigned>,
+                 std::pair<Token, unsigned>>
+      ObjectLikePasteResults;
+
   /// For each IdentifierInfo used in a \#pragma push_macro directive,
   /// we keep a MacroInfo stack used to restore the previous macro value.
   llvm::DenseMap<IdentifierInfo *, std::vector<MacroInfo *>>
@@ -1291,6 +1302,13 @@ public:
   /// the current module if we have changed modules since entering the file.
   Module *getCurrentLexerSubmodule() const { return CurLexerSubmodule; }
 
+  /// If tokens are currently coming straight from a file lexer for \p FID,
+  /// with no macro expansion or token caching in progress, move that lexer to
+  /// \p Offset and return true. The caller is responsible for re-lexing its
+  /// lookahead token and for ensuring the skipped text cannot change
+  /// preprocessor state.
+  bool trySeekCurrentLexer(FileID FID, unsigned Offset);
+
   /// Returns the FileID for the preprocessor predefines.
   FileID getPredefinesFileID() const { return PredefinesFileID; }
 
@@ -2232,6 +2250,28 @@ public:
       ++NumTokenPaste;
   }
 
+  /// Return the cached result of the '##' group starting at body token
+  /// \p LHSTokIdx of the object-like macro \p MI, or null if this group has
+  /// not been formed yet.
+  const std::pair<Token, unsigned> *
+  getObjectLikePasteResult(const MacroInfo *MI, unsigned LHSTokIdx) const {
+    auto I = ObjectLikePasteResults.find({MI, LHSTokIdx});
+    if (I == ObjectLikePasteResults.end())
+      return nullptr;
+    return &I->second;
+  }
+
+  /// Record the result of the '##' group starting at body token
+  /// \p LHSTokIdx of the object-like macro \p MI so that later expansions
+  /// can reuse it. \p Result must be spelled in permanent storage (e.g. the
+  /// scratch buffer) and \p NextTokIdx is the body index of the first token
+  /// after the group.
+  void rememberObjectLikePasteResult(const MacroInfo *MI, unsigned LHSTokIdx,
+                                     const Token &Result,
+                                     unsigned NextTokIdx) {
+    ObjectLikePasteResults[{MI, LHSTokIdx}] = {Result, NextTokIdx};
+  }
+
   void PrintStats();
 
   size_t getTotalMemory() const;
@@ -155,6 +155,11 @@ public:
   /// When enabled, the preprocessor will construct editor placeholder tokens.
   bool LexEditorPlaceholders = true;
 
+  /// If non-empty, the path of a sidecar index of skipped function body
+  /// extents that is consulted and refreshed across syntax-only runs of the
+  /// same main file; see Parser::SkipFunctionBody().
+  std::string FunctionBodyIndexPath;
+
   /// True if the SourceManager should report the original file name for
   /// contents of files that were remapped to other files. Defaults to true.
   bool RemappedFilesKeepOriginalName = true;
@@ -244,6 +249,7 @@ public:
     ImplicitPCHInclude.clear();
     SingleFileParseMode = false;
     LexEditorPlaceholders = true;
+    FunctionBodyIndexPath.clear();
     RetainRemappedFileBuffers = true;
     PrecompiledPreambleBytes.first = 0;
     PrecompiledPreambleBytes.second = false;
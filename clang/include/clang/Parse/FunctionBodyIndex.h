@@ -0,0 +1,79 @@
+//===--- FunctionBodyIndex.h - Sidecar index of function bodies -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the FunctionBodyIndex class, a sidecar index of the
+// source extents of function bodies a previous parse of the same file
+// skipped. A later syntax-only or tooling invocation can use it to seek the
+// lexer straight past a body instead of re-lexing its tokens.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_PARSE_FUNCTIONBODYINDEX_H
+#define LLVM_CLANG_PARSE_FUNCTIONBODYINDEX_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <memory>
+#include <optional>
+
+namespace clang {
+
+/// A sidecar index mapping the offset of a skipped function body to the
+/// offset of the first token after it, valid for one version of one source
+/// file.
+///
+/// Entries only cover bodies in the main file whose raw text cannot change
+/// preprocessor state (no directives, no _Pragma), so seeking past them is
+/// equivalent to lexing them. The on-disk form carries a content hash of the
+/// main file and is discarded wholesale when the file changes. Like a PCH,
+/// the index assumes the producing and consuming invocations agree on the
+/// command line; it does not validate predefined macros.
+class FunctionBodyIndex {
+  /// Offset of the token starting a skipped body (the '{', 'try', or the
+  /// ctor-initializer ':') to the offset of the first token after the body.
+  llvm::DenseMap<unsigned, unsigned> Extents;
+
+  /// Whether record() added entries that have not been written out yet.
+  bool Dirty = false;
+
+public:
+  /// Load the index at \p Path, or return null if it is missing, malformed,
+  /// or was built from different main-file contents.
+  static std::unique_ptr<FunctionBodyIndex>
+  loadFromFile(StringRef Path, StringRef MainFileContents);
+
+  /// Create an empty index to be populated by record().
+  static std::unique_ptr<FunctionBodyIndex> createEmpty() {
+    return std::make_unique<FunctionBodyIndex>();
+  }
+
+  /// Remember that the body starting at \p Begin ends right before \p End.
+  void record(unsigned Begin, unsigned End) {
+    Dirty |= Extents.try_emplace(Begin, End).second;
+  }
+
+  /// If a body starting at \p Begin was recorded, return the offset of the
+  /// first token after it.
+  std::optional<unsigned> lookup(unsigned Begin) const {
+    auto It = Extents.find(Begin);
+    if (It == Extents.end())
+      return std::nullopt;
+    return It->second;
+  }
+
+  bool isDirty() const { return Dirty; }
+
+  /// Write the index to \p Path, keyed by a hash of \p MainFileContents.
+  /// Returns false if the file could not be written.
+  bool writeToFile(StringRef Path, StringRef MainFileContents) const;
+};
+
+} // namespace clang
+
+#endif // LLVM_CLANG_PARSE_FUNCTIONBODYINDEX_H
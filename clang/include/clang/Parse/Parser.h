@@ -34,6 +34,7 @@ namespace clang {
   class CorrectionCandidateCallback;
   class DeclGroupRef;
   class DiagnosticBuilder;
+  class FunctionBodyIndex;
   struct LoopHint;
   class Parser;
   class ParsingDeclRAIIObject;
@@ -460,6 +461,10 @@ class Parser : public CodeCompletionHandler {
   /// declarations/definitions when indexing.
   bool SkipFunctionBodies;
 
+  /// When -function-body-index= is in effect, the sidecar index of skipped
+  /// function body extents consulted and refreshed by SkipFunctionBody().
+  std::unique_ptr<FunctionBodyIndex> BodyIndex;
+
   /// The location of the expression statement that is being parsed right now.
   /// Used to determine if an expression that is being parsed is a statement or
   /// just a regular sub-expression.
@@ -1698,6 +1703,7 @@ private:
                                                 AccessSpecifier AS);
 
   void SkipFunctionBody();
+  bool trySkipIndexedFunctionBody();
   Decl *ParseFunctionDefinition(ParsingDeclarator &D,
                  const ParsedTemplateInfo &TemplateInfo = ParsedTemplateInfo(),
                  LateParsedAttrList *LateParsedAttrs = nullptr);
@@ -200,6 +200,7 @@ class CapturingScopeInfo;
 class CompoundScopeInfo;
 class DelayedDiagnostic;
 class DelayedDiagnosticPool;
+class FailedDeducedSubstitution;
 class FunctionScopeInfo;
 class LambdaScopeInfo;
 class SemaPPCallbacks;
@@ -12274,6 +12275,15 @@ public:
       bool PartialOverloading = false,
       llvm::function_ref<bool()> CheckNonDependent = [] { return false; });
 
+  /// Memoized function template specializations whose substitution of
+  /// deduced arguments failed under SFINAE, keyed by the canonical template
+  /// and the canonical deduced argument list. Lets overload resolution fail
+  /// fast instead of re-attempting identical dead substitutions at every
+  /// call site. The nodes are owned by this set and freed in ~Sema.
+  llvm::ContextualFoldingSet<sema::FailedDeducedSubstitution,
+                             const ASTContext &>
+      FailedDeducedSubstitutionCache;
+
   /// Perform template argument deduction from a function call
   /// (C++ [temp.deduct.call]).
   ///
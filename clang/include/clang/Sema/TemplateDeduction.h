@@ -252,6 +252,40 @@ public:
   ConstraintSatisfaction AssociatedConstraintsSatisfaction;
 };
 
+/// Records a function template specialization whose substitution of deduced
+/// template arguments failed under SFINAE.
+///
+/// Failed specializations are never registered in the template's
+/// specialization set, so without this record every call site that deduces
+/// the same dead argument list re-runs the same failing substitution.
+class FailedDeducedSubstitution : public llvm::FoldingSetNode {
+public:
+  /// The canonical declaration of the primary function template.
+  FunctionTemplateDecl *Template;
+
+  /// The canonical deduced template arguments; allocated on the ASTContext.
+  TemplateArgumentList *DeducedArgs;
+
+  /// The deduction result to replay.
+  TemplateDeductionResult Result;
+
+  /// The suppressed diagnostic which caused the failure, if one was issued.
+  std::optional<PartialDiagnosticAt> SuppressedDiagnostic;
+
+  void Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Context) {
+    Profile(ID, Template, DeducedArgs->asArray(), Context);
+  }
+
+  static void Profile(llvm::FoldingSetNodeID &ID,
+                      const FunctionTemplateDecl *Template,
+                      ArrayRef<TemplateArgument> DeducedArgs,
+                      const ASTContext &Context) {
+    ID.AddPointer(Template);
+    for (const TemplateArgument &Arg : DeducedArgs)
+      Arg.Profile(ID, Context);
+  }
+};
+
 } // namespace sema
 
 /// A structure used to record information about a failed
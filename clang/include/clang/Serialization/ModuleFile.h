@@ -150,6 +150,11 @@ public:
   /// The base directory of the module.
   std::string BaseDirectory;
 
+  /// Reversed '-fmodule-file-prefix-map' mappings, applied to absolute paths
+  /// loaded from this module file to resolve the prefixes they were recorded
+  /// with back to local directories.
+  std::vector<std::pair<std::string, std::string>> PathPrefixMappings;
+
   static std::string getTimestampFilename(StringRef FileName) {
     return (FileName + ".timestamp").str();
   }
@@ -330,6 +330,11 @@ protected:
   /// A list of recently allocated nodes that can potentially be recycled.
   NodeVector ChangedNodes;
 
+  /// Nodes that were on the frontier (no successor yet) during the last
+  /// reclamation round and get reconsidered once in the next one, when they
+  /// have typically become reclaimable interior nodes.
+  NodeVector DeferredNodes;
+
   /// A list of nodes that can be reused.
   NodeVector FreeNodes;
 
@@ -220,6 +220,18 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Re-stats every cached path against \p UnderlyingFS and drops the
+  /// associations whose cached state is out of date: negative stats for paths
+  /// that now exist, paths that disappeared, and files whose size,
+  /// modification time or unique ID changed. Subsequent accesses observe the
+  /// new filesystem state. The backing entry storage is not reclaimed until
+  /// the cache is destroyed, so entry references held by worker filesystems
+  /// stay valid; still, this is intended to be called by long-lived scanning
+  /// services between builds, not concurrently with a scan.
+  ///
+  /// \returns The number of evicted entries.
+  size_t evictOutOfDateEntries(llvm::vfs::FileSystem &UnderlyingFS);
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
@@ -937,6 +937,18 @@ ASTContext::ASTContext(LangOptions &LOpts, SourceManager &SM,
 }
 
 void ASTContext::cleanup() {
+  // In bulk teardown mode the per-node walks below are skipped: the arena
+  // slabs are released by the BumpPtrAllocator destructor in O(slabs), and
+  // heap side structures owned by individual nodes are deliberately leaked.
+  if (BulkTeardownEnabled) {
+    Deallocations.clear();
+    ObjCLayouts.clear();
+    ASTRecordLayouts.clear();
+    DeclAttrs.clear();
+    ModuleInitializers.clear();
+    return;
+  }
+
   // Release the DenseMaps associated with DeclContext objects.
   // FIXME: Is this the ideal solution?
   ReleaseDeclContextMaps();
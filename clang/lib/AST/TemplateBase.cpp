@@ -200,7 +200,10 @@ void TemplateArgument::initFromStructural(const ASTContext &Ctx, QualType Type,
   Value.Kind = StructuralValue;
   Value.IsDefaulted = IsDefaulted;
   Value.Value = new (Ctx) APValue(V);
-  Ctx.addDestruction(Value.Value);
+  // Structural values are immutable once created, so only register values
+  // that actually own heap memory for destruction.
+  if (Value.Value->needsCleanup())
+    Ctx.addDestruction(Value.Value);
   Value.Type = Type.getAsOpaquePtr();
 }
 
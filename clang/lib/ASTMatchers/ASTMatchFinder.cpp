@@ -1048,19 +1048,30 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether `traverseIgnored` maps the node away depends only on the
+    // effective traversal kind, not on the matcher itself. With many
+    // registered matchers (e.g. a large clang-tidy run) the parent-map query
+    // dominates the per-node cost, so compute it at most once per traversal
+    // kind instead of once per matcher. Index 0 is "no explicit kind", which
+    // inherits the context's current traversal kind; that doesn't change
+    // between iterations, so caching it is safe too.
+    std::optional<bool> TraversedAway[3];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
-      BoundNodesTreeBuilder Builder;
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      auto TK = MP.first.getTraversalKind();
+      std::optional<bool> &Skip = TraversedAway[TK ? *TK + 1 : 0];
+      if (!Skip) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        Skip = getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
+               DynNode;
       }
+      if (*Skip)
+        continue;
 
+      BoundNodesTreeBuilder Builder;
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
         MatchVisitor Visitor(*this, ActiveASTContext, MP.second);
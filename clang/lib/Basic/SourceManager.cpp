@@ -27,11 +27,11 @@
 #include "llvm/Support/AutoConvert.h"
 #include "llvm/Support/Capacity.h"
 #include "llvm/Support/Compiler.h"
-#include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/NewlineScanner.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -1222,19 +1222,6 @@ unsigned SourceManager::getPresumedColumnNumber(SourceLocation Loc,
   return PLoc.getColumn();
 }
 
-// Check if mutli-byte word x has bytes between m and n, included. This may also
-// catch bytes equal to n + 1.
-// The returned value holds a 0x80 at each byte position that holds a match.
-// see http://graphics.stanford.edu/~seander/bithacks.html#HasBetweenInWord
-template <class T>
-static constexpr inline T likelyhasbetween(T x, unsigned char m,
-                                           unsigned char n) {
-  return ((x - ~static_cast<T>(0) / 255 * (n + 1)) & ~x &
-          ((x & ~static_cast<T>(0) / 255 * 127) +
-           (~static_cast<T>(0) / 255 * (127 - (m - 1))))) &
-         ~static_cast<T>(0) / 255 * 128;
-}
-
 LineOffsetMapping LineOffsetMapping::get(llvm::MemoryBufferRef Buffer,
                                          llvm::BumpPtrAllocator &Alloc) {
 
@@ -1245,57 +1232,19 @@ LineOffsetMapping LineOffsetMapping::get(llvm::MemoryBufferRef Buffer,
   // Line #1 starts at char 0.
   LineOffsets.push_back(0);
 
-  const unsigned char *Start = (const unsigned char *)Buffer.getBufferStart();
-  const unsigned char *End = (const unsigned char *)Buffer.getBufferEnd();
-  const unsigned char *Buf = Start;
-
-  uint64_t Word;
-
-  // scan sizeof(Word) bytes at a time for new lines.
-  // This is much faster than scanning each byte independently.
-  if ((unsigned long)(End - Start) > sizeof(Word)) {
-    do {
-      Word = llvm::support::endian::read64(Buf, llvm::endianness::little);
-      // no new line => jump over sizeof(Word) bytes.
-      auto Mask = likelyhasbetween(Word, '\n', '\r');
-      if (!Mask) {
-        Buf += sizeof(Word);
-        continue;
-      }
-
-      // At that point, Mask contains 0x80 set at each byte that holds a value
-      // in [\n, \r + 1 [
-
-      // Scan for the next newline - it's very likely there's one.
-      unsigned N = llvm::countr_zero(Mask) - 7; // -7 because 0x80 is the marker
-      Word >>= N;
-      Buf += N / 8 + 1;
-      unsigned char Byte = Word;
-      switch (Byte) {
-      case '\r':
-        // If this is \r\n, skip both characters.
-        if (*Buf == '\n') {
-          ++Buf;
-        }
-        [[fallthrough]];
-      case '\n':
-        LineOffsets.push_back(Buf - Start);
-      };
-    } while (Buf < End - sizeof(Word) - 1);
-  }
-
-  // Handle tail using a regular check.
-  while (Buf < End) {
-    if (*Buf == '\n') {
-      LineOffsets.push_back(Buf - Start + 1);
-    } else if (*Buf == '\r') {
-      // If this is \r\n, skip both characters.
-      if (Buf + 1 < End && Buf[1] == '\n') {
-        ++Buf;
-      }
-      LineOffsets.push_back(Buf - Start + 1);
-    }
+  const char *Start = Buffer.getBufferStart();
+  const char *End = Buffer.getBufferEnd();
+  const char *Buf = Start;
+
+  // Let the scanner skip over runs without line terminators; it uses SIMD
+  // compares where available, which is much faster than checking each byte
+  // independently.
+  while ((Buf = llvm::support::findNextLineTerminator(Buf, End)) != End) {
+    // If this is \r\n, skip both characters.
+    if (*Buf == '\r' && Buf + 1 != End && Buf[1] == '\n')
+      ++Buf;
     ++Buf;
+    LineOffsets.push_back(Buf - Start);
   }
 
   return LineOffsetMapping(LineOffsets, Alloc);
@@ -5144,9 +5144,18 @@ void Driver::BuildJobs(Compilation &C) const {
                        /*TargetDeviceOffloadKind*/ Action::OFK_None);
   }
 
-  // If we have more than one job, then disable integrated-cc1 for now. Do this
-  // also when we need to report process execution statistics.
-  if (C.getJobs().size() > 1 || CCPrintProcessStats)
+  // If we have more than one job, then disable integrated-cc1 for now. With
+  // -fintegrated-cc1-batch, keep the jobs in-process as long as every job in
+  // the compilation supports it: ExecuteJobs runs them sequentially within
+  // this process and the cc1 entry point resets global option state between
+  // invocations, so a multi-input compile saves one process launch per input.
+  // Always fall back to separate processes when we need to report per-process
+  // execution statistics.
+  bool BatchCC1 =
+      C.getArgs().hasFlag(options::OPT_fintegrated_cc1_batch,
+                          options::OPT_fno_integrated_cc1_batch, false) &&
+      llvm::all_of(C.getJobs(), [](const Command &J) { return J.InProcess; });
+  if ((C.getJobs().size() > 1 && !BatchCC1) || CCPrintProcessStats)
     for (auto &J : C.getJobs())
       J.InProcess = false;
 
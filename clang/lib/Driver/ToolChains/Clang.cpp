@@ -511,6 +511,20 @@ static void addCoveragePrefixMapArg(const Driver &D, const ArgList &Args,
   }
 }
 
+/// Add a CC1 option to specify the module file path prefix map.
+static void addModuleFilePrefixMapArg(const Driver &D, const ArgList &Args,
+                                      ArgStringList &CmdArgs) {
+  for (const Arg *A : Args.filtered(options::OPT_fmodule_file_prefix_map_EQ)) {
+    StringRef Map = A->getValue();
+    if (!Map.contains('='))
+      D.Diag(diag::err_drv_invalid_argument_to_option)
+          << Map << A->getOption().getName();
+    else
+      CmdArgs.push_back(Args.MakeArgString("-fmodule-file-prefix-map=" + Map));
+    A->claim();
+  }
+}
+
 /// Vectorize at all optimization levels greater than 1 except for -Oz.
 /// For -Oz the loop vectorizer is disabled, while the slp vectorizer is
 /// enabled.
@@ -1314,6 +1328,7 @@ void Clang::AddPreprocessingOptions(Compilation &C, const JobAction &JA,
 
   addMacroPrefixMapArg(D, Args, CmdArgs);
   addCoveragePrefixMapArg(D, Args, CmdArgs);
+  addModuleFilePrefixMapArg(D, Args, CmdArgs);
 
   Args.AddLastArg(CmdArgs, options::OPT_ffile_reproducible,
                   options::OPT_fno_file_reproducible);
@@ -5604,8 +5619,12 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
 
   // We normally speed up the clang process a bit by skipping destructors at
   // exit, but when we're generating diagnostics we can rely on some of the
-  // cleanup.
-  if (!C.isForDiagnostics())
+  // cleanup. Also clean up when several cc1 jobs may run in this process
+  // (-fintegrated-cc1-batch), since leaked per-TU state would otherwise
+  // accumulate for the lifetime of the driver.
+  if (!C.isForDiagnostics() &&
+      !Args.hasFlag(options::OPT_fintegrated_cc1_batch,
+                    options::OPT_fno_integrated_cc1_batch, false))
     CmdArgs.push_back("-disable-free");
   CmdArgs.push_back("-clear-ast-before-backend");
 
@@ -43,12 +43,14 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/BuryPointer.h"
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
@@ -58,6 +60,8 @@
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 #include <time.h>
 #include <utility>
@@ -1461,6 +1465,46 @@ static bool compileModuleAndReadASTImpl(CompilerInstance &ImportingInstance,
                                    /*OutOfDate=*/nullptr);
 }
 
+namespace {
+/// Tracks implicit module builds in flight in this process, so that
+/// concurrent threads (e.g. dependency scanner workers) build each module
+/// file once and wait on a condition variable instead of sleep-polling a
+/// lock file held by their own process.
+class InFlightModuleBuilds {
+public:
+  /// Blocks until no other thread in this process is building
+  /// \p ModuleFileName, then claims the build.
+  ///
+  /// \returns True if the build was claimed without waiting. False means
+  /// another thread's build just finished; the caller should try reading the
+  /// module file before rebuilding (and still owns the claim either way).
+  bool claim(StringRef ModuleFileName) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    bool Waited = false;
+    while (!InFlight.insert(ModuleFileName).second) {
+      Waited = true;
+      BuildFinished.wait(Lock);
+    }
+    return !Waited;
+  }
+
+  void release(StringRef ModuleFileName) {
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      InFlight.erase(ModuleFileName);
+    }
+    BuildFinished.notify_all();
+  }
+
+private:
+  std::mutex Mutex;
+  std::condition_variable BuildFinished;
+  llvm::StringSet<> InFlight;
+};
+} // namespace
+
+static llvm::ManagedStatic<InFlightModuleBuilds> ThisProcessModuleBuilds;
+
 /// Compile a module in a separate compiler instance and read the AST,
 /// returning true if the module compiles without errors, using a lock manager
 /// to avoid building the same module in multiple compiler instances.
@@ -1483,6 +1527,24 @@ static bool compileModuleAndReadASTBehindLock(
   llvm::sys::fs::create_directories(Dir);
 
   while (true) {
+    // Serialize against other threads in this process before touching the
+    // on-disk lock: the lock file manager only knows about processes, so
+    // in-process contenders would sleep-poll a lock held by their own PID.
+    bool ClaimedFirst = ThisProcessModuleBuilds->claim(ModuleFileName);
+    auto ReleaseClaim = llvm::make_scope_exit(
+        [&] { ThisProcessModuleBuilds->release(ModuleFileName); });
+    if (!ClaimedFirst) {
+      // Another thread in this process just built this module; read the
+      // result instead of building it again.
+      bool OutOfDate = false;
+      if (readASTAfterCompileModule(ImportingInstance, ImportLoc, ModuleNameLoc,
+                                    Module, ModuleFileName, &OutOfDate))
+        return true;
+      if (!OutOfDate)
+        return false;
+      continue;
+    }
+
     llvm::LockFileManager Locked(ModuleFileName);
     switch (Locked) {
     case llvm::LockFileManager::LFS_Error:
@@ -3231,6 +3231,10 @@ static void GenerateHeaderSearchArgs(const HeaderSearchOptions &Opts,
   for (const auto &Path : Opts.PrebuiltModulePaths)
     GenerateArg(Consumer, OPT_fprebuilt_module_path, Path);
 
+  for (const auto &Mapping : Opts.ModuleFilePrefixMappings)
+    GenerateArg(Consumer, OPT_fmodule_file_prefix_map_EQ,
+                Mapping.first + "=" + Mapping.second);
+
   for (const auto &Macro : Opts.ModulesIgnoreMacros)
     GenerateArg(Consumer, OPT_fmodules_ignore_macro, Macro.val());
 
@@ -3362,6 +3366,12 @@ static bool ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args,
   for (const auto *A : Args.filtered(OPT_fprebuilt_module_path))
     Opts.AddPrebuiltModulePath(A->getValue());
 
+  for (const auto &Arg : Args.getAllArgValues(OPT_fmodule_file_prefix_map_EQ)) {
+    auto Split = StringRef(Arg).split('=');
+    Opts.ModuleFilePrefixMappings.emplace_back(std::string(Split.first),
+                                               std::string(Split.second));
+  }
+
   for (const auto *A : Args.filtered(OPT_fmodules_ignore_macro)) {
     StringRef MacroDef = A->getValue();
     Opts.ModulesIgnoreMacros.insert(
@@ -22,6 +22,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Serialization/ASTWriter.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/iterator_range.h"
@@ -32,6 +33,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/xxhash.h"
 #include <limits>
 #include <mutex>
 #include <utility>
@@ -356,6 +358,57 @@ PreambleBounds clang::ComputePreambleBounds(const LangOptions &LangOpts,
   return Lexer::ComputePreamble(Buffer.getBuffer(), LangOpts, MaxLines);
 }
 
+namespace {
+
+/// Process-wide pool of in-memory preamble PCH images, keyed by a hash of
+/// their bytes. Embedders that hold many preambles at once (e.g. one per open
+/// file) then share a single image for every byte-identical build instead of
+/// holding N copies. The pool only keeps weak references, so it never extends
+/// a preamble's lifetime, and the shared images are immutable once built.
+class PreamblePCHPool {
+public:
+  /// Return a pooled buffer with the same contents as \p Buf, registering
+  /// \p Buf if no equivalent image is pooled yet.
+  std::shared_ptr<PCHBuffer> intern(std::shared_ptr<PCHBuffer> Buf) {
+    StringRef Bytes(Buf->Data.data(), Buf->Data.size());
+    uint64_t Key = llvm::xxh3_64bits(Bytes);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    // Periodically drop entries whose preambles are gone.
+    if (++InternCount % SweepInterval == 0) {
+      SmallVector<uint64_t, 8> Expired;
+      for (const auto &Entry : Pool)
+        if (Entry.second.expired())
+          Expired.push_back(Entry.first);
+      for (uint64_t K : Expired)
+        Pool.erase(K);
+    }
+
+    auto [It, Inserted] = Pool.try_emplace(Key);
+    if (!Inserted) {
+      if (std::shared_ptr<PCHBuffer> Existing = It->second.lock()) {
+        // Guard against hash collisions with a full comparison.
+        if (StringRef(Existing->Data.data(), Existing->Data.size()) == Bytes)
+          return Existing;
+        return Buf;
+      }
+    }
+    It->second = Buf;
+    return Buf;
+  }
+
+private:
+  static constexpr unsigned SweepInterval = 64;
+
+  std::mutex Mutex;
+  llvm::DenseMap<uint64_t, std::weak_ptr<PCHBuffer>> Pool;
+  unsigned InternCount = 0;
+};
+
+llvm::ManagedStatic<PreamblePCHPool> ThePreamblePCHPool;
+
+} // namespace
+
 class PrecompiledPreamble::PCHStorage {
 public:
   static std::unique_ptr<PCHStorage> file(std::unique_ptr<TempPCHFile> File) {
@@ -396,6 +449,15 @@ public:
     Memory->Data = decltype(Memory->Data)(Memory->Data);
   }
 
+  // Share the in-memory buffer with any byte-identical one already alive in
+  // this process. Only safe to call once the buffer is immutable, i.e. after
+  // shrink().
+  void dedupe() {
+    if (!Memory)
+      return;
+    Memory = ThePreamblePCHPool->intern(std::move(Memory));
+  }
+
 private:
   PCHStorage() = default;
   PCHStorage(const PCHStorage &) = delete;
@@ -573,6 +635,7 @@ llvm::ErrorOr<PrecompiledPreamble> PrecompiledPreamble::Build(
   CICleanup.unregister();
   Clang.reset();
   Storage->shrink();
+  Storage->dedupe();
   return PrecompiledPreamble(
       std::move(Storage), std::move(PreambleBytes), PreambleEndsAtStartOfLine,
       std::move(FilesInPreamble), std::move(MissingFiles));
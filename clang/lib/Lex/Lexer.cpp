@@ -50,6 +50,10 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2187,6 +2191,38 @@ const char *Lexer::LexUDSuffix(Token &Result, const char *CurPtr,
 
 /// LexStringLiteral - Lex the remainder of a string literal, after having lexed
 /// either " or L" or u8" or u" or U".
+/// Skip over string literal characters which need no special handling: i.e.
+/// anything other than the terminating quote, an escape, a trigraph
+/// introducer, a newline or a nul (end of file or code completion point).
+/// The slow path takes over on the first interesting character.
+static const char *
+fastSkipStringLiteralBody(const char *CurPtr,
+                          [[maybe_unused]] const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Quotes = _mm_set1_epi8('"');
+  const __m128i Escapes = _mm_set1_epi8('\\');
+  const __m128i Questions = _mm_set1_epi8('?');
+  const __m128i Nuls = _mm_setzero_si128();
+  const __m128i LFs = _mm_set1_epi8('\n');
+  const __m128i CRs = _mm_set1_epi8('\r');
+
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Interesting = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, Quotes), _mm_cmpeq_epi8(Cv, Escapes)),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Cv, Questions),
+                                  _mm_cmpeq_epi8(Cv, Nuls)),
+                     _mm_or_si128(_mm_cmpeq_epi8(Cv, LFs),
+                                  _mm_cmpeq_epi8(Cv, CRs))));
+    unsigned Mask = _mm_movemask_epi8(Interesting);
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero(Mask);
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
 bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
                              tok::TokenKind Kind) {
   const char *AfterQuote = CurPtr;
@@ -2200,6 +2236,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
     Diag(BufferPtr, LangOpts.CPlusPlus ? diag::warn_cxx98_compat_unicode_literal
                                        : diag::warn_c99_compat_unicode_literal);
 
+  CurPtr = fastSkipStringLiteralBody(CurPtr, BufferEnd);
   char C = getAndAdvanceChar(CurPtr, Result);
   while (C != '"') {
     // Skip escaped characters.  Escaped newlines will already be processed by
@@ -2228,6 +2265,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
       NulCharacter = CurPtr-1;
     }
+    CurPtr = fastSkipStringLiteralBody(CurPtr, BufferEnd);
     C = getAndAdvanceChar(CurPtr, Result);
   }
 
@@ -2485,6 +2523,34 @@ bool Lexer::LexCharConstant(Token &Result, const char *CurPtr,
 /// Update BufferPtr to point to the next non-whitespace character and return.
 ///
 /// This method forms a token and returns true if KeepWhitespaceMode is enabled.
+/// Skip over a run of horizontal whitespace characters, returning a pointer
+/// to the first character which is not horizontal whitespace.
+static const char *
+fastSkipHorizontalWhitespace(const char *CurPtr,
+                             [[maybe_unused]] const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Spaces = _mm_set1_epi8(' ');
+  const __m128i Tabs = _mm_set1_epi8('\t');
+  const __m128i FFs = _mm_set1_epi8('\f');
+  const __m128i VTs = _mm_set1_epi8('\v');
+
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Ws = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, Spaces), _mm_cmpeq_epi8(Cv, Tabs)),
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, FFs), _mm_cmpeq_epi8(Cv, VTs)));
+    unsigned Mask = _mm_movemask_epi8(Ws);
+    if (Mask != 0xFFFF)
+      return CurPtr + llvm::countr_zero(~Mask);
+    CurPtr += 16;
+  }
+#endif
+
+  while (isHorizontalWhitespace(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
 bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
                            bool &TokAtPhysicalStartOfLine) {
   // Whitespace - Skip it, then return the token after the whitespace.
@@ -2504,8 +2570,10 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
-    while (isHorizontalWhitespace(Char))
-      Char = *++CurPtr;
+    if (isHorizontalWhitespace(Char)) {
+      CurPtr = fastSkipHorizontalWhitespace(CurPtr + 1, BufferEnd);
+      Char = *CurPtr;
+    }
 
     // Otherwise if we have something other than whitespace, we're done.
     if (!isVerticalWhitespace(Char))
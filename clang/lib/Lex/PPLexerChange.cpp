@@ -58,6 +58,19 @@ PreprocessorLexer *Preprocessor::getCurrentFileLexer() const {
   return nullptr;
 }
 
+bool Preprocessor::trySeekCurrentLexer(FileID FID, unsigned Offset) {
+  // Only seek when the top of the lexer stack is the raw file lexer for the
+  // requested file; macro expansion or token caching in progress would
+  // otherwise replay stale tokens after the seek.
+  if (!CurLexer || CurPPLexer != CurLexer.get() || CurTokenLexer ||
+      InCachingLexMode())
+    return false;
+  if (CurLexer->getFileID() != FID)
+    return false;
+  CurLexer->SetByteOffset(Offset, /*StartOfLine=*/false);
+  return true;
+}
+
 
 //===----------------------------------------------------------------------===//
 // Methods for Entering and Callbacks for leaving various contexts
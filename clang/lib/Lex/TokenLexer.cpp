@@ -753,140 +753,163 @@ bool TokenLexer::pasteTokens(Token &LHSTok, ArrayRef<Token> TokenStream,
     return TokenStream.size() == CurIdx;
   };
 
-  do {
-    // Consume the ## operator if any.
-    PasteOpLoc = TokenStream[CurIdx].getLocation();
-    if (TokenStream[CurIdx].is(tok::hashhash))
-      ++CurIdx;
-    assert(!IsAtEnd() && "No token on the RHS of a paste operator!");
-
-    // Get the RHS token.
-    const Token &RHS = TokenStream[CurIdx];
-
-    // Allocate space for the result token.  This is guaranteed to be enough for
-    // the two tokens.
-    Buffer.resize(LHSTok.getLength() + RHS.getLength());
-
-    // Get the spelling of the LHS token in Buffer.
-    const char *BufPtr = &Buffer[0];
-    bool Invalid = false;
-    unsigned LHSLen = PP.getSpelling(LHSTok, BufPtr, &Invalid);
-    if (BufPtr != &Buffer[0])   // Really, we want the chars in Buffer!
-      memcpy(&Buffer[0], BufPtr, LHSLen);
-    if (Invalid)
-      return true;
-
-    BufPtr = Buffer.data() + LHSLen;
-    unsigned RHSLen = PP.getSpelling(RHS, BufPtr, &Invalid);
-    if (Invalid)
-      return true;
-    if (RHSLen && BufPtr != &Buffer[LHSLen])
-      // Really, we want the chars in Buffer!
-      memcpy(&Buffer[LHSLen], BufPtr, RHSLen);
-
-    // Trim excess space.
-    Buffer.resize(LHSLen+RHSLen);
-
-    // Plop the pasted result (including the trailing newline and null) into a
-    // scratch buffer where we can lex it.
-    Token ResultTokTmp;
-    ResultTokTmp.startToken();
-
-    // Claim that the tmp token is a string_literal so that we can get the
-    // character pointer back from CreateString in getLiteralData().
-    ResultTokTmp.setKind(tok::string_literal);
-    PP.CreateString(Buffer, ResultTokTmp);
-    SourceLocation ResultTokLoc = ResultTokTmp.getLocation();
-    ResultTokStrPtr = ResultTokTmp.getLiteralData();
-
-    // Lex the resultant pasted token into Result.
-    Token Result;
-
-    if (LHSTok.isAnyIdentifier() && RHS.isAnyIdentifier()) {
-      // Common paste case: identifier+identifier = identifier.  Avoid creating
-      // a lexer and other overhead.
-      PP.IncrementPasteCounter(true);
-      Result.startToken();
-      Result.setKind(tok::raw_identifier);
-      Result.setRawIdentifierData(ResultTokStrPtr);
-      Result.setLocation(ResultTokLoc);
-      Result.setLength(LHSLen+RHSLen);
-    } else {
-      PP.IncrementPasteCounter(false);
-
-      assert(ResultTokLoc.isFileID() &&
-             "Should be a raw location into scratch buffer");
-      SourceManager &SourceMgr = PP.getSourceManager();
-      FileID LocFileID = SourceMgr.getFileID(ResultTokLoc);
-
+  // The operands of a '##' group in an object-like macro body are fixed, so
+  // the group forms the same token on every expansion; reuse a previously
+  // formed result when we have one. Function-like macros paste substituted
+  // argument tokens, which differ per invocation, so they are not cacheable
+  // this way.
+  const unsigned PasteStartIdx = CurIdx;
+  const bool CacheableBodyPaste = Macro && !Macro->isFunctionLike();
+  bool PasteError = false;
+
+  if (const std::pair<Token, unsigned> *Cached =
+          CacheableBodyPaste ? PP.getObjectLikePasteResult(Macro, PasteStartIdx)
+                             : nullptr) {
+    PP.IncrementPasteCounter(true);
+    LHSTok = Cached->first;
+    CurIdx = Cached->second;
+  } else {
+    do {
+      // Consume the ## operator if any.
+      PasteOpLoc = TokenStream[CurIdx].getLocation();
+      if (TokenStream[CurIdx].is(tok::hashhash))
+        ++CurIdx;
+      assert(!IsAtEnd() && "No token on the RHS of a paste operator!");
+
+      // Get the RHS token.
+      const Token &RHS = TokenStream[CurIdx];
+
+      // Allocate space for the result token.  This is guaranteed to be enough for
+      // the two tokens.
+      Buffer.resize(LHSTok.getLength() + RHS.getLength());
+
+      // Get the spelling of the LHS token in Buffer.
+      const char *BufPtr = &Buffer[0];
       bool Invalid = false;
-      const char *ScratchBufStart
-        = SourceMgr.getBufferData(LocFileID, &Invalid).data();
+      unsigned LHSLen = PP.getSpelling(LHSTok, BufPtr, &Invalid);
+      if (BufPtr != &Buffer[0])   // Really, we want the chars in Buffer!
+        memcpy(&Buffer[0], BufPtr, LHSLen);
       if (Invalid)
-        return false;
-
-      // Make a lexer to lex this string from.  Lex just this one token.
-      // Make a lexer object so that we lex and expand the paste result.
-      Lexer TL(SourceMgr.getLocForStartOfFile(LocFileID),
-               PP.getLangOpts(), ScratchBufStart,
-               ResultTokStrPtr, ResultTokStrPtr+LHSLen+RHSLen);
-
-      // Lex a token in raw mode.  This way it won't look up identifiers
-      // automatically, lexing off the end will return an eof token, and
-      // warnings are disabled.  This returns true if the result token is the
-      // entire buffer.
-      bool isInvalid = !TL.LexFromRawLexer(Result);
-
-      // If we got an EOF token, we didn't form even ONE token.  For example, we
-      // did "/ ## /" to get "//".
-      isInvalid |= Result.is(tok::eof);
-
-      // If pasting the two tokens didn't form a full new token, this is an
-      // error.  This occurs with "x ## +"  and other stuff.  Return with LHSTok
-      // unmodified and with RHS as the next token to lex.
-      if (isInvalid) {
-        // Explicitly convert the token location to have proper expansion
-        // information so that the user knows where it came from.
-        SourceManager &SM = PP.getSourceManager();
-        SourceLocation Loc =
-          SM.createExpansionLoc(PasteOpLoc, ExpandLocStart, ExpandLocEnd, 2);
-
-        // Test for the Microsoft extension of /##/ turning into // here on the
-        // error path.
-        if (PP.getLangOpts().MicrosoftExt && LHSTok.is(tok::slash) &&
-            RHS.is(tok::slash)) {
-          HandleMicrosoftCommentPaste(LHSTok, Loc);
-          return true;
-        }
+        return true;
 
-        // Do not emit the error when preprocessing assembler code.
-        if (!PP.getLangOpts().AsmPreprocessor) {
-          // If we're in microsoft extensions mode, downgrade this from a hard
-          // error to an extension that defaults to an error.  This allows
-          // disabling it.
-          PP.Diag(Loc, PP.getLangOpts().MicrosoftExt ? diag::ext_pp_bad_paste_ms
-                                                     : diag::err_pp_bad_paste)
-              << Buffer;
+      BufPtr = Buffer.data() + LHSLen;
+      unsigned RHSLen = PP.getSpelling(RHS, BufPtr, &Invalid);
+      if (Invalid)
+        return true;
+      if (RHSLen && BufPtr != &Buffer[LHSLen])
+        // Really, we want the chars in Buffer!
+        memcpy(&Buffer[LHSLen], BufPtr, RHSLen);
+
+      // Trim excess space.
+      Buffer.resize(LHSLen+RHSLen);
+
+      // Plop the pasted result (including the trailing newline and null) into a
+      // scratch buffer where we can lex it.
+      Token ResultTokTmp;
+      ResultTokTmp.startToken();
+
+      // Claim that the tmp token is a string_literal so that we can get the
+      // character pointer back from CreateString in getLiteralData().
+      ResultTokTmp.setKind(tok::string_literal);
+      PP.CreateString(Buffer, ResultTokTmp);
+      SourceLocation ResultTokLoc = ResultTokTmp.getLocation();
+      ResultTokStrPtr = ResultTokTmp.getLiteralData();
+
+      // Lex the resultant pasted token into Result.
+      Token Result;
+
+      if (LHSTok.isAnyIdentifier() && RHS.isAnyIdentifier()) {
+        // Common paste case: identifier+identifier = identifier.  Avoid creating
+        // a lexer and other overhead.
+        PP.IncrementPasteCounter(true);
+        Result.startToken();
+        Result.setKind(tok::raw_identifier);
+        Result.setRawIdentifierData(ResultTokStrPtr);
+        Result.setLocation(ResultTokLoc);
+        Result.setLength(LHSLen+RHSLen);
+      } else {
+        PP.IncrementPasteCounter(false);
+
+        assert(ResultTokLoc.isFileID() &&
+               "Should be a raw location into scratch buffer");
+        SourceManager &SourceMgr = PP.getSourceManager();
+        FileID LocFileID = SourceMgr.getFileID(ResultTokLoc);
+
+        bool Invalid = false;
+        const char *ScratchBufStart
+          = SourceMgr.getBufferData(LocFileID, &Invalid).data();
+        if (Invalid)
+          return false;
+
+        // Make a lexer to lex this string from.  Lex just this one token.
+        // Make a lexer object so that we lex and expand the paste result.
+        Lexer TL(SourceMgr.getLocForStartOfFile(LocFileID),
+                 PP.getLangOpts(), ScratchBufStart,
+                 ResultTokStrPtr, ResultTokStrPtr+LHSLen+RHSLen);
+
+        // Lex a token in raw mode.  This way it won't look up identifiers
+        // automatically, lexing off the end will return an eof token, and
+        // warnings are disabled.  This returns true if the result token is the
+        // entire buffer.
+        bool isInvalid = !TL.LexFromRawLexer(Result);
+
+        // If we got an EOF token, we didn't form even ONE token.  For example, we
+        // did "/ ## /" to get "//".
+        isInvalid |= Result.is(tok::eof);
+
+        // If pasting the two tokens didn't form a full new token, this is an
+        // error.  This occurs with "x ## +"  and other stuff.  Return with LHSTok
+        // unmodified and with RHS as the next token to lex.
+        if (isInvalid) {
+          // Explicitly convert the token location to have proper expansion
+          // information so that the user knows where it came from.
+          SourceManager &SM = PP.getSourceManager();
+          SourceLocation Loc =
+            SM.createExpansionLoc(PasteOpLoc, ExpandLocStart, ExpandLocEnd, 2);
+
+          // Test for the Microsoft extension of /##/ turning into // here on the
+          // error path.
+          if (PP.getLangOpts().MicrosoftExt && LHSTok.is(tok::slash) &&
+              RHS.is(tok::slash)) {
+            HandleMicrosoftCommentPaste(LHSTok, Loc);
+            return true;
+          }
+
+          // Do not emit the error when preprocessing assembler code.
+          if (!PP.getLangOpts().AsmPreprocessor) {
+            // If we're in microsoft extensions mode, downgrade this from a hard
+            // error to an extension that defaults to an error.  This allows
+            // disabling it.
+            PP.Diag(Loc, PP.getLangOpts().MicrosoftExt ? diag::ext_pp_bad_paste_ms
+                                                       : diag::err_pp_bad_paste)
+                << Buffer;
+          }
+
+          // An error has occurred so exit loop.
+          PasteError = true;
+          break;
         }
 
-        // An error has occurred so exit loop.
-        break;
+        // Turn ## into 'unknown' to avoid # ## # from looking like a paste
+        // operator.
+        if (Result.is(tok::hashhash))
+          Result.setKind(tok::unknown);
       }
 
-      // Turn ## into 'unknown' to avoid # ## # from looking like a paste
-      // operator.
-      if (Result.is(tok::hashhash))
-        Result.setKind(tok::unknown);
-    }
+      // Transfer properties of the LHS over the Result.
+      Result.setFlagValue(Token::StartOfLine , LHSTok.isAtStartOfLine());
+      Result.setFlagValue(Token::LeadingSpace, LHSTok.hasLeadingSpace());
 
-    // Transfer properties of the LHS over the Result.
-    Result.setFlagValue(Token::StartOfLine , LHSTok.isAtStartOfLine());
-    Result.setFlagValue(Token::LeadingSpace, LHSTok.hasLeadingSpace());
+      // Finally, replace LHS with the result, consume the RHS, and iterate.
+      ++CurIdx;
+      LHSTok = Result;
+    } while (!IsAtEnd() && TokenStream[CurIdx].is(tok::hashhash));
 
-    // Finally, replace LHS with the result, consume the RHS, and iterate.
-    ++CurIdx;
-    LHSTok = Result;
-  } while (!IsAtEnd() && TokenStream[CurIdx].is(tok::hashhash));
+    // Remember the formed token (still spelled in the scratch buffer) so
+    // later expansions of this macro can skip the concatenation entirely.
+    if (CacheableBodyPaste && !PasteError)
+      PP.rememberObjectLikePasteResult(Macro, PasteStartIdx, LHSTok, CurIdx);
+  }
 
   SourceLocation EndLoc = TokenStream[CurIdx - 1].getLocation();
 
@@ -0,0 +1,77 @@
+//===--- FunctionBodyIndex.cpp - Sidecar index of function bodies ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// On-disk form of the function body index: a line-oriented text file whose
+// header names the format version and a content hash of the main file,
+// followed by one "<begin> <end>" extent per line.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Parse/FunctionBodyIndex.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace clang;
+
+static const char MagicLine[] = "clang-function-body-index 1";
+
+std::unique_ptr<FunctionBodyIndex>
+FunctionBodyIndex::loadFromFile(StringRef Path, StringRef MainFileContents) {
+  auto BufOrErr = llvm::MemoryBuffer::getFile(Path, /*IsText=*/true);
+  if (!BufOrErr)
+    return nullptr;
+
+  SmallVector<StringRef, 0> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                                 /*KeepEmpty=*/false);
+  if (Lines.size() < 2 || Lines[0].trim() != MagicLine)
+    return nullptr;
+
+  uint64_t StoredHash;
+  if (Lines[1].trim().getAsInteger(16, StoredHash) ||
+      StoredHash != llvm::xxh3_64bits(MainFileContents))
+    return nullptr;
+
+  auto Index = std::make_unique<FunctionBodyIndex>();
+  for (StringRef Line : ArrayRef(Lines).drop_front(2)) {
+    auto [BeginStr, EndStr] = Line.trim().split(' ');
+    unsigned Begin, End;
+    if (BeginStr.getAsInteger(10, Begin) || EndStr.getAsInteger(10, End) ||
+        End <= Begin)
+      return nullptr;
+    Index->Extents.try_emplace(Begin, End);
+  }
+  return Index;
+}
+
+bool FunctionBodyIndex::writeToFile(StringRef Path,
+                                    StringRef MainFileContents) const {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::OF_Text);
+  if (EC)
+    return false;
+
+  OS << MagicLine << '\n';
+  OS << llvm::format_hex_no_prefix(llvm::xxh3_64bits(MainFileContents), 16)
+     << '\n';
+
+  // Sort the extents so the output is stable across runs.
+  SmallVector<std::pair<unsigned, unsigned>, 0> Sorted(Extents.begin(),
+                                                       Extents.end());
+  llvm::sort(Sorted);
+  for (const auto &[Begin, End] : Sorted)
+    OS << Begin << ' ' << End << '\n';
+
+  OS.close();
+  return !OS.has_error();
+}
@@ -17,6 +17,7 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/Basic/DiagnosticParse.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Parse/FunctionBodyIndex.h"
 #include "clang/Parse/RAIIObjectsForParser.h"
 #include "clang/Sema/DeclSpec.h"
 #include "clang/Sema/ParsedTemplate.h"
@@ -576,6 +577,19 @@ void Parser::Initialize() {
     Ident_module = PP.getIdentifierInfo("module");
   }
 
+  if (SkipFunctionBodies) {
+    const std::string &IndexPath =
+        PP.getPreprocessorOpts().FunctionBodyIndexPath;
+    if (!IndexPath.empty()) {
+      SourceManager &SM = PP.getSourceManager();
+      BodyIndex = FunctionBodyIndex::loadFromFile(
+          IndexPath, SM.getBufferData(SM.getMainFileID()));
+      // No usable index on disk; start recording a fresh one.
+      if (!BodyIndex)
+        BodyIndex = FunctionBodyIndex::createEmpty();
+    }
+  }
+
   Actions.Initialize();
 
   // Prime the lexer look-ahead.
@@ -724,6 +738,15 @@ bool Parser::ParseTopLevelDecl(DeclGroupPtrTy &Result,
     Actions.SetLateTemplateParser(LateTemplateParserCallback, nullptr, this);
     Actions.ActOnEndOfTranslationUnit();
     //else don't tell Sema that we ended parsing: more input might come.
+
+    // Refresh the sidecar body index for the next run, unless this parse had
+    // errors that may have derailed body skipping.
+    if (BodyIndex && BodyIndex->isDirty() &&
+        !PP.getDiagnostics().hasErrorOccurred()) {
+      SourceManager &SM = PP.getSourceManager();
+      BodyIndex->writeToFile(PP.getPreprocessorOpts().FunctionBodyIndexPath,
+                             SM.getBufferData(SM.getMainFileID()));
+    }
     return true;
 
   case tok::identifier:
@@ -1526,6 +1549,22 @@ void Parser::SkipFunctionBody() {
     return;
   }
 
+  // If a previous run recorded this body's extent, seek straight past it
+  // instead of re-lexing its tokens.
+  if (trySkipIndexedFunctionBody())
+    return;
+
+  SourceManager &SM = PP.getSourceManager();
+  unsigned BodyBegin = 0;
+  bool RecordExtent = false;
+  if (BodyIndex && Tok.getLocation().isFileID()) {
+    auto [FID, Off] = SM.getDecomposedLoc(Tok.getLocation());
+    if (FID == SM.getMainFileID()) {
+      BodyBegin = Off;
+      RecordExtent = true;
+    }
+  }
+
   bool IsFunctionTryBlock = Tok.is(tok::kw_try);
   if (IsFunctionTryBlock)
     ConsumeToken();
@@ -1539,9 +1578,44 @@ void Parser::SkipFunctionBody() {
       SkipUntil(tok::l_brace);
       SkipUntil(tok::r_brace);
     }
+
+    if (RecordExtent && Tok.getLocation().isFileID()) {
+      auto [EndFID, EndOff] = SM.getDecomposedLoc(Tok.getLocation());
+      if (EndFID == SM.getMainFileID() && EndOff > BodyBegin) {
+        // Only remember bodies whose raw text cannot change preprocessor
+        // state, so that seeking past them is equivalent to lexing them.
+        StringRef Body =
+            SM.getBufferData(EndFID).substr(BodyBegin, EndOff - BodyBegin);
+        if (!Body.contains('#') && !Body.contains("_Pragma"))
+          BodyIndex->record(BodyBegin, EndOff);
+      }
+    }
   }
 }
 
+bool Parser::trySkipIndexedFunctionBody() {
+  if (!BodyIndex || !Tok.getLocation().isFileID())
+    return false;
+
+  SourceManager &SM = PP.getSourceManager();
+  auto [FID, Off] = SM.getDecomposedLoc(Tok.getLocation());
+  if (FID != SM.getMainFileID())
+    return false;
+
+  std::optional<unsigned> End = BodyIndex->lookup(Off);
+  if (!End)
+    return false;
+
+  // Seeking is only a pure fast-forward when tokens are coming straight from
+  // the main file's lexer; otherwise fall back to token skipping.
+  if (!PP.trySeekCurrentLexer(FID, *End))
+    return false;
+
+  PrevTokLocation = Tok.getLocation();
+  PP.Lex(Tok);
+  return true;
+}
+
 /// ParseKNRParamDeclarations - Parse 'declaration-list[opt]' which provides
 /// types for a function with a K&R-style identifier list for arguments.
 void Parser::ParseKNRParamDeclarations(Declarator &D) {
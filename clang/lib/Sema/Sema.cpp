@@ -263,7 +263,8 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       TyposCorrected(0), IsBuildingRecoveryCallExpr(false), NumSFINAEErrors(0),
       AccessCheckingSFINAE(false), CurrentInstantiationScope(nullptr),
       InNonInstantiationSFINAEContext(false), NonInstantiationEntries(0),
-      ArgumentPackSubstitutionIndex(-1), SatisfactionCache(Context) {
+      ArgumentPackSubstitutionIndex(-1), SatisfactionCache(Context),
+      FailedDeducedSubstitutionCache(Context) {
   assert(pp.TUKind == TUKind);
   TUScope = nullptr;
 
@@ -551,6 +552,14 @@ Sema::~Sema() {
   for (auto *Node : Satisfactions)
     delete Node;
 
+  // Delete memoized substitution failures.
+  std::vector<sema::FailedDeducedSubstitution *> FailedSubstitutions;
+  FailedSubstitutions.reserve(FailedDeducedSubstitutionCache.size());
+  for (auto &Node : FailedDeducedSubstitutionCache)
+    FailedSubstitutions.push_back(&Node);
+  for (auto *Node : FailedSubstitutions)
+    delete Node;
+
   threadSafety::threadSafetyCleanup(ThreadSafetyDeclCache);
 
   // Destroys data sharing attributes stack for OpenMP
@@ -3943,6 +3943,46 @@ TemplateDeductionResult Sema::FinishTemplateArgumentDeduction(
       TemplateArgumentList::CreateCopy(Context, CanonicalBuilder);
   Info.reset(SugaredDeducedArgumentList, CanonicalDeducedArgumentList);
 
+  // If substituting this exact deduced argument list into this template has
+  // already failed under SFINAE, replay the recorded failure instead of
+  // re-attempting the substitution. Failed specializations are never added
+  // to the template's specialization set, so without this every call site
+  // re-runs the same dead substitution. Substitution of a given argument
+  // list must mean the same thing everywhere in the translation unit
+  // ([temp.spec]), which is the same assumption the specialization set
+  // already makes for successful substitutions.
+  auto *CanonTemplate =
+      cast<FunctionTemplateDecl>(FunctionTemplate->getCanonicalDecl());
+  llvm::FoldingSetNodeID FailureID;
+  sema::FailedDeducedSubstitution::Profile(FailureID, CanonTemplate,
+                                           CanonicalBuilder, Context);
+  void *FailureInsertPos;
+  if (sema::FailedDeducedSubstitution *Failure =
+          FailedDeducedSubstitutionCache.FindNodeOrInsertPos(
+              FailureID, FailureInsertPos)) {
+    if (Failure->SuppressedDiagnostic)
+      Info.addSFINAEDiagnostic(Failure->SuppressedDiagnostic->first,
+                               Failure->SuppressedDiagnostic->second);
+    return Failure->Result;
+  }
+
+  // Record a substitution failure for replay by later identical deductions.
+  // Failures of checks that depend on the call site (the DR1391 conversion
+  // check, original-call-argument checks) must not be recorded.
+  auto RecordSubstitutionFailure = [&](TemplateDeductionResult Res) {
+    auto *Failure = new sema::FailedDeducedSubstitution;
+    Failure->Template = CanonTemplate;
+    Failure->DeducedArgs = CanonicalDeducedArgumentList;
+    Failure->Result = Res;
+    if (Info.hasSFINAEDiagnostic())
+      Failure->SuppressedDiagnostic = Info.peekSFINAEDiagnostic();
+    // Substitution may recursively deduce other specializations, so the
+    // insertion position from above may be stale; re-probe the set.
+    if (FailedDeducedSubstitutionCache.GetOrInsertNode(Failure) != Failure)
+      delete Failure;
+    return Res;
+  };
+
   // Substitute the deduced template arguments into the function template
   // declaration to produce the function template specialization.
   DeclContext *Owner = FunctionTemplate->getDeclContext();
@@ -4004,7 +4044,8 @@ TemplateDeductionResult Sema::FinishTemplateArgumentDeduction(
   Specialization = cast_or_null<FunctionDecl>(
       SubstDecl(FD, Owner, SubstArgs));
   if (!Specialization || Specialization->isInvalidDecl())
-    return TemplateDeductionResult::SubstitutionFailure;
+    return RecordSubstitutionFailure(
+        TemplateDeductionResult::SubstitutionFailure);
 
   assert(isSameDeclaration(Specialization->getPrimaryTemplate(),
                            FunctionTemplate));
@@ -4021,7 +4062,8 @@ TemplateDeductionResult Sema::FinishTemplateArgumentDeduction(
   // failure.
   if (Trap.hasErrorOccurred()) {
     Specialization->setInvalidDecl(true);
-    return TemplateDeductionResult::SubstitutionFailure;
+    return RecordSubstitutionFailure(
+        TemplateDeductionResult::SubstitutionFailure);
   }
 
   // C++2a [temp.deduct]p5
@@ -2811,9 +2811,30 @@ InputFile ASTReader::getInputFile(ModuleFile &F, unsigned ID, bool Complain) {
   return IF;
 }
 
+/// Apply the reverse of any -fmodule-file-prefix-map mappings to a path
+/// loaded from the given module file. Returns true if a mapping matched.
+static bool remapStoredPathPrefix(SmallVectorImpl<char> &Path,
+                                  ModuleFile &ModF) {
+  for (const auto &[Stored, Local] : ModF.PathPrefixMappings)
+    if (llvm::sys::path::replace_path_prefix(Path, Stored, Local))
+      return true;
+  return false;
+}
+
 ASTReader::TemporarilyOwnedStringRef
 ASTReader::ResolveImportedPath(SmallString<0> &Buf, StringRef Path,
                                ModuleFile &ModF) {
+  // Absolute paths may have been recorded with a remapped prefix; resolve
+  // them back to local directories. Relative paths are resolved against the
+  // base directory, which has already been remapped.
+  if (!ModF.PathPrefixMappings.empty() && llvm::sys::path::is_absolute(Path)) {
+    assert(Buf.capacity() != 0 && "Overlapping ResolveImportedPath calls");
+    Buf.clear();
+    Buf.append(Path.begin(), Path.end());
+    remapStoredPathPrefix(Buf, ModF);
+    StringRef ResolvedPath{Buf.data(), Buf.size()};
+    return {ResolvedPath, Buf};
+  }
   return ResolveImportedPath(Buf, Path, ModF.BaseDirectory);
 }
 
@@ -2978,6 +2999,29 @@ ASTReader::ReadControlBlock(ModuleFile &F,
 
   bool DisableValidation = shouldDisableValidationForFile(F);
 
+  // Paths in this module file were recorded with the <new> side of any
+  // -fmodule-file-prefix-map mappings; resolve them back to <old> locally.
+  F.PathPrefixMappings.clear();
+  for (const auto &[Old, New] :
+       PP.getHeaderSearchInfo().getHeaderSearchOpts().ModuleFilePrefixMappings)
+    F.PathPrefixMappings.emplace_back(New, Old);
+
+  // Imports are decoded as their records are seen but loaded together at the
+  // end of the control block. This lets us start kernel readahead on every
+  // imported module file up front, so the depth-first loads below find their
+  // pages already in the page cache instead of faulting them in one file at
+  // a time.
+  struct QueuedImport {
+    ModuleKind Kind;
+    SourceLocation ImportLoc;
+    std::string File;
+    off_t StoredSize;
+    time_t StoredModTime;
+    ASTFileSignature StoredSignature;
+  };
+  SmallVector<QueuedImport, 4> QueuedImports;
+  SmallVector<std::unique_ptr<llvm::MemoryBuffer>, 4> ImportReadaheadBuffers;
+
   // Read all of the records and blocks in the control block.
   RecordData Record;
   unsigned NumInputs = 0;
@@ -3001,6 +3045,44 @@ ASTReader::ReadControlBlock(ModuleFile &F,
       if (ASTReadResult Result = readUnhashedControlBlockOnce())
         return Result;
 
+      // Load the queued imports, in the order their records appeared.
+      for (QueuedImport &Import : QueuedImports) {
+        // If our client can't cope with us being out of date, we can't cope
+        // with our dependency being missing.
+        unsigned Capabilities = ClientLoadCapabilities;
+        if ((ClientLoadCapabilities & ARR_OutOfDate) == 0)
+          Capabilities &= ~ARR_Missing;
+
+        // Load the AST file.
+        auto Result = ReadASTCore(Import.File, Import.Kind, Import.ImportLoc,
+                                  &F, Loaded, Import.StoredSize,
+                                  Import.StoredModTime, Import.StoredSignature,
+                                  Capabilities);
+
+        // If we diagnosed a problem, produce a backtrace.
+        bool recompilingFinalized =
+            Result == OutOfDate && (Capabilities & ARR_OutOfDate) &&
+            getModuleManager().getModuleCache().isPCMFinal(F.FileName);
+        if (isDiagnosedResult(Result, Capabilities) || recompilingFinalized)
+          Diag(diag::note_module_file_imported_by)
+              << F.FileName << !F.ModuleName.empty() << F.ModuleName;
+        if (recompilingFinalized)
+          Diag(diag::note_module_file_conflict);
+
+        switch (Result) {
+        case Failure: return Failure;
+          // If we have to ignore the dependency, we'll have to ignore this
+          // too.
+        case Missing:
+        case OutOfDate: return OutOfDate;
+        case VersionMismatch: return VersionMismatch;
+        case ConfigurationMismatch: return ConfigurationMismatch;
+        case HadErrors: return HadErrors;
+        case Success: break;
+        }
+      }
+      ImportReadaheadBuffers.clear();
+
       // Validate input files.
       const HeaderSearchOptions &HSOpts =
           PP.getHeaderSearchInfo().getHeaderSearchOpts();
@@ -3022,6 +3104,38 @@ ASTReader::ReadControlBlock(ModuleFile &F,
             F.Kind == MK_ImplicitModule)
           N = NumUserInputs;
 
+        // Content validation reads each candidate input in full to hash it.
+        // Map the candidates up front and advise the kernel about the coming
+        // reads, so the I/O overlaps the serial validation loop below instead
+        // of being issued one file at a time.
+        SmallVector<std::unique_ptr<llvm::MemoryBuffer>, 16>
+            InputReadaheadBuffers;
+        if (ValidateASTInputFilesContent) {
+          for (unsigned I = 0; I < N; ++I) {
+            InputFileInfo FI = getInputFileInfo(F, I + 1);
+            if (FI.Overridden || FI.Transient || FI.ContentHash == 0)
+              continue;
+            auto Filename = ResolveImportedPath(
+                PathBuf, FI.UnresolvedImportedFilenameAsRequested, F);
+            auto File = FileMgr.getOptionalFileRef(*Filename,
+                                                   /*OpenFile=*/false);
+            if (!File || FI.StoredSize != File->getSize())
+              continue;
+            // Hashes are only consulted when the modification time cannot be
+            // trusted; see getInputFile().
+            if (FI.StoredTime && FI.StoredTime == File->getModificationTime() &&
+                !(HSOpts.ForceCheckCXX20ModulesInputFiles &&
+                  F.StandardCXXModule))
+              continue;
+            if (auto Buf = llvm::MemoryBuffer::getFile(
+                    *Filename, /*IsText=*/false,
+                    /*RequiresNullTerminator=*/false, /*IsVolatile=*/false)) {
+              (*Buf)->willNeedIfMmap();
+              InputReadaheadBuffers.push_back(std::move(*Buf));
+            }
+          }
+        }
+
         for (unsigned I = 0; I < N; ++I) {
           InputFile IF = getInputFile(F, I+1, Complain);
           if (!IF.getFile() || IF.isOutOfDate())
@@ -3231,40 +3345,29 @@ ASTReader::ReadControlBlock(ModuleFile &F,
           // ModuleCache as when writing.
           ImportedFile =
               ReadPathBlob(BaseDirectoryAsWritten, Record, Idx, Blob);
+          if (llvm::sys::path::is_absolute(ImportedFile) &&
+              !F.PathPrefixMappings.empty()) {
+            SmallString<128> P(ImportedFile);
+            if (remapStoredPathPrefix(P, F))
+              ImportedFile = std::string(P);
+          }
         }
       }
 
-      // If our client can't cope with us being out of date, we can't cope with
-      // our dependency being missing.
-      unsigned Capabilities = ClientLoadCapabilities;
-      if ((ClientLoadCapabilities & ARR_OutOfDate) == 0)
-        Capabilities &= ~ARR_Missing;
-
-      // Load the AST file.
-      auto Result = ReadASTCore(ImportedFile, ImportedKind, ImportLoc, &F,
-                                Loaded, StoredSize, StoredModTime,
-                                StoredSignature, Capabilities);
-
-      // If we diagnosed a problem, produce a backtrace.
-      bool recompilingFinalized =
-          Result == OutOfDate && (Capabilities & ARR_OutOfDate) &&
-          getModuleManager().getModuleCache().isPCMFinal(F.FileName);
-      if (isDiagnosedResult(Result, Capabilities) || recompilingFinalized)
-        Diag(diag::note_module_file_imported_by)
-            << F.FileName << !F.ModuleName.empty() << F.ModuleName;
-      if (recompilingFinalized)
-        Diag(diag::note_module_file_conflict);
-
-      switch (Result) {
-      case Failure: return Failure;
-        // If we have to ignore the dependency, we'll have to ignore this too.
-      case Missing:
-      case OutOfDate: return OutOfDate;
-      case VersionMismatch: return VersionMismatch;
-      case ConfigurationMismatch: return ConfigurationMismatch;
-      case HadErrors: return HadErrors;
-      case Success: break;
+      // Ask the kernel to start reading the imported file in the background.
+      // The load itself is deferred until the end of the control block so
+      // that readahead on later imports overlaps with loading earlier ones.
+      // The buffer is kept alive until all queued imports are loaded.
+      if (auto Buf = llvm::MemoryBuffer::getFile(
+              ImportedFile, /*IsText=*/false, /*RequiresNullTerminator=*/false,
+              /*IsVolatile=*/false)) {
+        (*Buf)->willNeedIfMmap();
+        ImportReadaheadBuffers.push_back(std::move(*Buf));
       }
+
+      QueuedImports.push_back({ImportedKind, ImportLoc,
+                               std::move(ImportedFile), StoredSize,
+                               StoredModTime, StoredSignature});
       break;
     }
 
@@ -3301,6 +3404,11 @@ ASTReader::ReadControlBlock(ModuleFile &F,
       assert(!F.ModuleName.empty() &&
              "MODULE_DIRECTORY found before MODULE_NAME");
       F.BaseDirectory = std::string(Blob);
+      if (!F.PathPrefixMappings.empty()) {
+        SmallString<128> BaseDir(Blob);
+        if (remapStoredPathPrefix(BaseDir, F))
+          F.BaseDirectory = std::string(BaseDir);
+      }
       if (!PP.getPreprocessorOpts().ModulesCheckRelocated)
         break;
       // If we've already loaded a module map file covering this module, we may
@@ -3598,9 +3706,15 @@ llvm::Error ASTReader::ReadASTBlock(ModuleFile &F,
       F.LocalNumIdentifiers = Record[0];
       F.BaseIdentifierID = getTotalNumIdentifiers();
 
-      if (F.LocalNumIdentifiers > 0)
+      if (F.LocalNumIdentifiers > 0) {
         IdentifiersLoaded.resize(IdentifiersLoaded.size()
                                  + F.LocalNumIdentifiers);
+        // These identifiers will be demand-loaded into the preprocessor's
+        // table; since the count is known, grow the table up front instead of
+        // rehashing it repeatedly as they stream in.
+        PP.getIdentifierTable().reserve(PP.getIdentifierTable().size() +
+                                        F.LocalNumIdentifiers);
+      }
       break;
     }
 
@@ -5001,6 +5001,17 @@ bool ASTWriter::PreparePathForOutput(SmallVectorImpl<char> &Path) {
 
   bool Changed = cleanPathForOutput(PP->getFileManager(), Path);
 
+  // Remap the path according to -fmodule-file-prefix-map, so that the
+  // serialized form does not depend on the location of the local worktree.
+  for (const auto &[Old, New] : PP->getHeaderSearchInfo()
+                                    .getHeaderSearchOpts()
+                                    .ModuleFilePrefixMappings) {
+    if (llvm::sys::path::replace_path_prefix(Path, Old, New)) {
+      Changed = true;
+      break;
+    }
+  }
+
   // Remove a prefix to make the path relative, if relevant.
   const char *PathBegin = Path.data();
   const char *PathPtr =
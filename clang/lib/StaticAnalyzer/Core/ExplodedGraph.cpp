@@ -167,7 +167,7 @@ void ExplodedGraph::collectNode(ExplodedNode *node) {
 }
 
 void ExplodedGraph::reclaimRecentlyAllocatedNodes() {
-  if (ChangedNodes.empty())
+  if (ChangedNodes.empty() && DeferredNodes.empty())
     return;
 
   // Only periodically reclaim nodes so that we can build up a set of
@@ -178,9 +178,23 @@ void ExplodedGraph::reclaimRecentlyAllocatedNodes() {
     return;
   ReclaimCounter = ReclaimNodeInterval;
 
-  for (const auto node : ChangedNodes)
+  // Nodes deferred from the last round have had a full interval to grow a
+  // successor; give them their second (and final) look.
+  for (const auto node : DeferredNodes)
     if (shouldCollect(node))
       collectNode(node);
+  DeferredNodes.clear();
+
+  for (const auto node : ChangedNodes) {
+    if (shouldCollect(node))
+      collectNode(node);
+    else if (node->succ_size() == 0)
+      // The node was on the frontier of exploration: it couldn't possibly be
+      // collected, since condition 2 requires a successor. Rather than
+      // exempting it from reclamation forever, reconsider it next round,
+      // when it has typically become an ordinary interior node.
+      DeferredNodes.push_back(node);
+  }
   ChangedNodes.clear();
 }
 
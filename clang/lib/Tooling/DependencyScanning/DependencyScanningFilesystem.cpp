@@ -108,6 +108,54 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+size_t DependencyScanningFilesystemSharedCache::evictOutOfDateEntries(
+    llvm::vfs::FileSystem &UnderlyingFS) {
+  size_t NumEvicted = 0;
+  // An entry's UID may live in a different shard than its filename, so erase
+  // the UID associations in a separate pass to take one shard lock at a time.
+  llvm::SmallVector<llvm::sys::fs::UniqueID> StaleUIDs;
+  for (unsigned I = 0; I != NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    // The key storage lives in the map's allocator and stays valid across
+    // erasure, so collect stale keys first and erase afterwards.
+    llvm::SmallVector<StringRef> StaleFilenames;
+    for (const auto &KV : Shard.CacheByFilename) {
+      const CachedFileSystemEntry *Entry = KV.getValue().first;
+      if (!Entry)
+        continue; // Only the real path is cached; nothing to re-validate.
+      llvm::ErrorOr<llvm::vfs::Status> Stat = UnderlyingFS.status(KV.getKey());
+      bool OutOfDate;
+      if (Entry->isError())
+        OutOfDate = static_cast<bool>(Stat);
+      else if (!Stat)
+        OutOfDate = true;
+      else {
+        llvm::vfs::Status Cached = Entry->getStatus();
+        OutOfDate = Cached.getUniqueID() != Stat->getUniqueID() ||
+                    Cached.getSize() != Stat->getSize() ||
+                    Cached.getLastModificationTime() !=
+                        Stat->getLastModificationTime();
+      }
+      if (!OutOfDate)
+        continue;
+      if (!Entry->isError())
+        StaleUIDs.push_back(Entry->getUniqueID());
+      StaleFilenames.push_back(KV.getKey());
+    }
+    for (StringRef Filename : StaleFilenames) {
+      Shard.CacheByFilename.erase(Filename);
+      ++NumEvicted;
+    }
+  }
+  for (llvm::sys::fs::UniqueID UID : StaleUIDs) {
+    CacheShard &Shard = getShardForUID(UID);
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    Shard.EntriesByUID.erase(UID);
+  }
+  return NumEvicted;
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
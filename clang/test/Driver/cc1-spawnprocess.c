@@ -41,6 +41,25 @@
 // Three jobs, thus integrated-cc1 is disabled.
 // RUN: %clang -fintegrated-cc1 -c %t1.cpp %t2.cpp %t3.cpp -### 2>&1 | FileCheck %s --check-prefix=NO
 
+// With -fintegrated-cc1-batch, all three cc1 jobs stay in-process and per-TU
+// cleanup stays enabled (no -disable-free), since the leaked state would
+// otherwise accumulate across the batched invocations.
+// RUN: %clang -fintegrated-cc1 -fintegrated-cc1-batch -fintegrated-as -c \
+// RUN:     %t1.cpp %t2.cpp %t3.cpp -### 2>&1 | FileCheck %s --check-prefix=BATCH
+// RUN: %clang -fintegrated-cc1 -fintegrated-cc1-batch -fintegrated-as -c \
+// RUN:     %t1.cpp %t2.cpp %t3.cpp -### 2>&1 | FileCheck %s --check-prefix=NOFREE
+// BATCH-COUNT-3: (in-process)
+// NOFREE-NOT: "-disable-free"
+
+// The last of -fintegrated-cc1-batch and -fno-integrated-cc1-batch wins.
+// RUN: %clang -fintegrated-cc1 -fintegrated-cc1-batch -fno-integrated-cc1-batch \
+// RUN:     -fintegrated-as -c %t1.cpp %t2.cpp %t3.cpp -### 2>&1 \
+// RUN:     | FileCheck %s --check-prefix=NO
+
+// Linking adds a job that cannot run in-process, which disables batching.
+// RUN: %clang -fintegrated-cc1 -fintegrated-cc1-batch %t1.cpp %t2.cpp %t3.cpp \
+// RUN:     -### 2>&1 | FileCheck %s --check-prefix=NO
+
 // -fintegrated-cc1 works with cc1as.
 // macOS triples have an extra -x assembler-with-cpp job so (in-process) is not triggered.
 // RUN: echo > %t.s
@@ -20,12 +20,20 @@
 #include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
+#include <atomic>
 #include <fstream>
+#include <mutex>
+#include <optional>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -135,6 +143,22 @@ static cl::opt<bool>
     Verbose("verbose", cl::desc("If set, shows the list of processed files"),
             cl::cat(ClangFormatCategory));
 
+static cl::opt<unsigned> ParallelJobs(
+    "j",
+    cl::desc("Number of files to format in parallel. 0 picks the number\n"
+             "of hardware threads. Can only be used with -i or --dry-run,\n"
+             "as parallel workers cannot share the standard output."),
+    cl::init(1), cl::cat(ClangFormatCategory));
+
+static cl::opt<std::string> CacheFile(
+    "cache-file",
+    cl::desc("A file recording content hashes of files already known to\n"
+             "be formatted correctly, which are then skipped entirely.\n"
+             "Created if missing, updated after each run. The hashes\n"
+             "cover the effective style, so style changes invalidate\n"
+             "the cache. Can only be used with -i or --dry-run."),
+    cl::value_desc("filename"), cl::init(""), cl::cat(ClangFormatCategory));
+
 // Use --dry-run to match other LLVM tools when you mean do it but don't
 // actually do it
 static cl::opt<bool>
@@ -348,11 +372,16 @@ static void outputReplacementsXML(const Replacements &Replaces) {
   }
 }
 
+// Serializes warning output so diagnostics from parallel workers (see the -j
+// option) don't interleave within a file's report.
+static std::mutex WarningsMutex;
+
 static bool
 emitReplacementWarnings(const Replacements &Replaces, StringRef AssumedFileName,
                         const std::unique_ptr<llvm::MemoryBuffer> &Code) {
   unsigned Errors = 0;
   if (WarnFormat && !NoWarnFormat) {
+    std::lock_guard<std::mutex> Lock(WarningsMutex);
     SourceMgr Mgr;
     const char *StartBuf = Code->getBufferStart();
 
@@ -393,6 +422,59 @@ static void outputXML(const Replacements &Replaces,
   outs() << "</replacements>\n";
 }
 
+// Records content hashes of files already known to be formatted correctly so
+// whole-repository runs can skip unchanged files. The cache is a text file
+// with one hex-encoded hash per line; each hash covers both the file content
+// and the effective style, so editing either invalidates the entry.
+class FormatCache {
+public:
+  void load(StringRef Path) {
+    this->Path = std::string(Path);
+    // A missing or unreadable cache simply starts empty.
+    auto Buffer = MemoryBuffer::getFile(Path, /*IsText=*/true);
+    if (!Buffer)
+      return;
+    for (StringRef Line : llvm::split((*Buffer)->getBuffer(), '\n')) {
+      uint64_t Key;
+      if (!Line.trim().getAsInteger(16, Key))
+        Clean.insert(Key);
+    }
+  }
+
+  bool isClean(uint64_t Key) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Clean.contains(Key);
+  }
+
+  void markClean(uint64_t Key) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Clean.insert(Key).second)
+      Dirty = true;
+  }
+
+  void save() {
+    if (Path.empty() || !Dirty)
+      return;
+    std::error_code EC;
+    raw_fd_ostream OS(Path, EC, llvm::sys::fs::OF_Text);
+    if (EC) {
+      errs() << "warning: cannot write format cache " << Path << ": "
+             << EC.message() << "\n";
+      return;
+    }
+    for (uint64_t Key : Clean)
+      OS << llvm::utohexstr(Key) << '\n';
+  }
+
+private:
+  std::string Path;
+  llvm::DenseSet<uint64_t> Clean;
+  bool Dirty = false;
+  std::mutex Mutex;
+};
+
+static FormatCache TheFormatCache;
+
 class ClangFormatDiagConsumer : public DiagnosticConsumer {
   virtual void anchor() {}
 
@@ -483,6 +565,18 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
     else
       FormatStyle->SortIncludes = FormatStyle::SI_Never;
   }
+  // With -cache-file, files whose content and effective style were already
+  // seen formatted correctly are skipped. Only whole-file runs can prove (or
+  // use) cleanliness, so ranges disable the cache for this file.
+  std::optional<uint64_t> CacheKey;
+  if (!IsSTDIN && !CacheFile.empty() && LineRanges.empty() &&
+      Lengths.empty() && Offsets.size() == 1 && Offsets[0] == 0) {
+    CacheKey = xxh3_64bits(Code->getBuffer()) ^
+               xxh3_64bits(configurationAsText(*FormatStyle));
+    if (TheFormatCache.isClean(*CacheKey))
+      return false;
+  }
+
   unsigned CursorPosition = Cursor;
   Replacements Replaces = sortIncludes(*FormatStyle, Code->getBuffer(), Ranges,
                                        AssumedFileName, &CursorPosition);
@@ -509,6 +603,11 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
   Replacements FormatChanges =
       reformat(*FormatStyle, *ChangedCode, Ranges, AssumedFileName, &Status);
   Replaces = Replaces.merge(FormatChanges);
+  // A run that found nothing to change proves the content clean under this
+  // style; remember it so later runs skip the file.
+  if (CacheKey && Status.FormatComplete &&
+      Replaces.size() <= (IsJson ? 1u : 0u))
+    TheFormatCache.markClean(*CacheKey);
   if (DryRun) {
     return Replaces.size() > (IsJson ? 1u : 0u) &&
            emitReplacementWarnings(Replaces, AssumedFileName, Code);
@@ -720,9 +819,27 @@ int main(int argc, const char **argv) {
     return 1;
   }
 
+  // Parallel workers and cache skipping both suppress the per-file output
+  // that stdout-mode relies on.
+  if ((ParallelJobs != 1 || !CacheFile.empty()) && !Inplace && !DryRun) {
+    errs() << "error: -j and -cache-file can only be used with -i or "
+              "--dry-run.\n";
+    return 1;
+  }
+
+  if (!CacheFile.empty())
+    clang::format::TheFormatCache.load(CacheFile);
+
+  const bool Parallel = ParallelJobs != 1 && FileNames.size() > 1;
+  std::optional<llvm::DefaultThreadPool> Pool;
+  if (Parallel)
+    Pool.emplace(llvm::hardware_concurrency(ParallelJobs));
+  std::atomic<bool> Error(false);
+
   unsigned FileNo = 1;
-  bool Error = false;
   for (const auto &FileName : FileNames) {
+    // .clang-format-ignore matching keeps per-directory state, so filter on
+    // the main thread and only dispatch the formatting itself.
     const bool Ignored = isIgnored(FileName);
     if (ListIgnored) {
       if (Ignored)
@@ -735,7 +852,18 @@ int main(int argc, const char **argv) {
       errs() << "Formatting [" << FileNo++ << "/" << FileNames.size() << "] "
              << FileName << "\n";
     }
-    Error |= clang::format::format(FileName, FailOnIncompleteFormat);
+    auto Format = [&Error, &FileName] {
+      if (clang::format::format(FileName, FailOnIncompleteFormat))
+        Error = true;
+    };
+    if (Parallel)
+      Pool->async(Format);
+    else
+      Format();
   }
+  if (Parallel)
+    Pool->wait();
+
+  clang::format::TheFormatCache.save();
   return Error ? 1 : 0;
 }
@@ -147,6 +147,36 @@ TEST(DependencyScanningFilesystem, CacheStatOnExists) {
   EXPECT_EQ(InstrumentingFS->NumExistsCalls, 0u);
 }
 
+TEST(DependencyScanningFilesystem, EvictOutOfDateEntries) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo.c", 0, llvm::MemoryBuffer::getMemBuffer("content"));
+
+  // Stands in for the state of the real filesystem after some modifications:
+  // "/foo.c" changed contents and "/bar.c" came into existence.
+  auto ModifiedFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  ModifiedFS->setCurrentWorkingDirectory("/");
+  ModifiedFS->addFile("/foo.c", 0,
+                      llvm::MemoryBuffer::getMemBuffer("new contents"));
+  ModifiedFS->addFile("/bar.c", 0, llvm::MemoryBuffer::getMemBuffer(""));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+
+  DepFS.status("/foo.c");
+  DepFS.status("/bar.c"); // Stat failures with known extensions cache too.
+
+  // Nothing changed, nothing to evict.
+  EXPECT_EQ(SharedCache.evictOutOfDateEntries(*InMemoryFS), 0u);
+
+  // Both the changed file and the negatively cached path get evicted.
+  EXPECT_EQ(SharedCache.evictOutOfDateEntries(*ModifiedFS), 2u);
+
+  // Subsequent accesses observe the new filesystem state.
+  DependencyScanningWorkerFilesystem DepFS2(SharedCache, ModifiedFS);
+  EXPECT_TRUE(DepFS2.status("/bar.c"));
+}
+
 TEST(DependencyScanningFilesystem, CacheStatFailures) {
   auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
   InMemoryFS->setCurrentWorkingDirectory("/");
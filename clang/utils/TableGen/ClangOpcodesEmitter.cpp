@@ -36,6 +36,7 @@ private:
 
   /// Emits the switch case and the invocation in the interpreter.
   void EmitInterp(raw_ostream &OS, StringRef N, const Record *R);
+  void EmitInterpLabelAddr(raw_ostream &OS, StringRef N, const Record *R);
 
   /// Emits the disassembler.
   void EmitDisasm(raw_ostream &OS, StringRef N, const Record *R);
@@ -92,6 +93,7 @@ void ClangOpcodesEmitter::run(raw_ostream &OS) {
 
     EmitEnum(OS, N, Opcode);
     EmitInterp(OS, N, Opcode);
+    EmitInterpLabelAddr(OS, N, Opcode);
     EmitDisasm(OS, N, Opcode);
     EmitProto(OS, N, Opcode);
     EmitGroup(OS, N, Opcode);
@@ -119,7 +121,10 @@ void ClangOpcodesEmitter::EmitInterp(raw_ostream &OS, StringRef N,
               bool ChangesPC = R->getValueAsBit("ChangesPC");
               const auto &Args = R->getValueAsListOfDefs("Args");
 
-              OS << "case OP_" << ID << ": {\n";
+              // INTERP_CASE expands to either a switch case or a label,
+              // depending on whether the including interpreter loop uses
+              // computed gotos for the dispatch.
+              OS << "INTERP_CASE(OP_" << ID << "): {\n";
 
               if (CanReturn)
                 OS << "  bool DoReturn = (S.Current == StartFrame);\n";
@@ -160,12 +165,23 @@ void ClangOpcodesEmitter::EmitInterp(raw_ostream &OS, StringRef N,
                 OS << "    return true;\n";
               }
 
-              OS << "  continue;\n";
+              OS << "  INTERP_DISPATCH;\n";
               OS << "}\n";
             });
   OS << "#endif\n";
 }
 
+void ClangOpcodesEmitter::EmitInterpLabelAddr(raw_ostream &OS, StringRef N,
+                                              const Record *R) {
+  // Emit the label addresses for the computed goto dispatch, in the same
+  // order as the opcode enumerators.
+  OS << "#ifdef GET_INTERP_LABEL_ADDRS\n";
+  Enumerate(R, N, [&OS](ArrayRef<const Record *>, const Twine &ID) {
+    OS << "&&LBL_OP_" << ID << ",\n";
+  });
+  OS << "#endif\n";
+}
+
 void ClangOpcodesEmitter::EmitDisasm(raw_ostream &OS, StringRef N,
                                      const Record *R) {
   OS << "#ifdef GET_DISASM\n";
@@ -108,10 +108,20 @@ class Quarantine {
   }
 
   void NOINLINE Drain(Cache *c, Callback cb) {
-    {
-      SpinMutexLock l(&cache_mutex_);
-      cache_.Transfer(c);
+    if (!cache_mutex_.TryLock()) {
+      // Contention-adaptive draining: when another thread is transferring its
+      // cache right now, let this cache grow instead of spinning on the
+      // global mutex. Under free-heavy loads with hundreds of threads the
+      // transfer lock otherwise dominates quarantine cost. The backoff is
+      // bounded: once the cache reaches kDrainBackoffLimit times its
+      // configured size we drain unconditionally, so the total memory
+      // overhead stays proportional to the configured limits.
+      if (c->Size() <= kDrainBackoffLimit * GetMaxCacheSize())
+        return;
+      cache_mutex_.Lock();
     }
+    cache_.Transfer(c);
+    cache_mutex_.Unlock();
     if (cache_.Size() > GetMaxSize() && recycle_mutex_.TryLock())
       Recycle(atomic_load_relaxed(&min_size_), cb);
   }
@@ -133,6 +143,10 @@ class Quarantine {
   }
 
  private:
+  // How much a thread local cache may overgrow its configured size while the
+  // global cache mutex is contended (see Drain).
+  static const uptr kDrainBackoffLimit = 8;
+
   // Read-only data.
   char pad0_[kCacheLineSize];
   atomic_uintptr_t max_size_;
@@ -13,6 +13,7 @@
 #ifndef SANITIZER_SYMBOLIZER_INTERNAL_H
 #define SANITIZER_SYMBOLIZER_INTERNAL_H
 
+#include "sanitizer_dense_map.h"
 #include "sanitizer_file.h"
 #include "sanitizer_symbolizer.h"
 #include "sanitizer_vector.h"
@@ -135,6 +136,7 @@ class LLVMSymbolizer final : public SymbolizerTool {
   bool SymbolizePC(uptr addr, SymbolizedStack *stack) override;
   bool SymbolizeData(uptr addr, DataInfo *info) override;
   bool SymbolizeFrame(uptr addr, FrameInfo *info) override;
+  void Flush() override;
 
  private:
   const char *FormatAndSendCommand(const char *command_prefix,
@@ -144,6 +146,12 @@ class LLVMSymbolizer final : public SymbolizerTool {
   LLVMSymbolizerProcess *symbolizer_process_;
   static const uptr kBufferSize = 16 * 1024;
   char buffer_[kBufferSize];
+
+  // Cache of CODE responses from the subprocess. Leak and race reports repeat
+  // the same PCs across many stacks; replaying the cached response avoids a
+  // pipe round-trip per repeated frame. Module name pointers are stable and
+  // unique (owned by the Symbolizer), so (module, offset) identifies a PC.
+  DenseMap<detail::DenseMapPair<uptr, uptr>, const char *> code_cache_;
 };
 
 // Parses one or more two-line strings in the following format:
@@ -422,14 +422,29 @@ void ParseSymbolizeFrameOutput(const char *str,
 
 bool LLVMSymbolizer::SymbolizePC(uptr addr, SymbolizedStack *stack) {
   AddressInfo *info = &stack->info;
+  const detail::DenseMapPair<uptr, uptr> key(
+      reinterpret_cast<uptr>(info->module), info->module_offset);
+  if (const char *cached = code_cache_.lookup(key)) {
+    ParseSymbolizePCOutput(cached, stack);
+    return true;
+  }
   const char *buf = FormatAndSendCommand(
       "CODE", info->module, info->module_offset, info->module_arch);
   if (!buf)
     return false;
   ParseSymbolizePCOutput(buf, stack);
+  code_cache_.try_emplace(key, internal_strdup(buf));
   return true;
 }
 
+void LLVMSymbolizer::Flush() {
+  code_cache_.forEach([](auto &kv) -> bool {
+    InternalFree(const_cast<char *>(kv.second));
+    return true;
+  });
+  code_cache_.clear();
+}
+
 bool LLVMSymbolizer::SymbolizeData(uptr addr, DataInfo *info) {
   const char *buf = FormatAndSendCommand(
       "DATA", info->module, info->module_offset, info->module_arch);
@@ -174,6 +174,10 @@ void AllocatorPrintStats() {
   allocator()->PrintStats();
 }
 
+void AllocatorReleaseToOS() {
+  allocator()->ForceReleaseToOS();
+}
+
 static void SignalUnsafeCall(ThreadState *thr, uptr pc) {
   if (atomic_load_relaxed(&thr->in_signal_handler) == 0 ||
       !ShouldReport(thr, ReportTypeSignalUnsafe))
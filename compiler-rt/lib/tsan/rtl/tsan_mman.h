@@ -24,6 +24,7 @@ void ReplaceSystemMalloc();
 void AllocatorProcStart(Processor *proc);
 void AllocatorProcFinish(Processor *proc);
 void AllocatorPrintStats();
+void AllocatorReleaseToOS();
 void AllocatorLockBeforeFork();
 void AllocatorUnlockAfterFork(bool child);
 void GlobalProcessorLock();
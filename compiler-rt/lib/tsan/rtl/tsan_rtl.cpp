@@ -491,8 +491,17 @@ static void *BackgroundThread(void *arg) {
               (u64)rss >> 20, (u64)last_rss >> 20, (u64)limit >> 20);
       if (2 * rss > limit + last_rss) {
         VReport(1, "ThreadSanitizer: flushing memory due to RSS\n");
-        FlushShadowMemory();
+        // First return freed application pages held by the allocator to the
+        // OS (madvise-based, so the address space stays intact). This keeps
+        // the detection state and is often enough to get back under the
+        // limit; only if it is not do the full shadow reset, which discards
+        // accumulated race-detection history.
+        AllocatorReleaseToOS();
         rss = GetRSS();
+        if (2 * rss > limit + last_rss) {
+          FlushShadowMemory();
+          rss = GetRSS();
+        }
         now = NanoTime();
         VReport(1, "ThreadSanitizer: memory flushed RSS=%llu\n",
                 (u64)rss >> 20);
@@ -118,6 +118,12 @@ public:
     return moduleFileOutputRenamings_;
   }
 
+  // Locates a module file in the given search path, memoizing the result for
+  // the duration of the compilation so that repeated USEs of the same module
+  // do not rescan the directories.
+  std::optional<std::string> LocateModuleFile(
+      const std::string &name, const std::list<std::string> &searchPath);
+
   SemanticsContext &set_location(
       const std::optional<parser::CharBlock> &location) {
     location_ = location;
@@ -334,6 +340,7 @@ private:
   std::unique_ptr<CommonBlockMap> commonBlockMap_;
   ModuleDependences moduleDependences_;
   std::map<const Symbol *, SourceName> moduleFileOutputRenamings_;
+  std::map<std::string, std::optional<std::string>> moduleFileSearchCache_;
   UnorderedSymbolSet isDefined_;
   std::list<ProgramTree> programTrees_;
 };
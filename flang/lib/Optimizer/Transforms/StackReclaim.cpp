@@ -32,6 +32,18 @@ public:
 };
 } // namespace
 
+/// Does the loop contain an alloca whose stack space should be reclaimed at
+/// the end of each iteration? Allocas nested in further loops are skipped;
+/// those loops insert their own save/restore pair.
+static bool hasReclaimableAllocas(fir::DoLoopOp loopOp) {
+  auto walkResult = loopOp.getRegion().walk([&](fir::AllocaOp alloca) {
+    if (alloca->getParentOfType<fir::DoLoopOp>() == loopOp)
+      return mlir::WalkResult::interrupt();
+    return mlir::WalkResult::advance();
+  });
+  return walkResult.wasInterrupted();
+}
+
 void StackReclaimPass::runOnOperation() {
   auto *op = getOperation();
   fir::FirOpBuilder builder(op, fir::getKindMapping(op));
@@ -39,7 +51,7 @@ void StackReclaimPass::runOnOperation() {
   op->walk([&](fir::DoLoopOp loopOp) {
     mlir::Location loc = loopOp.getLoc();
 
-    if (!loopOp.getRegion().getOps<fir::AllocaOp>().empty()) {
+    if (hasReclaimableAllocas(loopOp)) {
       builder.setInsertionPointToStart(&loopOp.getRegion().front());
       mlir::Value sp = builder.genStackSave(loc);
 
@@ -1418,8 +1418,12 @@ Scope *ModFileReader::Read(SourceName name, std::optional<bool> isIntrinsic,
     for (const auto &d : options.searchDirectories) {
       searchDirs.push_back(d);
     }
-    foundNonIntrinsicModuleFile =
-        parser::LocateSourceFile(path, searchDirs).has_value();
+    // The standard search path is the same for every USE in this compilation,
+    // so the context memoizes the probe; intrinsic modules in particular are
+    // probed here on every USE before their cached scope is found below.
+    foundNonIntrinsicModuleFile = notAModule
+        ? parser::LocateSourceFile(path, searchDirs).has_value()
+        : context_.LocateModuleFile(path, searchDirs).has_value();
   }
   if (isIntrinsic.value_or(!foundNonIntrinsicModuleFile)) {
     // Explicitly intrinsic, or not specified and not found in the search
@@ -39,6 +39,7 @@
 #include "rewrite-parse-tree.h"
 #include "flang/Common/default-kinds.h"
 #include "flang/Parser/parse-tree-visitor.h"
+#include "flang/Parser/source.h"
 #include "flang/Parser/tools.h"
 #include "flang/Semantics/expression.h"
 #include "flang/Semantics/scope.h"
@@ -607,6 +608,17 @@ parser::Program &SemanticsContext::SaveParseTree(parser::Program &&tree) {
   return modFileParseTrees_.emplace_back(std::move(tree));
 }
 
+std::optional<std::string> SemanticsContext::LocateModuleFile(
+    const std::string &name, const std::list<std::string> &searchPath) {
+  auto iter{moduleFileSearchCache_.find(name)};
+  if (iter == moduleFileSearchCache_.end()) {
+    iter = moduleFileSearchCache_
+               .emplace(name, parser::LocateSourceFile(name, searchPath))
+               .first;
+  }
+  return iter->second;
+}
+
 bool Semantics::Perform() {
   // Implicitly USE the __Fortran_builtins module so that special types
   // (e.g., __builtin_team_type) are available to semantics, esp. for
@@ -640,11 +652,18 @@ bool Semantics::Perform() {
       }
     }
   }
+  // The directive canonicalization passes are full parse tree walks; only run
+  // them when the corresponding language feature is enabled, as the parser
+  // cannot have produced their constructs otherwise.
+  const common::LanguageFeatureControl &features{context_.languageFeatures()};
   return ValidateLabels(context_, program_) &&
       parser::CanonicalizeDo(program_) && // force line break
-      CanonicalizeAcc(context_.messages(), program_) &&
-      CanonicalizeOmp(context_.messages(), program_) &&
-      CanonicalizeCUDA(program_) &&
+      (!features.IsEnabled(common::LanguageFeature::OpenACC) ||
+          CanonicalizeAcc(context_.messages(), program_)) &&
+      (!features.IsEnabled(common::LanguageFeature::OpenMP) ||
+          CanonicalizeOmp(context_.messages(), program_)) &&
+      (!features.IsEnabled(common::LanguageFeature::CUDA) ||
+          CanonicalizeCUDA(program_)) &&
       PerformStatementSemantics(context_, program_) &&
       CanonicalizeDirectives(context_.messages(), program_) &&
       ModFileWriter{context_}
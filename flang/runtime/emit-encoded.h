@@ -15,6 +15,8 @@
 #include "environment.h"
 #include "tools.h"
 #include "utf.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Fortran::runtime::io {
 
@@ -97,11 +99,16 @@ RT_API_ATTRS bool EmitRepeated(CONTEXT &to, char ch, std::size_t n) {
   ConnectionState &connection{to.GetConnectionState()};
   if (connection.internalIoCharKind <= 1 &&
       connection.access != Access::Stream) {
-    // faster path, no encoding needed
-    while (n-- > 0) {
-      if (!to.Emit(&ch, 1)) {
+    // faster path, no encoding needed; emit a chunk at a time rather than
+    // paying the per-call Emit overhead for each repeated character
+    char buffer[64];
+    std::memset(buffer, ch, std::min(n, sizeof buffer));
+    while (n > 0) {
+      std::size_t chunk{std::min(n, sizeof buffer)};
+      if (!to.Emit(buffer, chunk)) {
         return false;
       }
+      n -= chunk;
     }
   } else {
     while (n-- > 0) {
@@ -153,14 +153,28 @@ template <typename A>
 typename A::pint_t DwarfFDECache<A>::findFDE(pint_t mh, pint_t pc) {
   pint_t result = 0;
   _LIBUNWIND_LOG_IF_FALSE(_lock.lock_shared());
-  for (entry *p = _buffer; p < _bufferUsed; ++p) {
-    if ((mh == p->mh) || (mh == kSearchAll)) {
-      if ((p->ip_start <= pc) && (pc < p->ip_end)) {
-        result = p->fde;
-        break;
-      }
+  // The buffer is sorted by ip_start (see add()), so binary search for the
+  // last entry starting at or below pc, then check that it covers pc.
+  // Function address ranges do not overlap, so at most one entry can match
+  // and the module handle only needs to be checked on that entry.
+  size_t len = (size_t)(_bufferUsed - _buffer);
+  entry *first = _buffer;
+  while (len > 0) {
+    size_t half = len / 2;
+    entry *mid = &first[half];
+    if (mid->ip_start <= pc) {
+      first = mid + 1;
+      len -= half + 1;
+    } else {
+      len = half;
     }
   }
+  if (first != _buffer) {
+    entry *p = first - 1;
+    if (((mh == p->mh) || (mh == kSearchAll)) && (p->ip_start <= pc) &&
+        (pc < p->ip_end))
+      result = p->fde;
+  }
   _LIBUNWIND_LOG_IF_FALSE(_lock.unlock_shared());
   return result;
 }
@@ -182,10 +196,16 @@ void DwarfFDECache<A>::add(pint_t mh, pint_t ip_start, pint_t ip_end,
     _bufferUsed = &newBuffer[oldSize];
     _bufferEnd = &newBuffer[newSize];
   }
-  _bufferUsed->mh = mh;
-  _bufferUsed->ip_start = ip_start;
-  _bufferUsed->ip_end = ip_end;
-  _bufferUsed->fde = fde;
+  // Keep the buffer sorted by ip_start so that findFDE() can binary search.
+  entry *pos = _bufferUsed;
+  while (pos > _buffer && pos[-1].ip_start > ip_start)
+    --pos;
+  if (pos != _bufferUsed)
+    memmove(pos + 1, pos, (size_t)(_bufferUsed - pos) * sizeof(entry));
+  pos->mh = mh;
+  pos->ip_start = ip_start;
+  pos->ip_end = ip_end;
+  pos->fde = fde;
   ++_bufferUsed;
 #ifdef __APPLE__
   if (!_registeredForDyldUnloads) {
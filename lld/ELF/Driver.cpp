@@ -67,6 +67,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -1225,6 +1226,11 @@ static bool remapInputs(Ctx &ctx, StringRef line, const Twine &location) {
 
 // Initializes Config members by the command line options.
 static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
+  // Set first: readFile() consults this to digest every file read from here
+  // on, including scripts and ordering files opened while options are still
+  // being processed.
+  ctx.arg.incrementalCache = args.getLastArgValue(OPT_incremental_cache);
+
   ctx.e.verbose = args.hasArg(OPT_verbose);
   ctx.e.vsDiagnostics =
       args.hasArg(OPT_visual_studio_diagnostics_format, false);
@@ -1435,6 +1441,8 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.thinLTOIndexOnly = args.hasArg(OPT_thinlto_index_only) ||
                              args.hasArg(OPT_thinlto_index_only_eq);
   ctx.arg.thinLTOIndexOnlyArg = args.getLastArgValue(OPT_thinlto_index_only_eq);
+  ctx.arg.thinLTORemoteBackend =
+      args.getLastArgValue(OPT_thinlto_remote_backend_eq);
   ctx.arg.thinLTOObjectSuffixReplace =
       getOldNewOptions(ctx, args, OPT_thinlto_object_suffix_replace_eq);
   std::tie(ctx.arg.thinLTOPrefixReplaceOld, ctx.arg.thinLTOPrefixReplaceNew,
@@ -2531,6 +2539,13 @@ void LinkerDriver::compileBitcodeFiles(bool skipLinkedOutput) {
     markBuffersAsDontNeed(ctx, skipLinkedOutput);
 
   ltoObjectFiles = lto->compile();
+  // As for the initial inputs, decode and hash the symbol names the native
+  // objects contribute in parallel; the sequential parse below then only
+  // performs the order-dependent symbol resolution.
+  parallelForEach(ltoObjectFiles, [](std::unique_ptr<InputFile> &file) {
+    if (auto *f = dyn_cast<ELFFileBase>(file.get()))
+      f->cacheSymbolNames();
+  });
   for (auto &file : ltoObjectFiles) {
     auto *obj = cast<ObjFile<ELFT>>(file.get());
     obj->parse(/*ignoreComdats=*/true);
@@ -2864,9 +2879,90 @@ static void postParseObjectFile(ELFFileBase *file) {
 
 // Do actual linking. Note that when this function is called,
 // all linker scripts have already been parsed.
+// --incremental-cache support. The cache file records a digest of the
+// command line, the size and mtime of the output the previous link produced,
+// and the (path, digest) of every file that link read. When the current
+// run's command line and resolved inputs match the record and the output is
+// untouched, a relink would produce a byte-identical output (the link is
+// deterministic), so it can stop right after reading the inputs. Any
+// mismatch, however small, falls back to a full link; no attempt is made to
+// patch the previous output in place.
+
+static bool canSkipRelink(Ctx &ctx, uint64_t cmdDigest) {
+  auto mb = MemoryBuffer::getFile(ctx.arg.incrementalCache, /*IsText=*/true);
+  if (!mb)
+    return false;
+  SmallVector<StringRef, 0> lines;
+  (*mb)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  if (lines.size() < 2)
+    return false;
+
+  auto [magic, cmd] = lines[0].split(' ');
+  uint64_t cachedCmdDigest;
+  if (magic != "lld-incremental-1" || cmd.getAsInteger(10, cachedCmdDigest) ||
+      cachedCmdDigest != cmdDigest)
+    return false;
+
+  auto [sizeStr, mtimeStr] = lines[1].split(' ');
+  uint64_t size;
+  int64_t mtime;
+  sys::fs::file_status st;
+  if (sizeStr.getAsInteger(10, size) || mtimeStr.getAsInteger(10, mtime) ||
+      sys::fs::status(ctx.arg.outputFile, st) || st.getSize() != size ||
+      st.getLastModificationTime().time_since_epoch().count() != mtime)
+    return false;
+
+  // Compare the recorded inputs against the files this run actually resolved;
+  // ctx.inputDigests was filled in by createFiles. Re-hashing the recorded
+  // paths instead would not notice a resolution change: a library newly
+  // appearing earlier in a search path leaves every previously recorded file
+  // untouched but alters the link. Files discovered only during the link
+  // itself (dependent libraries, extracted archive members) are recorded but
+  // not resolved yet at this point, so links using them conservatively miss.
+  ArrayRef<StringRef> recorded = ArrayRef(lines).drop_front(2);
+  if (recorded.size() != ctx.inputDigests.size())
+    return false;
+  for (auto [line, input] : zip_equal(recorded, ctx.inputDigests)) {
+    auto [digestStr, path] = line.split(' ');
+    uint64_t digest;
+    if (digestStr.getAsInteger(10, digest) || path != input.first ||
+        digest != input.second)
+      return false;
+  }
+  return true;
+}
+
+static void writeIncrementalCache(Ctx &ctx, uint64_t cmdDigest) {
+  sys::fs::file_status st;
+  if (sys::fs::status(ctx.arg.outputFile, st))
+    return;
+  std::error_code ec;
+  raw_fd_ostream os(ctx.arg.incrementalCache, ec, sys::fs::OF_None);
+  if (ec) {
+    Warn(ctx) << "cannot write --incremental-cache file "
+              << ctx.arg.incrementalCache << ": " << ec.message();
+    return;
+  }
+  os << "lld-incremental-1 " << cmdDigest << '\n';
+  os << st.getSize() << ' '
+     << st.getLastModificationTime().time_since_epoch().count() << '\n';
+  for (auto &[path, digest] : ctx.inputDigests)
+    os << digest << ' ' << path << '\n';
+}
+
 template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   llvm::TimeTraceScope timeScope("Link", StringRef("LinkerDriver::Link"));
 
+  uint64_t incrementalCmdDigest = 0;
+  if (!ctx.arg.incrementalCache.empty()) {
+    std::string cmdline = createResponseFile(args);
+    incrementalCmdDigest = xxh3_64bits(cmdline);
+    if (canSkipRelink(ctx, incrementalCmdDigest)) {
+      Log(ctx) << "--incremental-cache: inputs unchanged, output up to date";
+      return;
+    }
+  }
+
   // Handle --trace-symbol.
   for (auto *arg : args.filtered(OPT_trace_symbol))
     ctx.symtab->insert(arg->getValue())->traced = true;
@@ -2878,6 +2974,17 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   for (StringRef name : ctx.arg.undefined)
     ctx.symtab->addUnusedUndefined(name)->referenced = true;
 
+  // Symbol table insertion must walk the input files sequentially in command
+  // line order, but decoding and hashing the symbol names each file
+  // contributes is file-local. Do that part in parallel up front so the
+  // sequential walk below only performs the order-dependent resolution.
+  // Files discovered during parsing (dependent libraries, extracted archive
+  // members) miss the cache and decode their names inline as before.
+  parallelForEach(files, [](std::unique_ptr<InputFile> &file) {
+    if (auto *f = dyn_cast<ELFFileBase>(file.get()))
+      f->cacheSymbolNames();
+  });
+
   parseFiles(ctx, files);
 
   // Create dynamic sections for dynamic linking and static PIE.
@@ -3220,4 +3327,7 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
 
   // Write the result to the file.
   writeResult<ELFT>(ctx);
+
+  if (!ctx.arg.incrementalCache.empty() && errCount(ctx) == 0)
+    writeIncrementalCache(ctx, incrementalCmdDigest);
 }
@@ -443,6 +443,26 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Fold the relocation fields that constantEq unconditionally compares (count,
+// offset and type) into the given content digest. Sections differing in any
+// of these can never be folded, so separating their classes up front leaves
+// less work for the quadratic segregation steps. Symbols and addends are
+// deliberately excluded: they may differ between foldable sections.
+template <class RelTy>
+static uint64_t combineRelocConstants(uint64_t hash, bool isMips64EL,
+                                      Relocs<RelTy> rels) {
+  SmallVector<uint64_t, 64> data;
+  data.reserve(2 * rels.size() + 1);
+  data.push_back(rels.size());
+  for (const RelTy &rel : rels) {
+    data.push_back(rel.r_offset);
+    data.push_back(rel.getType(isMips64EL));
+  }
+  return hash ^ xxh3_64bits(ArrayRef<uint8_t>(
+                    reinterpret_cast<const uint8_t *>(data.data()),
+                    data.size() * sizeof(uint64_t)));
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class RelTy>
@@ -487,10 +507,19 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
-  // Initially, we use hash values to partition sections.
+  // Initially, we use hash values to partition sections. Digest both the
+  // content and the constant parts of the relocations.
   parallelForEach(sections, [&](InputSection *s) {
+    uint64_t hash = xxh3_64bits(s->content());
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    if (rels.areRelocsCrel())
+      hash = combineRelocConstants(hash, ctx.arg.isMips64EL, rels.crels);
+    else if (rels.areRelocsRel())
+      hash = combineRelocConstants(hash, ctx.arg.isMips64EL, rels.rels);
+    else
+      hash = combineRelocConstants(hash, ctx.arg.isMips64EL, rels.relas);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
+    s->eqClass[0] = hash | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
@@ -30,6 +30,7 @@
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <optional>
 
 using namespace llvm;
@@ -258,9 +259,17 @@ std::optional<MemoryBufferRef> elf::readFile(Ctx &ctx, StringRef path) {
     return std::nullopt;
   }
 
+  // Hint the kernel to start reading the file ahead of the first access. The
+  // parallel section scanning and relocation passes otherwise serialize on
+  // major page faults when the inputs are not in the page cache.
+  (*mbOrErr)->willNeedIfMmap();
+
   MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
   ctx.memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
 
+  if (!ctx.arg.incrementalCache.empty())
+    ctx.inputDigests.emplace_back(path.str(), xxh3_64bits(mbref.getBuffer()));
+
   if (ctx.tar)
     ctx.tar->append(relativeToRoot(path), mbref.getBuffer());
   return mbref;
@@ -472,6 +481,54 @@ ELFFileBase::ELFFileBase(Ctx &ctx, Kind k, ELFKind ekind, MemoryBufferRef mb)
 
 ELFFileBase::~ELFFileBase() {}
 
+void ELFFileBase::cacheSymbolNames() {
+  // Only object files funnel their symbols through SymbolTable::insert;
+  // shared files mangle versioned names separately.
+  if (fileKind != ObjKind)
+    return;
+  switch (ekind) {
+  case ELF32LEKind:
+    cacheSymbolNames<ELF32LE>();
+    break;
+  case ELF32BEKind:
+    cacheSymbolNames<ELF32BE>();
+    break;
+  case ELF64LEKind:
+    cacheSymbolNames<ELF64LE>();
+    break;
+  case ELF64BEKind:
+    cacheSymbolNames<ELF64BE>();
+    break;
+  default:
+    llvm_unreachable("getELFKind");
+  }
+}
+
+template <class ELFT> void ELFFileBase::cacheSymbolNames() {
+  ArrayRef<typename ELFT::Sym> eSyms = getELFSyms<ELFT>();
+  if (firstGlobal >= eSyms.size())
+    return;
+  symbolNameCache.reserve(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      // Leave the cache empty; the sequential path will re-decode the name
+      // and report the error with full context.
+      consumeError(name.takeError());
+      symbolNameCache.clear();
+      return;
+    }
+    // Mirror the stem computation in SymbolTable::insert: <name>@@<version>
+    // symbols are keyed by <name>.
+    StringRef stem = *name;
+    size_t pos = name->find('@');
+    if (pos != StringRef::npos && pos + 1 < name->size() &&
+        (*name)[pos + 1] == '@')
+      stem = name->take_front(pos);
+    symbolNameCache.push_back({*name, CachedHashStringRef(stem)});
+  }
+}
+
 template <typename Elf_Shdr>
 static const Elf_Shdr *findSection(ArrayRef<Elf_Shdr> sections, uint32_t type) {
   for (const Elf_Shdr &sec : sections)
@@ -1092,11 +1149,23 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   if (!symbols)
     symbols = std::make_unique<Symbol *[]>(numSymbols);
 
-  // Some entries have been filled by LazyObjFile.
+  // Some entries have been filled by LazyObjFile. Use the names pre-decoded
+  // by cacheSymbolNames() when available.
   auto *symtab = ctx.symtab.get();
-  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  if (symbolNameCache.size() == eSyms.size() - firstGlobal) {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i]) {
+        auto &[name, stem] = symbolNameCache[i - firstGlobal];
+        symbols[i] = symtab->insert(name, stem);
+      }
+    // The cache has served its purpose; release the memory.
+    symbolNameCache = decltype(symbolNameCache)();
+  } else {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i])
+        symbols[i] =
+            symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  }
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1878,7 +1947,13 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+    if (symbolNameCache.size() == eSyms.size() - firstGlobal) {
+      auto &[name, stem] = symbolNameCache[i - firstGlobal];
+      symbols[i] = symtab->insert(name, stem);
+    } else {
+      symbols[i] =
+          symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+    }
     symbols[i]->resolve(ctx, LazySymbol{*this});
     if (!lazy)
       break;
@@ -14,6 +14,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/LLVM.h"
 #include "lld/Common/Reproduce.h"
+#include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/Object/ELF.h"
@@ -182,6 +183,12 @@ public:
   static bool classof(const InputFile *f) { return f->isElf(); }
 
   void init();
+
+  // Decode and hash this file's global symbol names. This is file-local work
+  // that can run in parallel across input files before the sequential,
+  // order-dependent symbol table insertion consumes the result.
+  void cacheSymbolNames();
+
   template <typename ELFT> llvm::object::ELFFile<ELFT> getObj() const {
     return check(llvm::object::ELFFile<ELFT>::create(mb.getBuffer()));
   }
@@ -221,6 +228,14 @@ protected:
   // Initializes this class's member variables.
   template <typename ELFT> void init(InputFile::Kind k);
 
+  template <typename ELFT> void cacheSymbolNames();
+
+  // Pre-decoded (name, hashed stem) pairs for global symbols, produced by
+  // cacheSymbolNames() and consumed during symbol table insertion. Empty if
+  // the names have not been (or could not be) pre-decoded.
+  SmallVector<std::pair<StringRef, llvm::CachedHashStringRef>, 0>
+      symbolNameCache;
+
   StringRef stringTable;
   const void *elfShdrs = nullptr;
   const void *elfSyms = nullptr;
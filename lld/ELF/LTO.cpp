@@ -30,6 +30,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <algorithm>
 #include <cstddef>
 #include <memory>
@@ -186,6 +187,11 @@ BitcodeCompiler::BitcodeCompiler(Ctx &ctx) : ctx(ctx) {
         std::string(ctx.arg.thinLTOPrefixReplaceNew),
         std::string(ctx.arg.thinLTOPrefixReplaceNativeObject),
         ctx.arg.thinLTOEmitImportsFiles, indexFile.get(), onIndexWrite);
+  } else if (!ctx.arg.thinLTORemoteBackend.empty()) {
+    backend = lto::createOutOfProcessThinBackend(
+        llvm::heavyweight_hardware_concurrency(ctx.arg.thinLTOJobs),
+        std::string(ctx.arg.thinLTORemoteBackend), onIndexWrite,
+        ctx.arg.thinLTOEmitImportsFiles);
   } else {
     backend = lto::createInProcessThinBackend(
         llvm::heavyweight_hardware_concurrency(ctx.arg.thinLTOJobs),
@@ -337,6 +343,17 @@ SmallVector<std::unique_ptr<InputFile>, 0> BitcodeCompiler::compile() {
                           },
                           cache));
 
+  // Report cache effectiveness, both in the --time-trace output and as a
+  // --verbose log line.
+  if (const FileCache::CacheStats *stats = cache.getStats()) {
+    uint64_t hits = stats->Hits, misses = stats->Misses;
+    llvm::TimeTraceScope timeScope("ThinLTO cache", ("hits: " + Twine(hits) +
+                                                     ", misses: " +
+                                                     Twine(misses))
+                                                        .str());
+    Log(ctx) << "ThinLTO cache: " << hits << " hits, " << misses << " misses";
+  }
+
   // Emit empty index files for non-indexed files but not in single-module mode.
   if (ctx.arg.thinLTOModulesToCompile.empty()) {
     for (StringRef s : thinIndices) {
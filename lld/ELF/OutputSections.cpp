@@ -361,57 +361,104 @@ static SmallVector<uint8_t, 0> deflateShard(Ctx &ctx, ArrayRef<uint8_t> in,
 //
 // * (if --compress-debug-sections is specified) non-empty .debug_* sections
 // * (if --compress-sections is specified) matched sections
-template <class ELFT> void OutputSection::maybeCompress(Ctx &ctx) {
+//
+// The shards of all selected sections form a single parallel work list, so
+// the small trailing sections (.debug_abbrev, .debug_line, ...) fill the
+// threads that would otherwise idle at the tail of a dominant .debug_info
+// instead of each running a mostly sequential round of its own.
+namespace {
+struct CompressJob {
+  OutputSection *osec;
+  DebugCompressionType ctype;
+  unsigned level;
+  // Uncompressed bytes, referenced by shardsIn.
+  std::unique_ptr<uint8_t[]> buf;
+  std::vector<ArrayRef<uint8_t>> shardsIn;
+  std::unique_ptr<SmallVector<uint8_t, 0>[]> shardsOut;
+  std::unique_ptr<uint32_t[]> shardsAdler; // zlib only
+};
+} // namespace
+
+template <class ELFT> void elf::maybeCompressSections(Ctx &ctx) {
   using Elf_Chdr = typename ELFT::Chdr;
   (void)sizeof(Elf_Chdr);
+  llvm::TimeTraceScope timeScope("Compress sections");
 
-  DebugCompressionType ctype = DebugCompressionType::None;
-  size_t compressedSize = sizeof(Elf_Chdr);
-  unsigned level = 0; // default compression level
-  if (!(flags & SHF_ALLOC) && ctx.arg.compressDebugSections &&
-      name.starts_with(".debug_"))
-    ctype = *ctx.arg.compressDebugSections;
-  for (auto &[glob, t, l] : ctx.arg.compressSections)
-    if (glob.match(name))
-      std::tie(ctype, level) = {t, l};
-  if (ctype == DebugCompressionType::None)
-    return;
-  if (flags & SHF_ALLOC) {
-    Err(ctx) << "--compress-sections: section '" << name
-             << "' with the SHF_ALLOC flag cannot be compressed";
-    return;
-  }
+  // Select the sections to compress and materialize their uncompressed
+  // contents.
+  SmallVector<CompressJob, 0> jobs;
+  for (OutputSection *osec : ctx.outputSections) {
+    DebugCompressionType ctype = DebugCompressionType::None;
+    unsigned level = 0; // default compression level
+    if (!(osec->flags & SHF_ALLOC) && ctx.arg.compressDebugSections &&
+        osec->name.starts_with(".debug_"))
+      ctype = *ctx.arg.compressDebugSections;
+    for (auto &[glob, t, l] : ctx.arg.compressSections)
+      if (glob.match(osec->name))
+        std::tie(ctype, level) = {t, l};
+    if (ctype == DebugCompressionType::None)
+      continue;
+    if (osec->flags & SHF_ALLOC) {
+      Err(ctx) << "--compress-sections: section '" << osec->name
+               << "' with the SHF_ALLOC flag cannot be compressed";
+      continue;
+    }
 
-  llvm::TimeTraceScope timeScope("Compress sections");
-  auto buf = std::make_unique<uint8_t[]>(size);
-  // Write uncompressed data to a temporary zero-initialized buffer.
-  {
-    parallel::TaskGroup tg;
-    writeTo<ELFT>(ctx, buf.get(), tg);
+    CompressJob job;
+    job.osec = osec;
+    job.ctype = ctype;
+    job.level = level;
+    // Write uncompressed data to a temporary zero-initialized buffer.
+    job.buf = std::make_unique<uint8_t[]>(osec->size);
+    {
+      parallel::TaskGroup tg;
+      osec->writeTo<ELFT>(ctx, job.buf.get(), tg);
+    }
+    // The generic ABI specifies "The sh_size and sh_addralign fields of the
+    // section header for a compressed section reflect the requirements of the
+    // compressed section." However, 1-byte alignment has been wildly accepted
+    // and utilized for a long time. Removing alignment padding is particularly
+    // useful when there are many compressed output sections.
+    osec->addralign = 1;
+
+    // Split input into 1-MiB shards.
+    constexpr size_t shardSize = 1 << 20;
+    job.shardsIn = split(ArrayRef<uint8_t>(job.buf.get(), osec->size),
+                         shardSize);
+    job.shardsOut =
+        std::make_unique<SmallVector<uint8_t, 0>[]>(job.shardsIn.size());
+#if LLVM_ENABLE_ZLIB
+    if (job.ctype == DebugCompressionType::Zlib) {
+      // We chose 1 (Z_BEST_SPEED) as the default compression level because it
+      // is fast and provides decent compression ratios.
+      if (!job.level)
+        job.level = Z_BEST_SPEED;
+      job.shardsAdler = std::make_unique<uint32_t[]>(job.shardsIn.size());
+    }
+#endif
+    jobs.push_back(std::move(job));
   }
-  // The generic ABI specifies "The sh_size and sh_addralign fields of the
-  // section header for a compressed section reflect the requirements of the
-  // compressed section." However, 1-byte alignment has been wildly accepted
-  // and utilized for a long time. Removing alignment padding is particularly
-  // useful when there are many compressed output sections.
-  addralign = 1;
-
-  // Split input into 1-MiB shards.
-  [[maybe_unused]] constexpr size_t shardSize = 1 << 20;
-  auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
-  const size_t numShards = shardsIn.size();
-  auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+  if (jobs.empty())
+    return;
+
+  // Compress the shards of all sections in one parallel loop.
+  SmallVector<std::pair<CompressJob *, size_t>, 0> work;
+  for (CompressJob &job : jobs)
+    for (size_t i = 0, e = job.shardsIn.size(); i != e; ++i)
+      work.push_back({&job, i});
 
+  parallelFor(0, work.size(), [&](size_t w) {
+    auto [job, i] = work[w];
 #if LLVM_ENABLE_ZSTD
-  // Use ZSTD's streaming compression API. See
-  // http://facebook.github.io/zstd/zstd_manual.html "Streaming compression -
-  // HowTo".
-  if (ctype == DebugCompressionType::Zstd) {
-    parallelFor(0, numShards, [&](size_t i) {
+    // Use ZSTD's streaming compression API. See
+    // http://facebook.github.io/zstd/zstd_manual.html "Streaming compression -
+    // HowTo".
+    if (job->ctype == DebugCompressionType::Zstd) {
       SmallVector<uint8_t, 0> out;
       ZSTD_CCtx *cctx = ZSTD_createCCtx();
-      ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
-      ZSTD_inBuffer zib = {shardsIn[i].data(), shardsIn[i].size(), 0};
+      ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, job->level);
+      ZSTD_inBuffer zib = {job->shardsIn[i].data(), job->shardsIn[i].size(),
+                           0};
       ZSTD_outBuffer zob = {nullptr, 0, 0};
       size_t size;
       do {
@@ -427,51 +474,56 @@ template <class ELFT> void OutputSection::maybeCompress(Ctx &ctx) {
       } while (size != 0);
       out.truncate(zob.pos);
       ZSTD_freeCCtx(cctx);
-      shardsOut[i] = std::move(out);
-    });
-    compressed.type = ELFCOMPRESS_ZSTD;
-    for (size_t i = 0; i != numShards; ++i)
-      compressedSize += shardsOut[i].size();
-  }
+      job->shardsOut[i] = std::move(out);
+      return;
+    }
 #endif
-
 #if LLVM_ENABLE_ZLIB
-  // We chose 1 (Z_BEST_SPEED) as the default compression level because it is
-  // fast and provides decent compression ratios.
-  if (ctype == DebugCompressionType::Zlib) {
-    if (!level)
-      level = Z_BEST_SPEED;
-
-    // Compress shards and compute Alder-32 checksums. Use Z_SYNC_FLUSH for all
-    // shards but the last to flush the output to a byte boundary to be
-    // concatenated with the next shard.
-    auto shardsAdler = std::make_unique<uint32_t[]>(numShards);
-    parallelFor(0, numShards, [&](size_t i) {
-      shardsOut[i] = deflateShard(ctx, shardsIn[i], level,
-                                  i != numShards - 1 ? Z_SYNC_FLUSH : Z_FINISH);
-      shardsAdler[i] = adler32(1, shardsIn[i].data(), shardsIn[i].size());
-    });
-
-    // Update section size and combine Alder-32 checksums.
-    uint32_t checksum = 1;       // Initial Adler-32 value
-    compressedSize += 2;         // Elf_Chdir and zlib header
-    for (size_t i = 0; i != numShards; ++i) {
-      compressedSize += shardsOut[i].size();
-      checksum = adler32_combine(checksum, shardsAdler[i], shardsIn[i].size());
+    // Use Z_SYNC_FLUSH for all shards but the last to flush the output to a
+    // byte boundary to be concatenated with the next shard.
+    if (job->ctype == DebugCompressionType::Zlib) {
+      job->shardsOut[i] =
+          deflateShard(ctx, job->shardsIn[i], job->level,
+                       i != job->shardsIn.size() - 1 ? Z_SYNC_FLUSH : Z_FINISH);
+      job->shardsAdler[i] =
+          adler32(1, job->shardsIn[i].data(), job->shardsIn[i].size());
     }
-    compressedSize += 4; // checksum
-    compressed.type = ELFCOMPRESS_ZLIB;
-    compressed.checksum = checksum;
-  }
 #endif
+  });
 
-  if (compressedSize >= size)
-    return;
-  compressed.uncompressedSize = size;
-  compressed.shards = std::move(shardsOut);
-  compressed.numShards = numShards;
-  size = compressedSize;
-  flags |= SHF_COMPRESSED;
+  // Assemble the per-section results.
+  for (CompressJob &job : jobs) {
+    OutputSection *osec = job.osec;
+    const size_t numShards = job.shardsIn.size();
+    size_t compressedSize = sizeof(Elf_Chdr);
+    if (job.ctype == DebugCompressionType::Zstd) {
+      osec->compressed.type = ELFCOMPRESS_ZSTD;
+      for (size_t i = 0; i != numShards; ++i)
+        compressedSize += job.shardsOut[i].size();
+    } else {
+#if LLVM_ENABLE_ZLIB
+      // Update section size and combine Alder-32 checksums.
+      uint32_t checksum = 1;       // Initial Adler-32 value
+      compressedSize += 2;         // Elf_Chdir and zlib header
+      for (size_t i = 0; i != numShards; ++i) {
+        compressedSize += job.shardsOut[i].size();
+        checksum =
+            adler32_combine(checksum, job.shardsAdler[i], job.shardsIn[i].size());
+      }
+      compressedSize += 4; // checksum
+      osec->compressed.type = ELFCOMPRESS_ZLIB;
+      osec->compressed.checksum = checksum;
+#endif
+    }
+
+    if (compressedSize >= osec->size)
+      continue;
+    osec->compressed.uncompressedSize = osec->size;
+    osec->compressed.shards = std::move(job.shardsOut);
+    osec->compressed.numShards = numShards;
+    osec->size = compressedSize;
+    osec->flags |= SHF_COMPRESSED;
+  }
 }
 
 static void writeInt(Ctx &ctx, uint8_t *buf, uint64_t data, uint64_t size) {
@@ -947,7 +999,7 @@ template void OutputSection::writeTo<ELF64LE>(Ctx &, uint8_t *,
 template void OutputSection::writeTo<ELF64BE>(Ctx &, uint8_t *,
                                               llvm::parallel::TaskGroup &);
 
-template void OutputSection::maybeCompress<ELF32LE>(Ctx &);
-template void OutputSection::maybeCompress<ELF32BE>(Ctx &);
-template void OutputSection::maybeCompress<ELF64LE>(Ctx &);
-template void OutputSection::maybeCompress<ELF64BE>(Ctx &);
+template void elf::maybeCompressSections<ELF32LE>(Ctx &);
+template void elf::maybeCompressSections<ELF32BE>(Ctx &);
+template void elf::maybeCompressSections<ELF64LE>(Ctx &);
+template void elf::maybeCompressSections<ELF64BE>(Ctx &);
@@ -118,7 +118,6 @@ public:
   void writeTo(Ctx &, uint8_t *buf, llvm::parallel::TaskGroup &tg);
   // Check that the addends for dynamic relocations were written correctly.
   void checkDynRelAddends(Ctx &);
-  template <class ELFT> void maybeCompress(Ctx &);
 
   void sort(llvm::function_ref<int(InputSectionBase *s)> order);
   void sortInitFini();
@@ -172,6 +171,10 @@ getInputSections(const OutputSection &os,
                  SmallVector<InputSection *, 0> &storage);
 
 uint64_t getHeaderSize(Ctx &);
+
+// Compresses the output sections selected by --compress-debug-sections and
+// --compress-sections, sharing one parallel work list across all of them.
+template <class ELFT> void maybeCompressSections(Ctx &ctx);
 } // namespace lld::elf
 
 #endif
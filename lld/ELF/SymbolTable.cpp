@@ -73,7 +73,13 @@ Symbol *SymbolTable::insert(StringRef name) {
   if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
     stem = name.take_front(pos);
 
-  auto p = symMap.insert({CachedHashStringRef(stem), (int)symVector.size()});
+  return insert(name, CachedHashStringRef(stem));
+}
+
+// As above, but with the stem and its hash precomputed, typically in parallel
+// by ELFFileBase::cacheSymbolNames.
+Symbol *SymbolTable::insert(StringRef name, CachedHashStringRef stem) {
+  auto p = symMap.insert({stem, (int)symVector.size()});
   if (!p.second) {
     Symbol *sym = symVector[p.first->second];
     if (stem.size() != name.size()) {
@@ -91,7 +97,7 @@ Symbol *SymbolTable::insert(StringRef name) {
   sym->setName(name);
   sym->partition = 1;
   sym->versionId = VER_NDX_GLOBAL;
-  if (pos != StringRef::npos)
+  if (name.contains('@'))
     sym->hasVersionSuffix = true;
   return sym;
 }
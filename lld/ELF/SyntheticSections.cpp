@@ -3518,9 +3518,51 @@ createSymbols(
     }
   });
 
+  // Compute how many bytes of CU vectors and names each shard contributes to
+  // the constant pool.
+  size_t cuVectorOffs[numShards], nameOffs[numShards];
   size_t numSymbols = 0;
-  for (ArrayRef<GdbSymbol> v : ArrayRef(symbols.get(), numShards))
-    numSymbols += v.size();
+  for (size_t i = 0; i != numShards; ++i)
+    numSymbols += symbols[i].size();
+  parallelFor(0, numShards, [&](size_t i) {
+    size_t cuBytes = 0, nameBytes = 0;
+    for (const GdbSymbol &sym : symbols[i]) {
+      cuBytes += (sym.cuVector.size() + 1) * 4;
+      nameBytes += sym.name.size() + 1;
+    }
+    cuVectorOffs[i] = cuBytes;
+    nameOffs[i] = nameBytes;
+  });
+
+  // CU vectors and symbol names are adjacent in the output file. Convert the
+  // per-shard sizes to file offsets: CU vectors come first, then names.
+  size_t off = 0;
+  for (size_t &cuBytes : cuVectorOffs) {
+    size_t size = cuBytes;
+    cuBytes = off;
+    off += size;
+  }
+  for (size_t &nameBytes : nameOffs) {
+    size_t size = nameBytes;
+    nameBytes = off;
+    off += size;
+  }
+  // If off overflows, the last symbol's nameOff likely overflows.
+  if (!isUInt<32>(off))
+    Err(ctx) << "--gdb-index: constant pool size (" << off
+             << ") exceeds UINT32_MAX";
+
+  // Assign each symbol its offsets within its shard's slice of the pool, in
+  // parallel.
+  parallelFor(0, numShards, [&](size_t i) {
+    size_t cuOff = cuVectorOffs[i], nameOff = nameOffs[i];
+    for (GdbSymbol &sym : symbols[i]) {
+      sym.cuVectorOff = cuOff;
+      cuOff += (sym.cuVector.size() + 1) * 4;
+      sym.nameOff = nameOff;
+      nameOff += sym.name.size() + 1;
+    }
+  });
 
   // The return type is a flattened vector, so we'll copy each vector
   // contents to Ret.
@@ -3531,22 +3573,6 @@ createSymbols(
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
 
-  // CU vectors and symbol names are adjacent in the output file.
-  // We can compute their offsets in the output file now.
-  size_t off = 0;
-  for (GdbSymbol &sym : ret) {
-    sym.cuVectorOff = off;
-    off += (sym.cuVector.size() + 1) * 4;
-  }
-  for (GdbSymbol &sym : ret) {
-    sym.nameOff = off;
-    off += sym.name.size() + 1;
-  }
-  // If off overflows, the last symbol's nameOff likely overflows.
-  if (!isUInt<32>(off))
-    Err(ctx) << "--gdb-index: constant pool size (" << off
-             << ") exceeds UINT32_MAX";
-
   return {ret, off};
 }
 
@@ -3665,21 +3691,19 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
 
   buf += symtabSize * 8;
 
-  // Write the string pool.
+  // Write the constant pool. Both the CU vectors and the string pool are
+  // addressed by per-symbol offsets computed in createSymbols, so each
+  // symbol's contribution can be written independently.
   hdr->constantPoolOff = buf - start;
   parallelForEach(symbols, [&](GdbSymbol &sym) {
     memcpy(buf + sym.nameOff, sym.name.data(), sym.name.size());
-  });
-
-  // Write the CU vectors.
-  for (GdbSymbol &sym : symbols) {
-    write32le(buf, sym.cuVector.size());
-    buf += 4;
+    uint8_t *p = buf + sym.cuVectorOff;
+    write32le(p, sym.cuVector.size());
     for (uint32_t val : sym.cuVector) {
-      write32le(buf, val);
-      buf += 4;
+      p += 4;
+      write32le(p, val);
     }
-  }
+  });
 }
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
@@ -3934,23 +3958,56 @@ size_t MergeTailSection::getSize() const { return builder.getSize(); }
 void MergeTailSection::writeTo(uint8_t *buf) { builder.write(buf); }
 
 void MergeTailSection::finalizeContents() {
-  // Add all string pieces to the string table builder to create section
+  // Tail merging in StringTableBuilder::finalize is inherently sequential,
+  // but for any strings S and T we know S is not a duplicate of T if their
+  // hash values differ. We can therefore discard exact duplicates with a
+  // sharded parallel pass and hand the sequential tail merge unique strings
+  // only. Shard IDs are the most significant bits of the 31-bit piece hashes
+  // (see MergeNoTailSection::getShardId for why not the low bits); bucketing
+  // the survivors by shard rather than by thread keeps the order in which
+  // strings reach the builder independent of the concurrency level.
+  constexpr size_t numShards = 32;
+  const size_t concurrency =
+      llvm::bit_floor(std::min<size_t>(ctx.arg.threadCount, numShards));
+  auto getShardId = [](uint32_t hash) {
+    return hash >> (31 - llvm::countr_zero(numShards));
+  };
+  SmallVector<SmallVector<CachedHashStringRef, 0>, 0> uniques(numShards);
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    // Strings in different shards have different hashes and can never be
+    // equal, so one set per thread suffices.
+    DenseSet<CachedHashStringRef> seen;
+    for (MergeInputSection *sec : sections) {
+      for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+        if (!sec->pieces[i].live)
+          continue;
+        size_t shardId = getShardId(sec->pieces[i].hash);
+        if ((shardId & (concurrency - 1)) == threadId &&
+            seen.insert(sec->getData(i)).second)
+          uniques[shardId].push_back(sec->getData(i));
+      }
+    }
+  });
+
+  // Add the unique strings to the string table builder to create section
   // contents.
-  for (MergeInputSection *sec : sections)
-    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        builder.add(sec->getData(i));
+  for (ArrayRef<CachedHashStringRef> shard : uniques)
+    for (CachedHashStringRef s : shard)
+      builder.add(s.val());
 
   // Fix the string table content. After this, the contents will never change.
   builder.finalize();
 
   // finalize() fixed tail-optimized strings, so we can now get
   // offsets of strings. Get an offset for each string and save it
-  // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
+  // to a corresponding SectionPiece for easy access. getOffset is a
+  // read-only lookup once the builder is finalized, so this is safe to
+  // do concurrently.
+  parallelForEach(sections, [&](MergeInputSection *sec) {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
       if (sec->pieces[i].live)
         sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
@@ -25,6 +25,7 @@
 #include "lld/Common/Filesystem.h"
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Parallel.h"
@@ -32,6 +33,7 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 #include <climits>
+#include <thread>
 
 #define DEBUG_TYPE "lld"
 
@@ -323,8 +325,7 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   // If --compressed-debug-sections is specified, compress .debug_* sections.
   // Do it right now because it changes the size of output sections.
-  for (OutputSection *sec : ctx.outputSections)
-    sec->maybeCompress<ELFT>(ctx);
+  maybeCompressSections<ELFT>(ctx);
 
   if (ctx.script->hasSectionsCommand)
     ctx.script->allocateHeaders(ctx.mainPart->phdrs);
@@ -345,8 +346,20 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   // Handle --print-map(-M)/--Map and --cref. Dump them before checkSections()
   // because the files may be useful in case checkSections() or openFile()
-  // fails, for example, due to an erroneous file size.
-  writeMapAndCref(ctx);
+  // fails, for example, due to an erroneous file size. The contents only
+  // depend on the addresses and sizes that are final at this point, and
+  // nothing below reopens the auxiliary files, so the (demangling-heavy)
+  // emission can run on a background thread, overlapped with opening and
+  // writing the output file. The thread is joined on every exit path.
+  std::thread mapThread;
+  auto joinMapThread = llvm::make_scope_exit([&] {
+    if (mapThread.joinable())
+      mapThread.join();
+  });
+  if (ctx.arg.threadCount > 1)
+    mapThread = std::thread(writeMapAndCref, std::ref(ctx));
+  else
+    writeMapAndCref(ctx);
 
   // Handle --print-memory-usage option.
   if (ctx.arg.printMemoryUsage)
@@ -2860,6 +2873,10 @@ template <class ELFT> void Writer<ELFT>::openFile() {
     flags |= FileOutputBuffer::F_executable;
   if (!ctx.arg.mmapOutputFile)
     flags |= FileOutputBuffer::F_no_mmap;
+  // Let the buffered (non-mmap) path skip all-zero ranges so that large
+  // zero-filled areas stay sparse on disk; the mmap path already leaves
+  // untouched pages unmaterialized.
+  flags |= FileOutputBuffer::F_sparse;
   Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr =
       FileOutputBuffer::create(ctx.arg.outputFile, fileSize, flags);
 
@@ -0,0 +1,92 @@
+# REQUIRES: x86
+## Test --incremental-cache: a relink whose command line, inputs, and output
+## are all unchanged is skipped; any mismatch falls back to a full link that
+## refreshes the cache.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 main.s -o main.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+
+## The first link produces the output and records the command line digest,
+## the output size/mtime, and a digest per input file.
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+# RUN: FileCheck %s --check-prefix=CACHE < cache
+# CACHE: lld-incremental-1 {{[0-9]+}}
+# CACHE: {{[0-9]+}} main.o
+# CACHE: {{[0-9]+}} a.o
+
+## An unchanged rerun skips the link.
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+# SKIP: --incremental-cache: inputs unchanged, output up to date
+# NOSKIP-NOT: --incremental-cache:
+
+## Modifying an input's content forces a full link, which refreshes the
+## cache, so the next unchanged rerun skips again.
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a2.s -o a.o
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+
+## A changed command line relinks even though all files are unchanged.
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose --no-gc-sections | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+## Restore the baseline command line (relinks once, then skips).
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+
+## A deleted output relinks.
+# RUN: rm out
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+
+## A modified output relinks.
+# RUN: echo x >> out
+# RUN: ld.lld main.o a.o -o out --incremental-cache=cache --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+
+## A change in input resolution must relink even though every file the
+## previous run recorded is untouched: a library appearing earlier in the
+## search path shadows the one the cache was built from.
+# RUN: mkdir dir1 dir2
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-ar rc dir2/libdummy.a a.o
+# RUN: ld.lld main.o -Ldir1 -Ldir2 -ldummy -o out2 --incremental-cache=cache2 --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+# RUN: ld.lld main.o -Ldir1 -Ldir2 -ldummy -o out2 --incremental-cache=cache2 --verbose | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+# RUN: llvm-ar rc dir1/libdummy.a b.o
+# RUN: ld.lld main.o -Ldir1 -Ldir2 -ldummy -o out2 --incremental-cache=cache2 --verbose | \
+# RUN:   FileCheck %s --check-prefix=NOSKIP --allow-empty
+## The relinked output picked up the shadowing library.
+# RUN: llvm-nm out2 | FileCheck %s --check-prefix=NEWLIB
+# NEWLIB: bar
+
+#--- main.s
+.globl _start
+_start:
+  call foo
+
+#--- a.s
+.globl foo
+foo:
+  ret
+
+#--- a2.s
+.globl foo
+foo:
+  nop
+  ret
+
+#--- b.s
+.globl foo, bar
+foo:
+  ret
+bar:
+  ret
@@ -0,0 +1,65 @@
+; REQUIRES: x86, shell
+;; Test --thinlto-remote-backend: per-module code generation is delegated to
+;; an external command invoked as <command> <module> <index> <object>, and the
+;; native object the command produces is ingested into the link.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: chmod +x backend.sh fail.sh noobj.sh
+; RUN: opt -module-summary a.ll -o a.o
+; RUN: opt -module-summary b.ll -o b.o
+
+;; Happy path: the command runs once per module, the sharded summary index is
+;; written next to each module, and the link consumes the command's objects.
+; RUN: ld.lld a.o b.o -o out --thinlto-remote-backend=./backend.sh
+; RUN: ls a.o.thinlto.bc b.o.thinlto.bc a.o.thinlto.o b.o.thinlto.o a.o.ran b.o.ran
+; RUN: llvm-nm out | FileCheck %s --check-prefix=NM
+
+; NM-DAG: T _start
+; NM-DAG: T f
+
+;; A command that exits nonzero fails the link.
+; RUN: not ld.lld a.o b.o -o out2 --thinlto-remote-backend=./fail.sh 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=FAIL
+; FAIL: ThinLTO backend command './fail.sh' failed for '{{.*}}.o'
+
+;; A command that cannot be found fails the link.
+; RUN: not ld.lld a.o b.o -o out3 --thinlto-remote-backend=./does-not-exist 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NOTFOUND
+; NOTFOUND: does-not-exist': {{[Nn]}}o such file or directory
+
+;; A command that succeeds without producing the object fails the link.
+; RUN: not ld.lld a.o b.o -o out4 --thinlto-remote-backend=./noobj.sh 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NOOBJ
+; NOOBJ: .thinlto.o': {{[Nn]}}o such file or directory
+
+;--- backend.sh
+#!/bin/sh
+touch "$1.ran"
+llc -filetype=obj "$1" -o "$3"
+
+;--- fail.sh
+#!/bin/sh
+exit 1
+
+;--- noobj.sh
+#!/bin/sh
+exit 0
+
+;--- a.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @f()
+
+define void @_start() {
+  call void @f()
+  ret void
+}
+
+;--- b.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @f() {
+  ret void
+}
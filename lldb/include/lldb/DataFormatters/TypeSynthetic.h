@@ -23,6 +23,10 @@
 #include "lldb/Utility/StructuredData.h"
 #include "lldb/ValueObject/ValueObject.h"
 
+namespace llvm {
+class MemoryBuffer;
+}
+
 namespace lldb_private {
 class SyntheticChildrenFrontEnd {
 protected:
@@ -473,6 +477,66 @@ private:
   const ScriptedSyntheticChildren &
   operator=(const ScriptedSyntheticChildren &) = delete;
 };
+
+/// Synthetic child provider implemented in LLDB formatter bytecode. Each
+/// callback runs a small native bytecode program in-process, so expanding a
+/// large container costs one interpreter loop per child instead of a round
+/// trip into a scripting language. Any of the programs may be absent; the
+/// corresponding callback then reports no children.
+class BytecodeSyntheticChildren : public SyntheticChildren {
+  std::unique_ptr<llvm::MemoryBuffer> m_get_num_children;
+  std::unique_ptr<llvm::MemoryBuffer> m_get_child_at_index;
+  std::unique_ptr<llvm::MemoryBuffer> m_get_child_index;
+
+public:
+  BytecodeSyntheticChildren(
+      const SyntheticChildren::Flags &flags,
+      std::unique_ptr<llvm::MemoryBuffer> get_num_children,
+      std::unique_ptr<llvm::MemoryBuffer> get_child_at_index,
+      std::unique_ptr<llvm::MemoryBuffer> get_child_index);
+
+  ~BytecodeSyntheticChildren() override;
+
+  std::string GetDescription() override;
+
+  bool IsScripted() override { return false; }
+
+  class FrontEnd : public SyntheticChildrenFrontEnd {
+  public:
+    FrontEnd(BytecodeSyntheticChildren &synth, ValueObject &backend)
+        : SyntheticChildrenFrontEnd(backend), m_synth(&synth) {}
+
+    ~FrontEnd() override;
+
+    llvm::Expected<uint32_t> CalculateNumChildren() override;
+
+    lldb::ValueObjectSP GetChildAtIndex(uint32_t idx) override;
+
+    lldb::ChildCacheState Update() override;
+
+    bool MightHaveChildren() override;
+
+    size_t GetIndexOfChildWithName(ConstString name) override;
+
+    typedef std::shared_ptr<SyntheticChildrenFrontEnd> SharedPointer;
+
+  private:
+    BytecodeSyntheticChildren *m_synth;
+
+    FrontEnd(const FrontEnd &) = delete;
+    const FrontEnd &operator=(const FrontEnd &) = delete;
+  };
+
+  SyntheticChildrenFrontEnd::AutoPointer
+  GetFrontEnd(ValueObject &backend) override {
+    return SyntheticChildrenFrontEnd::AutoPointer(new FrontEnd(*this, backend));
+  }
+
+private:
+  BytecodeSyntheticChildren(const BytecodeSyntheticChildren &) = delete;
+  const BytecodeSyntheticChildren &
+  operator=(const BytecodeSyntheticChildren &) = delete;
+};
 } // namespace lldb_private
 
 #endif // LLDB_DATAFORMATTERS_TYPESYNTHETIC_H
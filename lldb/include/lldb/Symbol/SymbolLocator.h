@@ -9,6 +9,7 @@
 #ifndef LLDB_SYMBOL_SYMBOLLOCATOR_H
 #define LLDB_SYMBOL_SYMBOLLOCATOR_H
 
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginInterface.h"
 #include "lldb/Utility/UUID.h"
 
@@ -24,6 +25,13 @@ public:
   /// found, this will notify all target which contain the module with the
   /// given UUID.
   static void DownloadSymbolFileAsync(const UUID &uuid);
+
+  /// Kick off background symbol file downloads for every module in the given
+  /// list that doesn't already have a symbol file. This function returns
+  /// immediately; the downloads run concurrently on the debugger's thread
+  /// pool, so by the time a consumer such as the unwinder asks for a module's
+  /// symbol file it is often already in the local cache.
+  static void DownloadSymbolFilesAsync(const ModuleList &module_list);
 };
 
 } // namespace lldb_private
@@ -342,10 +342,28 @@ private:
   void SymbolIndicesToSymbolContextList(std::vector<uint32_t> &symbol_indexes,
                                         SymbolContextList &sc_list);
 
-  void RegisterMangledNameEntry(
-      uint32_t value, std::set<const char *> &class_contexts,
-      std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-      RichManglingContext &rmc);
+  /// Name maps and mangling bookkeeping built from one contiguous slice of
+  /// the symbol table by an InitNameIndexes() worker. Demangling dominates
+  /// name index construction, so the slices are processed in parallel and the
+  /// per-slice results are merged (in slice order) once all workers finish.
+  struct NameIndexes {
+    NameToIndexMap name_to_index;
+    NameToIndexMap basename_to_index;
+    NameToIndexMap method_to_index;
+    NameToIndexMap selector_to_index;
+    // The "const char *" in "class_contexts" and backlog::value_type::second
+    // must come from a ConstString::GetCString()
+    std::set<const char *> class_contexts;
+    std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
+  };
+
+  void RegisterSymbolNameEntries(uint32_t value,
+                                 const std::vector<Language *> &languages,
+                                 RichManglingContext &rmc,
+                                 NameIndexes &indexes);
+
+  void RegisterMangledNameEntry(uint32_t value, NameIndexes &indexes,
+                                RichManglingContext &rmc);
 
   void RegisterBacklogEntry(const NameToIndexMap::Entry &entry,
                             const char *decl_context,
@@ -1192,6 +1192,18 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  /// Take a previously parsed user expression cached under \a key out of the
+  /// cache, or return an empty shared pointer if none is cached. Entries are
+  /// removed while in use, so a recursive or concurrent evaluation of the
+  /// same expression never shares a live instance; callers offer the
+  /// expression back with CacheUserExpression() when they are done with it.
+  lldb::UserExpressionSP TakeCachedUserExpression(llvm::StringRef key);
+
+  /// Offer a successfully parsed and executed user expression for reuse under
+  /// \a key. The caller must not keep using the expression after caching it.
+  void CacheUserExpression(llvm::StringRef key,
+                           lldb::UserExpressionSP user_expression_sp);
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1614,6 +1626,12 @@ protected:
   /// signals you will have.
   llvm::StringMap<DummySignalValues> m_dummy_signals;
 
+  /// Parsed user expressions kept for reuse by UserExpression::Evaluate(),
+  /// keyed by expression text, prefix, language and desired result type. See
+  /// TakeCachedUserExpression().
+  std::mutex m_cached_user_expressions_mutex;
+  llvm::StringMap<lldb::UserExpressionSP> m_cached_user_expressions;
+
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
 
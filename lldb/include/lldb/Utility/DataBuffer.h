@@ -60,6 +60,12 @@ public:
     return llvm::ArrayRef<uint8_t>(GetBytes(), GetByteSize());
   }
 
+  /// Hint that the buffer's contents are about to be accessed so that storage
+  /// backed by the file system can start reading ahead of the accesses. This
+  /// is a no-op for buffers whose bytes are already resident, such as heap
+  /// buffers.
+  virtual void AdviseWillNeed() {}
+
   /// LLVM RTTI support.
   /// {
   static char ID;
@@ -30,6 +30,7 @@ public:
 
   const uint8_t *GetBytesImpl() const override;
   lldb::offset_t GetByteSize() const override;
+  void AdviseWillNeed() override;
 
   /// LLVM RTTI support.
   /// {
@@ -806,6 +806,8 @@ public:
 
   lldb::DataBufferSP &GetSharedDataBuffer() { return m_data_sp; }
 
+  const lldb::DataBufferSP &GetSharedDataBuffer() const { return m_data_sp; }
+
   /// Peek at a C string at \a offset.
   ///
   /// Peeks at a string in the contained data. No verification is done to make
@@ -9,6 +9,7 @@
 #include "FormatterBytecode.h"
 #include "lldb/Core/Module.h"
 #include "lldb/DataFormatters/DataVisualization.h"
+#include "lldb/DataFormatters/TypeSynthetic.h"
 #include "lldb/Utility/LLDBLog.h"
 
 using namespace lldb;
@@ -140,6 +141,10 @@ void LoadFormattersForModule(ModuleSP module_sp) {
                                                    category);
         llvm::DataExtractor::Cursor cursor(0);
         uint64_t flags = extractor.getULEB128(cursor);
+        std::unique_ptr<llvm::MemoryBuffer> summary;
+        std::unique_ptr<llvm::MemoryBuffer> get_num_children;
+        std::unique_ptr<llvm::MemoryBuffer> get_child_at_index;
+        std::unique_ptr<llvm::MemoryBuffer> get_child_index;
         while (cursor && cursor.tell() < extractor.size()) {
           uint8_t signature = extractor.getU8(cursor);
           uint64_t size = extractor.getULEB128(cursor);
@@ -149,21 +154,45 @@ void LoadFormattersForModule(ModuleSP module_sp) {
                            "{0}");
             return;
           }
-          if (signature == 0) {
-            auto summary_sp = std::make_shared<BytecodeSummaryFormat>(
-                TypeSummaryImpl::Flags(flags),
-                llvm::MemoryBuffer::getMemBufferCopy(bytecode));
-            FormatterMatchType match_type = eFormatterMatchExact;
-            if (type_name.front() == '^')
-              match_type = eFormatterMatchRegex;
-            category->AddTypeSummary(type_name, match_type, summary_sp);
-            LLDB_LOG(GetLog(LLDBLog::DataFormatters),
-                     "Loaded embedded type summary for '{0}' from {1}.",
-                     type_name, module_sp->GetFileSpec());
-          } else
+          switch (signature) {
+          case FormatterBytecode::sig_summary:
+            summary = llvm::MemoryBuffer::getMemBufferCopy(bytecode);
+            break;
+          case FormatterBytecode::sig_get_num_children:
+            get_num_children = llvm::MemoryBuffer::getMemBufferCopy(bytecode);
+            break;
+          case FormatterBytecode::sig_get_child_at_index:
+            get_child_at_index = llvm::MemoryBuffer::getMemBufferCopy(bytecode);
+            break;
+          case FormatterBytecode::sig_get_child_index:
+            get_child_index = llvm::MemoryBuffer::getMemBufferCopy(bytecode);
+            break;
+          default:
             LLDB_LOG(GetLog(LLDBLog::DataFormatters),
                      "Unsupported formatter signature {0} for '{1}' in {2}",
                      signature, type_name, module_sp->GetFileSpec());
+            break;
+          }
+        }
+        FormatterMatchType match_type = eFormatterMatchExact;
+        if (type_name.front() == '^')
+          match_type = eFormatterMatchRegex;
+        if (summary) {
+          auto summary_sp = std::make_shared<BytecodeSummaryFormat>(
+              TypeSummaryImpl::Flags(flags), std::move(summary));
+          category->AddTypeSummary(type_name, match_type, summary_sp);
+          LLDB_LOG(GetLog(LLDBLog::DataFormatters),
+                   "Loaded embedded type summary for '{0}' from {1}.",
+                   type_name, module_sp->GetFileSpec());
+        }
+        if (get_num_children || get_child_at_index || get_child_index) {
+          auto synth_sp = std::make_shared<BytecodeSyntheticChildren>(
+              SyntheticChildren::Flags(flags), std::move(get_num_children),
+              std::move(get_child_at_index), std::move(get_child_index));
+          category->AddTypeSynthetic(type_name, match_type, synth_sp);
+          LLDB_LOG(GetLog(LLDBLog::DataFormatters),
+                   "Loaded embedded synthetic children for '{0}' from {1}.",
+                   type_name, module_sp->GetFileSpec());
         }
       });
 }
@@ -12,14 +12,19 @@
 #include "lldb/lldb-enumerations.h"
 #include "lldb/lldb-public.h"
 
+#include "FormatterBytecode.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/DataFormatters/TypeSynthetic.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/ScriptInterpreter.h"
 #include "lldb/Symbol/CompilerType.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/LLDBLog.h"
+#include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
 
+#include "llvm/Support/MemoryBuffer.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -249,3 +254,103 @@ std::string ScriptedSyntheticChildren::GetDescription() {
 
   return std::string(sstr.GetString());
 }
+
+BytecodeSyntheticChildren::BytecodeSyntheticChildren(
+    const SyntheticChildren::Flags &flags,
+    std::unique_ptr<llvm::MemoryBuffer> get_num_children,
+    std::unique_ptr<llvm::MemoryBuffer> get_child_at_index,
+    std::unique_ptr<llvm::MemoryBuffer> get_child_index)
+    : SyntheticChildren(flags), m_get_num_children(std::move(get_num_children)),
+      m_get_child_at_index(std::move(get_child_at_index)),
+      m_get_child_index(std::move(get_child_index)) {}
+
+BytecodeSyntheticChildren::~BytecodeSyntheticChildren() = default;
+
+std::string BytecodeSyntheticChildren::GetDescription() {
+  StreamString sstr;
+  sstr.Printf("%s%s%s LLDB bytecode synthetic children",
+              Cascades() ? "" : " (not cascading)",
+              SkipsPointers() ? " (skip pointers)" : "",
+              SkipsReferences() ? " (skip references)" : "");
+
+  return std::string(sstr.GetString());
+}
+
+BytecodeSyntheticChildren::FrontEnd::~FrontEnd() = default;
+
+/// Run one bytecode program with the given initial data stack and return the
+/// element left on top of the stack.
+static llvm::Expected<FormatterBytecode::DataStackElement>
+EvaluateBytecode(llvm::MemoryBuffer &bytecode,
+                 FormatterBytecode::DataStack &&data,
+                 FormatterBytecode::Selectors sel) {
+  std::vector<FormatterBytecode::ControlStackElement> control(
+      {bytecode.getBuffer()});
+  if (llvm::Error error = FormatterBytecode::Interpret(control, data, sel))
+    return std::move(error);
+  if (!data.size())
+    return llvm::createStringError("empty stack");
+  return data.PopAny();
+}
+
+llvm::Expected<uint32_t>
+BytecodeSyntheticChildren::FrontEnd::CalculateNumChildren() {
+  if (!m_synth->m_get_num_children)
+    return 0;
+  auto result_or_err = EvaluateBytecode(
+      *m_synth->m_get_num_children, FormatterBytecode::DataStack(
+                                        m_backend.GetSP()),
+      FormatterBytecode::sel_get_num_children);
+  if (!result_or_err)
+    return result_or_err.takeError();
+  if (auto *num = std::get_if<uint64_t>(&*result_or_err))
+    return std::min<uint64_t>(*num, UINT32_MAX);
+  return llvm::createStringError(
+      "get_num_children bytecode did not produce an unsigned integer");
+}
+
+lldb::ValueObjectSP
+BytecodeSyntheticChildren::FrontEnd::GetChildAtIndex(uint32_t idx) {
+  if (!m_synth->m_get_child_at_index)
+    return nullptr;
+  FormatterBytecode::DataStack data(m_backend.GetSP());
+  data.Push(static_cast<uint64_t>(idx));
+  auto result_or_err =
+      EvaluateBytecode(*m_synth->m_get_child_at_index, std::move(data),
+                       FormatterBytecode::sel_get_child_at_index);
+  if (!result_or_err) {
+    LLDB_LOG_ERROR(GetLog(LLDBLog::DataFormatters), result_or_err.takeError(),
+                   "{0}");
+    return nullptr;
+  }
+  if (auto *valobj = std::get_if<lldb::ValueObjectSP>(&*result_or_err))
+    return *valobj;
+  return nullptr;
+}
+
+lldb::ChildCacheState BytecodeSyntheticChildren::FrontEnd::Update() {
+  return lldb::ChildCacheState::eRefetch;
+}
+
+bool BytecodeSyntheticChildren::FrontEnd::MightHaveChildren() {
+  return m_synth->m_get_num_children != nullptr;
+}
+
+size_t
+BytecodeSyntheticChildren::FrontEnd::GetIndexOfChildWithName(ConstString name) {
+  if (!m_synth->m_get_child_index)
+    return UINT32_MAX;
+  FormatterBytecode::DataStack data(m_backend.GetSP());
+  data.Push(std::string(name.GetStringRef()));
+  auto result_or_err =
+      EvaluateBytecode(*m_synth->m_get_child_index, std::move(data),
+                       FormatterBytecode::sel_get_child_index);
+  if (!result_or_err) {
+    LLDB_LOG_ERROR(GetLog(LLDBLog::DataFormatters), result_or_err.takeError(),
+                   "{0}");
+    return UINT32_MAX;
+  }
+  if (auto *num = std::get_if<uint64_t>(&*result_or_err))
+    return *num;
+  return UINT32_MAX;
+}
@@ -41,6 +41,7 @@
 #include "lldb/Utility/StreamString.h"
 #include "lldb/ValueObject/ValueObjectConstResult.h"
 #include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb_private;
 
@@ -253,18 +254,46 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   }
 
   Status error;
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(
-          expr, full_prefix, language, desired_type, options, ctx_obj, error));
-  if (error.Fail() || !user_expression_sp) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    set_error(std::move(error));
-    return lldb::eExpressionSetupError;
+
+  // See if the target has a cached parsed expression we can reuse, the same
+  // way breakpoint locations reuse their condition expression across hits.
+  // Expressions evaluated against a context object, generating debug info, or
+  // declaring top-level code are not eligible. The cached instance is checked
+  // out of the target while in use and offered back after it has executed
+  // successfully, so recursive evaluations never share a live instance.
+  std::string expression_cache_key;
+  const bool can_cache_expression =
+      !ctx_obj && !options.GetGenerateDebugInfo() &&
+      execution_policy != eExecutionPolicyTopLevel;
+  lldb::UserExpressionSP user_expression_sp;
+  if (can_cache_expression) {
+    llvm::raw_string_ostream key_strm(expression_cache_key);
+    key_strm << (unsigned)desired_type << ';'
+             << (unsigned)language.AsLanguageType() << ';'
+             << full_prefix.size() << ';' << full_prefix << expr;
+    user_expression_sp = target->TakeCachedUserExpression(expression_cache_key);
+    if (user_expression_sp && (!user_expression_sp->IsParseCacheable() ||
+                               !user_expression_sp->MatchesContext(exe_ctx)))
+      user_expression_sp.reset();
+    if (user_expression_sp)
+      LLDB_LOG(log,
+               "== [UserExpression::Evaluate] Reusing cached expression {0} ==",
+               expr.str());
   }
 
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
+  const bool reused_cached_expression = (bool)user_expression_sp;
+  if (!user_expression_sp) {
+    user_expression_sp = lldb::UserExpressionSP(
+        target->GetUserExpressionForLanguage(expr, full_prefix, language,
+                                             desired_type, options, ctx_obj,
+                                             error));
+    if (error.Fail() || !user_expression_sp) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      set_error(std::move(error));
+      return lldb::eExpressionSetupError;
+    }
+  }
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -276,9 +305,15 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
 
   DiagnosticManager diagnostic_manager;
 
-  bool parse_success =
-      user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
-                                keep_expression_in_memory, generate_debug_info);
+  bool parse_success = reused_cached_expression;
+  if (!reused_cached_expression) {
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+    parse_success =
+        user_expression_sp->Parse(diagnostic_manager, exe_ctx,
+                                  execution_policy, keep_expression_in_memory,
+                                  generate_debug_info);
+  }
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
@@ -407,6 +442,13 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     }
   }
 
+  // Offer the parsed expression back to the target for the next evaluation
+  // of the same text. Execution must have completed: an expression that
+  // faulted may have been left partially materialized.
+  if (execution_results == lldb::eExpressionCompleted && can_cache_expression &&
+      user_expression_sp && user_expression_sp->IsParseCacheable())
+    target->CacheUserExpression(expression_cache_key, user_expression_sp);
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationComplete)) {
     set_error(Status::FromError(llvm::make_error<ExpressionError>(
         lldb::eExpressionInterrupted,
@@ -749,6 +749,23 @@ bool ClangASTImporter::importRecordLayoutFromOrigin(
   return true;
 }
 
+/// Even though the record layout we hand back short-circuits clang's own
+/// layout computation, the layout builder still asks for the size and
+/// alignment of every field, which requires the field types to be complete.
+/// The debug info parsers leave field types as forward declarations
+/// (completing them transitively when the record is completed is expensive),
+/// so the ones that are still incomplete have to be resolved here, right
+/// before clang lays the record out.
+static void RequireCompleteFieldTypes(const clang::RecordDecl *record_decl) {
+  clang::ASTContext &ast_ctx = record_decl->getASTContext();
+  TypeSystemClang *ast = TypeSystemClang::GetASTContext(&ast_ctx);
+  if (!ast)
+    return;
+  for (const clang::FieldDecl *field : record_decl->fields())
+    TypeSystemClang::RequireCompleteType(
+        ast->GetType(ast_ctx.getBaseElementType(field->getType())));
+}
+
 bool ClangASTImporter::LayoutRecordType(
     const clang::RecordDecl *record_decl, uint64_t &bit_size,
     uint64_t &alignment,
@@ -767,7 +784,11 @@ bool ClangASTImporter::LayoutRecordType(
     field_offsets.swap(pos->second.field_offsets);
     base_offsets.swap(pos->second.base_offsets);
     vbase_offsets.swap(pos->second.vbase_offsets);
+    // Erase the layout entry before completing the field types; completing
+    // them may parse more debug info and register layouts for other records,
+    // invalidating iterators into the map.
     m_record_decl_to_layout_map.erase(pos);
+    RequireCompleteFieldTypes(record_decl);
     return true;
   }
 
@@ -777,8 +798,10 @@ bool ClangASTImporter::LayoutRecordType(
   if (auto origin = GetDeclOrigin(record_decl); origin.Valid())
     if (importRecordLayoutFromOrigin(record_decl, bit_size, alignment,
                                      field_offsets, base_offsets,
-                                     vbase_offsets))
+                                     vbase_offsets)) {
+      RequireCompleteFieldTypes(record_decl);
       return true;
+    }
 
   bit_size = 0;
   alignment = 0;
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <memory>
@@ -392,41 +393,52 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
   if (core_objfile == nullptr)
     return 0;
 
-  // Get the address range
-  const VMRangeToFileOffset::Entry *address_range =
-      m_core_aranges.FindEntryThatContains(addr);
-  if (address_range == nullptr || address_range->GetRangeEnd() < addr) {
-    error = Status::FromErrorStringWithFormat(
-        "core file does not contain 0x%" PRIx64, addr);
-    return 0;
-  }
+  // Reads that cross load segment boundaries are common: the unwinder pulls
+  // whole spans of stack memory and those regularly straddle segments that
+  // are contiguous in the address space but separate in the core file. Loop
+  // through consecutive address ranges and satisfy as much of the request as
+  // the core file contains instead of returning short at the first boundary.
+  size_t bytes_copied = 0;
+  while (bytes_copied < size) {
+    const lldb::addr_t curr_addr = addr + bytes_copied;
+    // Get the address range
+    const VMRangeToFileOffset::Entry *address_range =
+        m_core_aranges.FindEntryThatContains(curr_addr);
+    if (address_range == nullptr || address_range->GetRangeEnd() < curr_addr) {
+      // Only report an error if nothing could be read at all.
+      if (bytes_copied == 0)
+        error = Status::FromErrorStringWithFormat(
+            "core file does not contain 0x%" PRIx64, curr_addr);
+      break;
+    }
 
-  // Convert the address into core file offset
-  const lldb::addr_t offset = addr - address_range->GetRangeBase();
-  const lldb::addr_t file_start = address_range->data.GetRangeBase();
-  const lldb::addr_t file_end = address_range->data.GetRangeEnd();
-  size_t bytes_to_read = size; // Number of bytes to read from the core file
-  size_t bytes_copied = 0;   // Number of bytes actually read from the core file
-  lldb::addr_t bytes_left =
-      0; // Number of bytes available in the core file from the given address
-
-  // Don't proceed if core file doesn't contain the actual data for this
-  // address range.
-  if (file_start == file_end)
-    return 0;
+    // Convert the address into core file offset
+    const lldb::addr_t offset = curr_addr - address_range->GetRangeBase();
+    const lldb::addr_t file_start = address_range->data.GetRangeBase();
+    const lldb::addr_t file_end = address_range->data.GetRangeEnd();
 
-  // Figure out how many on-disk bytes remain in this segment starting at the
-  // given offset
-  if (file_end > file_start + offset)
-    bytes_left = file_end - (file_start + offset);
+    // Number of on-disk bytes remaining in this segment starting at the
+    // given offset. Segments whose file size is smaller than their memory
+    // size have no data for the trailing part of the range.
+    lldb::addr_t bytes_left = 0;
+    if (file_end > file_start + offset)
+      bytes_left = file_end - (file_start + offset);
 
-  if (bytes_to_read > bytes_left)
-    bytes_to_read = bytes_left;
+    const size_t bytes_to_read =
+        std::min(size - bytes_copied, static_cast<size_t>(bytes_left));
 
-  // If there is data available on the core file read it
-  if (bytes_to_read)
-    bytes_copied =
-        core_objfile->CopyData(offset + file_start, bytes_to_read, buf);
+    // Don't proceed if core file doesn't contain the actual data for this
+    // address range.
+    if (bytes_to_read == 0)
+      break;
+
+    const size_t curr_bytes_read =
+        core_objfile->CopyData(offset + file_start, bytes_to_read,
+                               static_cast<char *>(buf) + bytes_copied);
+    if (curr_bytes_read == 0)
+      break;
+    bytes_copied += curr_bytes_read;
+  }
 
   return bytes_copied;
 }
@@ -194,6 +194,49 @@ GDBRemoteClientBase::SendPacketAndWaitForResponse(
   return SendPacketAndWaitForResponseNoLock(payload, response);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponses(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses,
+    std::chrono::seconds interrupt_timeout) {
+  responses.clear();
+  Lock lock(*this, interrupt_timeout);
+  if (!lock) {
+    if (Log *log = GetLog(GDBRLog::Process))
+      LLDB_LOGF(log,
+                "GDBRemoteClientBase::%s failed to get mutex, not sending "
+                "%zu packets",
+                __FUNCTION__, payloads.size());
+    return PacketResult::ErrorSendFailed;
+  }
+
+  responses.resize(payloads.size());
+
+  // While acks are still enabled each send waits for its '+' and each reply
+  // has to be acked in turn, so the packets cannot be safely interleaved.
+  if (GetSendAcks()) {
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      PacketResult packet_result =
+          SendPacketAndWaitForResponseNoLock(payloads[i], responses[i]);
+      if (packet_result != PacketResult::Success)
+        return packet_result;
+    }
+    return PacketResult::Success;
+  }
+
+  for (const std::string &payload : payloads) {
+    PacketResult packet_result = SendPacketNoLock(payload);
+    if (packet_result != PacketResult::Success)
+      return packet_result;
+  }
+  for (StringExtractorGDBRemote &response : responses) {
+    PacketResult packet_result = ReadPacket(response, GetPacketTimeout(), true);
+    if (packet_result != PacketResult::Success)
+      return packet_result;
+  }
+  return PacketResult::Success;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::ReadPacketWithOutputSupport(
     StringExtractorGDBRemote &response, Timeout<std::micro> timeout,
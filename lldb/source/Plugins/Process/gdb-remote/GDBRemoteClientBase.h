@@ -11,7 +11,10 @@
 
 #include "GDBRemoteCommunication.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include <condition_variable>
+#include <vector>
 
 namespace lldb_private {
 namespace process_gdb_remote {
@@ -58,6 +61,20 @@ public:
       llvm::StringRef payload, StringExtractorGDBRemote &response,
       std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
 
+  /// Send every packet in \a payloads before reading any reply, then read one
+  /// reply per packet in order. GDB remote replies carry no tags, but the
+  /// protocol guarantees replies arrive in request order, so pipelining
+  /// batches of independent requests pays the link round-trip once per batch
+  /// instead of once per packet. Requires no-ack mode to be in effect; while
+  /// acks are still enabled the packets are sent and answered one at a time.
+  /// \a responses is resized to match \a payloads; on failure the responses
+  /// collected so far remain valid and the first failing packet's result is
+  /// returned.
+  PacketResult SendPacketsAndWaitForResponses(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses,
+      std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
+
   PacketResult ReadPacketWithOutputSupport(
       StringExtractorGDBRemote &response, Timeout<std::micro> timeout,
       bool sync_on_timeout,
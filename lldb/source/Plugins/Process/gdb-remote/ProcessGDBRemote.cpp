@@ -2614,58 +2614,91 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   // M and m packets take 2 bytes for 1 byte of memory
   size_t max_memory_size =
       binary_memory_read ? m_max_memory_size : m_max_memory_size / 2;
-  if (size > max_memory_size) {
-    // Keep memory read sizes down to a sane limit. This function will be
-    // called multiple times in order to complete the task by
-    // lldb_private::Process so it is ok to do this.
-    size = max_memory_size;
+
+  // Reads larger than the packet limit are split into chunks whose requests
+  // are all sent before any reply is read. Memory read replies arrive in
+  // request order, so pipelining the chunks pays the link round-trip once per
+  // batch instead of once per chunk. Keep the number of outstanding requests
+  // to a sane limit; anything this batch doesn't cover is picked up by the
+  // caller's read loop.
+  const size_t max_chunks_in_flight = 128;
+  const size_t num_chunks = std::min(
+      (size + max_memory_size - 1) / max_memory_size, max_chunks_in_flight);
+
+  std::vector<std::string> payloads;
+  payloads.reserve(num_chunks);
+  size_t request_size = 0;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const size_t chunk_size = std::min(size - request_size, max_memory_size);
+    char packet[64];
+    int packet_len = ::snprintf(packet, sizeof(packet), "%c%" PRIx64 ",%" PRIx64,
+                                binary_memory_read ? 'x' : 'm',
+                                (uint64_t)(addr + request_size),
+                                (uint64_t)chunk_size);
+    assert(packet_len + 1 < (int)sizeof(packet));
+    UNUSED_IF_ASSERT_DISABLED(packet_len);
+    payloads.emplace_back(packet);
+    request_size += chunk_size;
   }
 
-  char packet[64];
-  int packet_len;
-  packet_len = ::snprintf(packet, sizeof(packet), "%c%" PRIx64 ",%" PRIx64,
-                          binary_memory_read ? 'x' : 'm', (uint64_t)addr,
-                          (uint64_t)size);
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
-  StringExtractorGDBRemote response;
-  if (m_gdb_comm.SendPacketAndWaitForResponse(packet, response,
-                                              GetInterruptTimeout()) ==
+  std::vector<StringExtractorGDBRemote> responses;
+  if (m_gdb_comm.SendPacketsAndWaitForResponses(payloads, responses,
+                                                GetInterruptTimeout()) !=
       GDBRemoteCommunication::PacketResult::Success) {
+    error = Status::FromErrorStringWithFormat("failed to send packet: '%s'",
+                                              payloads.front().c_str());
+    return 0;
+  }
+
+  size_t bytes_read = 0;
+  for (size_t i = 0; i < responses.size(); ++i) {
+    StringExtractorGDBRemote &response = responses[i];
+    const addr_t chunk_addr = addr + bytes_read;
+    const size_t chunk_size = std::min(size - bytes_read, max_memory_size);
+    uint8_t *chunk_buf = (uint8_t *)buf + bytes_read;
     if (response.IsNormalResponse()) {
       error.Clear();
+      size_t chunk_bytes_read;
       if (binary_memory_read) {
         // The lower level GDBRemoteCommunication packet receive layer has
         // already de-quoted any 0x7d character escaping that was present in
         // the packet
 
-        size_t data_received_size = response.GetBytesLeft();
-        if (data_received_size > size) {
+        chunk_bytes_read = response.GetBytesLeft();
+        if (chunk_bytes_read > chunk_size) {
           // Don't write past the end of BUF if the remote debug server gave us
           // too much data for some reason.
-          data_received_size = size;
+          chunk_bytes_read = chunk_size;
         }
-        memcpy(buf, response.GetStringRef().data(), data_received_size);
-        return data_received_size;
+        memcpy(chunk_buf, response.GetStringRef().data(), chunk_bytes_read);
       } else {
-        return response.GetHexBytes(
-            llvm::MutableArrayRef<uint8_t>((uint8_t *)buf, size), '\xdd');
+        chunk_bytes_read = response.GetHexBytes(
+            llvm::MutableArrayRef<uint8_t>(chunk_buf, chunk_size), '\xdd');
       }
-    } else if (response.IsErrorResponse())
+      bytes_read += chunk_bytes_read;
+      // A short chunk means the rest of the range isn't readable; report what
+      // we got and let the caller decide whether to retry beyond it.
+      if (chunk_bytes_read < chunk_size)
+        return bytes_read;
+      continue;
+    }
+    // A later chunk failing is just a short read from the caller's point of
+    // view; only report an error when nothing could be read at all.
+    if (bytes_read > 0)
+      return bytes_read;
+    if (response.IsErrorResponse())
       error = Status::FromErrorStringWithFormat(
-          "memory read failed for 0x%" PRIx64, addr);
+          "memory read failed for 0x%" PRIx64, chunk_addr);
     else if (response.IsUnsupportedResponse())
       error = Status::FromErrorStringWithFormat(
           "GDB server does not support reading memory");
     else
       error = Status::FromErrorStringWithFormat(
           "unexpected response to GDB server memory read packet '%s': '%s'",
-          packet, response.GetStringRef().data());
-  } else {
-    error = Status::FromErrorStringWithFormat("failed to send packet: '%s'",
-                                              packet);
+          payloads[i].c_str(), response.GetStringRef().data());
+    return 0;
   }
-  return 0;
+  return bytes_read;
 }
 
 bool ProcessGDBRemote::SupportsMemoryTagging() {
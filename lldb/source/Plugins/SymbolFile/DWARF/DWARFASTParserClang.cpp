@@ -2954,9 +2954,6 @@ void DWARFASTParserClang::ParseSingleMember(
     return;
   }
 
-  if (!member_clang_type.IsCompleteType())
-    member_clang_type.GetCompleteType();
-
   {
     // Older versions of clang emit the same DWARF for array[0] and array[1]. If
     // the current field is at the end of the structure, then there is
@@ -2990,7 +2987,14 @@ void DWARFASTParserClang::ParseSingleMember(
     }
   }
 
-  TypeSystemClang::RequireCompleteType(member_clang_type);
+  // Objective-C interfaces are not registered with the external layout
+  // source, so clang has to lay out their ivars unaided and the ivar types
+  // must be completed up front. For C++ records the layout comes from the
+  // DWARF via ClangASTImporter::LayoutRecordType, which completes the field
+  // types right before clang asks for their sizes, so members of types whose
+  // layout is never queried can stay as cheap forward declarations.
+  if (TypeSystemClang::IsObjCObjectOrInterfaceType(class_clang_type))
+    TypeSystemClang::RequireCompleteType(member_clang_type);
 
   clang::FieldDecl *field_decl = TypeSystemClang::AddFieldToRecordType(
       class_clang_type, attrs.name, member_clang_type, accessibility,
@@ -8,16 +8,19 @@
 
 #include "DWARFUnit.h"
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/DWARF/DWARFAddressRange.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugAbbrev.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugLoc.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugRangeList.h"
 #include "llvm/Object/Error.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugAranges.h"
@@ -221,60 +224,29 @@ DWARFUnit::ScopedExtractDIEs::operator=(DWARFUnit::ScopedExtractDIEs &&rhs) {
 
 // Parses a compile unit and indexes its DIEs, m_die_array_mutex must be
 // held R/W and m_die_array must be empty.
-void DWARFUnit::ExtractDIEsRWLocked() {
-  llvm::sys::ScopedWriter first_die_lock(m_first_die_mutex);
-
-  ElapsedTime elapsed(m_dwarf.GetDebugInfoParseTimeRef());
-  LLDB_SCOPED_TIMERF(
-      "%s",
-      llvm::formatv("{0:x16}: DWARFUnit::ExtractDIEsIfNeeded()", GetOffset())
-          .str()
-          .c_str());
-
-  // Set the offset to that of the first DIE and calculate the start of the
-  // next compilation unit header.
-  lldb::offset_t offset = GetFirstDIEOffset();
-  lldb::offset_t next_cu_offset = GetNextUnitOffset();
-
+// Extract the subtree of non-NULL DIEs rooted at *offset_ptr into \a dies,
+// consuming the subtree's terminating NULL entry. Parent and sibling indexes
+// are stored relative to the subtree with its root at local index 0, so the
+// resulting vector can be appended to a unit's DIE array at any position; the
+// root's own parent index is left for the caller to fix once the subtree's
+// final position is known. Returns false if a DIE failed to extract.
+static bool ExtractDIESubtree(const DWARFUnit &unit,
+                              const DWARFDataExtractor &data,
+                              lldb::offset_t *offset_ptr,
+                              lldb::offset_t end_offset,
+                              std::vector<DWARFDebugInfoEntry> &dies) {
   DWARFDebugInfoEntry die;
-
   uint32_t depth = 0;
-  // We are in our compile unit, parse starting at the offset we were told to
-  // parse
-  const DWARFDataExtractor &data = GetData();
   std::vector<uint32_t> die_index_stack;
   die_index_stack.reserve(32);
   die_index_stack.push_back(0);
   bool prev_die_had_children = false;
-  while (offset < next_cu_offset && die.Extract(data, *this, &offset)) {
+  while (*offset_ptr < end_offset && die.Extract(data, unit, offset_ptr)) {
     const bool null_die = die.IsNULL();
     if (depth == 0) {
-      assert(m_die_array.empty() && "Compile unit DIE already added");
-
-      // The average bytes per DIE entry has been seen to be around 14-20 so
-      // lets pre-reserve half of that since we are now stripping the NULL
-      // tags.
-
-      // Only reserve the memory if we are adding children of the main
-      // compile unit DIE. The compile unit DIE is always the first entry, so
-      // if our size is 1, then we are adding the first compile unit child
-      // DIE and should reserve the memory.
-      m_die_array.reserve(GetDebugInfoSize() / 24);
-      m_die_array.push_back(die);
-
-      if (!m_first_die)
-        AddUnitDIE(m_die_array.front());
-
-      // With -fsplit-dwarf-inlining, clang will emit non-empty skeleton compile
-      // units. We are not able to access these DIE *and* the dwo file
-      // simultaneously. We also don't need to do that as the dwo file will
-      // contain a superset of information. So, we don't even attempt to parse
-      // any remaining DIEs.
-      if (m_dwo) {
-        m_die_array.front().SetHasChildren(false);
-        break;
-      }
-
+      if (null_die)
+        return false;
+      dies.push_back(die);
     } else {
       if (null_die) {
         if (prev_die_had_children) {
@@ -282,18 +254,18 @@ void DWARFUnit::ExtractDIEsRWLocked() {
           // contains is a NULL tag. Since we are removing the NULL DIEs from
           // the list (saves up to 25% in C++ code), we need a way to let the
           // DIE know that it actually doesn't have children.
-          if (!m_die_array.empty())
-            m_die_array.back().SetHasChildren(false);
+          if (!dies.empty())
+            dies.back().SetHasChildren(false);
         }
       } else {
-        die.SetParentIndex(m_die_array.size() - die_index_stack[depth - 1]);
+        die.SetParentIndex(dies.size() - die_index_stack[depth - 1]);
 
         if (die_index_stack.back())
-          m_die_array[die_index_stack.back()].SetSiblingIndex(
-              m_die_array.size() - die_index_stack.back());
+          dies[die_index_stack.back()].SetSiblingIndex(
+              dies.size() - die_index_stack.back());
 
         // Only push the DIE if it isn't a NULL DIE
-        m_die_array.push_back(die);
+        dies.push_back(die);
       }
     }
 
@@ -306,7 +278,7 @@ void DWARFUnit::ExtractDIEsRWLocked() {
         --depth;
       prev_die_had_children = false;
     } else {
-      die_index_stack.back() = m_die_array.size() - 1;
+      die_index_stack.back() = dies.size() - 1;
       // Normal DIE
       const bool die_has_children = die.HasChildren();
       if (die_has_children) {
@@ -317,7 +289,136 @@ void DWARFUnit::ExtractDIEsRWLocked() {
     }
 
     if (depth == 0)
-      break; // We are done with this compile unit!
+      break; // We are done with this subtree!
+  }
+  return !dies.empty();
+}
+
+void DWARFUnit::ExtractDIEsRWLocked() {
+  llvm::sys::ScopedWriter first_die_lock(m_first_die_mutex);
+
+  ElapsedTime elapsed(m_dwarf.GetDebugInfoParseTimeRef());
+  LLDB_SCOPED_TIMERF(
+      "%s",
+      llvm::formatv("{0:x16}: DWARFUnit::ExtractDIEsIfNeeded()", GetOffset())
+          .str()
+          .c_str());
+
+  // Set the offset to that of the first DIE and calculate the start of the
+  // next compilation unit header.
+  lldb::offset_t offset = GetFirstDIEOffset();
+  lldb::offset_t next_cu_offset = GetNextUnitOffset();
+
+  const DWARFDataExtractor &data = GetData();
+  DWARFDebugInfoEntry unit_die;
+  if (offset < next_cu_offset && unit_die.Extract(data, *this, &offset) &&
+      !unit_die.IsNULL()) {
+    assert(m_die_array.empty() && "Compile unit DIE already added");
+
+    // The average bytes per DIE entry has been seen to be around 14-20 so
+    // lets pre-reserve half of that since we are now stripping the NULL
+    // tags.
+    m_die_array.reserve(GetDebugInfoSize() / 24);
+    m_die_array.push_back(unit_die);
+
+    if (!m_first_die)
+      AddUnitDIE(m_die_array.front());
+
+    // With -fsplit-dwarf-inlining, clang will emit non-empty skeleton compile
+    // units. We are not able to access these DIE *and* the dwo file
+    // simultaneously. We also don't need to do that as the dwo file will
+    // contain a superset of information. So, we don't even attempt to parse
+    // any remaining DIEs.
+    if (m_dwo) {
+      m_die_array.front().SetHasChildren(false);
+    } else if (unit_die.HasChildren()) {
+      // Partition the unit's children into one subtree per top-level DIE.
+      // Subtrees whose extent is announced by DW_AT_sibling can be extracted
+      // in parallel; the rest are extracted inline since finding their end
+      // means walking them anyway. Within a subtree all parent and sibling
+      // indexes are relative, so the extracted pieces concatenate without
+      // rewriting; only each top-level DIE's link to the unit DIE and to its
+      // next sibling need fixing up during the merge.
+      struct Subtree {
+        lldb::offset_t start;
+        lldb::offset_t end;
+        bool deferred = false;
+        bool failed = false;
+        std::vector<DWARFDebugInfoEntry> dies;
+      };
+      std::vector<Subtree> subtrees;
+      bool has_deferred_subtrees = false;
+      while (offset < next_cu_offset) {
+        Subtree subtree;
+        subtree.start = offset;
+        DWARFDebugInfoEntry child_die;
+        lldb::offset_t peek_offset = offset;
+        if (!child_die.Extract(data, *this, &peek_offset))
+          break;
+        if (child_die.IsNULL()) {
+          // The unit DIE's children are all NULL tags; it really has none.
+          if (subtrees.empty())
+            m_die_array.front().SetHasChildren(false);
+          break;
+        }
+        if (child_die.HasChildren()) {
+          DWARFFormValue form_value;
+          lldb::offset_t sibling_offset = DW_INVALID_OFFSET;
+          if (child_die.GetAttributeValue(this, DW_AT_sibling, form_value))
+            sibling_offset = form_value.Reference(GetOffset());
+          if (sibling_offset != DW_INVALID_OFFSET &&
+              sibling_offset > peek_offset &&
+              sibling_offset <= next_cu_offset) {
+            subtree.end = sibling_offset;
+            subtree.deferred = true;
+            has_deferred_subtrees = true;
+            offset = sibling_offset;
+            subtrees.push_back(std::move(subtree));
+            continue;
+          }
+        }
+        subtree.end = next_cu_offset;
+        subtree.failed =
+            !ExtractDIESubtree(*this, data, &offset, next_cu_offset,
+                               subtree.dies);
+        const bool failed = subtree.failed;
+        subtrees.push_back(std::move(subtree));
+        if (failed)
+          break;
+      }
+
+      if (has_deferred_subtrees) {
+        llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+        for (Subtree &subtree : subtrees) {
+          if (!subtree.deferred)
+            continue;
+          task_group.async([this, &data, &subtree]() {
+            lldb::offset_t subtree_offset = subtree.start;
+            subtree.failed = !ExtractDIESubtree(*this, data, &subtree_offset,
+                                                subtree.end, subtree.dies);
+          });
+        }
+        task_group.wait();
+      }
+
+      // Concatenate the subtrees in stream order. Matching the serial
+      // algorithm, extraction stops at the first malformed subtree.
+      size_t prev_top_level_index = 0;
+      for (Subtree &subtree : subtrees) {
+        if (subtree.failed && subtree.dies.empty())
+          break;
+        const size_t top_level_index = m_die_array.size();
+        if (prev_top_level_index)
+          m_die_array[prev_top_level_index].SetSiblingIndex(
+              top_level_index - prev_top_level_index);
+        llvm::append_range(m_die_array, subtree.dies);
+        // The subtree root's parent is the unit DIE at index 0.
+        m_die_array[top_level_index].SetParentIndex(top_level_index);
+        prev_top_level_index = top_level_index;
+        if (subtree.failed)
+          break;
+      }
+    }
   }
 
   if (!m_die_array.empty()) {
@@ -8,6 +8,7 @@
 
 #include "Plugins/SymbolFile/DWARF/ManualDWARFIndex.h"
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
+#include "Plugins/SymbolFile/DWARF/DWARFContext.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
@@ -21,6 +22,7 @@
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/ThreadPool.h"
 #include <atomic>
@@ -72,6 +74,23 @@ void ManualDWARFIndex::Index() {
   if (units_to_index.empty())
     return;
 
+  // The scan below touches nearly all of the debug info, which normally lives
+  // in a single memory mapped file and would otherwise be paged in by random
+  // faults from the worker threads. Hint that the backing pages are about to
+  // be needed so the kernel can read them ahead sequentially. Buffers whose
+  // bytes are already resident (heap copies of compressed sections, for
+  // example) ignore the hint.
+  if (const DataBufferSP &data_sp = m_dwarf->GetDWARFContext()
+                                        .getOrLoadDebugInfoData()
+                                        .GetSharedDataBuffer())
+    data_sp->AdviseWillNeed();
+  if (dwp_dwarf) {
+    if (const DataBufferSP &data_sp = dwp_dwarf->GetDWARFContext()
+                                          .getOrLoadDebugInfoData()
+                                          .GetSharedDataBuffer())
+      data_sp->AdviseWillNeed();
+  }
+
   StreamString module_desc;
   m_module.GetDescription(module_desc.AsRawOstream(),
                           lldb::eDescriptionLevelBrief);
@@ -573,10 +592,14 @@ enum DataID {
 
 // Version 2 changes the encoding of DIERef objects used in the DWARF manual
 // index name tables. See DIERef class for details.
-constexpr uint32_t CURRENT_CACHE_VERSION = 2;
+//
+// Version 3 prefixes each name table with its encoded byte size, which allows
+// the tables to be located up front and decoded in parallel.
+constexpr uint32_t CURRENT_CACHE_VERSION = 3;
 
 bool ManualDWARFIndex::IndexSet::Decode(const DataExtractor &data,
-                                        lldb::offset_t *offset_ptr) {
+                                        lldb::offset_t *offset_ptr,
+                                        llvm::ThreadPoolTaskGroup *task_group) {
   StringTableReader strtab;
   // We now decode the string table for all strings in the data cache file.
   if (!strtab.Decode(data, offset_ptr))
@@ -589,53 +612,66 @@ bool ManualDWARFIndex::IndexSet::Decode(const DataExtractor &data,
   if (version != CURRENT_CACHE_VERSION)
     return false;
 
+  // Find the extents of each name table first. Each table is preceded by its
+  // encoded byte size, so we can skip over it without decoding it and then
+  // decode all tables in parallel when we have a task group to run them on.
+  llvm::SmallVector<std::pair<NameToDIE *, lldb::offset_t>, 8> tables;
   bool done = false;
   while (!done) {
+    NameToDIE *table = nullptr;
     switch (data.GetU8(offset_ptr)) {
     default:
       // If we got here, this is not expected, we expect the data IDs to match
       // one of the values from the DataID enumeration.
       return false;
     case kDataIDFunctionBasenames:
-      if (!function_basenames.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &function_basenames;
       break;
     case kDataIDFunctionFullnames:
-      if (!function_fullnames.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &function_fullnames;
       break;
     case kDataIDFunctionMethods:
-      if (!function_methods.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &function_methods;
       break;
     case kDataIDFunctionSelectors:
-      if (!function_selectors.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &function_selectors;
       break;
     case kDataIDFunctionObjcClassSelectors:
-      if (!objc_class_selectors.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &objc_class_selectors;
       break;
     case kDataIDGlobals:
-      if (!globals.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &globals;
       break;
     case kDataIDTypes:
-      if (!types.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &types;
       break;
     case kDataIDNamespaces:
-      if (!namespaces.Decode(data, offset_ptr, strtab))
-        return false;
+      table = &namespaces;
       break;
     case kDataIDEnd:
       // We got to the end of our NameToDIE encodings.
       done = true;
-      break;
+      continue;
     }
+    const uint32_t table_size = data.GetU32(offset_ptr);
+    tables.emplace_back(table, *offset_ptr);
+    *offset_ptr += table_size;
   }
-  // Success!
-  return true;
+
+  std::atomic<bool> failed(false);
+  auto decode_table = [&](NameToDIE *table, lldb::offset_t offset) {
+    if (!table->Decode(data, &offset, strtab))
+      failed = true;
+  };
+  if (task_group) {
+    for (const auto &table : tables)
+      task_group->async(decode_table, table.first, table.second);
+    task_group->wait();
+  } else {
+    for (const auto &table : tables)
+      decode_table(table.first, table.second);
+  }
+  return !failed;
 }
 
 void ManualDWARFIndex::IndexSet::Encode(DataEncoder &encoder) const {
@@ -651,38 +687,26 @@ void ManualDWARFIndex::IndexSet::Encode(DataEncoder &encoder) const {
   // Encode the data version.
   index_encoder.AppendU32(CURRENT_CACHE_VERSION);
 
-  if (!function_basenames.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDFunctionBasenames);
-    function_basenames.Encode(index_encoder, strtab);
-  }
-  if (!function_fullnames.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDFunctionFullnames);
-    function_fullnames.Encode(index_encoder, strtab);
-  }
-  if (!function_methods.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDFunctionMethods);
-    function_methods.Encode(index_encoder, strtab);
-  }
-  if (!function_selectors.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDFunctionSelectors);
-    function_selectors.Encode(index_encoder, strtab);
-  }
-  if (!objc_class_selectors.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDFunctionObjcClassSelectors);
-    objc_class_selectors.Encode(index_encoder, strtab);
-  }
-  if (!globals.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDGlobals);
-    globals.Encode(index_encoder, strtab);
-  }
-  if (!types.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDTypes);
-    types.Encode(index_encoder, strtab);
-  }
-  if (!namespaces.IsEmpty()) {
-    index_encoder.AppendU8(kDataIDNamespaces);
-    namespaces.Encode(index_encoder, strtab);
-  }
+  // Each name table is written with its encoded byte size so that Decode()
+  // can find the extents of all tables up front and decode them in parallel.
+  auto encode_table = [&](const NameToDIE &table, uint8_t data_id) {
+    if (table.IsEmpty())
+      return;
+    index_encoder.AppendU8(data_id);
+    const uint32_t size_offset = index_encoder.GetByteSize();
+    index_encoder.AppendU32(0); // Placeholder for the table byte size.
+    table.Encode(index_encoder, strtab);
+    index_encoder.PutU32(size_offset,
+                         index_encoder.GetByteSize() - size_offset - 4);
+  };
+  encode_table(function_basenames, kDataIDFunctionBasenames);
+  encode_table(function_fullnames, kDataIDFunctionFullnames);
+  encode_table(function_methods, kDataIDFunctionMethods);
+  encode_table(function_selectors, kDataIDFunctionSelectors);
+  encode_table(objc_class_selectors, kDataIDFunctionObjcClassSelectors);
+  encode_table(globals, kDataIDGlobals);
+  encode_table(types, kDataIDTypes);
+  encode_table(namespaces, kDataIDNamespaces);
   index_encoder.AppendU8(kDataIDEnd);
 
   // Now that all strings have been gathered, we will emit the string table.
@@ -703,7 +727,8 @@ bool ManualDWARFIndex::Decode(const DataExtractor &data,
     return false;
   }
   IndexSet set;
-  if (!set.Decode(data, offset_ptr))
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  if (!set.Decode(data, offset_ptr, &task_group))
     return false;
   m_set = std::move(set);
   return true;
@@ -13,6 +13,10 @@
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "llvm/ADT/DenseSet.h"
 
+namespace llvm {
+class ThreadPoolTaskGroup;
+}
+
 namespace lldb_private::plugin {
 namespace dwarf {
 class DWARFDebugInfo;
@@ -68,7 +72,13 @@ public:
     NameToDIE globals;
     NameToDIE types;
     NameToDIE namespaces;
-    bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr);
+    /// Decode the index set from \a data. Each name table is stored with its
+    /// encoded byte size, so when \a task_group is non-null the tables are
+    /// decoded and sorted in parallel on it. Decoding the name tables
+    /// dominates cache load time for large binaries, and each table is
+    /// independent of the others.
+    bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                llvm::ThreadPoolTaskGroup *task_group = nullptr);
     void Encode(DataEncoder &encoder) const;
     bool operator==(const IndexSet &rhs) const {
       return function_basenames == rhs.function_basenames &&
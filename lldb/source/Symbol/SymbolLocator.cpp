@@ -9,6 +9,7 @@
 #include "lldb/Symbol/SymbolLocator.h"
 
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Host/Host.h"
 
@@ -55,3 +56,22 @@ void SymbolLocator::DownloadSymbolFileAsync(const UUID &uuid) {
     break;
   };
 }
+
+void SymbolLocator::DownloadSymbolFilesAsync(const ModuleList &module_list) {
+  // Bail out early so we don't pay for iterating the module list when symbol
+  // auto download is disabled.
+  if (ModuleList::GetGlobalModuleListProperties().GetSymbolAutoDownload() ==
+      eSymbolDownloadOff)
+    return;
+
+  const size_t num_modules = module_list.GetSize();
+  for (size_t idx = 0; idx < num_modules; ++idx) {
+    ModuleSP module_sp = module_list.GetModuleAtIndex(idx);
+    if (!module_sp || module_sp->GetSymbolFileFileSpec())
+      continue;
+    const UUID &uuid = module_sp->GetUUID();
+    if (!uuid.IsValid())
+      continue;
+    DownloadSymbolFileAsync(uuid);
+  }
+}
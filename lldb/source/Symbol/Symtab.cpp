@@ -10,6 +10,7 @@
 #include <set>
 
 #include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/Section.h"
@@ -27,6 +28,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DJB.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -303,82 +305,53 @@ void Symtab::InitNameIndexes() {
     const size_t num_symbols = m_symbols.size();
     name_to_index.Reserve(num_symbols);
 
+    // Demangling each symbol dominates this pass and every symbol is
+    // independent of the others, so carve the symbol table into contiguous
+    // slices, build per-slice name maps on the Debugger thread pool, and
+    // merge the slices in order afterwards. Merging in slice order keeps the
+    // entries in the same symbol-index order a serial scan would produce.
+    // Methods whose declaration context isn't known within a slice end up in
+    // that slice's backlog; the backlogs are replayed against the merged
+    // class context set below, which matches the serial algorithm since it
+    // also replayed its backlog only after scanning every symbol.
+    const size_t num_threads = Debugger::GetThreadPool().getMaxConcurrency();
+    // Keep slices reasonably large so small symbol tables don't pay the task
+    // dispatch overhead many times.
+    const size_t num_slices = std::max<size_t>(
+        1, std::min(num_threads, num_symbols / 4096 + 1));
+    const size_t slice_size = (num_symbols + num_slices - 1) / num_slices;
+    std::vector<NameIndexes> slices(num_slices);
+    llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+    for (size_t i = 0; i < num_slices; ++i) {
+      task_group.async([this, &languages, &slices, i, slice_size,
+                        num_symbols]() {
+        // Instantiation of the demangler is expensive, so better use a single
+        // one for all entries during batch processing.
+        RichManglingContext rmc;
+        const size_t end = std::min(num_symbols, (i + 1) * slice_size);
+        for (size_t value = i * slice_size; value < end; ++value)
+          RegisterSymbolNameEntries(value, languages, rmc, slices[i]);
+      });
+    }
+    task_group.wait();
+
     // The "const char *" in "class_contexts" and backlog::value_type::second
     // must come from a ConstString::GetCString()
     std::set<const char *> class_contexts;
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
-    backlog.reserve(num_symbols / 2);
-
-    // Instantiation of the demangler is expensive, so better use a single one
-    // for all entries during batch processing.
-    RichManglingContext rmc;
-    for (uint32_t value = 0; value < num_symbols; ++value) {
-      Symbol *symbol = &m_symbols[value];
-
-      // Don't let trampolines get into the lookup by name map If we ever need
-      // the trampoline symbols to be searchable by name we can remove this and
-      // then possibly add a new bool to any of the Symtab functions that
-      // lookup symbols by name to indicate if they want trampolines. We also
-      // don't want any synthetic symbols with auto generated names in the
-      // name lookups.
-      if (symbol->IsTrampoline() || symbol->IsSyntheticWithAutoGeneratedName())
-        continue;
-
-      // If the symbol's name string matched a Mangled::ManglingScheme, it is
-      // stored in the mangled field.
-      Mangled &mangled = symbol->GetMangled();
-      if (ConstString name = mangled.GetMangledName()) {
-        name_to_index.Append(name, value);
-
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          ConstString stripped = ConstString(
-              m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
-          name_to_index.Append(stripped, value);
-        }
-
-        const SymbolType type = symbol->GetType();
-        if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
-          if (mangled.GetRichManglingInfo(rmc, lldb_skip_name)) {
-            RegisterMangledNameEntry(value, class_contexts, backlog, rmc);
-            continue;
-          }
-        }
-      }
-
-      // Symbol name strings that didn't match a Mangled::ManglingScheme, are
-      // stored in the demangled field.
-      if (ConstString name = mangled.GetDemangledName()) {
-        name_to_index.Append(name, value);
-
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          name = ConstString(
-              m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
-          name_to_index.Append(name, value);
-        }
-
-        // If the demangled name turns out to be an ObjC name, and is a category
-        // name, add the version without categories to the index too.
-        for (Language *lang : languages) {
-          for (auto variant : lang->GetMethodNameVariants(name)) {
-            if (variant.GetType() & lldb::eFunctionNameTypeSelector)
-              selector_to_index.Append(variant.GetName(), value);
-            else if (variant.GetType() & lldb::eFunctionNameTypeFull)
-              name_to_index.Append(variant.GetName(), value);
-            else if (variant.GetType() & lldb::eFunctionNameTypeMethod)
-              method_to_index.Append(variant.GetName(), value);
-            else if (variant.GetType() & lldb::eFunctionNameTypeBase)
-              basename_to_index.Append(variant.GetName(), value);
-          }
-        }
-      }
-    }
-
-    for (const auto &record : backlog) {
-      RegisterBacklogEntry(record.first, record.second, class_contexts);
+    for (const NameIndexes &slice : slices)
+      class_contexts.insert(slice.class_contexts.begin(),
+                            slice.class_contexts.end());
+    for (NameIndexes &slice : slices) {
+      for (const auto &entry : slice.name_to_index)
+        name_to_index.Append(entry);
+      for (const auto &entry : slice.basename_to_index)
+        basename_to_index.Append(entry);
+      for (const auto &entry : slice.method_to_index)
+        method_to_index.Append(entry);
+      for (const auto &entry : slice.selector_to_index)
+        selector_to_index.Append(entry);
+      for (const auto &record : slice.backlog)
+        RegisterBacklogEntry(record.first, record.second, class_contexts);
     }
 
     name_to_index.Sort();
@@ -392,10 +365,75 @@ void Symtab::InitNameIndexes() {
   }
 }
 
-void Symtab::RegisterMangledNameEntry(
-    uint32_t value, std::set<const char *> &class_contexts,
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-    RichManglingContext &rmc) {
+void Symtab::RegisterSymbolNameEntries(
+    uint32_t value, const std::vector<Language *> &languages,
+    RichManglingContext &rmc, NameIndexes &indexes) {
+  Symbol *symbol = &m_symbols[value];
+
+  // Don't let trampolines get into the lookup by name map If we ever need
+  // the trampoline symbols to be searchable by name we can remove this and
+  // then possibly add a new bool to any of the Symtab functions that
+  // lookup symbols by name to indicate if they want trampolines. We also
+  // don't want any synthetic symbols with auto generated names in the
+  // name lookups.
+  if (symbol->IsTrampoline() || symbol->IsSyntheticWithAutoGeneratedName())
+    return;
+
+  // If the symbol's name string matched a Mangled::ManglingScheme, it is
+  // stored in the mangled field.
+  Mangled &mangled = symbol->GetMangled();
+  if (ConstString name = mangled.GetMangledName()) {
+    indexes.name_to_index.Append(name, value);
+
+    if (symbol->ContainsLinkerAnnotations()) {
+      // If the symbol has linker annotations, also add the version without
+      // the annotations.
+      ConstString stripped = ConstString(
+          m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
+      indexes.name_to_index.Append(stripped, value);
+    }
+
+    const SymbolType type = symbol->GetType();
+    if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
+      if (mangled.GetRichManglingInfo(rmc, lldb_skip_name)) {
+        RegisterMangledNameEntry(value, indexes, rmc);
+        return;
+      }
+    }
+  }
+
+  // Symbol name strings that didn't match a Mangled::ManglingScheme, are
+  // stored in the demangled field.
+  if (ConstString name = mangled.GetDemangledName()) {
+    indexes.name_to_index.Append(name, value);
+
+    if (symbol->ContainsLinkerAnnotations()) {
+      // If the symbol has linker annotations, also add the version without
+      // the annotations.
+      name = ConstString(
+          m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
+      indexes.name_to_index.Append(name, value);
+    }
+
+    // If the demangled name turns out to be an ObjC name, and is a category
+    // name, add the version without categories to the index too.
+    for (Language *lang : languages) {
+      for (auto variant : lang->GetMethodNameVariants(name)) {
+        if (variant.GetType() & lldb::eFunctionNameTypeSelector)
+          indexes.selector_to_index.Append(variant.GetName(), value);
+        else if (variant.GetType() & lldb::eFunctionNameTypeFull)
+          indexes.name_to_index.Append(variant.GetName(), value);
+        else if (variant.GetType() & lldb::eFunctionNameTypeMethod)
+          indexes.method_to_index.Append(variant.GetName(), value);
+        else if (variant.GetType() & lldb::eFunctionNameTypeBase)
+          indexes.basename_to_index.Append(variant.GetName(), value);
+      }
+    }
+  }
+}
+
+void Symtab::RegisterMangledNameEntry(uint32_t value, NameIndexes &indexes,
+                                      RichManglingContext &rmc) {
   // Only register functions that have a base name.
   llvm::StringRef base_name = rmc.ParseFunctionBaseName();
   if (base_name.empty())
@@ -408,41 +446,39 @@ void Symtab::RegisterMangledNameEntry(
   // Register functions with no context.
   if (decl_context.empty()) {
     // This has to be a basename
-    auto &basename_to_index =
-        GetNameToSymbolIndexMap(lldb::eFunctionNameTypeBase);
-    basename_to_index.Append(entry);
+    indexes.basename_to_index.Append(entry);
     // If there is no context (no namespaces or class scopes that come before
     // the function name) then this also could be a fullname.
-    auto &name_to_index = GetNameToSymbolIndexMap(lldb::eFunctionNameTypeNone);
-    name_to_index.Append(entry);
+    indexes.name_to_index.Append(entry);
     return;
   }
 
   // Make sure we have a pool-string pointer and see if we already know the
   // context name.
   const char *decl_context_ccstr = ConstString(decl_context).GetCString();
-  auto it = class_contexts.find(decl_context_ccstr);
+  auto it = indexes.class_contexts.find(decl_context_ccstr);
 
-  auto &method_to_index =
-      GetNameToSymbolIndexMap(lldb::eFunctionNameTypeMethod);
   // Register constructors and destructors. They are methods and create
   // declaration contexts.
   if (rmc.IsCtorOrDtor()) {
-    method_to_index.Append(entry);
-    if (it == class_contexts.end())
-      class_contexts.insert(it, decl_context_ccstr);
+    indexes.method_to_index.Append(entry);
+    if (it == indexes.class_contexts.end())
+      indexes.class_contexts.insert(it, decl_context_ccstr);
     return;
   }
 
-  // Register regular methods with a known declaration context.
-  if (it != class_contexts.end()) {
-    method_to_index.Append(entry);
+  // Register regular methods with a known declaration context. The slice's
+  // context set only covers contexts discovered so far in this slice; methods
+  // that miss here go to the backlog and are resolved against the merged
+  // context set, which yields the same entries either way.
+  if (it != indexes.class_contexts.end()) {
+    indexes.method_to_index.Append(entry);
     return;
   }
 
   // Regular methods in unknown declaration contexts are put to the backlog. We
   // will revisit them once we processed all remaining symbols.
-  backlog.push_back(std::make_pair(entry, decl_context_ccstr));
+  indexes.backlog.push_back(std::make_pair(entry, decl_context_ccstr));
 }
 
 void Symtab::RegisterBacklogEntry(
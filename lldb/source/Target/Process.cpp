@@ -39,6 +39,7 @@
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolLocator.h"
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/AssertFrameRecognizer.h"
 #include "lldb/Target/DynamicLoader.h"
@@ -6043,6 +6044,12 @@ void Process::ModulesDidLoad(ModuleList &module_list) {
     if (pair.second)
       pair.second->ModulesDidLoad(*this, module_list);
   }
+
+  // Kick off background symbol file downloads for the new modules now instead
+  // of waiting for each module to be touched one at a time. When the symbol
+  // locator has to go over the network (e.g. debuginfod), this overlaps the
+  // downloads for the whole batch.
+  SymbolLocator::DownloadSymbolFilesAsync(module_list);
 }
 
 void Process::PrintWarningOptimization(const SymbolContext &sc) {
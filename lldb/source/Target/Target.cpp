@@ -2673,6 +2673,30 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP Target::TakeCachedUserExpression(llvm::StringRef key) {
+  std::lock_guard<std::mutex> guard(m_cached_user_expressions_mutex);
+  auto pos = m_cached_user_expressions.find(key);
+  if (pos == m_cached_user_expressions.end())
+    return lldb::UserExpressionSP();
+  lldb::UserExpressionSP user_expression_sp = std::move(pos->second);
+  m_cached_user_expressions.erase(pos);
+  return user_expression_sp;
+}
+
+void Target::CacheUserExpression(llvm::StringRef key,
+                                 lldb::UserExpressionSP user_expression_sp) {
+  if (!user_expression_sp)
+    return;
+  std::lock_guard<std::mutex> guard(m_cached_user_expressions_mutex);
+  // Keep the cache small; evicting an arbitrary entry is fine since a miss
+  // only costs a re-parse.
+  const size_t max_cached_user_expressions = 32;
+  if (m_cached_user_expressions.size() >= max_cached_user_expressions &&
+      !m_cached_user_expressions.contains(key))
+    m_cached_user_expressions.erase(m_cached_user_expressions.begin());
+  m_cached_user_expressions[key] = std::move(user_expression_sp);
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
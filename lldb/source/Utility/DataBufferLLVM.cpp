@@ -30,6 +30,8 @@ lldb::offset_t DataBufferLLVM::GetByteSize() const {
   return Buffer->getBufferSize();
 }
 
+void DataBufferLLVM::AdviseWillNeed() { Buffer->willNeedIfMmap(); }
+
 WritableDataBufferLLVM::WritableDataBufferLLVM(
     std::unique_ptr<llvm::WritableMemoryBuffer> MemBuffer)
     : Buffer(std::move(MemBuffer)) {
@@ -11,6 +11,7 @@
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/TestUtilities.h"
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Mangled.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
@@ -25,6 +26,8 @@
 
 #include "gtest/gtest.h"
 
+#include <mutex>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -130,6 +133,10 @@ TEST(MangledTest, BoolConversionOperator) {
 TEST(MangledTest, NameIndexes_FindFunctionSymbols) {
   SubsystemRAII<FileSystem, HostInfo, ObjectFileELF, SymbolFileSymtab>
       subsystems;
+  // Building the symtab name indexes uses the Debugger's thread pool.
+  static std::once_flag debugger_initialize_flag;
+  std::call_once(debugger_initialize_flag,
+                 []() { Debugger::Initialize(nullptr); });
 
   auto ExpectedFile = TestFile::fromYaml(R"(
 --- !ELF
@@ -11,6 +11,7 @@
 #include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/Section.h"
@@ -25,12 +26,22 @@
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
+#include <mutex>
+
 using namespace lldb_private;
 using namespace lldb;
 
+static std::once_flag debugger_initialize_flag;
+
 class ObjectFileELFTest : public testing::Test {
   SubsystemRAII<FileSystem, HostInfo, ObjectFileELF, SymbolFileSymtab>
       subsystems;
+
+  void SetUp() override {
+    // Building the symtab name indexes uses the Debugger's thread pool.
+    std::call_once(debugger_initialize_flag,
+                   []() { Debugger::Initialize(nullptr); });
+  }
 };
 
 TEST_F(ObjectFileELFTest, SectionsResolveConsistently) {
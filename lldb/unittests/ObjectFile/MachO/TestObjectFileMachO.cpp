@@ -10,11 +10,14 @@
 #include "Plugins/ObjectFile/Mach-O/ObjectFileMachO.h"
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/lldb-defines.h"
 #include "gtest/gtest.h"
 
+#include <mutex>
+
 #ifdef __APPLE__
 #include <dlfcn.h>
 #endif
@@ -23,8 +26,16 @@ using namespace lldb_private;
 using namespace llvm;
 
 namespace {
+static std::once_flag debugger_initialize_flag;
+
 class ObjectFileMachOTest : public ::testing::Test {
   SubsystemRAII<FileSystem, HostInfo, ObjectFileMachO> subsystems;
+
+  void SetUp() override {
+    // Building the symtab name indexes uses the Debugger's thread pool.
+    std::call_once(debugger_initialize_flag,
+                   []() { Debugger::Initialize(nullptr); });
+  }
 };
 } // namespace
 
@@ -13,6 +13,7 @@
 #include "TestingSupport/TestUtilities.h"
 
 #include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
@@ -22,6 +23,7 @@
 #include "lldb/Utility/DataExtractor.h"
 
 #include <memory>
+#include <mutex>
 
 #include "gtest/gtest.h"
 
@@ -29,10 +31,18 @@ using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::plugin::dwarf;
 
+static std::once_flag debugger_initialize_flag;
+
 class SymtabTest : public testing::Test {
   SubsystemRAII<FileSystem, HostInfo, ObjectFileMachO, SymbolFileDWARF,
                 TypeSystemClang>
       subsystem;
+
+  void SetUp() override {
+    // Building the symtab name indexes uses the Debugger's thread pool.
+    std::call_once(debugger_initialize_flag,
+                   []() { Debugger::Initialize(nullptr); });
+  }
 };
 
 static void EncodeDecode(const Symtab &object, ByteOrder byte_order) {
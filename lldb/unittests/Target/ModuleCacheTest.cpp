@@ -8,6 +8,7 @@
 #include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
@@ -15,11 +16,15 @@
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/ModuleCache.h"
 
+#include <mutex>
+
 using namespace lldb_private;
 using namespace lldb;
 
 namespace {
 
+static std::once_flag debugger_initialize_flag;
+
 class ModuleCacheTest : public testing::Test {
   SubsystemRAII<FileSystem, HostInfo, ObjectFileELF, SymbolFileSymtab>
       subsystems;
@@ -65,6 +70,9 @@ static FileSpec GetSysrootView(FileSpec spec, const char *hostname) {
 }
 
 void ModuleCacheTest::SetUp() {
+  // Building the symtab name indexes uses the Debugger's thread pool.
+  std::call_once(debugger_initialize_flag,
+                 []() { Debugger::Initialize(nullptr); });
   s_cache_dir = HostInfo::GetProcessTempDir();
   s_test_executable = GetInputFilePath(module_name);
 }
@@ -85,6 +85,11 @@ public:
   /// Bits in a word.
   static constexpr unsigned APINT_BITS_PER_WORD = APINT_WORD_SIZE * CHAR_BIT;
 
+  /// Number of words stored inline, without a heap allocation. 128-bit
+  /// values are common (checked arithmetic lowering, _BitInt) and hot enough
+  /// in the middle end that they are worth the extra inline word.
+  static constexpr unsigned APINT_WORDS_INLINE = 2;
+
   enum class Rounding {
     DOWN,
     TOWARD_ZERO,
@@ -174,8 +179,8 @@ public:
 
   /// Copy Constructor.
   APInt(const APInt &that) : BitWidth(that.BitWidth) {
-    if (isSingleWord())
-      U.VAL = that.U.VAL;
+    if (isInlineStorage())
+      memcpy(&U, &that.U, sizeof(U));
     else
       initSlowCase(that);
   }
@@ -569,7 +574,7 @@ public:
   const uint64_t *getRawData() const {
     if (isSingleWord())
       return &U.VAL;
-    return &U.pVal[0];
+    return &wordsPtr()[0];
   }
 
   /// @}
@@ -616,10 +621,10 @@ public:
   ///
   /// \returns *this after assignment of RHS.
   APInt &operator=(const APInt &RHS) {
-    // The common case (both source or dest being inline) doesn't require
+    // The common case (both source and dest being inline) doesn't require
     // allocation or deallocation.
-    if (isSingleWord() && RHS.isSingleWord()) {
-      U.VAL = RHS.U.VAL;
+    if (isInlineStorage() && RHS.isInlineStorage()) {
+      memcpy(&U, &RHS.U, sizeof(U));
       BitWidth = RHS.BitWidth;
       return *this;
     }
@@ -636,7 +641,7 @@ public:
       return *this;
 #endif
     assert(this != &that && "Self-move not supported");
-    if (!isSingleWord())
+    if (needsCleanup())
       delete[] U.pVal;
 
     // Use memcpy so that type based alias analysis sees both VAL and pVal
@@ -660,8 +665,8 @@ public:
       U.VAL = RHS;
       return clearUnusedBits();
     }
-    U.pVal[0] = RHS;
-    memset(U.pVal + 1, 0, (getNumWords() - 1) * APINT_WORD_SIZE);
+    wordsPtr()[0] = RHS;
+    memset(wordsPtr() + 1, 0, (getNumWords() - 1) * APINT_WORD_SIZE);
     return *this;
   }
 
@@ -690,8 +695,8 @@ public:
       U.VAL &= RHS;
       return *this;
     }
-    U.pVal[0] &= RHS;
-    memset(U.pVal + 1, 0, (getNumWords() - 1) * APINT_WORD_SIZE);
+    wordsPtr()[0] &= RHS;
+    memset(wordsPtr() + 1, 0, (getNumWords() - 1) * APINT_WORD_SIZE);
     return *this;
   }
 
@@ -720,7 +725,7 @@ public:
       U.VAL |= RHS;
       return clearUnusedBits();
     }
-    U.pVal[0] |= RHS;
+    wordsPtr()[0] |= RHS;
     return *this;
   }
 
@@ -749,7 +754,7 @@ public:
       U.VAL ^= RHS;
       return clearUnusedBits();
     }
-    U.pVal[0] ^= RHS;
+    wordsPtr()[0] ^= RHS;
     return *this;
   }
 
@@ -1321,7 +1326,7 @@ public:
       U.VAL = WORDTYPE_MAX;
     else
       // Set all the bits in all the words.
-      memset(U.pVal, -1, getNumWords() * APINT_WORD_SIZE);
+      memset(wordsPtr(), -1, getNumWords() * APINT_WORD_SIZE);
     // Clear the unused ones
     clearUnusedBits();
   }
@@ -1333,7 +1338,7 @@ public:
     if (isSingleWord())
       U.VAL |= Mask;
     else
-      U.pVal[whichWord(BitPosition)] |= Mask;
+      wordsPtr()[whichWord(BitPosition)] |= Mask;
   }
 
   /// Set the sign bit to 1.
@@ -1376,7 +1381,7 @@ public:
       if (isSingleWord())
         U.VAL |= mask;
       else
-        U.pVal[0] |= mask;
+        wordsPtr()[0] |= mask;
     } else {
       setBitsSlowCase(loBit, hiBit);
     }
@@ -1398,7 +1403,7 @@ public:
     if (isSingleWord())
       U.VAL = 0;
     else
-      memset(U.pVal, 0, getNumWords() * APINT_WORD_SIZE);
+      memset(wordsPtr(), 0, getNumWords() * APINT_WORD_SIZE);
   }
 
   /// Set a given bit to 0.
@@ -1410,7 +1415,7 @@ public:
     if (isSingleWord())
       U.VAL &= Mask;
     else
-      U.pVal[whichWord(BitPosition)] &= Mask;
+      wordsPtr()[whichWord(BitPosition)] &= Mask;
   }
 
   /// Set bottom loBits bits to 0.
@@ -1521,7 +1526,7 @@ public:
     if (isSingleWord())
       return U.VAL;
     assert(getActiveBits() <= 64 && "Too many bits for uint64_t");
-    return U.pVal[0];
+    return wordsPtr()[0];
   }
 
   /// Get zero extended value if possible
@@ -1543,7 +1548,7 @@ public:
     if (isSingleWord())
       return SignExtend64(U.VAL, BitWidth);
     assert(getSignificantBits() <= 64 && "Too many bits for int64_t");
-    return int64_t(U.pVal[0]);
+    return int64_t(wordsPtr()[0]);
   }
 
   /// Get sign extended value if possible
@@ -1701,7 +1706,7 @@ public:
 
 #ifdef HAS_IEE754_FLOAT128
   float128 bitsToQuad() const {
-    __uint128_t ul = ((__uint128_t)U.pVal[1] << 64) + U.pVal[0];
+    __uint128_t ul = ((__uint128_t)wordsPtr()[1] << 64) + wordsPtr()[0];
     return llvm::bit_cast<float128>(ul);
   }
 #endif
@@ -1901,14 +1906,17 @@ public:
   void dump() const;
 
   /// Returns whether this instance allocated memory.
-  bool needsCleanup() const { return !isSingleWord(); }
+  bool needsCleanup() const { return getNumWords() > APINT_WORDS_INLINE; }
 
 private:
-  /// This union is used to store the integer value. When the
-  /// integer bit-width <= 64, it uses VAL, otherwise it uses pVal.
+  /// This union is used to store the integer value. When the integer
+  /// bit-width <= 64, it uses VAL; for bit-widths up to
+  /// APINT_WORDS_INLINE * 64 the words are stored inline in IVAL; wider
+  /// values are stored on the heap through pVal. VAL aliases IVAL[0].
   union {
-    uint64_t VAL;   ///< Used to store the <= 64 bits integer value.
-    uint64_t *pVal; ///< Used to store the >64 bits integer value.
+    uint64_t VAL;  ///< Used to store the <= 64 bits integer value.
+    uint64_t IVAL[APINT_WORDS_INLINE]; ///< Inline storage for small values.
+    uint64_t *pVal; ///< Used to store the > 128 bits integer value.
   } U;
 
   unsigned BitWidth = 1; ///< The number of bits in this APInt.
@@ -1921,8 +1929,35 @@ private:
 
   /// This constructor is used only internally for speed of construction of
   /// temporaries. It is unsafe since it takes ownership of the pointer, so it
-  /// is not public.
-  APInt(uint64_t *val, unsigned bits) : BitWidth(bits) { U.pVal = val; }
+  /// is not public. The bit width must not fit the inline storage.
+  APInt(uint64_t *val, unsigned bits) : BitWidth(bits) {
+    assert((!val || !isInlineStorage()) &&
+           "Adopted storage must be heap-allocated");
+    U.pVal = val;
+  }
+
+  /// Create an uninitialized APInt of the given bit width, allocating heap
+  /// storage if the value does not fit inline. Used internally for speed of
+  /// construction of temporaries whose words are filled in afterwards.
+  static APInt createUninitialized(unsigned numBits);
+
+  /// Returns whether the value is stored inline in the object rather than in
+  /// heap-allocated memory.
+  bool isInlineStorage() const {
+    return BitWidth <= APINT_WORDS_INLINE * APINT_BITS_PER_WORD;
+  }
+
+  /// Get a pointer to the array of words holding the value, independent of
+  /// whether it is stored inline or on the heap.
+  uint64_t *wordsPtr() { return isInlineStorage() ? U.IVAL : U.pVal; }
+  const uint64_t *wordsPtr() const {
+    return isInlineStorage() ? U.IVAL : U.pVal;
+  }
+
+  /// Make the word array for the current bit width available, allocating
+  /// heap storage if the value does not fit inline. If \p Zero is set the
+  /// words are zero-initialized.
+  uint64_t *allocWords(bool Zero);
 
   /// Determine which word a bit is in.
   ///
@@ -1964,14 +1999,14 @@ private:
     if (isSingleWord())
       U.VAL &= mask;
     else
-      U.pVal[getNumWords() - 1] &= mask;
+      wordsPtr()[getNumWords() - 1] &= mask;
     return *this;
   }
 
   /// Get the word corresponding to a bit position
   /// \returns the corresponding word for the specified bit position.
   uint64_t getWord(unsigned bitPosition) const {
-    return isSingleWord() ? U.VAL : U.pVal[whichWord(bitPosition)];
+    return isSingleWord() ? U.VAL : wordsPtr()[whichWord(bitPosition)];
   }
 
   /// Utility method to change the bit width of this APInt to new bit width,
@@ -25,6 +25,9 @@
 #include <mutex>
 #include <sstream>
 #include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace llvm {
 
@@ -180,48 +183,98 @@ public:
     CurBucket.Guard.lock();
 #endif
 
-    HashesPtr BucketHashes = CurBucket.Hashes;
-    DataPtr BucketEntries = CurBucket.Entries;
-    uint32_t CurEntryIdx = getStartIdx(ExtHashBits, CurBucket.Size);
+    bool Found = false;
+    uint32_t CurEntryIdx = findSlot(CurBucket, ExtHashBits, NewValue, Found);
 
-    while (true) {
-      uint32_t CurEntryHashBits = BucketHashes[CurEntryIdx];
+    if (Found) {
+      // Already existed entry matched with inserted data is found.
+      KeyDataTy *EntryData = CurBucket.Entries[CurEntryIdx];
+#if LLVM_ENABLE_THREADS
+      CurBucket.Guard.unlock();
+#endif
 
-      if (CurEntryHashBits == 0 && BucketEntries[CurEntryIdx] == nullptr) {
-        // Found empty slot. Insert data.
-        KeyDataTy *NewData = Info::create(NewValue, MultiThreadAllocator);
-        BucketEntries[CurEntryIdx] = NewData;
-        BucketHashes[CurEntryIdx] = ExtHashBits;
+      return {EntryData, false};
+    }
 
-        CurBucket.NumberOfEntries++;
-        RehashBucket(CurBucket);
+    // Found empty slot. Insert data.
+    KeyDataTy *NewData = Info::create(NewValue, MultiThreadAllocator);
+    CurBucket.Entries[CurEntryIdx] = NewData;
+    CurBucket.Hashes[CurEntryIdx] = ExtHashBits;
+
+    CurBucket.NumberOfEntries++;
+    RehashBucket(CurBucket);
 
 #if LLVM_ENABLE_THREADS
-        CurBucket.Guard.unlock();
+    CurBucket.Guard.unlock();
 #endif
 
-        return {NewData, true};
-      }
+    return {NewData, true};
+  }
+
+  /// Look up the entry for \p Value without inserting it.
+  ///
+  /// \returns the entry or nullptr if \p Value was never inserted.
+  KeyDataTy *lookup(const KeyTy &Value) {
+    uint64_t Hash = Info::getHashValue(Value);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
 
-      if (CurEntryHashBits == ExtHashBits) {
-        // Hash matched. Check value for equality.
-        KeyDataTy *EntryData = BucketEntries[CurEntryIdx];
-        if (Info::isEqual(Info::getKey(*EntryData), NewValue)) {
-          // Already existed entry matched with inserted data is found.
 #if LLVM_ENABLE_THREADS
-          CurBucket.Guard.unlock();
+    std::lock_guard<std::mutex> Guard(CurBucket.Guard);
 #endif
 
-          return {EntryData, false};
-        }
-      }
+    bool Found = false;
+    uint32_t CurEntryIdx = findSlot(CurBucket, ExtHashBits, Value, Found);
+    return Found ? CurBucket.Entries[CurEntryIdx] : nullptr;
+  }
+
+  /// Remove the entry for \p Value from the table. The KeyDataTy object
+  /// itself stays owned by the allocator. The probe sequences of the
+  /// remaining entries are restored by shifting the following cluster
+  /// members back, so no tombstones are left behind.
+  ///
+  /// \returns true if an entry was removed.
+  bool erase(const KeyTy &Value) {
+    uint64_t Hash = Info::getHashValue(Value);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Guard(CurBucket.Guard);
+#endif
 
-      CurEntryIdx++;
-      CurEntryIdx &= (CurBucket.Size - 1);
+    bool Found = false;
+    uint32_t CurEntryIdx = findSlot(CurBucket, ExtHashBits, Value, Found);
+    if (!Found)
+      return false;
+
+    HashesPtr BucketHashes = CurBucket.Hashes;
+    DataPtr BucketEntries = CurBucket.Entries;
+    uint32_t SizeMask = CurBucket.Size - 1;
+
+    // Backward-shift deletion: empty the slot, then walk the rest of the
+    // cluster and move every entry whose ideal position does not lie between
+    // the new hole and the entry into the hole.
+    uint32_t HoleIdx = CurEntryIdx;
+    BucketHashes[HoleIdx] = 0;
+    BucketEntries[HoleIdx] = nullptr;
+    for (uint32_t Idx = (HoleIdx + 1) & SizeMask;; Idx = (Idx + 1) & SizeMask) {
+      if (BucketHashes[Idx] == 0 && BucketEntries[Idx] == nullptr)
+        break;
+      uint32_t IdealIdx = getStartIdx(BucketHashes[Idx], CurBucket.Size);
+      // Cyclic distance from the ideal slot; if the hole is closer to the
+      // ideal slot than the entry is, the entry may move into the hole.
+      if (((Idx - IdealIdx) & SizeMask) >= ((Idx - HoleIdx) & SizeMask)) {
+        BucketHashes[HoleIdx] = BucketHashes[Idx];
+        BucketEntries[HoleIdx] = BucketEntries[Idx];
+        BucketHashes[Idx] = 0;
+        BucketEntries[Idx] = nullptr;
+        HoleIdx = Idx;
+      }
     }
 
-    llvm_unreachable("Insertion error.");
-    return {};
+    CurBucket.NumberOfEntries--;
+    return true;
   }
 
   /// Print information about current state of hash table structures.
@@ -295,6 +348,68 @@ protected:
 #endif
   };
 
+  // Find the slot for the entry with the specified \p ExtHashBits and
+  // \p Value inside \p CurBucket. The bucket must be locked by the caller.
+  // Sets \p Found and returns the index of the matching entry, or the index
+  // of the first empty slot if the value is not in the bucket.
+  uint32_t findSlot(const Bucket &CurBucket, uint32_t ExtHashBits,
+                    const KeyTy &Value, bool &Found) {
+    HashesPtr BucketHashes = CurBucket.Hashes;
+    DataPtr BucketEntries = CurBucket.Entries;
+    uint32_t SizeMask = CurBucket.Size - 1;
+    uint32_t CurEntryIdx = getStartIdx(ExtHashBits, CurBucket.Size);
+
+    while (true) {
+#if defined(__SSE2__)
+      // Scan four slots at a time: compare the hash array both against the
+      // probed hash and against zero (candidate empty slots) and only touch
+      // the entries for slots whose hash matched. The load never wraps
+      // because bucket sizes are powers of two >= 4 once the bucket holds
+      // more than a couple of entries.
+      if ((CurEntryIdx & 3) == 0 && CurEntryIdx + 4 <= CurBucket.Size) {
+        __m128i Hashes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(BucketHashes + CurEntryIdx));
+        __m128i HashMatch =
+            _mm_cmpeq_epi32(Hashes, _mm_set1_epi32(ExtHashBits));
+        __m128i ZeroMatch = _mm_cmpeq_epi32(Hashes, _mm_setzero_si128());
+        // One bit per hash lane, in probe order.
+        uint32_t Mask = _mm_movemask_ps(
+            _mm_castsi128_ps(_mm_or_si128(HashMatch, ZeroMatch)));
+        while (Mask != 0) {
+          uint32_t Idx = CurEntryIdx + llvm::countr_zero(Mask);
+          Mask &= Mask - 1;
+          uint32_t CurEntryHashBits = BucketHashes[Idx];
+          if (CurEntryHashBits == 0 && BucketEntries[Idx] == nullptr) {
+            Found = false;
+            return Idx;
+          }
+          if (CurEntryHashBits == ExtHashBits &&
+              Info::isEqual(Info::getKey(*BucketEntries[Idx]), Value)) {
+            Found = true;
+            return Idx;
+          }
+        }
+        CurEntryIdx = (CurEntryIdx + 4) & SizeMask;
+        continue;
+      }
+#endif
+      uint32_t CurEntryHashBits = BucketHashes[CurEntryIdx];
+
+      if (CurEntryHashBits == 0 && BucketEntries[CurEntryIdx] == nullptr) {
+        Found = false;
+        return CurEntryIdx;
+      }
+
+      if (CurEntryHashBits == ExtHashBits &&
+          Info::isEqual(Info::getKey(*BucketEntries[CurEntryIdx]), Value)) {
+        Found = true;
+        return CurEntryIdx;
+      }
+
+      CurEntryIdx = (CurEntryIdx + 1) & SizeMask;
+    }
+  }
+
   // Reallocate and rehash bucket if this is full enough.
   void RehashBucket(Bucket &CurBucket) {
     assert((CurBucket.Size > 0) && "Uninitialised bucket");
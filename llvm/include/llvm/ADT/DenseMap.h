@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/ADT/EpochTracker.h"
+#include "llvm/ADT/bit.h"
 #include "llvm/Support/AlignOf.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/MathExtras.h"
@@ -25,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <initializer_list>
 #include <iterator>
@@ -32,6 +34,12 @@
 #include <type_traits>
 #include <utility>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 namespace llvm {
 
 namespace detail {
@@ -48,6 +56,88 @@ struct DenseMapPair : public std::pair<KeyT, ValueT> {
   const ValueT &getSecond() const { return std::pair<KeyT, ValueT>::second; }
 };
 
+// Heap-allocated bucket arrays carry a trailing byte-per-bucket control array
+// that is probed one group at a time, in the style of "swiss table" hash
+// tables. A control byte holds the low 7 bits of the bucket's hash for full
+// buckets, or one of the sentinel values below, so a single wide compare
+// rejects most collisions without touching the bucket array at all. The
+// sentinel keys stored in the buckets remain authoritative; the control array
+// is an acceleration index maintained alongside them.
+
+/// Number of buckets probed as a unit when the control array is present, and
+/// the smallest bucket count for which one is allocated.
+inline constexpr unsigned DenseMapGroupWidth = 16;
+
+/// Control bytes for buckets that do not hold a key. Full buckets store the
+/// low 7 bits of their hash, so the high bit alone distinguishes them.
+inline constexpr uint8_t DenseMapCtrlEmpty = 0x80;
+inline constexpr uint8_t DenseMapCtrlTombstone = 0xFE;
+
+inline uint8_t denseMapControlForHash(unsigned Hash) { return Hash & 0x7F; }
+
+/// Bytes to allocate for \p NumBuckets buckets of \p BucketSize bytes each,
+/// including the trailing control array when the table is large enough to
+/// carry one.
+inline size_t denseMapAllocationSize(size_t BucketSize, unsigned NumBuckets) {
+  size_t Bytes = BucketSize * NumBuckets;
+  if (NumBuckets >= DenseMapGroupWidth)
+    Bytes += NumBuckets;
+  return Bytes;
+}
+
+/// The set of slots within one probed group, as produced by the wide byte
+/// compares below. On NEON each slot occupies four mask bits (the cheapest
+/// mask extraction narrows 8-bit lanes to nibbles), elsewhere one.
+class DenseMapGroupMask {
+#if !defined(__SSE2__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+  static constexpr unsigned BitsPerSlot = 4;
+#else
+  static constexpr unsigned BitsPerSlot = 1;
+#endif
+  uint64_t Bits;
+
+public:
+  explicit DenseMapGroupMask(uint64_t Bits) : Bits(Bits) {}
+
+  explicit operator bool() const { return Bits != 0; }
+
+  unsigned firstSlot() const {
+    assert(Bits != 0 && "No slot to take!");
+    return llvm::countr_zero(Bits) / BitsPerSlot;
+  }
+
+  void clearFirstSlot() {
+    Bits &= ~(((uint64_t(1) << BitsPerSlot) - 1)
+              << (firstSlot() * BitsPerSlot));
+  }
+};
+
+/// Return the slots of the group at \p Ctrl whose control byte equals \p C.
+inline DenseMapGroupMask denseMapMatchByte(const uint8_t *Ctrl, uint8_t C) {
+#if defined(__SSE2__)
+  __m128i Group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ctrl));
+  __m128i Match = _mm_cmpeq_epi8(Group, _mm_set1_epi8(static_cast<char>(C)));
+  return DenseMapGroupMask(
+      static_cast<unsigned>(_mm_movemask_epi8(Match)));
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  uint8x16_t Group = vld1q_u8(Ctrl);
+  uint8x16_t Match = vceqq_u8(Group, vdupq_n_u8(C));
+  // Narrow each 16-bit lane to 4 bits, giving one nibble per group byte.
+  uint8x8_t Narrow = vshrn_n_u16(vreinterpretq_u16_u8(Match), 4);
+  return DenseMapGroupMask(vget_lane_u64(vreinterpret_u64_u8(Narrow), 0));
+#else
+  uint64_t Bits = 0;
+  for (unsigned I = 0; I != DenseMapGroupWidth; ++I)
+    Bits |= uint64_t(Ctrl[I] == C) << I;
+  return DenseMapGroupMask(Bits);
+#endif
+}
+
+/// Return the slots of the group at \p Ctrl that are empty.
+inline DenseMapGroupMask denseMapMatchEmpty(const uint8_t *Ctrl) {
+  return denseMapMatchByte(Ctrl, DenseMapCtrlEmpty);
+}
+
 } // end namespace detail
 
 template <typename KeyT, typename ValueT,
@@ -139,6 +229,8 @@ public:
       assert(NumEntries == 0 && "Node count imbalance!");
       (void)NumEntries;
     }
+    if (uint8_t *Ctrl = getControlBytes())
+      memset(Ctrl, detail::DenseMapCtrlEmpty, getNumBuckets());
     setNumEntries(0);
     setNumTombstones(0);
   }
@@ -325,6 +417,7 @@ public:
 
     TheBucket->getSecond().~ValueT();
     TheBucket->getFirst() = getTombstoneKey();
+    setControlByte(TheBucket, detail::DenseMapCtrlTombstone);
     decrementNumEntries();
     incrementNumTombstones();
     return true;
@@ -333,6 +426,7 @@ public:
     BucketT *TheBucket = &*I;
     TheBucket->getSecond().~ValueT();
     TheBucket->getFirst() = getTombstoneKey();
+    setControlByte(TheBucket, detail::DenseMapCtrlTombstone);
     decrementNumEntries();
     incrementNumTombstones();
   }
@@ -390,6 +484,8 @@ protected:
     const KeyT EmptyKey = getEmptyKey();
     for (BucketT *B = getBuckets(), *E = getBucketsEnd(); B != E; ++B)
       ::new (&B->getFirst()) KeyT(EmptyKey);
+    if (uint8_t *Ctrl = getControlBytes())
+      memset(Ctrl, detail::DenseMapCtrlEmpty, getNumBuckets());
   }
 
   /// Returns the number of buckets to allocate to ensure that the DenseMap can
@@ -419,6 +515,8 @@ protected:
         assert(!FoundVal && "Key already in new map?");
         DestBucket->getFirst() = std::move(B->getFirst());
         ::new (&DestBucket->getSecond()) ValueT(std::move(B->getSecond()));
+        setControlByte(DestBucket, detail::denseMapControlForHash(
+                                       getHashValue(DestBucket->getFirst())));
         incrementNumEntries();
 
         // Free the value.
@@ -454,6 +552,8 @@ protected:
           ::new (&Buckets[I].getSecond()) ValueT(OtherBuckets[I].getSecond());
       }
     }
+    if (uint8_t *Ctrl = getControlBytes())
+      memcpy(Ctrl, other.getControlBytes(), NumBuckets);
   }
 
   static unsigned getHashValue(const KeyT &Val) {
@@ -593,6 +693,8 @@ private:
     if (!KeyInfoT::isEqual(TheBucket->getFirst(), EmptyKey))
       decrementNumTombstones();
 
+    setControlByte(TheBucket,
+                   detail::denseMapControlForHash(getHashValue(Lookup)));
     return TheBucket;
   }
 
@@ -602,6 +704,9 @@ private:
     if (NumBuckets == 0)
       return nullptr;
 
+    if (const uint8_t *Ctrl = getControlBytes())
+      return doFindWithControl(Val, Ctrl);
+
     const KeyT EmptyKey = getEmptyKey();
     unsigned BucketNo = getHashValue(Val) & (NumBuckets - 1);
     unsigned ProbeAmt = 1;
@@ -624,6 +729,37 @@ private:
     return const_cast<DenseMapBase *>(this)->doFind(Val); // NOLINT
   }
 
+  /// Lookup \p Val by probing the control array one group at a time. Only
+  /// buckets whose control byte matches the low hash bits are compared, and a
+  /// group containing an empty slot ends the probe sequence.
+  template <typename LookupKeyT>
+  BucketT *doFindWithControl(const LookupKeyT &Val, const uint8_t *Ctrl) {
+    BucketT *BucketsPtr = getBuckets();
+    const unsigned NumGroups = getNumBuckets() / detail::DenseMapGroupWidth;
+    const unsigned Hash = getHashValue(Val);
+    const uint8_t Tag = detail::denseMapControlForHash(Hash);
+    unsigned GroupNo = (Hash >> 7) & (NumGroups - 1);
+    unsigned ProbeAmt = 1;
+    while (true) {
+      const uint8_t *GroupCtrl = Ctrl + GroupNo * detail::DenseMapGroupWidth;
+      BucketT *GroupBuckets =
+          BucketsPtr + GroupNo * detail::DenseMapGroupWidth;
+      for (auto Match = detail::denseMapMatchByte(GroupCtrl, Tag); Match;
+           Match.clearFirstSlot()) {
+        BucketT *Bucket = GroupBuckets + Match.firstSlot();
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Val, Bucket->getFirst())))
+          return Bucket;
+      }
+      // An empty slot anywhere in the group means the key cannot live in a
+      // later group.
+      if (detail::denseMapMatchEmpty(GroupCtrl))
+        return nullptr;
+
+      // Otherwise, continue quadratic probing over whole groups.
+      GroupNo = (GroupNo + ProbeAmt++) & (NumGroups - 1);
+    }
+  }
+
   /// LookupBucketFor - Lookup the appropriate bucket for Val, returning it in
   /// FoundBucket.  If the bucket contains the key and a value, this returns
   /// true, otherwise it returns a bucket with an empty marker or tombstone and
@@ -646,6 +782,9 @@ private:
            !KeyInfoT::isEqual(Val, TombstoneKey) &&
            "Empty/Tombstone value shouldn't be inserted into map!");
 
+    if (const uint8_t *Ctrl = getControlBytes())
+      return LookupBucketForWithControl(Val, FoundBucket, Ctrl);
+
     unsigned BucketNo = getHashValue(Val) & (NumBuckets - 1);
     unsigned ProbeAmt = 1;
     while (true) {
@@ -678,12 +817,72 @@ private:
     }
   }
 
+  /// Group-probed variant of LookupBucketFor, used whenever the control array
+  /// is present.
+  template <typename LookupKeyT>
+  bool LookupBucketForWithControl(const LookupKeyT &Val, BucketT *&FoundBucket,
+                                  const uint8_t *Ctrl) {
+    BucketT *BucketsPtr = getBuckets();
+    const unsigned NumGroups = getNumBuckets() / detail::DenseMapGroupWidth;
+    const unsigned Hash = getHashValue(Val);
+    const uint8_t Tag = detail::denseMapControlForHash(Hash);
+    BucketT *FoundTombstone = nullptr;
+    unsigned GroupNo = (Hash >> 7) & (NumGroups - 1);
+    unsigned ProbeAmt = 1;
+    while (true) {
+      const uint8_t *GroupCtrl = Ctrl + GroupNo * detail::DenseMapGroupWidth;
+      BucketT *GroupBuckets =
+          BucketsPtr + GroupNo * detail::DenseMapGroupWidth;
+      for (auto Match = detail::denseMapMatchByte(GroupCtrl, Tag); Match;
+           Match.clearFirstSlot()) {
+        BucketT *ThisBucket = GroupBuckets + Match.firstSlot();
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Val, ThisBucket->getFirst()))) {
+          FoundBucket = ThisBucket;
+          return true;
+        }
+      }
+
+      if (auto Empty = detail::denseMapMatchEmpty(GroupCtrl)) {
+        // Prefer filling a tombstone seen earlier on the probe sequence over
+        // the empty bucket we eventually probed to.
+        FoundBucket = FoundTombstone ? FoundTombstone
+                                     : GroupBuckets + Empty.firstSlot();
+        return false;
+      }
+
+      // Remember the first tombstone found, as in the scalar path.
+      if (!FoundTombstone)
+        if (auto Tombs = detail::denseMapMatchByte(
+                GroupCtrl, detail::DenseMapCtrlTombstone))
+          FoundTombstone = GroupBuckets + Tombs.firstSlot();
+
+      GroupNo = (GroupNo + ProbeAmt++) & (NumGroups - 1);
+    }
+  }
+
+  /// Update the control byte for \p B, if this map carries a control array.
+  void setControlByte(const BucketT *B, uint8_t C) {
+    if (uint8_t *Ctrl = getControlBytes())
+      Ctrl[B - getBuckets()] = C;
+  }
+
+  const uint8_t *getControlBytes() const {
+    return static_cast<const DerivedT *>(this)->getControlBytes();
+  }
+
+  uint8_t *getControlBytes() {
+    return static_cast<DerivedT *>(this)->getControlBytes();
+  }
+
 public:
   /// Return the approximate size (in bytes) of the actual map.
   /// This is just the raw memory used by DenseMap.
   /// If entries are pointers to objects, the size of the referenced objects
   /// are not included.
-  size_t getMemorySize() const { return getNumBuckets() * sizeof(BucketT); }
+  size_t getMemorySize() const {
+    return getNumBuckets() * sizeof(BucketT) +
+           (getControlBytes() ? getNumBuckets() : 0);
+  }
 };
 
 /// Equality comparison for DenseMap.
@@ -763,7 +962,10 @@ public:
 
   ~DenseMap() {
     this->destroyAll();
-    deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets, alignof(BucketT));
+    deallocate_buffer(Buckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     NumBuckets),
+                      alignof(BucketT));
   }
 
   void swap(DenseMap &RHS) {
@@ -783,7 +985,10 @@ public:
 
   DenseMap &operator=(DenseMap &&other) {
     this->destroyAll();
-    deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets, alignof(BucketT));
+    deallocate_buffer(Buckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     NumBuckets),
+                      alignof(BucketT));
     init(0);
     swap(other);
     return *this;
@@ -791,7 +996,10 @@ public:
 
   void copyFrom(const DenseMap &other) {
     this->destroyAll();
-    deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets, alignof(BucketT));
+    deallocate_buffer(Buckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     NumBuckets),
+                      alignof(BucketT));
     if (allocateBuckets(other.NumBuckets)) {
       this->BaseT::copyFrom(other);
     } else {
@@ -825,7 +1033,9 @@ public:
     this->moveFromOldBuckets(OldBuckets, OldBuckets + OldNumBuckets);
 
     // Free the old table.
-    deallocate_buffer(OldBuckets, sizeof(BucketT) * OldNumBuckets,
+    deallocate_buffer(OldBuckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     OldNumBuckets),
                       alignof(BucketT));
   }
 
@@ -843,7 +1053,9 @@ public:
       return;
     }
 
-    deallocate_buffer(Buckets, sizeof(BucketT) * OldNumBuckets,
+    deallocate_buffer(Buckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     OldNumBuckets),
                       alignof(BucketT));
     init(NewNumBuckets);
   }
@@ -861,6 +1073,12 @@ private:
 
   unsigned getNumBuckets() const { return NumBuckets; }
 
+  uint8_t *getControlBytes() const {
+    return NumBuckets >= detail::DenseMapGroupWidth
+               ? reinterpret_cast<uint8_t *>(Buckets + NumBuckets)
+               : nullptr;
+  }
+
   bool allocateBuckets(unsigned Num) {
     NumBuckets = Num;
     if (NumBuckets == 0) {
@@ -868,8 +1086,9 @@ private:
       return false;
     }
 
-    Buckets = static_cast<BucketT *>(
-        allocate_buffer(sizeof(BucketT) * NumBuckets, alignof(BucketT)));
+    Buckets = static_cast<BucketT *>(allocate_buffer(
+        detail::denseMapAllocationSize(sizeof(BucketT), NumBuckets),
+        alignof(BucketT)));
     return true;
   }
 };
@@ -1090,7 +1309,9 @@ public:
                              OldRep.Buckets + OldRep.NumBuckets);
 
     // Free the old table.
-    deallocate_buffer(OldRep.Buckets, sizeof(BucketT) * OldRep.NumBuckets,
+    deallocate_buffer(OldRep.Buckets,
+                      detail::denseMapAllocationSize(sizeof(BucketT),
+                                                     OldRep.NumBuckets),
                       alignof(BucketT));
   }
 
@@ -1165,12 +1386,24 @@ private:
     return Small ? InlineBuckets : getLargeRep()->NumBuckets;
   }
 
+  uint8_t *getControlBytes() const {
+    // Only the heap-allocated representation has room for a control array;
+    // the inline buckets are probed with the scalar paths.
+    if (Small)
+      return nullptr;
+    const LargeRep *Rep = getLargeRep();
+    return Rep->NumBuckets >= detail::DenseMapGroupWidth
+               ? reinterpret_cast<uint8_t *>(Rep->Buckets + Rep->NumBuckets)
+               : nullptr;
+  }
+
   void deallocateBuckets() {
     if (Small)
       return;
 
     deallocate_buffer(getLargeRep()->Buckets,
-                      sizeof(BucketT) * getLargeRep()->NumBuckets,
+                      detail::denseMapAllocationSize(
+                          sizeof(BucketT), getLargeRep()->NumBuckets),
                       alignof(BucketT));
     getLargeRep()->~LargeRep();
   }
@@ -1178,7 +1411,8 @@ private:
   LargeRep allocateBuckets(unsigned Num) {
     assert(Num > InlineBuckets && "Must allocate more buckets than are inline");
     LargeRep Rep = {static_cast<BucketT *>(allocate_buffer(
-                        sizeof(BucketT) * Num, alignof(BucketT))),
+                        detail::denseMapAllocationSize(sizeof(BucketT), Num),
+                        alignof(BucketT))),
                     Num};
     return Rep;
   }
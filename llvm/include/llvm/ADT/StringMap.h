@@ -55,6 +55,7 @@ protected:
   StringMapImpl(unsigned InitSize, unsigned ItemSize);
   ~StringMapImpl() { free(TheTable); }
   unsigned RehashTable(unsigned BucketNo = 0);
+  unsigned moveEntriesTo(unsigned NewSize, unsigned BucketNo);
 
   /// LookupBucketFor - Look up the bucket that the specified string should end
   /// up in.  If it already exists as a key in the map, the Item pointer for the
@@ -103,6 +104,11 @@ public:
   bool empty() const { return NumItems == 0; }
   unsigned size() const { return NumItems; }
 
+  /// Grow the table so that it can contain at least \p NumEntries items
+  /// before resizing again. Existing entries are redistributed using their
+  /// cached hash values, without rehashing any key bytes.
+  void reserve(unsigned NumEntries);
+
   /// Returns the hash value that will be used for the given string.
   /// This allows precomputing the value and passing it explicitly
   /// to some of the functions.
@@ -52,17 +52,17 @@ class BasicAAResult : public AAResultBase {
   }
 
 public:
+  // The constructors and destructor are defined out of line so that the
+  // decomposed-GEP cache type can stay private to the implementation.
   BasicAAResult(const DataLayout &DL, const Function &F,
                 const TargetLibraryInfo &TLI, AssumptionCache &AC,
-                DominatorTree *DT = nullptr)
-      : DL(DL), F(F), TLI(TLI), AC(AC), DT_(DT) {}
+                DominatorTree *DT = nullptr);
 
-  BasicAAResult(const BasicAAResult &Arg)
-      : AAResultBase(Arg), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI), AC(Arg.AC),
-        DT_(Arg.DT_) {}
-  BasicAAResult(BasicAAResult &&Arg)
-      : AAResultBase(std::move(Arg)), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI),
-        AC(Arg.AC), DT_(Arg.DT_) {}
+  // The decomposed-GEP cache is an optimization local to one result object
+  // and is not copied or moved along with it.
+  BasicAAResult(const BasicAAResult &Arg);
+  BasicAAResult(BasicAAResult &&Arg);
+  ~BasicAAResult();
 
   /// Handle invalidation events in the new pass manager.
   bool invalidate(Function &Fn, const PreservedAnalyses &PA,
@@ -99,14 +99,26 @@ public:
 
 private:
   struct DecomposedGEP;
+  class DecomposedGEPCache;
 
   /// Tracks instructions visited by pointsToConstantMemory.
   SmallPtrSet<const Value *, 16> Visited;
 
+  /// Memoized DecomposeGEPExpression results, keyed by the queried pointer.
+  /// Flushed whenever any value a cached decomposition refers to is deleted
+  /// or replaced; only populated under -basic-aa-gep-cache. Lazily created.
+  std::unique_ptr<DecomposedGEPCache> DecompCache;
+
   static DecomposedGEP
   DecomposeGEPExpression(const Value *V, const DataLayout &DL,
                          AssumptionCache *AC, DominatorTree *DT);
 
+  /// Cached wrapper around DecomposeGEPExpression. Decompositions are purely
+  /// structural, so a cached result stays valid until the IR it refers to
+  /// changes; value handles conservatively flush the cache on such changes.
+  DecomposedGEP getDecomposedGEP(const Value *V, AssumptionCache *AC,
+                                 DominatorTree *DT);
+
   /// A Heuristic for aliasGEP that searches for a constant offset
   /// between the variables.
   ///
@@ -140,13 +140,16 @@ private:
   bool Recorded = false;
 };
 
+class DefaultInlineAdvisor;
+
 class DefaultInlineAdvice : public InlineAdvice {
 public:
   DefaultInlineAdvice(InlineAdvisor *Advisor, CallBase &CB,
                       std::optional<InlineCost> OIC,
-                      OptimizationRemarkEmitter &ORE, bool EmitRemarks = true)
+                      OptimizationRemarkEmitter &ORE, bool EmitRemarks = true,
+                      DefaultInlineAdvisor *OwningAdvisor = nullptr)
       : InlineAdvice(Advisor, CB, ORE, OIC.has_value()), OriginalCB(&CB),
-        OIC(OIC), EmitRemarks(EmitRemarks) {}
+        OIC(OIC), EmitRemarks(EmitRemarks), OwningAdvisor(OwningAdvisor) {}
 
 private:
   void recordUnsuccessfulInliningImpl(const InlineResult &Result) override;
@@ -157,6 +160,10 @@ private:
   CallBase *const OriginalCB;
   std::optional<InlineCost> OIC;
   bool EmitRemarks;
+  /// Set when the advice was created by a DefaultInlineAdvisor (as opposed to
+  /// e.g. the replay advisor), so that its memoized cost results can be
+  /// invalidated when inlining changes a function.
+  DefaultInlineAdvisor *const OwningAdvisor;
 };
 
 /// Interface for deciding whether to inline a call site or not.
@@ -232,9 +239,40 @@ public:
                        InlineParams Params, InlineContext IC)
       : InlineAdvisor(M, FAM, IC), Params(Params) {}
 
+  /// Return the inline cost for \p CB as evaluated against \p CalleeTTI,
+  /// reusing a memoized result when one exists and computing and recording it
+  /// with \p Compute otherwise.
+  InlineCost getMemoizedInlineCost(CallBase &CB,
+                                   const TargetTransformInfo &CalleeTTI,
+                                   function_ref<InlineCost()> Compute);
+
+  /// Drop the memoized cost results computed for call sites in \p F or with
+  /// \p F as the callee. Called whenever inlining changes or deletes \p F.
+  void forgetFunction(const Function *F);
+
 private:
   std::unique_ptr<InlineAdvice> getAdviceImpl(CallBase &CB) override;
 
+  /// Memoized results are only reusable while no pass other than the inliner
+  /// itself mutates the IR, so start every pass run with an empty cache.
+  void onPassEntry(LazyCallGraph::SCC *) override { CostCache.clear(); }
+
+  struct CachedInlineCost {
+    const Function *Caller;
+    const Function *Callee;
+    InlineCost IC;
+  };
+
+  /// Memoized inline cost results for the current pass run. The deferral
+  /// heuristic re-evaluates every call site of a caller once per inlining
+  /// candidate within it, with identical inputs until inlining changes one of
+  /// the involved functions. The key includes the callee TTI the cost was
+  /// evaluated against because the deferral path evaluates outer call sites
+  /// with the inner callee's TTI.
+  DenseMap<std::pair<const CallBase *, const TargetTransformInfo *>,
+           CachedInlineCost>
+      CostCache;
+
   InlineParams Params;
 };
 
@@ -0,0 +1,83 @@
+//===- KnownBitsCache.h - Memoized known-bits queries -----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a cache for computeKnownBits results that passes can opt
+// into through SimplifyQuery. Entries are keyed on the queried value and the
+// context instruction, and the cache flushes itself when any cached value is
+// deleted or has all uses replaced.
+//
+// The cache cannot observe in-place instruction mutation (dropping flags,
+// replacing operands), so a pass holding one must call clear() after changing
+// the IR in ways a value handle does not see, and must not share one cache
+// between queries that use different analyses (DT, AC, and so on).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_KNOWNBITSCACHE_H
+#define LLVM_ANALYSIS_KNOWNBITSCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Support/KnownBits.h"
+#include <optional>
+
+namespace llvm {
+
+class Instruction;
+
+/// A map from (value, context instruction) pairs to known-bits results,
+/// flushed when any cached value is RAUW'd or deleted.
+class KnownBitsCache {
+  class ValueCallbackVH final : public CallbackVH {
+    KnownBitsCache *Cache;
+
+    void deleted() override;
+    void allUsesReplacedWith(Value *) override;
+
+  public:
+    ValueCallbackVH(Value *V = nullptr, KnownBitsCache *Cache = nullptr)
+        : CallbackVH(V), Cache(Cache) {}
+  };
+  friend class ValueCallbackVH;
+
+  using KeyTy = std::pair<const Value *, const Instruction *>;
+  DenseMap<KeyTy, KnownBits> Results;
+
+  /// One callback handle per distinct cached value, so that RAUW or deletion
+  /// of anything we have a result for invalidates the cache.
+  DenseMap<const Value *, ValueCallbackVH> Handles;
+
+public:
+  KnownBitsCache() = default;
+  KnownBitsCache(const KnownBitsCache &) = delete;
+  KnownBitsCache &operator=(const KnownBitsCache &) = delete;
+
+  std::optional<KnownBits> lookup(const Value *V,
+                                  const Instruction *CxtI) const {
+    auto It = Results.find({V, CxtI});
+    if (It == Results.end())
+      return std::nullopt;
+    return It->second;
+  }
+
+  void insert(const Value *V, const Instruction *CxtI, const KnownBits &K) {
+    Results[{V, CxtI}] = K;
+    Handles.try_emplace(V, const_cast<Value *>(V), this);
+  }
+
+  /// Drop all cached results. Must be called after IR changes that a value
+  /// handle cannot observe.
+  void clear() {
+    Results.clear();
+    Handles.clear();
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ANALYSIS_KNOWNBITSCACHE_H
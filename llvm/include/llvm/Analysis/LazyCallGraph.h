@@ -58,6 +58,7 @@ namespace llvm {
 class Constant;
 template <class GraphType> struct GraphTraits;
 class Module;
+class ThreadPoolInterface;
 
 /// A lazily constructed view of the call graph of a module.
 ///
@@ -971,6 +972,21 @@ public:
     return make_range(postorder_ref_scc_begin(), postorder_ref_scc_end());
   }
 
+  /// Visit every RefSCC bottom-up, dispatching independent RefSCCs to \p
+  /// Pool.
+  ///
+  /// A RefSCC is visited only once every RefSCC it references has been
+  /// visited, so \p Fn observes the same bottom-up guarantee as the
+  /// sequential postorder walk, but RefSCCs with no reference path between
+  /// them run concurrently. The full postorder is materialized up front.
+  ///
+  /// \p Fn runs on the pool's worker threads: it must not mutate the graph
+  /// or touch shared mutable state (including analysis managers) without its
+  /// own synchronization. This is intended for analysis-only consumers such
+  /// as inline-priority precomputation.
+  void visitRefSCCsBottomUpParallel(ThreadPoolInterface &Pool,
+                                    function_ref<void(RefSCC &)> Fn);
+
   /// Lookup a function in the graph which has already been scanned and added.
   Node *lookup(const Function &F) const { return NodeMap.lookup(&F); }
 
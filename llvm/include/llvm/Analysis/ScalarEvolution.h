@@ -75,6 +75,10 @@ class SCEV : public FoldingSetNode {
   /// ScalarEvolution's BumpPtrAllocator holds the data.
   FoldingSetNodeIDRef FastID;
 
+  /// The hash of FastID, computed once at construction so that folding-set
+  /// growth and bucket collisions do not re-hash the interned ID.
+  const unsigned HashValue;
+
   // The SCEV baseclass this node corresponds to
   const SCEVTypes SCEVType;
 
@@ -133,7 +137,8 @@ public:
 
   explicit SCEV(const FoldingSetNodeIDRef ID, SCEVTypes SCEVTy,
                 unsigned short ExpressionSize)
-      : FastID(ID), SCEVType(SCEVTy), ExpressionSize(ExpressionSize) {}
+      : FastID(ID), HashValue(ID.ComputeHash()), SCEVType(SCEVTy),
+        ExpressionSize(ExpressionSize) {}
   SCEV(const SCEV &) = delete;
   SCEV &operator=(const SCEV &) = delete;
 
@@ -185,11 +190,13 @@ template <> struct FoldingSetTrait<SCEV> : DefaultFoldingSetTrait<SCEV> {
 
   static bool Equals(const SCEV &X, const FoldingSetNodeID &ID, unsigned IDHash,
                      FoldingSetNodeID &TempID) {
+    if (X.HashValue != IDHash)
+      return false;
     return ID == X.FastID;
   }
 
   static unsigned ComputeHash(const SCEV &X, FoldingSetNodeID &TempID) {
-    return X.FastID.ComputeHash();
+    return X.HashValue;
   }
 };
 
@@ -2309,6 +2316,13 @@ private:
            std::pair<const SCEV *, SmallVector<const SCEVPredicate *, 3>>>
       PredicatedSCEVRewrites;
 
+  /// The keys of PredicatedSCEVRewrites, indexed by loop, so that forgetLoop
+  /// can drop a loop's rewrites without scanning the whole map. May contain
+  /// stale entries for rewrites already dropped by forgetMemoizedResults;
+  /// erasing those again is a no-op.
+  DenseMap<const Loop *, SmallVector<const SCEVUnknown *, 4>>
+      PredicatedRewriteUsers;
+
   /// Set of AddRecs for which proving NUW via an induction has already been
   /// tried.
   SmallPtrSet<const SCEVAddRecExpr *, 16> UnsignedWrapViaInductionTried;
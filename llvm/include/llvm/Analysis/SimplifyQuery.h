@@ -17,6 +17,7 @@ namespace llvm {
 class AssumptionCache;
 class DomConditionCache;
 class DominatorTree;
+class KnownBitsCache;
 class TargetLibraryInfo;
 
 /// InstrInfoQuery provides an interface to query additional information for
@@ -75,6 +76,9 @@ struct SimplifyQuery {
   const Instruction *CxtI = nullptr;
   const DomConditionCache *DC = nullptr;
   const CondContext *CC = nullptr;
+  /// If set, computeKnownBits memoizes full-depth results here. The owning
+  /// pass is responsible for the cache's validity; see KnownBitsCache.
+  KnownBitsCache *KBC = nullptr;
 
   // Wrapper to query additional information for instructions like metadata or
   // keywords like nsw, which provides conservative results if those cannot
@@ -125,6 +129,12 @@ struct SimplifyQuery {
     return Copy;
   }
 
+  SimplifyQuery getWithKnownBitsCache(KnownBitsCache *KBC) const {
+    SimplifyQuery Copy(*this);
+    Copy.KBC = KBC;
+    return Copy;
+  }
+
   SimplifyQuery getWithCondContext(const CondContext &CC) const {
     SimplifyQuery Copy(*this);
     Copy.CC = &CC;
@@ -492,7 +492,9 @@ public:
   void setNumRangeExtensions(unsigned N) { NumRangeExtensions = N; }
 };
 
-static_assert(sizeof(ValueLatticeElement) <= 40,
+// The dominant component is the embedded ConstantRange, whose APInts store up
+// to 128 bits inline; everything else must fit in one extra word.
+static_assert(sizeof(ValueLatticeElement) <= sizeof(ConstantRange) + 8,
               "size of ValueLatticeElement changed unexpectedly");
 
 raw_ostream &operator<<(raw_ostream &OS, const ValueLatticeElement &Val);
@@ -179,6 +179,14 @@ private:
   /// List of symbols to be inserted into PC sections.
   DenseMap<const MDNode *, SmallVector<const MCSymbol *>> PCSectionsSymbols;
 
+  /// Constants already emitted into a constant-pool section by earlier
+  /// functions in the module, with the symbol and alignment they were emitted
+  /// at. Later functions equate their constant-pool symbols with the earlier
+  /// copy instead of emitting the same bytes again.
+  DenseMap<std::pair<const MCSection *, const Constant *>,
+           std::pair<MCSymbol *, Align>>
+      EmittedCPConstants;
+
   static char ID;
 
 protected:
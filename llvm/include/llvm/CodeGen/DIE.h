@@ -887,6 +887,11 @@ public:
   /// eventually used to call \a setAbbrevNumber().
   DIEAbbrev generateAbbrev() const;
 
+  /// Add the profile of the abbreviation \a generateAbbrev() would produce to
+  /// \p ID, without materializing it. This lets the abbreviation uniquing hit
+  /// path skip building a DIEAbbrev entirely.
+  void profileAbbrev(FoldingSetNodeID &ID) const;
+
   /// Set the abbreviation number for this DIE.
   void setAbbrevNumber(unsigned I) { AbbrevNumber = I; }
 
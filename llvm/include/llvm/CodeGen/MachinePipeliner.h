@@ -685,6 +685,11 @@ private:
   /// The initiation interval (II) for the schedule.
   int InitiationInterval = 0;
 
+  /// Number of cycles probed by insert() so far. Deliberately not cleared by
+  /// reset() so that it accumulates across II candidates and can be compared
+  /// against a per-loop scheduling budget.
+  unsigned NumCycleProbes = 0;
+
   /// Target machine information.
   const TargetSubtargetInfo &ST;
 
@@ -715,6 +720,10 @@ public:
   /// Return the initiation interval for this schedule.
   int getInitiationInterval() const { return InitiationInterval; }
 
+  /// Return the cumulative number of cycles probed while scheduling this
+  /// loop, across all II candidates tried so far.
+  unsigned getNumCycleProbes() const { return NumCycleProbes; }
+
   /// Return the first cycle in the completed schedule.  This
   /// can be a negative value.
   int getFirstCycle() const { return FirstCycle; }
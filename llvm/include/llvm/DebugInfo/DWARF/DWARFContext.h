@@ -162,6 +162,11 @@ public:
 
   bool verify(raw_ostream &OS, DIDumpOptions DumpOpts = {}) override;
 
+  /// Return true if this context was constructed with the thread safe state,
+  /// in which case clients may parse and access debug information from
+  /// multiple threads at once.
+  bool isThreadSafe() const { return State->isThreadSafe(); }
+
   using unit_iterator_range = DWARFUnitVector::iterator_range;
   using compile_unit_range = DWARFUnitVector::compile_unit_range;
 
@@ -42,6 +42,10 @@ public:
   size_t GetNumCategories() const { return Aggregation.size(); }
   void Report(StringRef s, std::function<void()> detailCallback);
   void EnumerateResults(std::function<void(StringRef, unsigned)> handleCounts);
+  /// Add the categories aggregated by \a Other into this aggregator. Used to
+  /// fold the results collected by per-thread aggregators back into the main
+  /// one when verifying in parallel.
+  void Merge(const OutputCategoryAggregator &Other);
 };
 
 /// A class that verifies DWARF debug information given a DWARF Context.
@@ -175,6 +179,15 @@ private:
   unsigned verifyUnitSection(const DWARFSection &S);
   unsigned verifyUnits(const DWARFUnitVector &Units);
 
+  /// Verifies the contents of the units in \a Units concurrently on a thread
+  /// pool. Each task verifies one unit with its own verifier so that output
+  /// and aggregated errors can be collected per unit and emitted in unit
+  /// order once all tasks have finished. Only used when the DWARFContext was
+  /// constructed thread safe.
+  ///
+  /// \returns The number of errors that occurred during verification.
+  unsigned verifyUnitsParallel(const DWARFUnitVector &Units);
+
   unsigned verifyIndex(StringRef Name, DWARFSectionKind SectionKind,
                        StringRef Index);
 
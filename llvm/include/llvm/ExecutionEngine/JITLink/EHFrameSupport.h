@@ -89,6 +89,13 @@ public:
   virtual ~EHFrameRegistrar();
   virtual Error registerEHFrames(orc::ExecutorAddrRange EHFrameSection) = 0;
   virtual Error deregisterEHFrames(orc::ExecutorAddrRange EHFrameSection) = 0;
+
+  /// Deregister a batch of EH-frame sections. The default implementation
+  /// deregisters the sections one at a time. Registrars that talk to a
+  /// remote executor should override this to issue a single call for the
+  /// whole batch.
+  virtual Error
+  deregisterEHFrames(ArrayRef<orc::ExecutorAddrRange> EHFrameSections);
 };
 
 /// Registers / Deregisters EH-frames in the current process.
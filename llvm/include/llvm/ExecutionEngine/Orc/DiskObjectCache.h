@@ -0,0 +1,63 @@
+//===- DiskObjectCache.h - On-disk object cache for ORC ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache implementation that persists compiled objects on disk,
+// keyed by a content hash of the module, so warm process starts load
+// previously compiled objects instead of recompiling.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Error.h"
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// An on-disk ObjectCache.
+///
+/// Objects are stored in a flat directory, named by a hash of the module's
+/// bitcode mixed with a client-supplied salt. The salt should encode
+/// everything besides the module that affects the generated code -- at
+/// minimum the target triple, CPU, feature string and codegen optimization
+/// level -- so that caches populated with different TargetMachine
+/// configurations do not alias.
+///
+/// Cache entries are written to a unique temporary file and renamed into
+/// place, so concurrent processes sharing a cache directory see either no
+/// entry or a complete one.
+class DiskObjectCache : public ObjectCache {
+public:
+  /// Create a cache rooted at \p CacheDir, creating the directory if
+  /// necessary. \p Salt is mixed into every cache key.
+  static Expected<std::unique_ptr<DiskObjectCache>> Create(StringRef CacheDir,
+                                                           StringRef Salt);
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  DiskObjectCache(std::string CacheDir, std::string Salt)
+      : CacheDir(std::move(CacheDir)), Salt(std::move(Salt)) {}
+
+  /// Return the path of the cache entry for \p M.
+  std::string getPathForModule(const Module &M) const;
+
+  std::string CacheDir;
+  std::string Salt;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
@@ -36,20 +36,26 @@ public:
   Create(ExecutionSession &ES);
 
   /// Create a EPCEHFrameRegistrar with the given ExecutorProcessControl
-  /// object and registration/deregistration function addresses.
-  EPCEHFrameRegistrar(ExecutionSession &ES,
-                      ExecutorAddr RegisterEHFrameSectionWrapper,
-                      ExecutorAddr DeregisterEHFRameSectionWrapper)
+  /// object and registration/deregistration function addresses. If
+  /// DeregisterEHFrameSectionsWrapper is null then batch deregistration
+  /// falls back to one call per section.
+  EPCEHFrameRegistrar(
+      ExecutionSession &ES, ExecutorAddr RegisterEHFrameSectionWrapper,
+      ExecutorAddr DeregisterEHFRameSectionWrapper,
+      ExecutorAddr DeregisterEHFrameSectionsWrapper = ExecutorAddr())
       : ES(ES), RegisterEHFrameSectionWrapper(RegisterEHFrameSectionWrapper),
-        DeregisterEHFrameSectionWrapper(DeregisterEHFRameSectionWrapper) {}
+        DeregisterEHFrameSectionWrapper(DeregisterEHFRameSectionWrapper),
+        DeregisterEHFrameSectionsWrapper(DeregisterEHFrameSectionsWrapper) {}
 
   Error registerEHFrames(ExecutorAddrRange EHFrameSection) override;
   Error deregisterEHFrames(ExecutorAddrRange EHFrameSection) override;
+  Error deregisterEHFrames(ArrayRef<ExecutorAddrRange> EHFrameSections) override;
 
 private:
   ExecutionSession &ES;
   ExecutorAddr RegisterEHFrameSectionWrapper;
   ExecutorAddr DeregisterEHFrameSectionWrapper;
+  ExecutorAddr DeregisterEHFrameSectionsWrapper;
 };
 
 } // end namespace orc
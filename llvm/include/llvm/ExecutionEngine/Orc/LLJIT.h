@@ -323,6 +323,7 @@ public:
   ProcessSymbolsJITDylibSetupFunction SetupProcessSymbolsJITDylib;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unique_function<Error(LLJIT &)> PrePlatformSetup;
   PlatformSetupFunction SetUpPlatform;
   NotifyCreatedFunction NotifyCreated;
@@ -424,6 +425,17 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache.
+  ///
+  /// The cache is consulted by the default compile function before
+  /// compiling, and notified with each newly compiled object. It has no
+  /// effect if a custom CompileFunctionCreator is also set. The cache must
+  /// outlive the LLJIT instance.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set a setup function to be run just before the PlatformSetupFunction is
   /// run.
   ///
@@ -46,6 +46,7 @@ extern const char *MemoryWritePointersWrapperName;
 
 extern const char *RegisterEHFrameSectionWrapperName;
 extern const char *DeregisterEHFrameSectionWrapperName;
+extern const char *DeregisterEHFrameSectionsWrapperName;
 
 extern const char *RunAsMainWrapperName;
 extern const char *RunAsVoidFunctionWrapperName;
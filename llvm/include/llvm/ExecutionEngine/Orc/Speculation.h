@@ -14,6 +14,7 @@
 #define LLVM_EXECUTIONENGINE_ORC_SPECULATION_H
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/DebugUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
@@ -76,6 +77,11 @@ private:
     // the datastructure.
     {
       std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+      // Speculate through each target only once. The entry guards already
+      // arrange that per stub, but the chained speculation below may reach
+      // the same target along several call paths or through cycles.
+      if (!SpeculatedAddrs.insert(FAddr).second)
+        return;
       auto It = GlobalSpecMap.find(FAddr);
       if (It == GlobalSpecMap.end())
         return;
@@ -112,8 +118,17 @@ private:
                                   JITDylibLookupFlags::MatchAllSymbols),
           SymbolLookupSet(LookupPair.second), SymbolState::Ready,
           [this](Expected<SymbolMap> Result) {
-            if (auto Err = Result.takeError())
-              ES.reportError(std::move(Err));
+            if (!Result) {
+              ES.reportError(Result.takeError());
+              return;
+            }
+            // Chain the speculation transitively: the implementations that
+            // just became ready are themselves likely to run soon, so walk
+            // their likely callees as well. Each completed compile funds the
+            // next wave, and SpeculatedAddrs bounds the walk to one visit
+            // per target.
+            for (auto &KV : *Result)
+              launchCompile(KV.second.getAddress());
           },
           NoDependenciesToRegister);
   }
@@ -166,6 +181,9 @@ private:
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  // Targets that speculation has already walked through, to stop the
+  // transitive walk from revisiting targets or cycling.
+  DenseSet<TargetFAddr> SpeculatedAddrs;
 };
 
 class IRSpeculationLayer : public IRLayer {
@@ -40,4 +40,7 @@ llvm_orc_registerEHFrameSectionWrapper(const char *Data, uint64_t Size);
 extern "C" LLVM_ABI llvm::orc::shared::CWrapperFunctionResult
 llvm_orc_deregisterEHFrameSectionWrapper(const char *Data, uint64_t Size);
 
+extern "C" LLVM_ABI llvm::orc::shared::CWrapperFunctionResult
+llvm_orc_deregisterEHFrameSectionsWrapper(const char *Data, uint64_t Size);
+
 #endif // LLVM_EXECUTIONENGINE_ORC_TARGETPROCESS_REGISTEREHFRAMES_H
@@ -824,6 +824,14 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// Despite the exclusive-access rule above, the adaptor cannot shard the
+/// functions across threads: IR mutation goes through LLVMContext-level
+/// uniquing tables (constants, types, metadata) that are shared by all
+/// functions in the module and are not synchronized. Until the context offers
+/// a thread-safe interface for those tables, only analyses that do not mutate
+/// IR can run concurrently; see
+/// \c LazyCallGraph::visitRefSCCsBottomUpParallel for that use case.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
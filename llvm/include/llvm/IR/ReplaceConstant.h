@@ -14,11 +14,14 @@
 #ifndef LLVM_IR_REPLACECONSTANT_H
 #define LLVM_IR_REPLACECONSTANT_H
 
+#include "llvm/ADT/DenseMap.h"
+
 namespace llvm {
 
 template <typename T> class ArrayRef;
 class Constant;
 class Function;
+class Module;
 
 /// Replace constant expressions users of the given constants with
 /// instructions. Return whether anything was changed.
@@ -38,6 +41,23 @@ bool convertUsersOfConstantsToInstructions(ArrayRef<Constant *> Consts,
                                            bool RemoveDeadConstants = true,
                                            bool IncludeSelf = false);
 
+/// Replace every use of the keys of \p Replacements in \p F with the
+/// corresponding constant, including uses reached through constant
+/// expressions and constant aggregates, in a single pass over the function's
+/// operands. Unlike calling replaceAllUsesWith once per constant, this never
+/// traverses a constant's use-list, so replacing constants whose uses are
+/// spread over a large module (or replacing many constants at once) only
+/// touches the function at hand. Replacement constants must have the same
+/// type as the constants they replace. Metadata uses are not rewritten.
+/// Returns whether anything was changed.
+bool replaceConstantsInFunction(
+    Function &F, const DenseMap<Constant *, Constant *> &Replacements);
+
+/// Module-wide variant of replaceConstantsInFunction. Also rewrites global
+/// variable initializers, alias aliasees and ifunc resolvers.
+bool replaceConstantsInModule(
+    Module &M, const DenseMap<Constant *, Constant *> &Replacements);
+
 } // end namespace llvm
 
 #endif // LLVM_IR_REPLACECONSTANT_H
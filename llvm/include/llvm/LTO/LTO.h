@@ -317,6 +317,21 @@ ThinBackend createWriteIndexesThinBackend(ThreadPoolStrategy Parallelism,
                                           raw_fd_ostream *LinkedObjectsFile,
                                           IndexWriteCallback OnWrite);
 
+/// This ThinBackend runs each backend job out of process, for build systems
+/// that distribute backend compilations (e.g. to a remote execution farm).
+/// For every module it writes the sharded summary index next to the module
+/// (and, if ShouldEmitImportsFiles is true, an ".imports" file), invokes
+///
+///   <Command> <module path> <index path> <native object path>
+///
+/// and adds the native object produced at the given path to the link. The
+/// commands run on the backend thread pool, so their results are ingested as
+/// they complete.
+ThinBackend createOutOfProcessThinBackend(ThreadPoolStrategy Parallelism,
+                                          std::string Command,
+                                          IndexWriteCallback OnWrite = nullptr,
+                                          bool ShouldEmitImportsFiles = false);
+
 /// This class implements a resolution-based interface to LLVM's LTO
 /// functionality. It supports regular LTO, parallel LTO code generation and
 /// ThinLTO. You can use it from a linker in the following way:
@@ -426,6 +441,19 @@ private:
     // The bitcode modules to compile, if specified by the LTO Config.
     std::optional<ModuleMapType> ModulesToCompile;
     DenseMap<GlobalValue::GUID, StringRef> PrevailingModuleForGUID;
+
+    // Summary reading is pipelined: addModule() schedules each module that
+    // carries a summary on this single-threaded pool, which merges it into
+    // CombinedIndex in input order while the main thread keeps resolving
+    // symbols for later input files. waitForSummaryReads() drains the pool
+    // and reports any deferred parse error before run() consults the index.
+    DefaultThreadPool SummaryReaderPool{llvm::hardware_concurrency(1)};
+    std::optional<Error> SummaryReadErr;
+    std::mutex SummaryReadErrMu;
+
+    // Buffered by addModule() and applied to CombinedIndex once the reader
+    // pool has drained, so the flag write cannot race with summary merging.
+    bool PartiallySplitLTOUnits = false;
   } ThinLTO;
 
   // The global resolution for a particular (mangled) symbol name. This is in
@@ -519,6 +547,8 @@ private:
   Error addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                    const SymbolResolution *&ResI, const SymbolResolution *ResE);
 
+  Error waitForSummaryReads();
+
   Error runRegularLTO(AddStreamFn AddStream);
   Error runThinLTO(AddStreamFn AddStream, FileCache Cache,
                    const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols);
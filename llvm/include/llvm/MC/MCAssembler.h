@@ -65,6 +65,7 @@ private:
 
   bool HasLayout = false;
   bool RelaxAll = false;
+  bool FastLayout = false;
 
   SectionListType Sections;
 
@@ -115,6 +116,11 @@ private:
   /// were adjusted.
   bool layoutOnce();
 
+  /// Relax every instruction that may need relaxation to its maximal form,
+  /// without consulting fixup values. Used by the fast layout mode to bound
+  /// the number of layout iterations.
+  void relaxInstructionsToMaxSize();
+
   /// Perform relaxation on a single fragment - returns true if the fragment
   /// changes as a result of relaxation.
   bool relaxFragment(MCFragment &F);
@@ -205,6 +211,9 @@ public:
   bool getRelaxAll() const { return RelaxAll; }
   void setRelaxAll(bool Value) { RelaxAll = Value; }
 
+  bool getFastLayout() const { return FastLayout; }
+  void setFastLayout(bool Value) { FastLayout = Value; }
+
   bool isBundlingEnabled() const { return BundleAlignSize != 0; }
 
   unsigned getBundleAlignSize() const { return BundleAlignSize; }
@@ -44,6 +44,13 @@ public:
   };
 
   bool MCRelaxAll : 1;
+
+  /// Lay out the object file with a single pessimistic relaxation pass that
+  /// widens every relaxable instruction to its maximal form, instead of
+  /// iterating relaxation to a fixpoint. Faster on very large inputs at the
+  /// cost of slightly larger code.
+  bool MCFastLayout : 1;
+
   bool MCNoExecStack : 1;
   bool MCFatalWarnings : 1;
   bool MCNoWarn : 1;
@@ -27,6 +27,8 @@ namespace mc {
 bool getRelaxAll();
 std::optional<bool> getExplicitRelaxAll();
 
+bool getFastLayout();
+
 bool getIncrementalLinkerCompatible();
 
 bool getFDPIC();
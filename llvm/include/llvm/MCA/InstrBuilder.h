@@ -110,6 +110,15 @@ public:
     FirstReturnInst = true;
   }
 
+  /// Reset the per-sequence diagnostic state without dropping the cached
+  /// instruction descriptors. Descriptors are keyed by instruction content
+  /// (opcode or MCInst hash, plus sched class), so they remain valid across
+  /// code regions and can be reused when regions share instructions.
+  void resetState() {
+    FirstCallInst = true;
+    FirstReturnInst = true;
+  }
+
   /// Set a callback which is invoked to retrieve a recycled mca::Instruction
   /// or null if there isn't any.
   void setInstRecycleCallback(InstRecycleCallback CB) { InstRecycleCB = CB; }
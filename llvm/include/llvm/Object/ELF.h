@@ -24,6 +24,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Error.h"
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -272,10 +273,34 @@ private:
   StringRef Buf;
   std::vector<Elf_Shdr> FakeSections;
   SmallString<0> FakeSectionStrings;
+  // The number of headers in the validated section header table, or
+  // NoSectionsCache before the first successful call to sections(). ELFFile
+  // is safe to use from concurrent readers, so the cache is a single atomic
+  // published with a release store and read with an acquire load; the table
+  // itself is recomputed from the immutable Buf on a hit.
+  static constexpr size_t NoSectionsCache = ~size_t(0);
+  mutable std::atomic<size_t> NumSectionsCache{NoSectionsCache};
 
   ELFFile(StringRef Object);
 
 public:
+  // The atomic cache member suppresses the implicit copy operations; copying
+  // the cached count is fine because it is derived from Buf alone.
+  ELFFile(const ELFFile &Other)
+      : Buf(Other.Buf), FakeSections(Other.FakeSections),
+        FakeSectionStrings(Other.FakeSectionStrings),
+        NumSectionsCache(
+            Other.NumSectionsCache.load(std::memory_order_relaxed)) {}
+  ELFFile &operator=(const ELFFile &Other) {
+    Buf = Other.Buf;
+    FakeSections = Other.FakeSections;
+    FakeSectionStrings = Other.FakeSectionStrings;
+    NumSectionsCache.store(
+        Other.NumSectionsCache.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    return *this;
+  }
+
   const Elf_Ehdr &getHeader() const {
     return *reinterpret_cast<const Elf_Ehdr *>(base());
   }
@@ -923,6 +948,19 @@ template <class ELFT> void ELFFile<ELFT>::createFakeSections() {
 
 template <class ELFT>
 Expected<typename ELFT::ShdrRange> ELFFile<ELFT>::sections() const {
+  // Every per-section and per-symbol accessor funnels through here, so tools
+  // iterating large symbol tables would re-run the validation below for each
+  // query. The table is immutable once the file exists, so validate it once
+  // and serve later calls from the cache. The e_shoff == 0 path stays
+  // uncached because createFakeSections() may populate FakeSections later,
+  // and error paths stay uncached so that every caller receives its own
+  // Error to consume.
+  if (size_t CachedNum = NumSectionsCache.load(std::memory_order_acquire);
+      CachedNum != NoSectionsCache)
+    return ArrayRef(
+        reinterpret_cast<const Elf_Shdr *>(base() + getHeader().e_shoff),
+        CachedNum);
+
   const uintX_t SectionTableOffset = getHeader().e_shoff;
   if (SectionTableOffset == 0) {
     if (!FakeSections.empty())
@@ -970,6 +1008,7 @@ Expected<typename ELFT::ShdrRange> ELFFile<ELFT>::sections() const {
   // Section table goes past end of file!
   if (SectionTableOffset + SectionTableSize > FileSize)
     return createError("section table goes past the end of file");
+  NumSectionsCache.store(NumSections, std::memory_order_release);
   return ArrayRef(First, NumSections);
 }
 
@@ -958,9 +958,34 @@ class CoverageMapping {
                bool &DataFound,
                SmallVectorImpl<object::BuildID> *FoundBinaryIDs = nullptr);
 
-  /// Add a function record corresponding to \p Record.
-  Error loadFunctionRecord(const CoverageMappingRecord &Record,
-                           IndexedInstrProfReader &ProfileReader);
+  /// A function record together with owned copies of everything needed to
+  /// evaluate it. The reader reuses its per-record storage, so decoupling the
+  /// record from the reader allows evaluation to be deferred and batched.
+  struct PendingFunctionRecord {
+    StringRef OrigFuncName;
+    std::vector<StringRef> Filenames;
+    std::vector<CounterExpression> Expressions;
+    std::vector<CounterMappingRegion> MappingRegions;
+    std::vector<uint64_t> Counts;
+    BitVector Bitmap;
+  };
+
+  /// Decode \p Record, look up its profile data and append an owned copy of
+  /// it to \p Pending for later evaluation by evaluateFunctionRecords().
+  Error prepareFunctionRecord(const CoverageMappingRecord &Record,
+                              IndexedInstrProfReader &ProfileReader,
+                              std::vector<PendingFunctionRecord> &Pending);
+
+  /// Evaluate the counter expressions of \p PR against its counts and bitmap
+  /// and build the corresponding function record, or return std::nullopt if
+  /// the record should be skipped. Only reads \p PR, so records can be
+  /// evaluated concurrently.
+  static std::optional<FunctionRecord>
+  evaluatePendingRecord(PendingFunctionRecord &PR, bool IsVersion11);
+
+  /// Evaluate \p Pending in parallel and add the resulting function records.
+  void evaluateFunctionRecords(MutableArrayRef<PendingFunctionRecord> Pending,
+                               bool IsVersion11);
 
   /// Look up the indices for function records which are at least partially
   /// defined in the specified file. This is guaranteed to return a superset of
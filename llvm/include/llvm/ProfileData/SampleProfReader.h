@@ -765,7 +765,7 @@ public:
 class SampleProfileReaderExtBinaryBase : public SampleProfileReaderBinary {
 private:
   std::error_code decompressSection(const uint8_t *SecStart,
-                                    const uint64_t SecSize,
+                                    const uint64_t SecSize, bool IsZstd,
                                     const uint8_t *&DecompressBuf,
                                     uint64_t &DecompressBufSize);
 
@@ -35,6 +35,15 @@
 // through the change objects in `Tracker::Changes` in order, calling
 // `IRChangeBase::accept()`.
 //
+// Checkpoints
+// -----------
+// `Tracker::getCheckpoint()` marks a position in the list of tracked changes
+// and `Tracker::revertToCheckpoint()` reverts and discards only the changes
+// made after the mark, while keeping the transaction open. This lets users
+// like the sandbox vectorizer try out a candidate transformation and roll it
+// back at a cost proportional to the changes the candidate made, instead of
+// reverting and re-applying the whole transaction.
+//
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_SANDBOXIR_TRACKER_H
@@ -46,6 +55,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/SandboxIR/Use.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include <memory>
 
@@ -268,8 +278,8 @@ public:
 /// setter function provided.
 ///
 /// Example:
-///  Tracker.track(std::make_unique<
-///                GenericSetter<&FooInst::get, &FooInst::set>>(I, Tracker));
+///  Tracker.emplaceIfTracking<
+///      GenericSetter<&FooInst::get, &FooInst::set>>(I);
 ///
 template <auto GetterFn, auto SetterFn>
 class GenericSetter final : public IRChangeBase {
@@ -445,8 +455,14 @@ public:
   };
 
 private:
-  /// The list of changes that are being tracked.
-  SmallVector<std::unique_ptr<IRChangeBase>> Changes;
+  /// The list of changes that are being tracked. The objects are owned by
+  /// \p ChangeAllocator.
+  SmallVector<IRChangeBase *> Changes;
+  /// Change objects are bump-allocated from this pool instead of individually
+  /// on the heap, since candidate exploration can create and revert large
+  /// numbers of them per transaction. The pool is reset once the list of
+  /// changes empties in accept() or revert().
+  BumpPtrAllocator ChangeAllocator;
   /// The current state of the tracker.
   TrackerState State = TrackerState::Disabled;
   Context &Ctx;
@@ -473,9 +489,16 @@ public:
 
   ~Tracker();
   Context &getContext() const { return Ctx; }
-  /// Record \p Change and take ownership. This is the main function used to
-  /// track Sandbox IR changes.
-  void track(std::unique_ptr<IRChangeBase> &&Change) {
+  /// Construct a change object in the tracker's allocation pool. The object
+  /// remains owned by the pool and must be registered with track().
+  template <typename ChangeT, typename... ArgsT>
+  ChangeT *createChange(ArgsT &&...Args) {
+    return new (ChangeAllocator.Allocate(sizeof(ChangeT), alignof(ChangeT)))
+        ChangeT(std::forward<ArgsT>(Args)...);
+  }
+  /// Record \p Change, which must have been constructed with createChange().
+  /// This is the main function used to track Sandbox IR changes.
+  void track(IRChangeBase *Change) {
     assert(State == TrackerState::Record && "The tracker should be tracking!");
 #ifndef NDEBUG
     assert(!InMiddleOfCreatingChange &&
@@ -483,7 +506,7 @@ public:
     if (isTracking())
       InMiddleOfCreatingChange = true;
 #endif // NDEBUG
-    Changes.push_back(std::move(Change));
+    Changes.push_back(Change);
 
 #ifndef NDEBUG
     InMiddleOfCreatingChange = false;
@@ -492,10 +515,10 @@ public:
   /// A convenience wrapper for `track()` that constructs and tracks the Change
   /// object if tracking is enabled. \Returns true if tracking is enabled.
   template <typename ChangeT, typename... ArgsT>
-  bool emplaceIfTracking(ArgsT... Args) {
+  bool emplaceIfTracking(ArgsT &&...Args) {
     if (!isTracking())
       return false;
-    track(std::make_unique<ChangeT>(Args...));
+    track(createChange<ChangeT>(std::forward<ArgsT>(Args)...));
     return true;
   }
   /// \Returns true if the tracker is recording changes.
@@ -508,6 +531,19 @@ public:
   void accept();
   /// Stops tracking and reverts to saved state.
   void revert();
+  /// An opaque position in the list of tracked changes. See getCheckpoint().
+  using CheckpointTy = size_t;
+  /// \Returns a checkpoint at the current end of the list of tracked changes.
+  /// Only valid while tracking, and invalidated by revert(), accept() and by
+  /// revertToCheckpoint() to an earlier checkpoint.
+  CheckpointTy getCheckpoint() const {
+    assert(State == TrackerState::Record && "Forgot to save()!");
+    return Changes.size();
+  }
+  /// Reverts and discards the changes tracked after \p Chkpnt, in reverse
+  /// order, and keeps on tracking. Unlike revert(), the cost is proportional
+  /// to the changes made since the checkpoint, not to the whole transaction.
+  void revertToCheckpoint(CheckpointTy Chkpnt);
 
 #ifndef NDEBUG
   void dump(raw_ostream &OS) const;
@@ -16,6 +16,8 @@
 #define LLVM_SUPPORT_CACHING_H
 
 #include "llvm/Support/Error.h"
+#include <atomic>
+#include <memory>
 
 namespace llvm {
 
@@ -65,8 +67,18 @@ using FileCacheFunction = std::function<Expected<AddStreamFn>(
 ///
 /// CacheDirectoryPath stores the directory path where cached files are kept.
 struct FileCache {
-  FileCache(FileCacheFunction CacheFn, const std::string &DirectoryPath)
-      : CacheFunction(std::move(CacheFn)), CacheDirectoryPath(DirectoryPath) {}
+  /// Cumulative hit/miss counts, maintained by the caching function. Shared
+  /// so that FileCache remains copyable and the counts survive copies handed
+  /// to backend threads.
+  struct CacheStats {
+    std::atomic<uint64_t> Hits{0};
+    std::atomic<uint64_t> Misses{0};
+  };
+
+  FileCache(FileCacheFunction CacheFn, const std::string &DirectoryPath,
+            std::shared_ptr<CacheStats> Stats = nullptr)
+      : CacheFunction(std::move(CacheFn)), CacheDirectoryPath(DirectoryPath),
+        Stats(std::move(Stats)) {}
   FileCache() = default;
 
   Expected<AddStreamFn> operator()(unsigned Task, StringRef Key,
@@ -79,9 +91,14 @@ struct FileCache {
   }
   bool isValid() const { return static_cast<bool>(CacheFunction); }
 
+  /// Returns the hit/miss counters, or null if the caching function does not
+  /// maintain any.
+  const CacheStats *getStats() const { return Stats.get(); }
+
 private:
   FileCacheFunction CacheFunction = nullptr;
   std::string CacheDirectoryPath;
+  std::shared_ptr<CacheStats> Stats;
 };
 
 /// This type defines the callback to add a pre-existing file (e.g. in a cache).
@@ -34,6 +34,12 @@ public:
     /// Don't use mmap and instead write an in-memory buffer to a file when this
     /// buffer is closed.
     F_no_mmap = 2,
+
+    /// Skip all-zero ranges when writing an in-memory buffer to a file,
+    /// leaving holes the filesystem can keep sparse. Mmap'ed buffers are
+    /// already sparse wherever no page was dirtied, so this only affects the
+    /// non-mmap path.
+    F_sparse = 4,
   };
 
   /// Factory method to create an OutputBuffer object which manages a read/write
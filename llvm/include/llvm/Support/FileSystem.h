@@ -1296,6 +1296,7 @@ private:
 
   void unmapImpl();
   void dontNeedImpl();
+  void willNeedImpl();
 
   std::error_code init(sys::fs::file_t FD, uint64_t Offset, mapmode Mode);
 
@@ -1326,6 +1327,7 @@ public:
     copyFrom(mapped_file_region());
   }
   void dontNeed() { dontNeedImpl(); }
+  void willNeed() { willNeedImpl(); }
 
   size_t size() const;
   char *data() const;
@@ -82,6 +82,13 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// For read-only MemoryBuffer_MMap, hint that the whole buffer will be
+  /// accessed soon so the kernel can start reading it ahead of the faults.
+  /// This calls madvise(MADV_WILLNEED) on read-only file mappings on *NIX
+  /// systems and is a no-op for non-mmap buffers, whose contents are already
+  /// resident.
+  virtual void willNeedIfMmap() {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
@@ -0,0 +1,86 @@
+//===- NewlineScanner.h - Fast scan for line terminators --------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides a fast scanner for '\n' and '\r' characters, used when
+// building line-offset tables for diagnostics. It processes 16 bytes per step
+// with SSE2 compare/movemask where available and falls back to a branchless
+// word-at-a-time scan elsewhere.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_NEWLINESCANNER_H
+#define LLVM_SUPPORT_NEWLINESCANNER_H
+
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/Endian.h"
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace llvm {
+namespace support {
+
+#ifndef __SSE2__
+namespace detail {
+
+/// Returns a mask with 0x80 set in every byte of \p x whose value is in
+/// [m, n]. May also flag values just outside the range; callers must verify
+/// candidate bytes.
+template <class T>
+static constexpr inline T likelyHasBetween(T x, unsigned char m,
+                                           unsigned char n) {
+  return ((x - ~static_cast<T>(0) / 255 * (n + 1)) & ~x &
+          ((x & ~static_cast<T>(0) / 255 * 127) +
+           (~static_cast<T>(0) / 255 * (127 - (m - 1))))) &
+         ~static_cast<T>(0) / 255 * 128;
+}
+
+} // namespace detail
+#endif
+
+/// Returns a pointer to the first '\n' or '\r' in [Buf, End), or End if
+/// there is none. Callers are responsible for any '\r\n' folding.
+inline const char *findNextLineTerminator(const char *Buf, const char *End) {
+#ifdef __SSE2__
+  const __m128i LF = _mm_set1_epi8('\n');
+  const __m128i CR = _mm_set1_epi8('\r');
+  while (End - Buf >= 16) {
+    __m128i Chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(Buf));
+    int Mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, LF), _mm_cmpeq_epi8(Chunk, CR)));
+    if (Mask != 0)
+      return Buf + countr_zero(static_cast<unsigned>(Mask));
+    Buf += 16;
+  }
+#else
+  // Scan a word at a time for a byte in ['\n', '\r']. The range test also
+  // matches '\v' and '\f', so candidates are re-checked below.
+  while (End - Buf >= static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+    uint64_t Word = endian::read64(Buf, llvm::endianness::little);
+    if (uint64_t Mask = detail::likelyHasBetween(Word, '\n', '\r')) {
+      Buf += countr_zero(Mask) / 8;
+      if (*Buf == '\n' || *Buf == '\r')
+        return Buf;
+      ++Buf;
+      continue;
+    }
+    Buf += sizeof(uint64_t);
+  }
+#endif
+  while (Buf != End && *Buf != '\n' && *Buf != '\r')
+    ++Buf;
+  return Buf;
+}
+
+} // namespace support
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_NEWLINESCANNER_H
@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace llvm {
 
@@ -99,6 +100,11 @@ public:
   // exactly in the order which they were spawned.
   void spawn(std::function<void()> f);
 
+  // Spawn a batch of tasks with a single submission to the executor. This is
+  // cheaper than calling spawn() in a loop when handing many small tasks to
+  // the pool at once, as the workers are only notified once.
+  void spawnBatch(std::vector<std::function<void()>> Fs);
+
   void sync() const { L.sync(); }
 
   bool isParallel() const { return Parallel; }
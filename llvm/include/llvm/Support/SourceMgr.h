@@ -48,7 +48,8 @@ private:
     std::unique_ptr<MemoryBuffer> Buffer;
 
     /// Vector of offsets into Buffer at which there are line-endings
-    /// (lazily populated). Once populated, the '\n' that marks the end of
+    /// (populated lazily, a chunk of the buffer at a time as queries
+    /// require). Once populated, the '\n' that marks the end of
     /// line number N from [1..] is at Buffer[OffsetCache[N-1]]. Since
     /// these offsets are in sorted (ascending) order, they can be
     /// binary-searched for the first one after any given offset (eg. an
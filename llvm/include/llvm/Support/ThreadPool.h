@@ -27,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -52,6 +53,11 @@ class ThreadPoolInterface {
   virtual void asyncEnqueue(std::function<void()> Task,
                             ThreadPoolTaskGroup *Group) = 0;
 
+  /// Enqueue a batch of tasks with a single synchronization event, to be
+  /// defined by the concrete implementation.
+  virtual void asyncBatchEnqueue(std::vector<std::function<void()>> Tasks,
+                                 ThreadPoolTaskGroup *Group) = 0;
+
 public:
   /// Destroying the pool will drain the pending tasks and wait. The current
   /// thread may participate in the execution of the pending tasks.
@@ -104,6 +110,20 @@ public:
                      &Group);
   }
 
+  /// Asynchronous submission of a batch of tasks with a single
+  /// synchronization event on the queue. Prefer this over calling async() in
+  /// a loop when submitting many small tasks at once; completion is observed
+  /// through wait() or the task group rather than per-task futures.
+  void asyncBatch(std::vector<std::function<void()>> Tasks) {
+    asyncBatchEnqueue(std::move(Tasks), nullptr);
+  }
+
+  /// Overload, tasks will be in the given task group.
+  void asyncBatch(ThreadPoolTaskGroup &Group,
+                  std::vector<std::function<void()>> Tasks) {
+    asyncBatchEnqueue(std::move(Tasks), &Group);
+  }
+
 private:
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
@@ -178,6 +198,24 @@ private:
     grow(requestedThreads);
   }
 
+  /// Batched submission: push all tasks under one queue lock and wake all the
+  /// workers once, instead of taking the lock and signaling per task.
+  void asyncBatchEnqueue(std::vector<std::function<void()>> TaskVec,
+                         ThreadPoolTaskGroup *Group) override {
+    if (TaskVec.empty())
+      return;
+    int requestedThreads;
+    {
+      std::unique_lock<std::mutex> LockGuard(QueueLock);
+      assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+      for (std::function<void()> &Task : TaskVec)
+        Tasks.emplace_back(std::make_pair(std::move(Task), Group));
+      requestedThreads = ActiveThreads + Tasks.size();
+    }
+    QueueCondition.notify_all();
+    grow(requestedThreads);
+  }
+
   /// Grow to ensure that we have at least `requested` Threads, but do not go
   /// over MaxThreadCount.
   void grow(int requested);
@@ -247,6 +285,12 @@ private:
     Tasks.emplace_back(std::make_pair(std::move(Task), Group));
   }
 
+  void asyncBatchEnqueue(std::vector<std::function<void()>> TaskVec,
+                         ThreadPoolTaskGroup *Group) override {
+    for (std::function<void()> &Task : TaskVec)
+      Tasks.emplace_back(std::make_pair(std::move(Task), Group));
+  }
+
   /// Tasks waiting for execution in the pool.
   std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>> Tasks;
 };
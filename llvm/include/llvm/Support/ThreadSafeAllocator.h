@@ -18,11 +18,9 @@ namespace llvm {
 /// Thread-safe allocator adaptor. Uses a spin lock on the assumption that
 /// contention here is extremely rare.
 ///
-/// TODO: Using a spin lock on every allocation can be quite expensive when
-/// contention is high. Since this is mainly used for BumpPtrAllocator and
-/// SpecificBumpPtrAllocator, it'd be better to have a specific thread-safe
-/// BumpPtrAllocator implementation that only use a fair lock when allocating a
-/// new slab but otherwise using atomic and be lock-free.
+/// Note: when contention is high and bump-pointer semantics are acceptable,
+/// prefer ThreadSafeBumpPtrAllocator, which only takes a lock when a thread
+/// exhausts its cached slab.
 template <class AllocatorType> class ThreadSafeAllocator {
   struct LockGuard {
     LockGuard(std::atomic_flag &Flag) : Flag(Flag) {
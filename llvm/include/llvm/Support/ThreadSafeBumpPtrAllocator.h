@@ -0,0 +1,202 @@
+//===- ThreadSafeBumpPtrAllocator.h -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the ThreadSafeBumpPtrAllocator class, a bump-pointer
+/// allocator that may be shared by any set of threads. Unlike
+/// parallel::PerThreadAllocator it does not require callers to run on
+/// ThreadPoolExecutor threads, and unlike ThreadSafeAllocator it does not
+/// take a lock on every allocation: each thread bumps within a slab it has
+/// cached locally and only touches the shared state when the slab is
+/// exhausted. Slabs retired by Reset() are returned to a shared pool and
+/// recycled in O(1).
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_THREADSAFEBUMPPTRALLOCATOR_H
+#define LLVM_SUPPORT_THREADSAFEBUMPPTRALLOCATOR_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Alignment.h"
+#include "llvm/Support/AllocatorBase.h"
+#include "llvm/Support/Compiler.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace llvm {
+
+/// A thread-safe allocator with bump-pointer semantics.
+///
+/// Memory is handed out from fixed-size slabs. Each thread caches the slab it
+/// is currently filling, so the fast path is a thread-local pointer bump; the
+/// shared slab pool, protected by a mutex, is consulted only when a thread's
+/// slab runs out. Allocations larger than half a slab get their own custom
+/// slab, as with BumpPtrAllocator.
+///
+/// Allocate() may be called concurrently from any thread. Reset() and the
+/// destructor must not race with allocations; Reset() retires every slab to
+/// the shared free pool so a subsequent round of parallel allocation reuses
+/// the memory instead of going back to malloc.
+class ThreadSafeBumpPtrAllocator
+    : public AllocatorBase<ThreadSafeBumpPtrAllocator> {
+public:
+  static constexpr size_t SlabSize = 64 * 1024;
+
+  ThreadSafeBumpPtrAllocator() : ID(nextID()) {}
+  ThreadSafeBumpPtrAllocator(const ThreadSafeBumpPtrAllocator &) = delete;
+  ThreadSafeBumpPtrAllocator &
+  operator=(const ThreadSafeBumpPtrAllocator &) = delete;
+
+  ~ThreadSafeBumpPtrAllocator() {
+    for (void *Slab : Slabs)
+      deallocate_buffer(Slab, SlabSize, alignof(std::max_align_t));
+    for (auto [Ptr, Size] : CustomSizedSlabs)
+      deallocate_buffer(Ptr, Size, alignof(std::max_align_t));
+  }
+
+  using AllocatorBase<ThreadSafeBumpPtrAllocator>::Allocate;
+  using AllocatorBase<ThreadSafeBumpPtrAllocator>::Deallocate;
+
+  /// Allocate \a Size bytes of \a Alignment aligned memory. Safe to call
+  /// concurrently from any thread.
+  void *Allocate(size_t Size, size_t Alignment) {
+    assert(Alignment > 0 && "0-byte alignment is not allowed. Use 1 instead.");
+    assert(Alignment <= alignof(std::max_align_t) &&
+           "Alignment beyond max_align_t is not supported.");
+
+    // Oversized requests bypass the slab caches entirely.
+    if (LLVM_UNLIKELY(Size > SlabSize / 2))
+      return allocateCustomSized(Size, Alignment);
+
+    ThreadCache &Cache = getThreadCache(this, ID);
+    if (LLVM_LIKELY(Cache.Owner == this && Cache.OwnerID == ID)) {
+      uintptr_t Aligned = alignAddr(Cache.CurPtr, Align(Alignment));
+      if (LLVM_LIKELY(Aligned + Size <= (uintptr_t)Cache.End)) {
+        Cache.CurPtr = (char *)(Aligned + Size);
+        BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+        return (void *)Aligned;
+      }
+    }
+    return allocateFromNewSlab(Cache, Size, Alignment);
+  }
+
+  /// Deallocation is a no-op, as for all bump-pointer allocators.
+  void Deallocate(const void *, size_t, size_t) {}
+
+  /// Retire all slabs to the shared free pool and forget all outstanding
+  /// allocations. Must not race with Allocate() on other threads. Stale
+  /// thread caches are invalidated lazily via the allocator ID, so no
+  /// cross-thread synchronization is needed here.
+  void Reset() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    ID = nextID();
+    FreeSlabs.assign(Slabs.begin(), Slabs.end());
+    for (auto [Ptr, Size] : CustomSizedSlabs)
+      deallocate_buffer(Ptr, Size, alignof(std::max_align_t));
+    CustomSizedSlabs.clear();
+    BytesAllocated.store(0, std::memory_order_relaxed);
+  }
+
+  size_t getBytesAllocated() const {
+    return BytesAllocated.load(std::memory_order_relaxed);
+  }
+
+  size_t getTotalMemory() const {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    size_t Total = Slabs.size() * SlabSize;
+    for (auto [Ptr, Size] : CustomSizedSlabs) {
+      (void)Ptr;
+      Total += Size;
+    }
+    return Total;
+  }
+
+private:
+  /// Per-thread slab cursor. Entries identify their allocator by pointer and
+  /// ID; the ID changes on every construction and Reset(), so an entry left
+  /// behind for a destroyed or reset allocator is never dereferenced, merely
+  /// discarded on the next lookup. Kept POD so the TLS needs no destructor.
+  struct ThreadCache {
+    const void *Owner;
+    uint64_t OwnerID;
+    char *CurPtr;
+    char *End;
+  };
+
+  /// Find this thread's cached cursor for \p Owner, or evict an entry
+  /// round-robin to make room for one. The table is small so a thread
+  /// interleaving allocations from a few allocators keeps a fast path for
+  /// each of them.
+  static ThreadCache &getThreadCache(const void *Owner, uint64_t OwnerID) {
+    static LLVM_THREAD_LOCAL ThreadCache Caches[8];
+    static LLVM_THREAD_LOCAL unsigned NextVictim;
+    for (ThreadCache &Cache : Caches)
+      if (Cache.Owner == Owner && Cache.OwnerID == OwnerID)
+        return Cache;
+    ThreadCache &Victim = Caches[NextVictim++ % 8];
+    Victim.Owner = nullptr;
+    return Victim;
+  }
+
+  static uint64_t nextID() {
+    static std::atomic<uint64_t> NextID{1};
+    return NextID.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void *allocateCustomSized(size_t Size, size_t Alignment) {
+    void *Ptr = allocate_buffer(Size, alignof(std::max_align_t));
+    (void)Alignment;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    CustomSizedSlabs.push_back({Ptr, Size});
+    BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+    return Ptr;
+  }
+
+  LLVM_ATTRIBUTE_NOINLINE void *allocateFromNewSlab(ThreadCache &Cache,
+                                                    size_t Size,
+                                                    size_t Alignment) {
+    char *Slab;
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (!FreeSlabs.empty()) {
+        Slab = (char *)FreeSlabs.pop_back_val();
+      } else {
+        Slab = (char *)allocate_buffer(SlabSize, alignof(std::max_align_t));
+        Slabs.push_back(Slab);
+      }
+    }
+    // Abandon whatever tail was left in the old cached slab; the slab itself
+    // stays owned by its allocator's slab list.
+    Cache.Owner = this;
+    Cache.OwnerID = ID;
+    Cache.CurPtr = Slab;
+    Cache.End = Slab + SlabSize;
+    uintptr_t Aligned = alignAddr(Cache.CurPtr, Align(Alignment));
+    assert(Aligned + Size <= (uintptr_t)Cache.End && "Slab cannot fit request");
+    Cache.CurPtr = (char *)(Aligned + Size);
+    BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+    return (void *)Aligned;
+  }
+
+  /// Unique identity of this allocator's current epoch, used to invalidate
+  /// thread caches across Reset() and destruction.
+  uint64_t ID;
+
+  mutable std::mutex Mutex;
+  SmallVector<void *, 8> Slabs;
+  SmallVector<void *, 8> FreeSlabs;
+  SmallVector<std::pair<void *, size_t>, 0> CustomSizedSlabs;
+  std::atomic<size_t> BytesAllocated{0};
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_THREADSAFEBUMPPTRALLOCATOR_H
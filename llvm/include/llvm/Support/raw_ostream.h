@@ -13,6 +13,7 @@
 #ifndef LLVM_SUPPORT_RAW_OSTREAM_H
 #define LLVM_SUPPORT_RAW_OSTREAM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DataTypes.h"
@@ -381,6 +382,16 @@ private:
   virtual uint64_t current_pos() const = 0;
 
 protected:
+  /// Write several discontiguous chunks to the underlying stream as if they
+  /// were concatenated. The default implementation calls \c write_impl once
+  /// per non-empty chunk; subclasses backed by a file descriptor may override
+  /// this with a scatter/gather write to avoid extra syscalls or copies.
+  ///
+  /// Like \c write_impl, this is only called at a point at which it is safe
+  /// for the subclass to install a new buffer via SetBuffer, and the first
+  /// chunk, if the stream is buffered, starts at the buffer.
+  virtual void write_vectored_impl(ArrayRef<StringRef> Chunks);
+
   /// Use the provided buffer as the raw_ostream buffer. This is intended for
   /// use only by subclasses which can arrange for the output to go directly
   /// into the desired output buffer, instead of being copied on each flush.
@@ -481,6 +492,12 @@ class raw_fd_ostream : public raw_pwrite_stream {
   /// See raw_ostream::write_impl.
   void write_impl(const char *Ptr, size_t Size) override;
 
+#ifndef _WIN32
+  /// See raw_ostream::write_vectored_impl. Gathers the chunks into a single
+  /// ::writev call where possible.
+  void write_vectored_impl(ArrayRef<StringRef> Chunks) override;
+#endif
+
   void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
 
   /// Return the current position within the stream, not counting the bytes
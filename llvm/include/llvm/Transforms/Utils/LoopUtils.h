@@ -13,6 +13,7 @@
 #ifndef LLVM_TRANSFORMS_UTILS_LOOPUTILS_H
 #define LLVM_TRANSFORMS_UTILS_LOOPUTILS_H
 
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Analysis/IVDescriptors.h"
 #include "llvm/Analysis/LoopAccessAnalysis.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
@@ -132,12 +133,21 @@ public:
   bool tooManyClobberingCalls() { return LicmMssaOptCounter >= LicmMssaOptCap; }
   void incrementClobberingCalls() { ++LicmMssaOptCounter; }
 
+  /// Return the set of blocks of \p L that contain a MemoryDef, computing it
+  /// on the first call for a given loop. The set is not updated as
+  /// instructions are sunk out of the loop; it can only over-approximate,
+  /// which makes the sinking legality check conservative.
+  const SmallPtrSetImpl<const BasicBlock *> &
+  getBlocksWithMemoryDefs(const Loop &L, MemorySSA &MSSA);
+
 protected:
   bool NoOfMemAccTooLarge = false;
   unsigned LicmMssaOptCounter = 0;
   unsigned LicmMssaOptCap;
   unsigned LicmMssaNoAccForPromotionCap;
   bool IsSink;
+  SmallPtrSet<const BasicBlock *, 8> BlocksWithMemoryDefs;
+  const Loop *BlocksWithMemoryDefsLoop = nullptr;
 };
 
 /// Walk the specified region of the CFG (defined by all blocks
@@ -48,6 +48,7 @@
 #include "llvm/IR/Type.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
+#include "llvm/IR/ValueHandle.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
@@ -72,6 +73,11 @@ static cl::opt<bool> EnableRecPhiAnalysis("basic-aa-recphi", cl::Hidden,
 static cl::opt<bool> EnableSeparateStorageAnalysis("basic-aa-separate-storage",
                                                    cl::Hidden, cl::init(true));
 
+/// Memoize DecomposeGEPExpression results across queries on the same result
+/// object, so repeated queries on the same pointers do not re-walk GEP chains.
+static cl::opt<bool> EnableGEPDecompositionCache("basic-aa-gep-cache",
+                                                 cl::Hidden, cl::init(false));
+
 /// SearchLimitReached / SearchTimes shows how often the limit of
 /// to decompose GEPs is reached. It will affect the precision
 /// of basic alias analysis.
@@ -564,6 +570,90 @@ struct BasicAAResult::DecomposedGEP {
   }
 };
 
+/// A map from queried pointers to their decomposition, flushed whenever a
+/// value any cached decomposition refers to is deleted or replaced.
+///
+/// Decompositions are structural facts about a chain of GEPs, so they can go
+/// stale in only two ways: a value in the chain dies or is RAUW'd (observed
+/// via the callback handles below), or an intermediate operand is rewritten
+/// in place without RAUW. The latter cannot be observed, which is why this
+/// cache is opt-in via -basic-aa-gep-cache.
+class BasicAAResult::DecomposedGEPCache {
+  class CacheVH final : public CallbackVH {
+    DecomposedGEPCache *Cache;
+
+    // A decomposition may depend transitively on values we hold no handle
+    // for, so any observable change conservatively drops everything. The
+    // flush destroys this handle; *this must not be touched afterwards.
+    void deleted() override { Cache->clear(); }
+    void allUsesReplacedWith(Value *) override { Cache->clear(); }
+
+  public:
+    CacheVH(Value *V = nullptr, DecomposedGEPCache *Cache = nullptr)
+        : CallbackVH(V), Cache(Cache) {}
+  };
+  friend class CacheVH;
+
+  DenseMap<const Value *, DecomposedGEP> Entries;
+
+  /// One handle per distinct value referenced by any entry: the queried
+  /// pointer itself, its base, and each variable index.
+  DenseMap<const Value *, CacheVH> Handles;
+
+  void watch(const Value *V) {
+    Handles.try_emplace(V, const_cast<Value *>(V), this);
+  }
+
+public:
+  const DecomposedGEP *lookup(const Value *V) const {
+    auto It = Entries.find(V);
+    return It == Entries.end() ? nullptr : &It->second;
+  }
+
+  void insert(const Value *V, const DecomposedGEP &Decomposed) {
+    Entries.try_emplace(V, Decomposed);
+    watch(V);
+    watch(Decomposed.Base);
+    for (const VariableGEPIndex &Index : Decomposed.VarIndices)
+      watch(Index.Val.V);
+  }
+
+  void clear() {
+    Entries.clear();
+    Handles.clear();
+  }
+};
+
+BasicAAResult::BasicAAResult(const DataLayout &DL, const Function &F,
+                             const TargetLibraryInfo &TLI, AssumptionCache &AC,
+                             DominatorTree *DT)
+    : DL(DL), F(F), TLI(TLI), AC(AC), DT_(DT) {}
+
+BasicAAResult::BasicAAResult(const BasicAAResult &Arg)
+    : AAResultBase(Arg), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI), AC(Arg.AC),
+      DT_(Arg.DT_) {}
+
+BasicAAResult::BasicAAResult(BasicAAResult &&Arg)
+    : AAResultBase(std::move(Arg)), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI),
+      AC(Arg.AC), DT_(Arg.DT_) {}
+
+BasicAAResult::~BasicAAResult() = default;
+
+BasicAAResult::DecomposedGEP
+BasicAAResult::getDecomposedGEP(const Value *V, AssumptionCache *AC,
+                                DominatorTree *DT) {
+  if (!EnableGEPDecompositionCache)
+    return DecomposeGEPExpression(V, DL, AC, DT);
+
+  if (!DecompCache)
+    DecompCache = std::make_unique<DecomposedGEPCache>();
+  if (const DecomposedGEP *Cached = DecompCache->lookup(V))
+    return *Cached;
+
+  DecomposedGEP Decomposed = DecomposeGEPExpression(V, DL, AC, DT);
+  DecompCache->insert(V, Decomposed);
+  return Decomposed;
+}
 
 /// If V is a symbolic pointer expression, decompose it into a base pointer
 /// with a constant offset and a number of scaled symbolic offsets.
@@ -1083,8 +1173,8 @@ AliasResult BasicAAResult::aliasGEP(
   }
 
   DominatorTree *DT = getDT(AAQI);
-  DecomposedGEP DecompGEP1 = DecomposeGEPExpression(GEP1, DL, &AC, DT);
-  DecomposedGEP DecompGEP2 = DecomposeGEPExpression(V2, DL, &AC, DT);
+  DecomposedGEP DecompGEP1 = getDecomposedGEP(GEP1, &AC, DT);
+  DecomposedGEP DecompGEP2 = getDecomposedGEP(V2, &AC, DT);
 
   // Bail if we were not able to decompose anything.
   if (DecompGEP1.Base == GEP1 && DecompGEP2.Base == V2)
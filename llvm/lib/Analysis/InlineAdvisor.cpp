@@ -51,6 +51,11 @@ static cl::opt<bool> EnableInlineDeferral("inline-deferral", cl::init(false),
                                           cl::Hidden,
                                           cl::desc("Enable deferred inlining"));
 
+static cl::opt<bool> MemoizeInlineCosts(
+    "inline-memoize-costs", cl::init(true), cl::Hidden,
+    cl::desc("Reuse inline cost analysis results for call sites that are "
+             "re-evaluated within an inliner pass run"));
+
 // An integer used to limit the cost of inline deferral.  The default negative
 // number tells shouldBeDeferred to only take the secondary cost into account.
 static cl::opt<int>
@@ -119,6 +124,10 @@ void DefaultInlineAdvice::recordUnsuccessfulInliningImpl(
 }
 
 void DefaultInlineAdvice::recordInliningWithCalleeDeletedImpl() {
+  if (OwningAdvisor) {
+    OwningAdvisor->forgetFunction(Caller);
+    OwningAdvisor->forgetFunction(Callee);
+  }
   if (EmitRemarks)
     emitInlinedIntoBasedOnCost(ORE, DLoc, Block, *Callee, *Caller, *OIC,
                                /* ForProfileContext= */ false,
@@ -126,6 +135,8 @@ void DefaultInlineAdvice::recordInliningWithCalleeDeletedImpl() {
 }
 
 void DefaultInlineAdvice::recordInliningImpl() {
+  if (OwningAdvisor)
+    OwningAdvisor->forgetFunction(Caller);
   if (EmitRemarks)
     emitInlinedIntoBasedOnCost(ORE, DLoc, Block, *Callee, *Caller, *OIC,
                                /* ForProfileContext= */ false,
@@ -133,7 +144,8 @@ void DefaultInlineAdvice::recordInliningImpl() {
 }
 
 std::optional<llvm::InlineCost> static getDefaultInlineAdvice(
-    CallBase &CB, FunctionAnalysisManager &FAM, const InlineParams &Params) {
+    CallBase &CB, FunctionAnalysisManager &FAM, const InlineParams &Params,
+    DefaultInlineAdvisor *MemoizingAdvisor = nullptr) {
   Function &Caller = *CB.getCaller();
   ProfileSummaryInfo *PSI =
       FAM.getResult<ModuleAnalysisManagerFunctionProxy>(Caller)
@@ -157,8 +169,15 @@ std::optional<llvm::InlineCost> static getDefaultInlineAdvice(
     bool RemarksEnabled =
         Callee.getContext().getDiagHandlerPtr()->isMissedOptRemarkEnabled(
             DEBUG_TYPE);
-    return getInlineCost(CB, Params, CalleeTTI, GetAssumptionCache, GetTLI,
-                         GetBFI, PSI, RemarksEnabled ? &ORE : nullptr);
+    auto Compute = [&] {
+      return getInlineCost(CB, Params, CalleeTTI, GetAssumptionCache, GetTLI,
+                           GetBFI, PSI, RemarksEnabled ? &ORE : nullptr);
+    };
+    // Reusing a memoized result would swallow the per-call-site analysis
+    // remarks, so bypass the cache when they are enabled.
+    if (!MemoizingAdvisor || !MemoizeInlineCosts || RemarksEnabled)
+      return Compute();
+    return MemoizingAdvisor->getMemoizedInlineCost(CB, CalleeTTI, Compute);
   };
   return llvm::shouldInline(
       CB, CalleeTTI, GetInlineCost, ORE,
@@ -167,10 +186,35 @@ std::optional<llvm::InlineCost> static getDefaultInlineAdvice(
 
 std::unique_ptr<InlineAdvice>
 DefaultInlineAdvisor::getAdviceImpl(CallBase &CB) {
-  auto OIC = getDefaultInlineAdvice(CB, FAM, Params);
+  auto OIC = getDefaultInlineAdvice(CB, FAM, Params, this);
   return std::make_unique<DefaultInlineAdvice>(
       this, CB, OIC,
-      FAM.getResult<OptimizationRemarkEmitterAnalysis>(*CB.getCaller()));
+      FAM.getResult<OptimizationRemarkEmitterAnalysis>(*CB.getCaller()),
+      /*EmitRemarks=*/true, /*OwningAdvisor=*/this);
+}
+
+InlineCost
+DefaultInlineAdvisor::getMemoizedInlineCost(CallBase &CB,
+                                            const TargetTransformInfo &CalleeTTI,
+                                            function_ref<InlineCost()> Compute) {
+  std::pair<const CallBase *, const TargetTransformInfo *> Key(&CB, &CalleeTTI);
+  auto It = CostCache.find(Key);
+  if (It != CostCache.end())
+    return It->second.IC;
+  InlineCost IC = Compute();
+  CostCache.try_emplace(
+      Key, CachedInlineCost{CB.getCaller(), CB.getCalledFunction(), IC});
+  return IC;
+}
+
+void DefaultInlineAdvisor::forgetFunction(const Function *F) {
+  SmallVector<std::pair<const CallBase *, const TargetTransformInfo *>, 8>
+      Stale;
+  for (const auto &[Key, Cached] : CostCache)
+    if (Cached.Caller == F || Cached.Callee == F)
+      Stale.push_back(Key);
+  for (const auto &Key : Stale)
+    CostCache.erase(Key);
 }
 
 InlineAdvice::InlineAdvice(InlineAdvisor *Advisor, CallBase &CB,
@@ -0,0 +1,24 @@
+//===- KnownBitsCache.cpp - Memoized known-bits queries -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/KnownBitsCache.h"
+
+using namespace llvm;
+
+// A cached result can depend transitively on any value reachable from the
+// key, so deleting or replacing one cached value conservatively drops
+// everything rather than trying to track dependencies.
+
+void KnownBitsCache::ValueCallbackVH::deleted() {
+  // This handle is destroyed by the flush; do not touch *this afterwards.
+  Cache->clear();
+}
+
+void KnownBitsCache::ValueCallbackVH::allUsesReplacedWith(Value *) {
+  Cache->clear();
+}
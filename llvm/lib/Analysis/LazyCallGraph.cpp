@@ -26,6 +26,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 
@@ -1970,6 +1971,51 @@ void LazyCallGraph::buildRefSCCs() {
       });
 }
 
+void LazyCallGraph::visitRefSCCsBottomUpParallel(
+    ThreadPoolInterface &Pool, function_ref<void(RefSCC &)> Fn) {
+  // Materialize the full postorder sequence so the RefSCC DAG is complete
+  // before we inspect it.
+  for (RefSCC &RC : postorder_ref_sccs())
+    (void)RC;
+
+  size_t NumRCs = PostOrderRefSCCs.size();
+  if (!NumRCs)
+    return;
+
+  // Dependents[I] lists the RefSCCs referencing PostOrderRefSCCs[I], which
+  // cannot start until it finishes; RemainingDeps[I] counts the distinct
+  // RefSCCs that PostOrderRefSCCs[I] still waits on. Postorder guarantees
+  // every referenced RefSCC precedes its referrers, so the DAG is acyclic
+  // and the counts drain to zero.
+  std::vector<SmallVector<int, 4>> Dependents(NumRCs);
+  std::vector<std::atomic<int>> RemainingDeps(NumRCs);
+  for (size_t I = 0; I != NumRCs; ++I) {
+    RefSCC &RC = *PostOrderRefSCCs[I];
+    SmallPtrSet<RefSCC *, 4> Children;
+    for (SCC &C : RC)
+      for (Node &N : C)
+        for (Edge &E : *N) {
+          RefSCC *ChildRC = lookupRefSCC(E.getNode());
+          if (ChildRC && ChildRC != &RC && Children.insert(ChildRC).second)
+            Dependents[getRefSCCIndex(*ChildRC)].push_back(I);
+        }
+    RemainingDeps[I].store(Children.size(), std::memory_order_relaxed);
+  }
+
+  ThreadPoolTaskGroup Group(Pool);
+  std::function<void(int)> Visit = [&](int I) {
+    Fn(*PostOrderRefSCCs[I]);
+    for (int Dependent : Dependents[I])
+      if (RemainingDeps[Dependent].fetch_sub(1, std::memory_order_acq_rel) ==
+          1)
+        Group.async(Visit, Dependent);
+  };
+  for (size_t I = 0; I != NumRCs; ++I)
+    if (RemainingDeps[I].load(std::memory_order_relaxed) == 0)
+      Group.async(Visit, (int)I);
+  Group.wait();
+}
+
 void LazyCallGraph::visitReferences(SmallVectorImpl<Constant *> &Worklist,
                                     SmallPtrSetImpl<Constant *> &Visited,
                                     function_ref<void(Function &)> Callback) {
@@ -119,6 +119,11 @@ class LazyValueInfoCache {
     // std::nullopt indicates that the nonnull pointers for this basic block
     // block have not been computed yet.
     std::optional<NonNullPointerSet> NonNullPointers;
+    // Set when the block's CFG changes. The entry's contents are stale and
+    // ignored by lookups; the allocation is reset and reused the next time
+    // a result is inserted for the block. This makes eraseBlock O(1) instead
+    // of deallocating and rebuilding the per-block maps on every CFG edit.
+    bool Invalidated = false;
   };
 
   /// Cached information per basic block.
@@ -129,7 +134,7 @@ class LazyValueInfoCache {
 
   const BlockCacheEntry *getBlockEntry(BasicBlock *BB) const {
     auto It = BlockCache.find_as(BB);
-    if (It == BlockCache.end())
+    if (It == BlockCache.end() || It->second->Invalidated)
       return nullptr;
     return It->second.get();
   }
@@ -139,7 +144,15 @@ class LazyValueInfoCache {
     if (It == BlockCache.end())
       It = BlockCache.insert({BB, std::make_unique<BlockCacheEntry>()}).first;
 
-    return It->second.get();
+    BlockCacheEntry *Entry = It->second.get();
+    if (Entry->Invalidated) {
+      // Lazily drop stale contents, reusing the allocation.
+      Entry->LatticeElements.clear();
+      Entry->OverDefined.clear();
+      Entry->NonNullPointers.reset();
+      Entry->Invalidated = false;
+    }
+    return Entry;
   }
 
   void addValueHandle(Value *Val) {
@@ -232,7 +245,12 @@ void LVIValueHandle::deleted() {
 }
 
 void LazyValueInfoCache::eraseBlock(BasicBlock *BB) {
-  BlockCache.erase(BB);
+  // Invalidate lazily rather than erasing: passes like JumpThreading and
+  // CorrelatedValuePropagation call this for every block they touch, and
+  // dropping the entry would deallocate maps we are about to repopulate.
+  auto It = BlockCache.find_as(BB);
+  if (It != BlockCache.end())
+    It->second->Invalidated = true;
 }
 
 void LazyValueInfoCache::threadEdgeImpl(BasicBlock *OldSucc,
@@ -269,7 +287,8 @@ void LazyValueInfoCache::threadEdgeImpl(BasicBlock *OldSucc,
 
     // If a value was marked overdefined in OldSucc, and is here too...
     auto OI = BlockCache.find_as(ToUpdate);
-    if (OI == BlockCache.end() || OI->second->OverDefined.empty())
+    if (OI == BlockCache.end() || OI->second->Invalidated ||
+        OI->second->OverDefined.empty())
       continue;
     auto &ValueSet = OI->second->OverDefined;
 
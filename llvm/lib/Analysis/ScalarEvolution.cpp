@@ -5655,7 +5655,11 @@ ScalarEvolution::createAddRecFromPHIWithCastsImpl(const SCEVUnknown *SymbolicPHI
   std::pair<const SCEV *, SmallVector<const SCEVPredicate *, 3>> PredRewrite =
       std::make_pair(NewAR, Predicates);
   // Remember the result of the analysis for this SCEV at this locayyytion.
-  PredicatedSCEVRewrites[{SymbolicPHI, L}] = PredRewrite;
+  auto [RewriteIt, Inserted] =
+      PredicatedSCEVRewrites.try_emplace({SymbolicPHI, L});
+  RewriteIt->second = PredRewrite;
+  if (Inserted)
+    PredicatedRewriteUsers[L].push_back(SymbolicPHI);
   return PredRewrite;
 }
 
@@ -5687,7 +5691,11 @@ ScalarEvolution::createAddRecFromPHIWithCasts(const SCEVUnknown *SymbolicPHI) {
   // Record in the cache that the analysis failed
   if (!Rewrite) {
     SmallVector<const SCEVPredicate *, 3> Predicates;
-    PredicatedSCEVRewrites[{SymbolicPHI, L}] = {SymbolicPHI, Predicates};
+    auto [RewriteIt, Inserted] =
+        PredicatedSCEVRewrites.try_emplace({SymbolicPHI, L});
+    RewriteIt->second = {SymbolicPHI, Predicates};
+    if (Inserted)
+      PredicatedRewriteUsers[L].push_back(SymbolicPHI);
     return std::nullopt;
   }
 
@@ -8468,6 +8476,7 @@ void ScalarEvolution::forgetAllLoops() {
   HasRecMap.clear();
   ConstantMultipleCache.clear();
   PredicatedSCEVRewrites.clear();
+  PredicatedRewriteUsers.clear();
   FoldCache.clear();
   FoldCacheUser.clear();
 }
@@ -8508,13 +8517,11 @@ void ScalarEvolution::forgetLoop(const Loop *L) {
     forgetBackedgeTakenCounts(CurrL, /* Predicated */ true);
 
     // Drop information about predicated SCEV rewrites for this loop.
-    for (auto I = PredicatedSCEVRewrites.begin();
-         I != PredicatedSCEVRewrites.end();) {
-      std::pair<const SCEV *, const Loop *> Entry = I->first;
-      if (Entry.second == CurrL)
-        PredicatedSCEVRewrites.erase(I++);
-      else
-        ++I;
+    auto RewriteUsersIt = PredicatedRewriteUsers.find(CurrL);
+    if (RewriteUsersIt != PredicatedRewriteUsers.end()) {
+      for (const SCEVUnknown *S : RewriteUsersIt->second)
+        PredicatedSCEVRewrites.erase({S, CurrL});
+      PredicatedRewriteUsers.erase(RewriteUsersIt);
     }
 
     auto LoopUsersItr = LoopUsers.find(CurrL);
@@ -13687,6 +13694,7 @@ ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
       SCEVAllocator(std::move(Arg.SCEVAllocator)),
       LoopUsers(std::move(Arg.LoopUsers)),
       PredicatedSCEVRewrites(std::move(Arg.PredicatedSCEVRewrites)),
+      PredicatedRewriteUsers(std::move(Arg.PredicatedRewriteUsers)),
       FirstUnknown(Arg.FirstUnknown) {
   Arg.FirstUnknown = nullptr;
 }
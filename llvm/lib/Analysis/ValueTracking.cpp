@@ -29,6 +29,7 @@
 #include "llvm/Analysis/DomConditionCache.h"
 #include "llvm/Analysis/GuardUtils.h"
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/KnownBitsCache.h"
 #include "llvm/Analysis/Loads.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
@@ -152,6 +153,15 @@ static void computeKnownBits(const Value *V, const APInt &DemandedElts,
 
 void llvm::computeKnownBits(const Value *V, KnownBits &Known, unsigned Depth,
                             const SimplifyQuery &Q) {
+  // A memoized full-depth result is valid at any depth: it can only be more
+  // precise than what the depth-limited recursion would compute.
+  if (Q.KBC) {
+    if (std::optional<KnownBits> Cached = Q.KBC->lookup(V, Q.CxtI)) {
+      Known = *Cached;
+      return;
+    }
+  }
+
   // Since the number of lanes in a scalable vector is unknown at compile time,
   // we track one bit which is implicitly broadcast to all lanes.  This means
   // that all lanes in a scalable vector are considered demanded.
@@ -159,6 +169,11 @@ void llvm::computeKnownBits(const Value *V, KnownBits &Known, unsigned Depth,
   APInt DemandedElts =
       FVTy ? APInt::getAllOnes(FVTy->getNumElements()) : APInt(1, 1);
   ::computeKnownBits(V, DemandedElts, Known, Depth, Q);
+
+  // Only top-level results are cached; deeper queries are truncated by the
+  // recursion limit and may be weaker than a fresh full-depth computation.
+  if (Q.KBC && Depth == 0)
+    Q.KBC->insert(V, Q.CxtI, Known);
 }
 
 void llvm::computeKnownBits(const Value *V, KnownBits &Known,
@@ -7025,11 +7025,22 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (StripDebugInfo)
     stripDebugInfo(*F);
 
-  // Upgrade any old intrinsic calls in the function.
-  for (auto &I : UpgradedIntrinsics) {
-    for (User *U : llvm::make_early_inc_range(I.first->materialized_users()))
-      if (CallInst *CI = dyn_cast<CallInst>(U))
-        UpgradeIntrinsicCall(CI, I.second);
+  // Upgrade any old intrinsic calls in the function. Walking this function's
+  // instructions and looking up the callee keeps the work proportional to the
+  // function's size; iterating each old intrinsic's module-wide user list
+  // here would rescan, on every materialization, users that sit in function
+  // bodies which were already upgraded or have not been parsed yet.
+  if (!UpgradedIntrinsics.empty()) {
+    SmallVector<std::pair<CallInst *, Function *>, 8> CallsToUpgrade;
+    for (Instruction &I : instructions(F))
+      if (auto *CI = dyn_cast<CallInst>(&I))
+        if (Function *Callee = CI->getCalledFunction()) {
+          auto UI = UpgradedIntrinsics.find(Callee);
+          if (UI != UpgradedIntrinsics.end())
+            CallsToUpgrade.push_back({CI, UI->second});
+        }
+    for (auto &[CI, NewFn] : CallsToUpgrade)
+      UpgradeIntrinsicCall(CI, NewFn);
   }
 
   // Finish fn->subprogram upgrade for materialized functions.
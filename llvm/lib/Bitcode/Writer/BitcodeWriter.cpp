@@ -94,6 +94,16 @@ static cl::opt<uint32_t> FlushThreshold(
     "bitcode-flush-threshold", cl::Hidden, cl::init(512),
     cl::desc("The threshold (unit M) for flushing LLVM bitcode."));
 
+static cl::opt<bool> AdaptiveMetadataAbbrevs(
+    "bitcode-adaptive-metadata-abbrevs", cl::Hidden, cl::init(false),
+    cl::desc("Sample metadata record frequency in the module being written "
+             "and emit dedicated abbreviations for the hot record kinds"));
+
+static cl::opt<unsigned> AdaptiveAbbrevThreshold(
+    "bitcode-adaptive-abbrev-threshold", cl::Hidden, cl::init(64),
+    cl::desc("Number of records of one metadata kind above which a dedicated "
+             "abbreviation pays for its definition"));
+
 static cl::opt<bool> WriteRelBFToSummary(
     "write-relbf-to-summary", cl::Hidden, cl::init(false),
     cl::desc("Write relative block frequency to function summary "));
@@ -2433,7 +2443,10 @@ void ModuleBitcodeWriter::writeModuleMetadata() {
   if (!VE.hasMDs() && M.named_metadata_empty())
     return;
 
-  Stream.EnterSubblock(bitc::METADATA_BLOCK_ID, 4);
+  // The adaptive mode defines extra per-kind abbreviations, so it needs a
+  // wider abbrev-id space; the extra bit per record is won back by the
+  // dedicated encodings.
+  Stream.EnterSubblock(bitc::METADATA_BLOCK_ID, AdaptiveMetadataAbbrevs ? 5 : 4);
   SmallVector<uint64_t, 64> Record;
 
   // Emit all abbrevs upfront, so that the reader can jump in the middle of the
@@ -2445,6 +2458,71 @@ void ModuleBitcodeWriter::writeModuleMetadata() {
   MDAbbrevs[MetadataAbbrev::GenericDINodeAbbrevID] =
       createGenericDINodeAbbrev();
 
+  if (AdaptiveMetadataAbbrevs) {
+    // Sample how often each metadata kind occurs in this module and define a
+    // dedicated abbreviation for the hot kinds: the record code as a literal
+    // plus a VBR6 array covering all fields. This removes the per-record
+    // unabbreviated framing (VBR6 code and operand count), which adds up in
+    // metadata-heavy debug-info modules. Only kinds whose writer emits a
+    // single record code are eligible; MDTuple switches between NODE and
+    // DISTINCT_NODE and keeps the generic encoding.
+    static constexpr struct {
+      Metadata::MetadataKind Kind;
+      MetadataAbbrev Slot;
+      bitc::MetadataCodes Code;
+    } HotKinds[] = {
+        {Metadata::DIEnumeratorKind, DIEnumeratorAbbrevID,
+         bitc::METADATA_ENUMERATOR},
+        {Metadata::DIBasicTypeKind, DIBasicTypeAbbrevID,
+         bitc::METADATA_BASIC_TYPE},
+        {Metadata::DIFileKind, DIFileAbbrevID, bitc::METADATA_FILE},
+        {Metadata::DIDerivedTypeKind, DIDerivedTypeAbbrevID,
+         bitc::METADATA_DERIVED_TYPE},
+        {Metadata::DICompositeTypeKind, DICompositeTypeAbbrevID,
+         bitc::METADATA_COMPOSITE_TYPE},
+        {Metadata::DISubroutineTypeKind, DISubroutineTypeAbbrevID,
+         bitc::METADATA_SUBROUTINE_TYPE},
+        {Metadata::DISubprogramKind, DISubprogramAbbrevID,
+         bitc::METADATA_SUBPROGRAM},
+        {Metadata::DILexicalBlockKind, DILexicalBlockAbbrevID,
+         bitc::METADATA_LEXICAL_BLOCK},
+        {Metadata::DILexicalBlockFileKind, DILexicalBlockFileAbbrevID,
+         bitc::METADATA_LEXICAL_BLOCK_FILE},
+        {Metadata::DINamespaceKind, DINamespaceAbbrevID,
+         bitc::METADATA_NAMESPACE},
+        {Metadata::DITemplateTypeParameterKind, DITemplateTypeParameterAbbrevID,
+         bitc::METADATA_TEMPLATE_TYPE},
+        {Metadata::DITemplateValueParameterKind,
+         DITemplateValueParameterAbbrevID, bitc::METADATA_TEMPLATE_VALUE},
+        {Metadata::DIGlobalVariableKind, DIGlobalVariableAbbrevID,
+         bitc::METADATA_GLOBAL_VAR},
+        {Metadata::DILocalVariableKind, DILocalVariableAbbrevID,
+         bitc::METADATA_LOCAL_VAR},
+        {Metadata::DILabelKind, DILabelAbbrevID, bitc::METADATA_LABEL},
+        {Metadata::DIExpressionKind, DIExpressionAbbrevID,
+         bitc::METADATA_EXPRESSION},
+        {Metadata::DIGlobalVariableExpressionKind,
+         DIGlobalVariableExpressionAbbrevID, bitc::METADATA_GLOBAL_VAR_EXPR},
+        {Metadata::DIImportedEntityKind, DIImportedEntityAbbrevID,
+         bitc::METADATA_IMPORTED_ENTITY},
+    };
+
+    DenseMap<unsigned, unsigned> KindCounts;
+    for (const Metadata *MD : VE.getNonMDStrings())
+      if (const MDNode *N = dyn_cast<MDNode>(MD))
+        ++KindCounts[N->getMetadataID()];
+
+    for (const auto &HK : HotKinds) {
+      if (KindCounts.lookup(HK.Kind) < AdaptiveAbbrevThreshold)
+        continue;
+      auto Abbv = std::make_shared<BitCodeAbbrev>();
+      Abbv->Add(BitCodeAbbrevOp(HK.Code));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+      MDAbbrevs[HK.Slot] = Stream.EmitAbbrev(std::move(Abbv));
+    }
+  }
+
   auto Abbv = std::make_shared<BitCodeAbbrev>();
   Abbv->Add(BitCodeAbbrevOp(bitc::METADATA_INDEX_OFFSET));
   Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
@@ -2815,6 +2815,20 @@ void AsmPrinter::emitConstantPool() {
     CPSections[SecIdx].CPEs.push_back(i);
   }
 
+  // Constants are uniqued in the LLVMContext, so identical pool entries from
+  // different functions share their Constant and can be merged by equating
+  // symbols. Skip XCOFF, where symbol equating is not generally available,
+  // and group sections, which may be discarded at link time, taking the
+  // merged copy with them.
+  auto IsMergeableCPSection = [&](const MCSection *S) {
+    if (TM.getTargetTriple().isOSBinFormatXCOFF())
+      return false;
+    if (auto *ELFSec = dyn_cast<MCSectionELF>(S))
+      if (ELFSec->getGroup())
+        return false;
+    return true;
+  };
+
   // Now print stuff into the calculated sections.
   const MCSection *CurSection = nullptr;
   unsigned Offset = 0;
@@ -2825,6 +2839,21 @@ void AsmPrinter::emitConstantPool() {
       if (!Sym->isUndefined())
         continue;
 
+      MachineConstantPoolEntry CPE = CP[CPI];
+
+      // If an earlier function emitted this constant into the same section,
+      // equate this function's symbol with the existing copy.
+      std::pair<MCSymbol *, Align> *Reuse = nullptr;
+      if (!CPE.isMachineConstantPoolEntry() &&
+          IsMergeableCPSection(CPSections[i].S)) {
+        Reuse = &EmittedCPConstants[{CPSections[i].S, CPE.Val.ConstVal}];
+        if (Reuse->first && Reuse->second >= CPE.getAlign()) {
+          OutStreamer->emitAssignment(
+              Sym, MCSymbolRefExpr::create(Reuse->first, OutContext));
+          continue;
+        }
+      }
+
       if (CurSection != CPSections[i].S) {
         OutStreamer->switchSection(CPSections[i].S);
         emitAlignment(Align(CPSections[i].Alignment));
@@ -2832,8 +2861,6 @@ void AsmPrinter::emitConstantPool() {
         Offset = 0;
       }
 
-      MachineConstantPoolEntry CPE = CP[CPI];
-
       // Emit inter-object padding for alignment.
       unsigned NewOffset = alignTo(Offset, CPE.getAlign());
       OutStreamer->emitZeros(NewOffset - Offset);
@@ -2841,10 +2868,13 @@ void AsmPrinter::emitConstantPool() {
       Offset = NewOffset + CPE.getSizeInBytes(getDataLayout());
 
       OutStreamer->emitLabel(Sym);
-      if (CPE.isMachineConstantPoolEntry())
+      if (CPE.isMachineConstantPoolEntry()) {
         emitMachineConstantPoolValue(CPE.Val.MachineCPVal);
-      else
+      } else {
         emitGlobalConstant(getDataLayout(), CPE.Val.ConstVal);
+        if (Reuse)
+          *Reuse = {Sym, CPE.getAlign()};
+      }
     }
   }
 }
@@ -134,10 +134,10 @@ DIEAbbrevSet::~DIEAbbrevSet() {
 }
 
 DIEAbbrev &DIEAbbrevSet::uniqueAbbreviation(DIE &Die) {
-
+  // Profile the DIE directly; almost every DIE resolves to an existing
+  // abbreviation, and the hit path should not pay for materializing one.
   FoldingSetNodeID ID;
-  DIEAbbrev Abbrev = Die.generateAbbrev();
-  Abbrev.Profile(ID);
+  Die.profileAbbrev(ID);
 
   void *InsertPos;
   if (DIEAbbrev *Existing =
@@ -147,7 +147,7 @@ DIEAbbrev &DIEAbbrevSet::uniqueAbbreviation(DIE &Die) {
   }
 
   // Move the abbreviation to the heap and assign a number.
-  DIEAbbrev *New = new (Alloc) DIEAbbrev(std::move(Abbrev));
+  DIEAbbrev *New = new (Alloc) DIEAbbrev(Die.generateAbbrev());
   Abbreviations.push_back(New);
   New->setNumber(Abbreviations.size());
   Die.setAbbrevNumber(Abbreviations.size());
@@ -182,6 +182,18 @@ DIEAbbrev DIE::generateAbbrev() const {
   return Abbrev;
 }
 
+void DIE::profileAbbrev(FoldingSetNodeID &ID) const {
+  // Must match DIEAbbrev::Profile applied to generateAbbrev()'s result.
+  ID.AddInteger(unsigned(Tag));
+  ID.AddInteger(unsigned(hasChildren()));
+  for (const DIEValue &V : values()) {
+    ID.AddInteger(unsigned(V.getAttribute()));
+    ID.AddInteger(unsigned(V.getForm()));
+    if (V.getForm() == dwarf::DW_FORM_implicit_const)
+      ID.AddInteger(V.getDIEInteger().getValue());
+  }
+}
+
 uint64_t DIE::getDebugSectionOffset() const {
   const DIEUnit *Unit = getUnit();
   assert(Unit && "DIE must be owned by a DIEUnit to get its absolute offset");
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/CodeGen/GlobalMergeFunctions.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/ModuleSummaryAnalysis.h"
 #include "llvm/CGData/CodeGenData.h"
@@ -18,7 +19,9 @@
 #include "llvm/IR/StructuralHash.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
+#include <optional>
 
 #define DEBUG_TYPE "global-merge-func"
 
@@ -178,27 +181,42 @@ static Value *createCast(IRBuilder<> &Builder, Value *V, Type *DestTy) {
   return Builder.CreateBitCast(V, DestTy);
 }
 
+/// Compute the stable hashes of \p Funcs in parallel. Hashing only reads the
+/// IR and each invocation writes to a distinct slot of the result vector, so
+/// no synchronization is needed.
+static SmallVector<std::optional<FunctionHashInfo>>
+computeHashInfos(ArrayRef<Function *> Funcs) {
+  SmallVector<std::optional<FunctionHashInfo>> HashInfos(Funcs.size());
+  parallelFor(0, Funcs.size(), [&](size_t I) {
+    HashInfos[I] = llvm::StructuralHashWithDifferences(*Funcs[I], ignoreOp);
+  });
+  return HashInfos;
+}
+
 void GlobalMergeFunc::analyze(Module &M) {
   ++NumAnalyzedModues;
+  SmallVector<Function *> EligibleFuncs;
   for (Function &Func : M) {
     ++NumAnalyzedFunctions;
     if (isEligibleFunction(&Func)) {
       ++NumEligibleFunctions;
+      EligibleFuncs.push_back(&Func);
+    }
+  }
 
-      auto FI = llvm::StructuralHashWithDifferences(Func, ignoreOp);
-
-      // Convert the operand map to a vector for a serialization-friendly
-      // format.
-      IndexOperandHashVecType IndexOperandHashes;
-      for (auto &Pair : *FI.IndexOperandHashMap)
-        IndexOperandHashes.emplace_back(Pair);
+  auto HashInfos = computeHashInfos(EligibleFuncs);
+  for (auto [Func, FI] : zip(EligibleFuncs, HashInfos)) {
+    // Convert the operand map to a vector for a serialization-friendly
+    // format.
+    IndexOperandHashVecType IndexOperandHashes;
+    for (auto &Pair : *FI->IndexOperandHashMap)
+      IndexOperandHashes.emplace_back(Pair);
 
-      StableFunction SF(FI.FunctionHash, get_stable_name(Func.getName()).str(),
-                        M.getModuleIdentifier(), FI.IndexInstruction->size(),
-                        std::move(IndexOperandHashes));
+    StableFunction SF(FI->FunctionHash, get_stable_name(Func->getName()).str(),
+                      M.getModuleIdentifier(), FI->IndexInstruction->size(),
+                      std::move(IndexOperandHashes));
 
-      LocalFunctionMap->insert(SF);
-    }
+    LocalFunctionMap->insert(SF);
   }
 }
 
@@ -428,13 +446,19 @@ bool GlobalMergeFunc::merge(Module &M, const StableFunctionMap *FunctionMap) {
   DenseMap<stable_hash, SmallVector<std::pair<Function *, FunctionHashInfo>>>
       HashToFuncs;
   auto &Maps = FunctionMap->getFunctionMap();
-  for (auto &F : M) {
-    if (!isEligibleFunction(&F))
-      continue;
-    auto FI = llvm::StructuralHashWithDifferences(F, ignoreOp);
-    if (Maps.contains(FI.FunctionHash))
-      HashToFuncs[FI.FunctionHash].emplace_back(&F, std::move(FI));
-  }
+  SmallVector<Function *> EligibleFuncs;
+  for (auto &F : M)
+    if (isEligibleFunction(&F))
+      EligibleFuncs.push_back(&F);
+
+  auto HashInfos = computeHashInfos(EligibleFuncs);
+  for (auto [F, FI] : zip(EligibleFuncs, HashInfos))
+    if (Maps.contains(FI->FunctionHash))
+      HashToFuncs[FI->FunctionHash].emplace_back(F, std::move(*FI));
+
+  // Per merged hash group, the number of functions merged and their size, to
+  // report the estimated size impact.
+  SmallVector<std::tuple<stable_hash, unsigned, unsigned>> MergedGroups;
 
   for (auto &[Hash, Funcs] : HashToFuncs) {
     std::optional<ParamLocsVecTy> ParamLocsVec;
@@ -493,6 +517,8 @@ bool GlobalMergeFunc::merge(Module &M, const StableFunctionMap *FunctionMap) {
 
     LLVM_DEBUG(dbgs() << "[GlobalMergeFunc] Merging function count "
                       << FuncMergeInfoSize << " for hash:  " << Hash << "\n");
+    MergedGroups.emplace_back(Hash, FuncMergeInfoSize,
+                              (unsigned)RFS->InstCount);
 
     for (auto &FMI : FuncMergeInfos) {
       Changed = true;
@@ -532,6 +558,23 @@ bool GlobalMergeFunc::merge(Module &M, const StableFunctionMap *FunctionMap) {
     }
   }
 
+  // Report the merged groups ranked by their estimated size impact.
+  // Instruction counts stand in for bytes since the final code size is not
+  // known at IR time. Each merged instance is expected to be folded by the
+  // linker's ICF, so a group of N bodies of size S saves roughly N * S
+  // instructions minus the thunk overhead.
+  LLVM_DEBUG({
+    llvm::stable_sort(MergedGroups, [](const auto &L, const auto &R) {
+      return (uint64_t)std::get<1>(L) * std::get<2>(L) >
+             (uint64_t)std::get<1>(R) * std::get<2>(R);
+    });
+    if (!MergedGroups.empty())
+      dbgs() << "[GlobalMergeFunc] Estimated size impact per merged hash:\n";
+    for (auto &[Hash, Count, InstCount] : MergedGroups)
+      dbgs() << "  hash " << Hash << ": " << Count << " merged x " << InstCount
+             << " insts, ~" << (uint64_t)Count * InstCount << " insts saved\n";
+  });
+
   return Changed;
 }
 
@@ -2442,6 +2442,21 @@ bool InstrRefBasedLDV::mlocJoin(
     return false;
   }
 
+  // A block with a single predecessor has no PHIs to examine: its live-in
+  // values are exactly the predecessor's live-outs. Copy them over without
+  // the per-location PHI tests.
+  if (BlockOrders.size() == 1) {
+    const ValueTable &PredOutLocs = OutLocs[*BlockOrders[0]];
+    for (auto Location : MTracker->locations()) {
+      uint64_t Idx = Location.Idx.asU64();
+      if (InLocs[Idx] != PredOutLocs[Idx]) {
+        InLocs[Idx] = PredOutLocs[Idx];
+        Changed = true;
+      }
+    }
+    return Changed;
+  }
+
   // Step through all machine locations, look at each predecessor and test
   // whether we can eliminate redundant PHIs.
   for (auto Location : MTracker->locations()) {
@@ -3235,10 +3250,19 @@ void InstrRefBasedLDV::buildVLocValueMap(
       *LiveIn = DbgValue(BlockNo, EmptyProperties, DbgValue::VPHI);
     }
 
-    for (auto *MBB : BlockOrders) {
-      Worklist.push(BBToOrder[MBB]);
-      OnWorklist.insert(MBB);
-    }
+    // Seed the worklist with only the blocks where this variable's value can
+    // originate: its def blocks and the join points where a VPHI was placed.
+    // Live-ins are unknown (NoVal) everywhere else until a changed live-out
+    // propagates downstream, and the loop below queues successors whenever
+    // that happens, so blocks the value never reaches are never visited.
+    OnWorklist.clear();
+    OnPending.clear();
+    for (MachineBasicBlock *DefMBB : DefBlocks)
+      if (OnWorklist.insert(DefMBB).second)
+        Worklist.push(BBToOrder[DefMBB]);
+    for (MachineBasicBlock *PHIMBB : PHIBlocks)
+      if (OnWorklist.insert(PHIMBB).second)
+        Worklist.push(BBToOrder[PHIMBB]);
 
     // Iterate over all the blocks we selected, propagating the variables value.
     // This loop does two things:
@@ -110,6 +110,8 @@ STATISTIC(NumFailLargeMaxMII, "Pipeliner abort due to MaxMII too large");
 STATISTIC(NumFailZeroMII, "Pipeliner abort due to zero MII");
 STATISTIC(NumFailNoSchedule, "Pipeliner abort due to no schedule found");
 STATISTIC(NumFailZeroStage, "Pipeliner abort due to zero stage");
+STATISTIC(NumFailExhaustedBudget,
+          "Pipeliner abort due to exhausted scheduling budget");
 STATISTIC(NumFailLargeMaxStage, "Pipeliner abort due to too many stages");
 
 /// A command line option to turn software pipelining on or off.
@@ -180,6 +182,14 @@ static cl::opt<int> SwpIISearchRange("pipeliner-ii-search-range",
                                      cl::desc("Range to search for II"),
                                      cl::Hidden, cl::init(10));
 
+static cl::opt<unsigned> SwpMaxCycleProbes(
+    "pipeliner-max-cycle-probes",
+    cl::desc("Maximum cumulative number of cycles probed across all II "
+             "candidates before giving up on swing modulo scheduling "
+             "(0 = no limit). A loop abandoned this way can still be "
+             "pipelined by the window scheduler."),
+    cl::Hidden, cl::init(0));
+
 static cl::opt<bool>
     LimitRegPressure("pipeliner-register-pressure", cl::Hidden, cl::init(false),
                      cl::desc("Limit register pressure of scheduled loop"));
@@ -2417,7 +2427,9 @@ bool SwingSchedulerDAG::schedulePipeline(SMSchedule &Schedule) {
     HRPDetector->init(RegClassInfo);
   }
   // Keep increasing II until a valid schedule is found.
-  for (unsigned II = MII; II <= MAX_II && !scheduleFound; ++II) {
+  bool BudgetExhausted = false;
+  for (unsigned II = MII; II <= MAX_II && !scheduleFound && !BudgetExhausted;
+       ++II) {
     Schedule.reset();
     Schedule.setInitiationInterval(II);
     LLVM_DEBUG(dbgs() << "Try to schedule with " << II << "\n");
@@ -2425,6 +2437,21 @@ bool SwingSchedulerDAG::schedulePipeline(SMSchedule &Schedule) {
     SetVector<SUnit *>::iterator NI = NodeOrder.begin();
     SetVector<SUnit *>::iterator NE = NodeOrder.end();
     do {
+      // Bail out of the entire II search once the cumulative number of
+      // probed cycles exceeds the budget; large loops with large IIs can
+      // otherwise spend unbounded time here. The loop may still be pipelined
+      // by the window scheduler when SMS gives up.
+      if (SwpMaxCycleProbes != 0 &&
+          Schedule.getNumCycleProbes() > SwpMaxCycleProbes) {
+        LLVM_DEBUG(dbgs() << "Scheduling budget exhausted after "
+                          << Schedule.getNumCycleProbes()
+                          << " cycle probes, giving up.\n");
+        NumFailExhaustedBudget++;
+        scheduleFound = false;
+        BudgetExhausted = true;
+        break;
+      }
+
       SUnit *SU = *NI;
 
       // Compute the schedule time for the instruction, which is based
@@ -2786,6 +2813,7 @@ bool SMSchedule::insert(SUnit *SU, int StartCycle, int EndCycle, int II) {
   int termCycle = forward ? EndCycle + 1 : EndCycle - 1;
   for (int curCycle = StartCycle; curCycle != termCycle;
        forward ? ++curCycle : --curCycle) {
+    ++NumCycleProbes;
 
     if (ST.getInstrInfo()->isZeroCost(SU->getInstr()->getOpcode()) ||
         ProcItinResources.canReserveResources(*SU, curCycle)) {
@@ -158,6 +158,11 @@ static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
 static cl::opt<bool> EnableCyclicPath("misched-cyclicpath", cl::Hidden,
   cl::desc("Enable cyclic critical path analysis."), cl::init(true));
 
+static cl::opt<bool> MISchedReuseIdenticalRegions(
+    "misched-reuse-identical-regions", cl::Hidden, cl::init(false),
+    cl::desc("Reuse the computed schedule of a region for later regions that "
+             "are identical up to virtual register numbering."));
+
 static cl::opt<bool> EnableMemOpCluster("misched-cluster", cl::Hidden,
                                         cl::desc("Enable memop clustering."),
                                         cl::init(true));
@@ -534,9 +539,161 @@ struct SchedRegion {
               unsigned N) :
     RegionBegin(B), RegionEnd(E), NumRegionInstrs(N) {}
 };
+/// The schedule computed for a region fingerprint: the positions of the
+/// region's instructions (in original program order) in scheduled order.
+struct ReusableRegionSchedule {
+  SmallVector<uint64_t, 0> Fingerprint;
+  SmallVector<unsigned, 0> Order;
+};
 } // end anonymous namespace
 
 using MBBRegionsVector = SmallVector<SchedRegion, 16>;
+using RegionScheduleCache = DenseMap<uint64_t, ReusableRegionSchedule>;
+
+/// Append a stable encoding of \p MO to \p FP, or return false if the operand
+/// kind cannot be encoded. Virtual registers are canonicalized by order of
+/// first occurrence (recorded in \p VRegIndex) so that regions cloned with
+/// different register numbers compare equal; physical registers must match
+/// exactly.
+static bool encodeOperand(const MachineOperand &MO,
+                          const MachineRegisterInfo &MRI,
+                          DenseMap<Register, unsigned> &VRegIndex,
+                          SmallVectorImpl<uint64_t> &FP) {
+  switch (MO.getType()) {
+  case MachineOperand::MO_Register: {
+    Register Reg = MO.getReg();
+    uint64_t Word = uint64_t(MO.getSubReg()) << 32 |
+                    uint64_t(MO.isDef()) << 8 | uint64_t(MO.isImplicit()) << 9 |
+                    uint64_t(MO.isUndef()) << 10 |
+                    uint64_t(MO.isInternalRead()) << 11 |
+                    uint64_t(MO.isEarlyClobber()) << 12;
+    if (Reg.isVirtual()) {
+      const TargetRegisterClass *RC = MRI.getRegClassOrNull(Reg);
+      if (!RC)
+        return false;
+      unsigned Idx = VRegIndex.try_emplace(Reg, VRegIndex.size()).first->second;
+      FP.push_back(Word | 1);
+      FP.push_back(uint64_t(Idx) << 16 | RC->getID());
+    } else {
+      FP.push_back(Word);
+      FP.push_back(Reg.id());
+    }
+    return true;
+  }
+  case MachineOperand::MO_Immediate:
+    FP.push_back(MO.getType());
+    FP.push_back(uint64_t(MO.getImm()));
+    return true;
+  case MachineOperand::MO_CImmediate:
+    // Uniqued in the LLVMContext, so the pointer identifies the value.
+    FP.push_back(MO.getType());
+    FP.push_back(reinterpret_cast<uintptr_t>(MO.getCImm()));
+    return true;
+  case MachineOperand::MO_FPImmediate:
+    FP.push_back(MO.getType());
+    FP.push_back(reinterpret_cast<uintptr_t>(MO.getFPImm()));
+    return true;
+  case MachineOperand::MO_FrameIndex:
+  case MachineOperand::MO_JumpTableIndex:
+    FP.push_back(uint64_t(MO.getType()) | uint64_t(MO.getTargetFlags()) << 16);
+    FP.push_back(uint64_t(MO.getIndex()));
+    return true;
+  case MachineOperand::MO_ConstantPoolIndex:
+  case MachineOperand::MO_TargetIndex:
+    FP.push_back(uint64_t(MO.getType()) | uint64_t(MO.getTargetFlags()) << 16);
+    FP.push_back(uint64_t(MO.getIndex()));
+    FP.push_back(uint64_t(MO.getOffset()));
+    return true;
+  case MachineOperand::MO_GlobalAddress:
+    FP.push_back(uint64_t(MO.getType()) | uint64_t(MO.getTargetFlags()) << 16);
+    FP.push_back(reinterpret_cast<uintptr_t>(MO.getGlobal()));
+    FP.push_back(uint64_t(MO.getOffset()));
+    return true;
+  case MachineOperand::MO_ExternalSymbol:
+    FP.push_back(uint64_t(MO.getType()) | uint64_t(MO.getTargetFlags()) << 16);
+    FP.push_back(reinterpret_cast<uintptr_t>(MO.getSymbolName()));
+    FP.push_back(uint64_t(MO.getOffset()));
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Compute a dependence-complete fingerprint of the scheduling region
+/// [\p Begin, \p End), appending the non-debug instructions to \p MIs.
+/// Returns false if the region is not eligible for schedule reuse.
+///
+/// Two regions with equal fingerprints have isomorphic dependence graphs:
+/// eligible instructions carry only register dependences (no memory accesses,
+/// calls, or unmodeled side effects), and equal operand streams imply a
+/// consistent register renaming between the regions. Debug values are
+/// excluded so that reuse behaves identically with and without debug info.
+static bool fingerprintRegion(MachineBasicBlock::iterator Begin,
+                              MachineBasicBlock::iterator End,
+                              const MachineRegisterInfo &MRI,
+                              SmallVectorImpl<uint64_t> &FP,
+                              SmallVectorImpl<MachineInstr *> &MIs) {
+  DenseMap<Register, unsigned> VRegIndex;
+  for (MachineInstr &MI : make_range(Begin, End)) {
+    if (MI.isDebugInstr())
+      continue;
+    if (MI.isDebugOrPseudoInstr() || MI.isBundled() || MI.isInlineAsm() ||
+        MI.isCall() || MI.mayLoadOrStore() || MI.hasUnmodeledSideEffects())
+      return false;
+    MIs.push_back(&MI);
+    FP.push_back(uint64_t(MI.getOpcode()) | uint64_t(MI.getFlags()) << 32);
+    FP.push_back(MI.getNumOperands());
+    for (const MachineOperand &MO : MI.operands())
+      if (!encodeOperand(MO, MRI, VRegIndex, FP))
+        return false;
+  }
+  return MIs.size() > 1;
+}
+
+/// Reorder the region's instructions to match \p Order, the scheduled
+/// positions recorded from an identical region. Debug values stay attached to
+/// the preceding non-debug instruction, mirroring placeDebugValues().
+static void replayRegionSchedule(MachineBasicBlock *MBB,
+                                 MachineBasicBlock::iterator RegionBegin,
+                                 MachineBasicBlock::iterator RegionEnd,
+                                 ArrayRef<MachineInstr *> MIs,
+                                 ArrayRef<unsigned> Order, LiveIntervals *LIS) {
+  // Collect the run of debug values following each non-debug instruction so
+  // they can be moved along with it.
+  DenseMap<MachineInstr *, SmallVector<MachineInstr *, 2>> DbgRuns;
+  MachineInstr *Anchor = nullptr;
+  for (MachineInstr &MI : make_range(RegionBegin, RegionEnd)) {
+    if (MI.isDebugInstr()) {
+      if (Anchor)
+        DbgRuns[Anchor].push_back(&MI);
+    } else {
+      Anchor = &MI;
+    }
+  }
+
+  // Leading debug values stay at the top of the region.
+  MachineBasicBlock::iterator InsertPos = RegionBegin;
+  while (InsertPos != RegionEnd && InsertPos->isDebugInstr())
+    ++InsertPos;
+
+  for (unsigned Idx : Order) {
+    MachineInstr *MI = MIs[Idx];
+    if (InsertPos != RegionEnd && &*InsertPos == MI) {
+      // Already in place; skip past it and its attached debug values.
+      ++InsertPos;
+      while (InsertPos != RegionEnd && InsertPos->isDebugInstr())
+        ++InsertPos;
+      continue;
+    }
+    MBB->splice(InsertPos, MBB, MI);
+    if (LIS)
+      LIS->handleMove(*MI, /*UpdateFlags=*/true);
+    auto DbgIt = DbgRuns.find(MI);
+    if (DbgIt != DbgRuns.end())
+      for (MachineInstr *Dbg : DbgIt->second)
+        MBB->splice(InsertPos, MBB, Dbg);
+  }
+}
 
 static void
 getSchedRegions(MachineBasicBlock *MBB,
@@ -583,6 +740,11 @@ getSchedRegions(MachineBasicBlock *MBB,
 /// Main driver for both MachineScheduler and PostMachineScheduler.
 void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
                                            bool FixKillFlags) {
+  // Schedules computed for eligible regions, reused for later regions with
+  // the same fingerprint. Instruction pointers are not stored, so entries
+  // stay valid as regions are reordered.
+  RegionScheduleCache ScheduleCache;
+
   // Visit all machine basic blocks.
   //
   // TODO: Visit blocks in global postorder or postorder within the bottom-up
@@ -632,6 +794,37 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
         Scheduler.exitRegion();
         continue;
       }
+
+      // If an identical region has been scheduled before, replay its
+      // schedule instead of rebuilding the DAG.
+      SmallVector<uint64_t, 64> Fingerprint;
+      SmallVector<MachineInstr *, 32> RegionMIs;
+      uint64_t FPHash = 0;
+      bool Fingerprinted =
+          MISchedReuseIdenticalRegions &&
+          fingerprintRegion(I, RegionEnd, MF->getRegInfo(), Fingerprint,
+                            RegionMIs);
+      if (Fingerprinted) {
+        FPHash = hash_combine_range(Fingerprint.begin(), Fingerprint.end());
+        auto CacheIt = ScheduleCache.find(FPHash);
+        if (CacheIt != ScheduleCache.end() &&
+            CacheIt->second.Fingerprint == Fingerprint &&
+            CacheIt->second.Order.size() == RegionMIs.size()) {
+          LLVM_DEBUG(dbgs() << "Replaying cached schedule for identical "
+                               "region in "
+                            << printMBBReference(*MBB) << '\n');
+          replayRegionSchedule(&*MBB, I, RegionEnd, RegionMIs,
+                               CacheIt->second.Order, LIS);
+          Scheduler.exitRegion();
+          continue;
+        }
+      }
+
+      // Remember the instruction above the region so the region's new first
+      // instruction can be found after scheduling invalidates 'I'.
+      MachineBasicBlock::iterator AnchorPrev =
+          I == MBB->begin() ? MachineBasicBlock::iterator() : std::prev(I);
+      bool HaveAnchor = I != MBB->begin();
       LLVM_DEBUG(dbgs() << "********** MI Scheduling **********\n");
       LLVM_DEBUG(dbgs() << MF->getName() << ":" << printMBBReference(*MBB)
                         << " " << MBB->getName() << "\n  From: " << *I
@@ -649,6 +842,31 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
       // This invalidates the original region iterators.
       Scheduler.schedule();
 
+      // Record the scheduled order for reuse by later identical regions.
+      if (Fingerprinted && !ScheduleCache.count(FPHash)) {
+        DenseMap<MachineInstr *, unsigned> OrigPos;
+        for (auto [Pos, MI] : enumerate(RegionMIs))
+          OrigPos[MI] = Pos;
+        MachineBasicBlock::iterator NewBegin =
+            HaveAnchor ? std::next(AnchorPrev) : MBB->begin();
+        ReusableRegionSchedule Entry;
+        bool Valid = true;
+        for (MachineInstr &MI : make_range(NewBegin, RegionEnd)) {
+          if (MI.isDebugInstr())
+            continue;
+          auto PosIt = OrigPos.find(&MI);
+          if (PosIt == OrigPos.end()) {
+            Valid = false;
+            break;
+          }
+          Entry.Order.push_back(PosIt->second);
+        }
+        if (Valid && Entry.Order.size() == RegionMIs.size()) {
+          Entry.Fingerprint = std::move(Fingerprint);
+          ScheduleCache[FPHash] = std::move(Entry);
+        }
+      }
+
       // Close the current region.
       Scheduler.exitRegion();
     }
@@ -137,6 +137,13 @@ static cl::opt<bool> GreedyReverseLocalAssignment(
              "shorter local live ranges will tend to be allocated first"),
     cl::Hidden);
 
+static cl::opt<unsigned long> GreedyBoundedWorkThreshold(
+    "greedy-bounded-work-instr-threshold",
+    cl::desc("For functions with more instructions than this threshold, skip "
+             "live-range splitting and spill unassignable ranges directly, "
+             "like the basic allocator. 0 disables the threshold."),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<unsigned> SplitThresholdForRegWithHint(
     "split-threshold-for-reg-with-hint",
     cl::desc("The threshold for splitting a virtual register with a hint, in "
@@ -2475,14 +2482,16 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
   // The first time we see a live range, don't try to split or spill.
   // Wait until the second time, when all smaller ranges have been allocated.
   // This gives a better picture of the interference to split around.
-  if (Stage < RS_Split) {
+  // In bounded-work mode no splitting will happen, so the second round would
+  // be wasted requeueing.
+  if (Stage < RS_Split && !BoundedWorkMode) {
     ExtraInfo->setStage(VirtReg, RS_Split);
     LLVM_DEBUG(dbgs() << "wait for second round\n");
     NewVRegs.push_back(VirtReg.reg());
     return 0;
   }
 
-  if (Stage < RS_Spill && !VirtReg.empty()) {
+  if (Stage < RS_Spill && !VirtReg.empty() && !BoundedWorkMode) {
     // Try splitting VirtReg or interferences.
     unsigned NewVRegSizeBefore = NewVRegs.size();
     Register PhysReg = trySplit(VirtReg, Order, NewVRegs, FixedRegisters);
@@ -2763,6 +2772,12 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
                                ? GreedyReverseLocalAssignment
                                : TRI->reverseLocalAssignment();
 
+  BoundedWorkMode = GreedyBoundedWorkThreshold &&
+                    MF->getInstructionCount() > GreedyBoundedWorkThreshold;
+  LLVM_DEBUG(if (BoundedWorkMode) dbgs()
+             << "Function exceeds the bounded-work threshold, "
+                "live-range splitting disabled.\n");
+
   ExtraInfo.emplace();
   EvictAdvisor =
       getAnalysis<RegAllocEvictionAdvisorAnalysis>().getAdvisor(*MF, *this);
@@ -281,6 +281,11 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// Set for functions whose instruction count exceeds the bounded-work
+  /// threshold. Live-range splitting is skipped so unassignable ranges are
+  /// spilled directly, as the basic allocator would.
+  bool BoundedWorkMode = false;
+
 public:
   RAGreedy(const RegAllocFilterFunc F = nullptr);
 
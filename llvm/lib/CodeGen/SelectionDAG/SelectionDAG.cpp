@@ -1448,8 +1448,11 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 
 void SelectionDAG::clear() {
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
+  // Keep the operand recycler's free lists and the backing slabs for the next
+  // block: allnodes_clear has already returned every operand array to the
+  // recycler, so the next block reuses the memory instead of reallocating it.
+  // Like the node allocator, the operand allocator is only released in the
+  // destructor.
   CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
@@ -1104,12 +1104,22 @@ void DWARFLinkerImpl::forEachCompileUnit(
 }
 
 void DWARFLinkerImpl::patchOffsetsAndSizes() {
+  // Each section only updates its own data, while reading section start
+  // offsets and string pool entries which are all assigned by this point.
+  // Thus patches for different sections may be applied in parallel.
+  SmallVector<std::pair<OutputSections *, SectionDescriptor *>> Sections;
   forEachObjectSectionsSet([&](OutputSections &SectionsSet) {
     SectionsSet.forEach([&](SectionDescriptor &OutSection) {
-      SectionsSet.applyPatches(OutSection, DebugStrStrings, DebugLineStrStrings,
-                               ArtificialTypeUnit.get());
+      Sections.emplace_back(&SectionsSet, &OutSection);
     });
   });
+
+  parallelForEach(Sections,
+                  [&](std::pair<OutputSections *, SectionDescriptor *> &Entry) {
+                    Entry.first->applyPatches(*Entry.second, DebugStrStrings,
+                                              DebugLineStrStrings,
+                                              ArtificialTypeUnit.get());
+                  });
 }
 
 void DWARFLinkerImpl::emitCommonSectionsAndWriteCompileUnitsToTheOutput() {
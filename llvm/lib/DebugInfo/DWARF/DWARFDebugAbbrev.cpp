@@ -143,6 +143,19 @@ void DWARFDebugAbbrev::dump(raw_ostream &OS) const {
 Expected<const DWARFAbbreviationDeclarationSet *>
 DWARFDebugAbbrev::getAbbreviationDeclarationSet(uint64_t CUAbbrOffset) const {
   const auto End = AbbrDeclSets.end();
+  // Once the section has been fully parsed (see parse()) the set map can no
+  // longer change, so lookups are plain reads that may safely happen from
+  // multiple threads at once. Don't touch the single entry iterator cache in
+  // that case; updating it from concurrent lookups would be a data race.
+  if (!Data) {
+    const auto Pos = AbbrDeclSets.find(CUAbbrOffset);
+    if (Pos != End)
+      return &Pos->second;
+    return make_error<llvm::object::GenericBinaryError>(
+        "the abbreviation offset into the .debug_abbrev section is not valid");
+  }
+
+
   if (PrevAbbrOffsetPos != End && PrevAbbrOffsetPos->first == CUAbbrOffset) {
     return &PrevAbbrOffsetPos->second;
   }
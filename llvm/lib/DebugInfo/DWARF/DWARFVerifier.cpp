@@ -33,6 +33,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
@@ -414,6 +415,12 @@ bool DWARFVerifier::handleDebugAbbrev() {
 }
 
 unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
+  // When the context was constructed thread safe, all shared state reached
+  // while verifying a unit is protected, so the units can be verified
+  // concurrently.
+  if (DCtx.isThreadSafe() && Units.getNumUnits() > 1)
+    return verifyUnitsParallel(Units);
+
   unsigned NumDebugInfoErrors = 0;
   ReferenceMap CrossUnitReferences;
 
@@ -442,6 +449,71 @@ unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
   return NumDebugInfoErrors;
 }
 
+unsigned DWARFVerifier::verifyUnitsParallel(const DWARFUnitVector &Units) {
+  // Fully parse the abbreviations up front: lookups into a fully parsed
+  // DWARFDebugAbbrev are read-only, so the tasks below can share it without
+  // locking. A parse failure surfaces again as a missing abbreviation set
+  // when the affected units are verified.
+  if (const DWARFDebugAbbrev *Abbrev = DCtx.getDebugAbbrev())
+    if (Error Err = Abbrev->parse())
+      consumeError(std::move(Err));
+  if (const DWARFDebugAbbrev *AbbrevDWO = DCtx.getDebugAbbrevDWO())
+    if (Error Err = AbbrevDWO->parse())
+      consumeError(std::move(Err));
+
+  // Each task verifies one unit with its own verifier so that both the
+  // detailed output and the aggregated error categories are collected per
+  // unit and can be emitted in unit order below, as if the units had been
+  // verified serially.
+  struct UnitResult {
+    std::string Output;
+    OutputCategoryAggregator Errors;
+    ReferenceMap CrossUnitReferences;
+    unsigned NumErrors = 0;
+  };
+  std::vector<UnitResult> Results(Units.getNumUnits());
+
+  DefaultThreadPool Pool;
+  for (unsigned I = 0, E = Units.getNumUnits(); I != E; ++I)
+    Pool.async([this, &Units, &Results, I, E]() {
+      UnitResult &Result = Results[I];
+      DWARFUnit &Unit = *Units[I];
+      raw_string_ostream UnitOS(Result.Output);
+      UnitOS << "Verifying unit: " << (I + 1) << " / " << E;
+      if (const char *Name = Unit.getUnitDIE(true).getShortName())
+        UnitOS << ", \"" << Name << '\"';
+      UnitOS << '\n';
+      DWARFVerifier UnitVerifier(UnitOS, DCtx, DumpOpts);
+      ReferenceMap UnitLocalReferences;
+      Result.NumErrors += UnitVerifier.verifyUnitContents(
+          Unit, UnitLocalReferences, Result.CrossUnitReferences);
+      Result.NumErrors += UnitVerifier.verifyDebugInfoReferences(
+          UnitLocalReferences, [&](uint64_t) { return &Unit; });
+      Result.Errors = UnitVerifier.ErrorCategory;
+    });
+  Pool.wait();
+
+  unsigned NumDebugInfoErrors = 0;
+  ReferenceMap CrossUnitReferences;
+  for (UnitResult &Result : Results) {
+    OS << Result.Output;
+    OS.flush();
+    ErrorCategory.Merge(Result.Errors);
+    NumDebugInfoErrors += Result.NumErrors;
+    for (const auto &[Offset, Refs] : Result.CrossUnitReferences)
+      CrossUnitReferences[Offset].insert(Refs.begin(), Refs.end());
+  }
+
+  NumDebugInfoErrors += verifyDebugInfoReferences(
+      CrossUnitReferences, [&](uint64_t Offset) -> DWARFUnit * {
+        if (DWARFUnit *U = Units.getUnitForOffset(Offset))
+          return U;
+        return nullptr;
+      });
+
+  return NumDebugInfoErrors;
+}
+
 unsigned DWARFVerifier::verifyUnitSection(const DWARFSection &S) {
   const DWARFObject &DObj = DCtx.getDWARFObj();
   DWARFDataExtractor DebugInfoData(DObj, S, DCtx.isLittleEndian(), 0);
@@ -2181,6 +2253,11 @@ void OutputCategoryAggregator::EnumerateResults(
   }
 }
 
+void OutputCategoryAggregator::Merge(const OutputCategoryAggregator &Other) {
+  for (auto &&[name, count] : Other.Aggregation)
+    Aggregation[name] += count;
+}
+
 void DWARFVerifier::summarize() {
   if (DumpOpts.ShowAggregateErrors && ErrorCategory.GetNumCategories()) {
     error() << "Aggregated error counts:\n";
@@ -15,6 +15,8 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/BTF/BTFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -428,6 +430,34 @@ ObjectFile *LLVMSymbolizer::lookUpBuildIDObject(const std::string &Path,
   return DbgObjOrErr.get();
 }
 
+std::string LLVMSymbolizer::lookUpGsymFile(const std::string &Path) {
+  if (Opts.DisableGsym)
+    return {};
+
+  auto CheckGsymFile = [](const llvm::StringRef &GsymPath) {
+    sys::fs::file_status Status;
+    std::error_code EC = llvm::sys::fs::status(GsymPath, Status);
+    return !EC && !llvm::sys::fs::is_directory(Status);
+  };
+
+  // First, look beside the binary file
+  if (const auto GsymPath = Path + ".gsym"; CheckGsymFile(GsymPath))
+    return GsymPath;
+
+  // Then, look in the directories specified by GsymFileDirectory
+
+  for (const auto &Directory : Opts.GsymFileDirectory) {
+    SmallString<16> GsymPath = llvm::StringRef{Directory};
+    llvm::sys::path::append(
+        GsymPath, llvm::sys::path::filename(Path) + llvm::Twine(".gsym"));
+
+    if (CheckGsymFile(GsymPath))
+      return static_cast<std::string>(GsymPath);
+  }
+
+  return {};
+}
+
 bool LLVMSymbolizer::findDebugBinary(const std::string &OrigPath,
                                      const std::string &DebuglinkName,
                                      uint32_t CRCHash, std::string &Result) {
@@ -660,6 +690,20 @@ LLVMSymbolizer::getOrCreateModuleInfo(StringRef ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
+  if (!Context) {
+    // If there is a GSYM file next to the binary or in one of the
+    // GsymFileDirectory directories, use it instead of parsing DWARF: GSYM is
+    // a prebuilt lookup table, so symbolication skips debug-info parsing
+    // entirely.
+    if (std::string GsymFile = lookUpGsymFile(std::string{BinaryName});
+        !GsymFile.empty()) {
+      if (auto ReaderOrErr = gsym::GsymReader::openFile(GsymFile))
+        Context = std::make_unique<gsym::GsymDIContext>(
+            std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr)));
+      else
+        consumeError(ReaderOrErr.takeError());
+    }
+  }
   if (!Context)
     Context = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
@@ -641,6 +641,14 @@ Error EHFrameNullTerminator::operator()(LinkGraph &G) {
 
 EHFrameRegistrar::~EHFrameRegistrar() = default;
 
+Error EHFrameRegistrar::deregisterEHFrames(
+    ArrayRef<orc::ExecutorAddrRange> EHFrameSections) {
+  Error Err = Error::success();
+  for (auto &EHFrameSection : EHFrameSections)
+    Err = joinErrors(std::move(Err), deregisterEHFrames(EHFrameSection));
+  return Err;
+}
+
 Error InProcessEHFrameRegistrar::registerEHFrames(
     orc::ExecutorAddrRange EHFrameSection) {
   return orc::registerEHFrameSection(EHFrameSection.Start.toPtr<void *>(),
@@ -0,0 +1,82 @@
+//===------ DiskObjectCache.cpp - On-disk object cache for ORC ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/DiskObjectCache.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<DiskObjectCache>>
+DiskObjectCache::Create(StringRef CacheDir, StringRef Salt) {
+  if (auto EC = sys::fs::create_directories(CacheDir))
+    return createStringError(EC, "unable to create cache directory " +
+                                     CacheDir);
+  return std::unique_ptr<DiskObjectCache>(
+      new DiskObjectCache(CacheDir.str(), Salt.str()));
+}
+
+std::string DiskObjectCache::getPathForModule(const Module &M) const {
+  // Key on the content of the module rather than its identifier: modules
+  // that serialize to the same bitcode compile to the same object. The salt
+  // is hashed along with the bitcode so that differing TargetMachine
+  // configurations key to different entries.
+  SmallString<0> KeyData;
+  raw_svector_ostream KeyOS(KeyData);
+  KeyOS << Salt;
+  WriteBitcodeToFile(M, KeyOS);
+  uint64_t Hash = xxh3_64bits(KeyData);
+
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, utohexstr(Hash) + ".o");
+  return std::string(Path);
+}
+
+void DiskObjectCache::notifyObjectCompiled(const Module *M,
+                                           MemoryBufferRef Obj) {
+  std::string Path = getPathForModule(*M);
+
+  // Write to a unique temporary file and rename it into place so that
+  // concurrent readers (including other processes sharing the cache
+  // directory) never observe a partially written entry. Failures only cost
+  // a future cache hit, so they are ignored.
+  SmallString<128> TempPath;
+  int TempFD;
+  if (sys::fs::createUniqueFile(Path + ".tmp%%%%%%", TempFD, TempPath))
+    return;
+  {
+    raw_fd_ostream OS(TempFD, /*shouldClose=*/true);
+    OS << Obj.getBuffer();
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TempPath);
+      return;
+    }
+  }
+  if (sys::fs::rename(TempPath, Path))
+    sys::fs::remove(TempPath);
+}
+
+std::unique_ptr<MemoryBuffer> DiskObjectCache::getObject(const Module *M) {
+  auto Buf = MemoryBuffer::getFile(getPathForModule(*M));
+  if (!Buf)
+    return nullptr;
+  return std::move(*Buf);
+}
+
+} // end namespace orc
+} // end namespace llvm
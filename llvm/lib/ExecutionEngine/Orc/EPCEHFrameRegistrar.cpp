@@ -30,8 +30,18 @@ EPCEHFrameRegistrar::Create(ExecutionSession &ES) {
             rt::DeregisterEHFrameSectionWrapperName}}))
     return std::move(Err);
 
+  // The batched deregistration wrapper is optional: older executors don't
+  // provide it, in which case batch deregistration falls back to one call
+  // per section.
+  ExecutorAddr DeregisterEHFrameSectionsWrapper;
+  if (auto Err = ES.getExecutorProcessControl().getBootstrapSymbols(
+          {{DeregisterEHFrameSectionsWrapper,
+            rt::DeregisterEHFrameSectionsWrapperName}}))
+    consumeError(std::move(Err));
+
   return std::make_unique<EPCEHFrameRegistrar>(
-      ES, RegisterEHFrameSectionWrapper, DeregisterEHFrameSectionWrapper);
+      ES, RegisterEHFrameSectionWrapper, DeregisterEHFrameSectionWrapper,
+      DeregisterEHFrameSectionsWrapper);
 }
 
 Error EPCEHFrameRegistrar::registerEHFrames(ExecutorAddrRange EHFrameSection) {
@@ -45,5 +55,13 @@ Error EPCEHFrameRegistrar::deregisterEHFrames(
       DeregisterEHFrameSectionWrapper, EHFrameSection);
 }
 
+Error EPCEHFrameRegistrar::deregisterEHFrames(
+    ArrayRef<ExecutorAddrRange> EHFrameSections) {
+  if (!DeregisterEHFrameSectionsWrapper || EHFrameSections.size() == 1)
+    return EHFrameRegistrar::deregisterEHFrames(EHFrameSections);
+  return ES.callSPSWrapper<void(SPSExecutorAddrRangeSequence)>(
+      DeregisterEHFrameSectionsWrapper, EHFrameSections);
+}
+
 } // end namespace orc
 } // end namespace llvm
@@ -642,16 +642,18 @@ Error EHFrameRegistrationPlugin::notifyRemovingResources(JITDylib &JD,
     }
   });
 
-  Error Err = Error::success();
-  while (!RangesToRemove.empty()) {
-    auto RangeToRemove = RangesToRemove.back();
-    RangesToRemove.pop_back();
+  if (RangesToRemove.empty())
+    return Error::success();
+
+#ifndef NDEBUG
+  for (auto &RangeToRemove : RangesToRemove)
     assert(RangeToRemove.Start && "Untracked eh-frame range must not be null");
-    Err = joinErrors(std::move(Err),
-                     Registrar->deregisterEHFrames(RangeToRemove));
-  }
+#endif
 
-  return Err;
+  // Removing a resource key may tear down eh-frames for many graphs at once.
+  // Hand the whole batch to the registrar so that remote registrars can
+  // deregister them with a single executor call.
+  return Registrar->deregisterEHFrames(RangesToRemove);
 }
 
 void EHFrameRegistrationPlugin::notifyTransferringResources(
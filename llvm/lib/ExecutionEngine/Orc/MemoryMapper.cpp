@@ -42,9 +42,16 @@ InProcessMemoryMapper::Create() {
 
 void InProcessMemoryMapper::reserve(size_t NumBytes,
                                     OnReservedFunction OnReserved) {
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  // Hint that large slab reservations should be backed by huge pages where
+  // the system supports it: JIT'd code served from huge pages takes fewer
+  // iTLB misses. This is only a hint and degrades to normal pages.
+  static constexpr size_t HugePageSize = 2 << 20;
+  if (NumBytes >= HugePageSize)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+
   std::error_code EC;
-  auto MB = sys::Memory::allocateMappedMemory(
-      NumBytes, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  auto MB = sys::Memory::allocateMappedMemory(NumBytes, nullptr, Flags, EC);
 
   if (EC)
     return OnReserved(errorCodeToError(EC));
@@ -56,6 +56,8 @@ const char *RegisterEHFrameSectionWrapperName =
     "llvm_orc_registerEHFrameSectionWrapper";
 const char *DeregisterEHFrameSectionWrapperName =
     "llvm_orc_deregisterEHFrameSectionWrapper";
+const char *DeregisterEHFrameSectionsWrapperName =
+    "llvm_orc_deregisterEHFrameSectionsWrapper";
 
 const char *RunAsMainWrapperName = "__llvm_orc_bootstrap_run_as_main_wrapper";
 const char *RunAsVoidFunctionWrapperName =
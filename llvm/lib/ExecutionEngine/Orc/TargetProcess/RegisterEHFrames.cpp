@@ -176,3 +176,18 @@ llvm_orc_deregisterEHFrameSectionWrapper(const char *Data, uint64_t Size) {
              Data, Size, deregisterEHFrameWrapper)
       .release();
 }
+
+static Error
+deregisterEHFramesWrapper(std::vector<ExecutorAddrRange> EHFrames) {
+  Error Err = Error::success();
+  for (auto &EHFrame : EHFrames)
+    Err = joinErrors(std::move(Err), deregisterEHFrameWrapper(EHFrame));
+  return Err;
+}
+
+extern "C" orc::shared::CWrapperFunctionResult
+llvm_orc_deregisterEHFrameSectionsWrapper(const char *Data, uint64_t Size) {
+  return WrapperFunction<SPSError(SPSSequence<SPSExecutorAddrRange>)>::handle(
+             Data, Size, deregisterEHFramesWrapper)
+      .release();
+}
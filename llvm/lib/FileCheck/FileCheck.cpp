@@ -1051,9 +1051,49 @@ bool Pattern::parsePattern(StringRef PatternStr, StringRef Prefix,
     RegExStr += '$';
   }
 
+  updateLiteralPrefix();
+
   return false;
 }
 
+void Pattern::updateLiteralPrefix() {
+  LiteralPrefix.clear();
+
+  // A substitution splices arbitrary text into RegExStr at match time, so
+  // only the part of the regex before the first substitution is known here.
+  size_t PrefixEnd = RegExStr.size();
+  for (const auto *Substitution : Substitutions)
+    PrefixEnd = std::min(PrefixEnd, Substitution->getIndex());
+
+  for (size_t I = 0; I != PrefixEnd;) {
+    char C = RegExStr[I];
+    if (C == '\\') {
+      // Only an escaped non-alphanumeric character stands for the character
+      // itself; anything else (a backreference or character class escape)
+      // ends the literal prefix.
+      if (I + 1 == PrefixEnd || isAlnum(RegExStr[I + 1]))
+        break;
+      LiteralPrefix += RegExStr[I + 1];
+      I += 2;
+      continue;
+    }
+    if (StringRef("^$.[]()|").contains(C))
+      break;
+    if (StringRef("*?{").contains(C)) {
+      // These quantifiers allow the preceding character to occur zero times,
+      // so it is not a mandatory part of the prefix. '+' requires at least
+      // one occurrence and so keeps the preceding character.
+      if (!LiteralPrefix.empty())
+        LiteralPrefix.pop_back();
+      break;
+    }
+    if (C == '+')
+      break;
+    LiteralPrefix += C;
+    ++I;
+  }
+}
+
 bool Pattern::AddRegExToRegEx(StringRef RS, unsigned &CurParen, SourceMgr &SM) {
   Regex R(RS);
   std::string Error;
@@ -1141,11 +1181,25 @@ Pattern::MatchResult Pattern::match(StringRef Buffer,
     RegExToMatch = TmpStr;
   }
 
+  // If every match must start with a known literal, skip ahead to the first
+  // occurrence of that literal: searching for a fixed string is much cheaper
+  // than advancing the regex engine through text that cannot contain a match.
+  // The match positions below are computed against the underlying data, so
+  // they are unaffected by the skip.
+  StringRef MatchBuffer = Buffer;
+  if (!LiteralPrefix.empty()) {
+    size_t Pos = IgnoreCase ? Buffer.find_insensitive(LiteralPrefix)
+                            : Buffer.find(LiteralPrefix);
+    if (Pos == StringRef::npos)
+      return make_error<NotFoundError>();
+    MatchBuffer = Buffer.substr(Pos);
+  }
+
   SmallVector<StringRef, 4> MatchInfo;
   unsigned int Flags = Regex::Newline;
   if (IgnoreCase)
     Flags |= Regex::IgnoreCase;
-  if (!Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo))
+  if (!Regex(RegExToMatch, Flags).match(MatchBuffer, &MatchInfo))
     return make_error<NotFoundError>();
 
   // Successful regex match.
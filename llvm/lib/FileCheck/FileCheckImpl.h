@@ -573,6 +573,12 @@ class Pattern {
   /// a fixed string to match.
   std::string RegExStr;
 
+  /// The longest literal string that any match of RegExStr must start with,
+  /// with regex escapes resolved, or empty if no such string is known. Used
+  /// by match() to skip over input that cannot contain a match with a fast
+  /// fixed-string search before running the regex engine.
+  std::string LiteralPrefix;
+
   /// Entries in this vector represent a substitution of a string variable or
   /// an expression in the RegExStr regex at match time. For example, in the
   /// case of a CHECK directive with the pattern "foo[[bar]]baz[[#N+1]]",
@@ -726,6 +732,8 @@ public:
 private:
   bool AddRegExToRegEx(StringRef RS, unsigned &CurParen, SourceMgr &SM);
   void AddBackrefToRegEx(unsigned BackrefNum);
+  /// Recomputes LiteralPrefix from RegExStr and Substitutions.
+  void updateLiteralPrefix();
   /// Computes an arbitrary estimate for the quality of matching this pattern
   /// at the start of \p Buffer; a distance of zero should correspond to a
   /// perfect match.
@@ -36,6 +36,18 @@ using namespace llvm::PatternMatch;
 //                ConstantFold*Instruction Implementations
 //===----------------------------------------------------------------------===//
 
+/// Fetch one element of a vector constant for elementwise folding. Most
+/// vector constants answer getAggregateElement directly, which avoids
+/// materializing an index constant and an extractelement expression for a
+/// value that is immediately folded away; anything else (e.g. a constant
+/// expression) falls back to building the extractelement.
+static Constant *getVectorElement(Constant *C, unsigned Idx) {
+  if (Constant *Elt = C->getAggregateElement(Idx))
+    return Elt;
+  return ConstantExpr::getExtractElement(
+      C, ConstantInt::get(Type::getInt32Ty(C->getContext()), Idx));
+}
+
 /// This function determines which opcode to use to fold two constant cast
 /// expressions together. It uses CastInst::isEliminableCastPair to determine
 /// the opcode. Consequently its just a wrapper around that function.
@@ -175,11 +187,10 @@ Constant *llvm::ConstantFoldCastInstruction(unsigned opc, Constant *V,
           cast<VectorType>(DestTy)->getElementCount(), Res);
     }
     SmallVector<Constant *, 16> res;
-    Type *Ty = IntegerType::get(V->getContext(), 32);
     for (unsigned i = 0,
                   e = cast<FixedVectorType>(V->getType())->getNumElements();
          i != e; ++i) {
-      Constant *C = ConstantExpr::getExtractElement(V, ConstantInt::get(Ty, i));
+      Constant *C = getVectorElement(V, i);
       Constant *Casted = foldMaybeUndesirableCast(opc, C, DstEltTy);
       if (!Casted)
         return nullptr;
@@ -268,13 +279,10 @@ Constant *llvm::ConstantFoldSelectInstruction(Constant *Cond,
   if (ConstantVector *CondV = dyn_cast<ConstantVector>(Cond)) {
     auto *V1VTy = CondV->getType();
     SmallVector<Constant*, 16> Result;
-    Type *Ty = IntegerType::get(CondV->getContext(), 32);
     for (unsigned i = 0, e = V1VTy->getNumElements(); i != e; ++i) {
       Constant *V;
-      Constant *V1Element = ConstantExpr::getExtractElement(V1,
-                                                    ConstantInt::get(Ty, i));
-      Constant *V2Element = ConstantExpr::getExtractElement(V2,
-                                                    ConstantInt::get(Ty, i));
+      Constant *V1Element = getVectorElement(V1, i);
+      Constant *V2Element = getVectorElement(V2, i);
       auto *Cond = cast<Constant>(CondV->getOperand(i));
       if (isa<PoisonValue>(Cond)) {
         V = PoisonValue::get(V1Element->getType());
@@ -427,7 +435,6 @@ Constant *llvm::ConstantFoldInsertElementInstruction(Constant *Val,
 
   SmallVector<Constant*, 16> Result;
   Result.reserve(NumElts);
-  auto *Ty = Type::getInt32Ty(Val->getContext());
   uint64_t IdxVal = CIdx->getZExtValue();
   for (unsigned i = 0; i != NumElts; ++i) {
     if (i == IdxVal) {
@@ -435,8 +442,7 @@ Constant *llvm::ConstantFoldInsertElementInstruction(Constant *Val,
       continue;
     }
 
-    Constant *C = ConstantExpr::getExtractElement(Val, ConstantInt::get(Ty, i));
-    Result.push_back(C);
+    Result.push_back(getVectorElement(Val, i));
   }
 
   return ConstantVector::get(Result);
@@ -458,9 +464,7 @@ Constant *llvm::ConstantFoldShuffleVectorInstruction(Constant *V1, Constant *V2,
   // If the mask is all zeros this is a splat, no need to go through all
   // elements.
   if (all_of(Mask, [](int Elt) { return Elt == 0; })) {
-    Type *Ty = IntegerType::get(V1->getContext(), 32);
-    Constant *Elt =
-        ConstantExpr::getExtractElement(V1, ConstantInt::get(Ty, 0));
+    Constant *Elt = getVectorElement(V1, 0);
 
     if (Elt->isNullValue()) {
       auto *VTy = VectorType::get(EltTy, MaskEltCount);
@@ -487,15 +491,10 @@ Constant *llvm::ConstantFoldShuffleVectorInstruction(Constant *V1, Constant *V2,
     Constant *InElt;
     if (unsigned(Elt) >= SrcNumElts*2)
       InElt = UndefValue::get(EltTy);
-    else if (unsigned(Elt) >= SrcNumElts) {
-      Type *Ty = IntegerType::get(V2->getContext(), 32);
-      InElt =
-        ConstantExpr::getExtractElement(V2,
-                                        ConstantInt::get(Ty, Elt - SrcNumElts));
-    } else {
-      Type *Ty = IntegerType::get(V1->getContext(), 32);
-      InElt = ConstantExpr::getExtractElement(V1, ConstantInt::get(Ty, Elt));
-    }
+    else if (unsigned(Elt) >= SrcNumElts)
+      InElt = getVectorElement(V2, Elt - SrcNumElts);
+    else
+      InElt = getVectorElement(V1, Elt);
     Result.push_back(InElt);
   }
 
@@ -582,11 +581,9 @@ Constant *llvm::ConstantFoldUnaryInstruction(unsigned Opcode, Constant *C) {
 
     if (auto *FVTy = dyn_cast<FixedVectorType>(VTy)) {
       // Fold each element and create a vector constant from those constants.
-      Type *Ty = IntegerType::get(FVTy->getContext(), 32);
       SmallVector<Constant *, 16> Result;
       for (unsigned i = 0, e = FVTy->getNumElements(); i != e; ++i) {
-        Constant *ExtractIdx = ConstantInt::get(Ty, i);
-        Constant *Elt = ConstantExpr::getExtractElement(C, ExtractIdx);
+        Constant *Elt = getVectorElement(C, i);
         Constant *Res = ConstantFoldUnaryInstruction(Opcode, Elt);
         if (!Res)
           return nullptr;
@@ -892,11 +889,9 @@ Constant *llvm::ConstantFoldBinaryInstruction(unsigned Opcode, Constant *C1,
     if (auto *FVTy = dyn_cast<FixedVectorType>(VTy)) {
       // Fold each element and create a vector constant from those constants.
       SmallVector<Constant*, 16> Result;
-      Type *Ty = IntegerType::get(FVTy->getContext(), 32);
       for (unsigned i = 0, e = FVTy->getNumElements(); i != e; ++i) {
-        Constant *ExtractIdx = ConstantInt::get(Ty, i);
-        Constant *LHS = ConstantExpr::getExtractElement(C1, ExtractIdx);
-        Constant *RHS = ConstantExpr::getExtractElement(C2, ExtractIdx);
+        Constant *LHS = getVectorElement(C1, i);
+        Constant *RHS = getVectorElement(C2, i);
         Constant *Res = ConstantExpr::isDesirableBinOp(Opcode)
                             ? ConstantExpr::get(Opcode, LHS, RHS)
                             : ConstantFoldBinaryInstruction(Opcode, LHS, RHS);
@@ -1186,14 +1181,11 @@ Constant *llvm::ConstantFoldCompareInstruction(CmpInst::Predicate Predicate,
     // If we can constant fold the comparison of each element, constant fold
     // the whole vector comparison.
     SmallVector<Constant*, 4> ResElts;
-    Type *Ty = IntegerType::get(C1->getContext(), 32);
     // Compare the elements, producing an i1 result or constant expr.
     for (unsigned I = 0, E = C1VTy->getElementCount().getKnownMinValue();
          I != E; ++I) {
-      Constant *C1E =
-          ConstantExpr::getExtractElement(C1, ConstantInt::get(Ty, I));
-      Constant *C2E =
-          ConstantExpr::getExtractElement(C2, ConstantInt::get(Ty, I));
+      Constant *C1E = getVectorElement(C1, I);
+      Constant *C2E = getVectorElement(C2, I);
       Constant *Elt = ConstantFoldCompareInstruction(Predicate, C1E, C2E);
       if (!Elt)
         return nullptr;
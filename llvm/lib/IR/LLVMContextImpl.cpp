@@ -63,6 +63,11 @@ LLVMContextImpl::~LLVMContextImpl() {
   assert(ValueMetadata.empty() && "Values with metadata have been leaked");
 #endif
 
+  // Drop interned metadata attachment lists while the nodes their tracking
+  // references point at are still alive.
+  AttachmentSets.clear();
+  AttachmentSetsOwner.clear();
+
   // Drop references for MDNodes.  Do this before Values get deleted to avoid
   // unnecessary RAUW when nodes are still unresolved.
   for (auto *I : DistinctMDNodes)
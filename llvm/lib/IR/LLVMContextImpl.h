@@ -23,6 +23,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/FoldingSet.h"
 #include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -1416,6 +1417,12 @@ template <class NodeTy> struct MDNodeInfo {
 #include "llvm/IR/Metadata.def"
 
 /// Multimap-like storage for metadata attachments.
+///
+/// The attachment list itself is refcounted and copy-on-write, and lists
+/// whose nodes are all resolved are uniqued in LLVMContextImpl the same way
+/// AttributeListImpl is, so the many values carrying identical attachment
+/// sets (common with -g, where most instructions in a function share the
+/// same few attachments) share a single list instead of each owning a copy.
 class MDAttachments {
 public:
   struct Attachment {
@@ -1423,12 +1430,36 @@ public:
     TrackingMDNodeRef Node;
   };
 
+  /// A shared attachment list. Once interned in the context's uniquing
+  /// table a list is immutable; mutation goes through copy-on-write.
+  class SetImpl final : public FoldingSetNode, public RefCountedBase<SetImpl> {
+    friend class MDAttachments;
+
+    SmallVector<Attachment, 1> List;
+
+    /// Whether this list is in LLVMContextImpl::AttachmentSets. Interned
+    /// lists only ever contain resolved nodes, so their tracking references
+    /// never rewrite the list under its uniquing key.
+    bool Interned = false;
+
+  public:
+    void Profile(FoldingSetNodeID &ID) const;
+  };
+
 private:
-  SmallVector<Attachment, 1> Attachments;
+  IntrusiveRefCntPtr<SetImpl> Set;
+
+  /// Return a list that is safe to mutate, unsharing it first if necessary.
+  SmallVector<Attachment, 1> &getMutableList();
+
+  /// Try to replace the current list with an equal interned one, or intern
+  /// it if it is the first of its kind. Lists containing unresolved nodes
+  /// stay private to this value.
+  void uniquify(LLVMContextImpl &Ctx);
 
 public:
-  bool empty() const { return Attachments.empty(); }
-  size_t size() const { return Attachments.size(); }
+  bool empty() const { return !Set || Set->List.empty(); }
+  size_t size() const { return Set ? Set->List.size() : 0; }
 
   /// Returns the first attachment with the given ID or nullptr if no such
   /// attachment exists.
@@ -1448,21 +1479,25 @@ public:
   ///
   /// Set the \c ID attachment to \c MD, replacing the current attachments at \c
   /// ID (if anyway).
-  void set(unsigned ID, MDNode *MD);
+  void set(LLVMContextImpl &Ctx, unsigned ID, MDNode *MD);
 
   /// Adds an attachment to a particular node.
-  void insert(unsigned ID, MDNode &MD);
+  void insert(LLVMContextImpl &Ctx, unsigned ID, MDNode &MD);
 
   /// Remove attachments with the given ID.
   ///
   /// Remove the attachments at \c ID, if any.
-  bool erase(unsigned ID);
+  bool erase(LLVMContextImpl &Ctx, unsigned ID);
 
   /// Erase matching attachments.
   ///
   /// Erases all attachments matching the \c shouldRemove predicate.
-  template <class PredTy> void remove_if(PredTy shouldRemove) {
-    llvm::erase_if(Attachments, shouldRemove);
+  template <class PredTy>
+  void remove_if(LLVMContextImpl &Ctx, PredTy shouldRemove) {
+    if (empty() || llvm::none_of(Set->List, shouldRemove))
+      return;
+    llvm::erase_if(getMutableList(), shouldRemove);
+    uniquify(Ctx);
   }
 };
 
@@ -1636,6 +1671,13 @@ public:
   /// Collection of metadata used in this context.
   DenseMap<const Value *, MDAttachments> ValueMetadata;
 
+  /// Uniquing table for attachment lists shared by values with identical
+  /// metadata. Interned lists are kept alive for the context's lifetime by
+  /// AttachmentSetsOwner and torn down explicitly in the destructor, while
+  /// the nodes they reference are still alive.
+  FoldingSet<MDAttachments::SetImpl> AttachmentSets;
+  std::vector<IntrusiveRefCntPtr<MDAttachments::SetImpl>> AttachmentSetsOwner;
+
   /// Map DIAssignID -> Instructions with that attachment.
   /// Managed by Instruction via Instruction::updateDIAssignIDMapping.
   /// Query using the at:: functions defined in DebugInfo.h.
@@ -1445,23 +1445,70 @@ StringRef NamedMDNode::getName() const { return StringRef(Name); }
 // Instruction Metadata method implementations.
 //
 
+void MDAttachments::SetImpl::Profile(FoldingSetNodeID &ID) const {
+  for (const Attachment &A : List) {
+    ID.AddInteger(A.MDKind);
+    ID.AddPointer(A.Node.get());
+  }
+}
+
+SmallVector<MDAttachments::Attachment, 1> &MDAttachments::getMutableList() {
+  if (!Set) {
+    Set = new SetImpl();
+  } else if (Set->Interned || Set->UseCount() > 1) {
+    // Unshare before mutating. Shared lists only contain resolved nodes, so
+    // copying their tracking references is trivial.
+    IntrusiveRefCntPtr<SetImpl> NewSet = new SetImpl();
+    NewSet->List = Set->List;
+    Set = std::move(NewSet);
+  }
+  return Set->List;
+}
+
+void MDAttachments::uniquify(LLVMContextImpl &Ctx) {
+  assert(Set && !Set->Interned && "Interned lists are immutable");
+  if (Set->List.empty())
+    return; // Callers drop empty attachment maps entirely.
+
+  // Only fully-resolved lists are safe to share: an unresolved node may
+  // still be RAUW'd in place, which would rewrite an interned list under
+  // its uniquing key.
+  for (const Attachment &A : Set->List)
+    if (!A.Node->isResolved())
+      return;
+
+  FoldingSetNodeID ID;
+  Set->Profile(ID);
+  void *InsertPos;
+  if (SetImpl *Existing = Ctx.AttachmentSets.FindNodeOrInsertPos(ID, InsertPos)) {
+    Set = Existing;
+    return;
+  }
+  Ctx.AttachmentSets.InsertNode(Set.get(), InsertPos);
+  Set->Interned = true;
+  Ctx.AttachmentSetsOwner.push_back(Set);
+}
+
 MDNode *MDAttachments::lookup(unsigned ID) const {
-  for (const auto &A : Attachments)
-    if (A.MDKind == ID)
-      return A.Node;
+  if (Set)
+    for (const auto &A : Set->List)
+      if (A.MDKind == ID)
+        return A.Node;
   return nullptr;
 }
 
 void MDAttachments::get(unsigned ID, SmallVectorImpl<MDNode *> &Result) const {
-  for (const auto &A : Attachments)
-    if (A.MDKind == ID)
-      Result.push_back(A.Node);
+  if (Set)
+    for (const auto &A : Set->List)
+      if (A.MDKind == ID)
+        Result.push_back(A.Node);
 }
 
 void MDAttachments::getAll(
     SmallVectorImpl<std::pair<unsigned, MDNode *>> &Result) const {
-  for (const auto &A : Attachments)
-    Result.emplace_back(A.MDKind, A.Node);
+  if (Set)
+    for (const auto &A : Set->List)
+      Result.emplace_back(A.MDKind, A.Node);
 
   // Sort the resulting array so it is stable with respect to metadata IDs. We
   // need to preserve the original insertion order though.
@@ -1469,30 +1516,33 @@ void MDAttachments::getAll(
     llvm::stable_sort(Result, less_first());
 }
 
-void MDAttachments::set(unsigned ID, MDNode *MD) {
-  erase(ID);
+void MDAttachments::set(LLVMContextImpl &Ctx, unsigned ID, MDNode *MD) {
+  SmallVector<Attachment, 1> &List = getMutableList();
+  llvm::erase_if(List, [ID](const Attachment &A) { return A.MDKind == ID; });
   if (MD)
-    insert(ID, *MD);
+    List.push_back({ID, TrackingMDNodeRef(MD)});
+  uniquify(Ctx);
 }
 
-void MDAttachments::insert(unsigned ID, MDNode &MD) {
-  Attachments.push_back({ID, TrackingMDNodeRef(&MD)});
+void MDAttachments::insert(LLVMContextImpl &Ctx, unsigned ID, MDNode &MD) {
+  getMutableList().push_back({ID, TrackingMDNodeRef(&MD)});
+  uniquify(Ctx);
 }
 
-bool MDAttachments::erase(unsigned ID) {
-  if (empty())
+bool MDAttachments::erase(LLVMContextImpl &Ctx, unsigned ID) {
+  if (!lookup(ID))
     return false;
 
+  SmallVector<Attachment, 1> &List = getMutableList();
   // Common case is one value.
-  if (Attachments.size() == 1 && Attachments.back().MDKind == ID) {
-    Attachments.pop_back();
+  if (List.size() == 1) {
+    List.pop_back();
     return true;
   }
 
-  auto OldSize = Attachments.size();
-  llvm::erase_if(Attachments,
-                 [ID](const Attachment &A) { return A.MDKind == ID; });
-  return OldSize != Attachments.size();
+  llvm::erase_if(List, [ID](const Attachment &A) { return A.MDKind == ID; });
+  uniquify(Ctx);
+  return true;
 }
 
 MDNode *Value::getMetadata(StringRef Kind) const {
@@ -1537,7 +1587,7 @@ void Value::setMetadata(unsigned KindID, MDNode *Node) {
     assert(!Info.empty() == HasMetadata && "bit out of sync with hash table");
     if (Info.empty())
       HasMetadata = true;
-    Info.set(KindID, Node);
+    Info.set(*getContext().pImpl, KindID, Node);
     return;
   }
 
@@ -1549,7 +1599,7 @@ void Value::setMetadata(unsigned KindID, MDNode *Node) {
   MDAttachments &Info = getContext().pImpl->ValueMetadata.find(this)->second;
 
   // Handle removal of an existing value.
-  Info.erase(KindID);
+  Info.erase(*getContext().pImpl, KindID);
   if (!Info.empty())
     return;
   getContext().pImpl->ValueMetadata.erase(this);
@@ -1566,7 +1616,8 @@ void Value::addMetadata(unsigned KindID, MDNode &MD) {
   assert(isa<Instruction>(this) || isa<GlobalObject>(this));
   if (!HasMetadata)
     HasMetadata = true;
-  getContext().pImpl->ValueMetadata[this].insert(KindID, MD);
+  getContext().pImpl->ValueMetadata[this].insert(*getContext().pImpl, KindID,
+                                                 MD);
 }
 
 void Value::addMetadata(StringRef Kind, MDNode &MD) {
@@ -1579,7 +1630,7 @@ bool Value::eraseMetadata(unsigned KindID) {
     return false;
 
   MDAttachments &Store = getContext().pImpl->ValueMetadata.find(this)->second;
-  bool Changed = Store.erase(KindID);
+  bool Changed = Store.erase(*getContext().pImpl, KindID);
   if (Store.empty())
     clearMetadata();
   return Changed;
@@ -1592,9 +1643,10 @@ void Value::eraseMetadataIf(function_ref<bool(unsigned, MDNode *)> Pred) {
   auto &MetadataStore = getContext().pImpl->ValueMetadata;
   MDAttachments &Info = MetadataStore.find(this)->second;
   assert(!Info.empty() && "bit out of sync with hash table");
-  Info.remove_if([Pred](const MDAttachments::Attachment &I) {
-    return Pred(I.MDKind, I.Node);
-  });
+  Info.remove_if(*getContext().pImpl,
+                 [Pred](const MDAttachments::Attachment &I) {
+                   return Pred(I.MDKind, I.Node);
+                 });
 
   if (Info.empty())
     clearMetadata();
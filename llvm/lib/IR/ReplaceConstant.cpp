@@ -14,7 +14,9 @@
 #include "llvm/IR/ReplaceConstant.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
 
 namespace llvm {
 
@@ -119,4 +121,117 @@ bool convertUsersOfConstantsToInstructions(ArrayRef<Constant *> Consts,
   return Changed;
 }
 
+/// Return \p C with every (possibly nested) occurrence of a key of
+/// \p Replacements rewritten to the mapped constant. \p Cache memoizes
+/// rewrites of constant expressions and aggregates so shared subtrees are
+/// processed once.
+static Constant *
+getRewrittenConstant(Constant *C,
+                     const DenseMap<Constant *, Constant *> &Replacements,
+                     DenseMap<Constant *, Constant *> &Cache) {
+  auto RI = Replacements.find(C);
+  if (RI != Replacements.end()) {
+    assert(RI->second->getType() == C->getType() &&
+           "Replacement constant must have the same type");
+    return RI->second;
+  }
+
+  // Only constant expressions and aggregates can reach a replaced constant
+  // through their operands.
+  if (!isa<ConstantExpr>(C) && !isa<ConstantAggregate>(C))
+    return C;
+
+  auto CI = Cache.find(C);
+  if (CI != Cache.end())
+    return CI->second;
+
+  SmallVector<Constant *, 8> Ops;
+  bool OpChanged = false;
+  for (Value *Op : C->operands()) {
+    Constant *NewOp =
+        getRewrittenConstant(cast<Constant>(Op), Replacements, Cache);
+    OpChanged |= NewOp != Op;
+    Ops.push_back(NewOp);
+  }
+
+  Constant *Result = C;
+  if (OpChanged) {
+    if (auto *CE = dyn_cast<ConstantExpr>(C))
+      Result = CE->getWithOperands(Ops);
+    else if (auto *CS = dyn_cast<ConstantStruct>(C))
+      Result = ConstantStruct::get(CS->getType(), Ops);
+    else if (isa<ConstantArray>(C))
+      Result = ConstantArray::get(cast<ArrayType>(C->getType()), Ops);
+    else
+      Result = ConstantVector::get(Ops);
+  }
+  Cache[C] = Result;
+  return Result;
+}
+
+static bool
+replaceConstantUses(Function &F,
+                    const DenseMap<Constant *, Constant *> &Replacements,
+                    DenseMap<Constant *, Constant *> &Cache) {
+  bool Changed = false;
+  for (Instruction &I : instructions(F)) {
+    for (Use &U : I.operands()) {
+      auto *C = dyn_cast<Constant>(U.get());
+      if (!C)
+        continue;
+      Constant *NewC = getRewrittenConstant(C, Replacements, Cache);
+      if (NewC != C) {
+        U.set(NewC);
+        Changed = true;
+      }
+    }
+  }
+  return Changed;
+}
+
+bool replaceConstantsInFunction(
+    Function &F, const DenseMap<Constant *, Constant *> &Replacements) {
+  DenseMap<Constant *, Constant *> Cache;
+  return replaceConstantUses(F, Replacements, Cache);
+}
+
+bool replaceConstantsInModule(
+    Module &M, const DenseMap<Constant *, Constant *> &Replacements) {
+  DenseMap<Constant *, Constant *> Cache;
+  bool Changed = false;
+  for (Function &F : M)
+    Changed |= replaceConstantUses(F, Replacements, Cache);
+
+  for (GlobalVariable &GV : M.globals()) {
+    if (!GV.hasInitializer())
+      continue;
+    Constant *Init = GV.getInitializer();
+    Constant *NewInit = getRewrittenConstant(Init, Replacements, Cache);
+    if (NewInit != Init) {
+      GV.setInitializer(NewInit);
+      Changed = true;
+    }
+  }
+
+  for (GlobalAlias &GA : M.aliases()) {
+    Constant *Aliasee = GA.getAliasee();
+    Constant *NewAliasee = getRewrittenConstant(Aliasee, Replacements, Cache);
+    if (NewAliasee != Aliasee) {
+      GA.setAliasee(NewAliasee);
+      Changed = true;
+    }
+  }
+
+  for (GlobalIFunc &GI : M.ifuncs()) {
+    Constant *Resolver = GI.getResolver();
+    Constant *NewResolver = getRewrittenConstant(Resolver, Replacements, Cache);
+    if (NewResolver != Resolver) {
+      GI.setResolver(NewResolver);
+      Changed = true;
+    }
+  }
+
+  return Changed;
+}
+
 } // namespace llvm
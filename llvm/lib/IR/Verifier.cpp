@@ -56,6 +56,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
@@ -119,6 +120,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/ModRef.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -127,6 +129,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace llvm;
 
@@ -135,6 +138,11 @@ static cl::opt<bool> VerifyNoAliasScopeDomination(
     cl::desc("Ensure that llvm.experimental.noalias.scope.decl for identical "
              "scopes are not dominating"));
 
+static cl::opt<bool> VerifyParallel(
+    "verify-parallel", cl::Hidden, cl::init(false),
+    cl::desc("Verify function bodies on the default thread pool, keeping the "
+             "module-level cross-checks serial"));
+
 namespace llvm {
 
 struct VerifierSupport {
@@ -398,6 +406,26 @@ public:
 
   bool hasBrokenDebugInfo() const { return BrokenDebugInfo; }
 
+  /// Fold the cross-function state gathered by \p Other, which verified a
+  /// disjoint subset of this module's functions, into this verifier so that
+  /// the module-level checks in verify() see the whole picture.
+  void mergeCrossFunctionState(const Verifier &Other) {
+    assert(&Other.M == &M && "Merging state for a different module!");
+    for (const auto &I : Other.FrameEscapeInfo) {
+      auto &Entry = FrameEscapeInfo[I.first];
+      Entry.first = std::max(Entry.first, I.second.first);
+      Entry.second = std::max(Entry.second, I.second.second);
+    }
+    for (const auto &I : Other.DISubprogramAttachments) {
+      const Function *&AttachedTo = DISubprogramAttachments[I.first];
+      if (AttachedTo && AttachedTo != I.second)
+        DebugInfoCheckFailed("DISubprogram attached to more than one function",
+                             I.first, I.second);
+      AttachedTo = I.second;
+    }
+    BrokenDebugInfo |= Other.BrokenDebugInfo;
+  }
+
   bool verify(const Function &F) {
     assert(F.getParent() == &M &&
            "An instance of this class only works with a specific module!");
@@ -7311,8 +7339,47 @@ bool llvm::verifyModule(const Module &M, raw_ostream *OS,
   Verifier V(OS, /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
 
   bool Broken = false;
-  for (const Function &F : M)
-    Broken |= !V.verify(F);
+  if (VerifyParallel && M.size() > 1) {
+    // Function-level invariants are independent, so verify contiguous shards
+    // of functions concurrently, each with its own Verifier and diagnostic
+    // buffer. Buffers are emitted in module order afterwards, and the
+    // cross-function state each shard gathered is folded into the main
+    // verifier before the serial module-level checks, so both the verdict
+    // and the diagnostics are deterministic.
+    SmallVector<const Function *, 0> Functions;
+    for (const Function &F : M)
+      Functions.push_back(&F);
+
+    struct Shard {
+      SmallString<0> Log;
+      std::optional<raw_svector_ostream> LogOS;
+      std::unique_ptr<Verifier> V;
+      bool Broken = false;
+    };
+    std::vector<Shard> Shards(
+        std::min(Functions.size(), parallel::getThreadCount()));
+    parallelFor(0, Shards.size(), [&](size_t I) {
+      Shard &S = Shards[I];
+      if (OS)
+        S.LogOS.emplace(S.Log);
+      S.V = std::make_unique<Verifier>(
+          OS ? &*S.LogOS : nullptr,
+          /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
+      size_t Begin = Functions.size() * I / Shards.size();
+      size_t End = Functions.size() * (I + 1) / Shards.size();
+      for (size_t F = Begin; F != End; ++F)
+        S.Broken |= !S.V->verify(*Functions[F]);
+    });
+    for (Shard &S : Shards) {
+      Broken |= S.Broken;
+      if (OS)
+        *OS << S.Log;
+      V.mergeCrossFunctionState(*S.V);
+    }
+  } else {
+    for (const Function &F : M)
+      Broken |= !V.verify(F);
+  }
 
   Broken |= !V.verify();
   if (BrokenDebugInfo)
@@ -43,6 +43,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/ThreadPool.h"
@@ -759,7 +760,7 @@ Error LTO::addModule(InputFile &Input, unsigned ModI,
     // we can skip or error on optimizations that need consistently split
     // modules (whole program devirt and lower type tests).
     if (*EnableSplitLTOUnit != LTOInfo->EnableSplitLTOUnit)
-      ThinLTO.CombinedIndex.setPartiallySplitLTOUnits();
+      ThinLTO.PartiallySplitLTOUnits = true;
   } else
     EnableSplitLTOUnit = LTOInfo->EnableSplitLTOUnit;
 
@@ -795,9 +796,18 @@ Error LTO::addModule(InputFile &Input, unsigned ModI,
     return linkRegularLTO(std::move(*ModOrErr), /*LivenessFromIndex=*/false);
 
   // Regular LTO module summaries are added to a dummy module that represents
-  // the combined regular LTO module.
-  if (Error Err = BM.readSummary(ThinLTO.CombinedIndex, ""))
-    return Err;
+  // the combined regular LTO module. As for ThinLTO modules, the parse runs
+  // on the summary reader pool so it overlaps the handling of later inputs.
+  ThinLTO.SummaryReaderPool.async([this, BM]() mutable {
+    if (Error E = BM.readSummary(ThinLTO.CombinedIndex, "")) {
+      std::unique_lock<std::mutex> L(ThinLTO.SummaryReadErrMu);
+      if (ThinLTO.SummaryReadErr)
+        ThinLTO.SummaryReadErr =
+            joinErrors(std::move(*ThinLTO.SummaryReadErr), std::move(E));
+      else
+        ThinLTO.SummaryReadErr = std::move(E);
+    }
+  });
   RegularLTO.ModsWithSummaries.push_back(std::move(*ModOrErr));
   return Error::success();
 }
@@ -1031,6 +1041,7 @@ Error LTO::linkRegularLTO(RegularLTOState::AddedModule Mod,
 Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                       const SymbolResolution *&ResI,
                       const SymbolResolution *ResE) {
+  DenseSet<GlobalValue::GUID> PrevailingGUIDs;
   const SymbolResolution *ResITmp = ResI;
   for (const InputFile::Symbol &Sym : Syms) {
     assert(ResITmp != ResE);
@@ -1039,20 +1050,24 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     if (!Sym.getIRName().empty()) {
       auto GUID = GlobalValue::getGUID(GlobalValue::getGlobalIdentifier(
           Sym.getIRName(), GlobalValue::ExternalLinkage, ""));
-      if (Res.Prevailing)
+      if (Res.Prevailing) {
         ThinLTO.PrevailingModuleForGUID[GUID] = BM.getModuleIdentifier();
+        PrevailingGUIDs.insert(GUID);
+      }
     }
   }
-
-  if (Error Err =
-          BM.readSummary(ThinLTO.CombinedIndex, BM.getModuleIdentifier(),
-                         [&](GlobalValue::GUID GUID) {
-                           return ThinLTO.PrevailingModuleForGUID[GUID] ==
-                                  BM.getModuleIdentifier();
-                         }))
-    return Err;
   LLVM_DEBUG(dbgs() << "Module " << BM.getModuleIdentifier() << "\n");
 
+  // Fixups that must inspect this module's summaries once they have been
+  // merged into the combined index. They are collected here, where the
+  // resolutions are at hand, and applied on the summary reader pool below.
+  struct SummaryFixup {
+    GlobalValue::GUID GUID;
+    bool LinkerRedefined;
+    bool FinalDefinitionInLinkageUnit;
+  };
+  SmallVector<SummaryFixup, 0> Fixups;
+
   for (const InputFile::Symbol &Sym : Syms) {
     assert(ResI != ResE);
     SymbolResolution Res = *ResI++;
@@ -1060,30 +1075,55 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     if (!Sym.getIRName().empty()) {
       auto GUID = GlobalValue::getGUID(GlobalValue::getGlobalIdentifier(
           Sym.getIRName(), GlobalValue::ExternalLinkage, ""));
-      if (Res.Prevailing) {
-        assert(ThinLTO.PrevailingModuleForGUID[GUID] ==
-               BM.getModuleIdentifier());
+      assert(!Res.Prevailing || ThinLTO.PrevailingModuleForGUID[GUID] ==
+                                    BM.getModuleIdentifier());
+      if ((Res.Prevailing && Res.LinkerRedefined) ||
+          Res.FinalDefinitionInLinkageUnit)
+        Fixups.push_back({GUID, Res.Prevailing && Res.LinkerRedefined,
+                          Res.FinalDefinitionInLinkageUnit != 0});
+    }
+  }
 
-        // For linker redefined symbols (via --wrap or --defsym) we want to
-        // switch the linkage to `weak` to prevent IPOs from happening.
-        // Find the summary in the module for this very GV and record the new
-        // linkage so that we can switch it when we import the GV.
-        if (Res.LinkerRedefined)
-          if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                  GUID, BM.getModuleIdentifier()))
-            S->setLinkage(GlobalValue::WeakAnyLinkage);
-      }
+  // Summary parsing is the dominant cost of the thin link, so merge this
+  // module's summaries into the combined index on the reader pool (a single
+  // thread, preserving input order) while symbol resolution of later input
+  // files proceeds concurrently on this thread. PrevailingGUIDs snapshots the
+  // state the inline prevailing-callback used to observe.
+  ThinLTO.SummaryReaderPool.async(
+      [this, BM, PrevailingGUIDs = std::move(PrevailingGUIDs),
+       Fixups = std::move(Fixups)]() mutable {
+        if (Error E = BM.readSummary(ThinLTO.CombinedIndex,
+                                     BM.getModuleIdentifier(),
+                                     [&](GlobalValue::GUID GUID) {
+                                       return PrevailingGUIDs.count(GUID);
+                                     })) {
+          std::unique_lock<std::mutex> L(ThinLTO.SummaryReadErrMu);
+          if (ThinLTO.SummaryReadErr)
+            ThinLTO.SummaryReadErr =
+                joinErrors(std::move(*ThinLTO.SummaryReadErr), std::move(E));
+          else
+            ThinLTO.SummaryReadErr = std::move(E);
+          return;
+        }
 
-      // If the linker resolved the symbol to a local definition then mark it
-      // as local in the summary for the module we are adding.
-      if (Res.FinalDefinitionInLinkageUnit) {
-        if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                GUID, BM.getModuleIdentifier())) {
-          S->setDSOLocal(true);
+        for (const SummaryFixup &F : Fixups) {
+          // For linker redefined symbols (via --wrap or --defsym) we want to
+          // switch the linkage to `weak` to prevent IPOs from happening.
+          // Find the summary in the module for this very GV and record the new
+          // linkage so that we can switch it when we import the GV.
+          if (F.LinkerRedefined)
+            if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
+                    F.GUID, BM.getModuleIdentifier()))
+              S->setLinkage(GlobalValue::WeakAnyLinkage);
+
+          // If the linker resolved the symbol to a local definition then mark
+          // it as local in the summary for the module we are adding.
+          if (F.FinalDefinitionInLinkageUnit)
+            if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
+                    F.GUID, BM.getModuleIdentifier()))
+              S->setDSOLocal(true);
         }
-      }
-    }
-  }
+      });
 
   if (!ThinLTO.ModuleMap.insert({BM.getModuleIdentifier(), BM}).second)
     return make_error<StringError>(
@@ -1107,6 +1147,18 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
   return Error::success();
 }
 
+// Drain the pipelined summary reads scheduled by addModule(): wait for the
+// reader pool, apply the buffered partially-split flag, and report any parse
+// error that was deferred from add().
+Error LTO::waitForSummaryReads() {
+  ThinLTO.SummaryReaderPool.wait();
+  if (ThinLTO.PartiallySplitLTOUnits)
+    ThinLTO.CombinedIndex.setPartiallySplitLTOUnits();
+  if (ThinLTO.SummaryReadErr)
+    return std::move(*ThinLTO.SummaryReadErr);
+  return Error::success();
+}
+
 unsigned LTO::getMaxTasks() const {
   CalledGetMaxTasks = true;
   auto ModuleCount = ThinLTO.ModulesToCompile ? ThinLTO.ModulesToCompile->size()
@@ -1159,6 +1211,10 @@ Error LTO::checkPartiallySplit() {
 }
 
 Error LTO::run(AddStreamFn AddStream, FileCache Cache) {
+  // The combined index must be complete before anything below consults it.
+  if (Error Err = waitForSummaryReads())
+    return Err;
+
   // Compute "dead" symbols, we don't want to import/export these!
   DenseSet<GlobalValue::GUID> GUIDPreservedSymbols;
   DenseMap<GlobalValue::GUID, PrevailingType> GUIDPrevailingResolutions;
@@ -1820,6 +1876,94 @@ public:
     return true;
   }
 };
+
+// This backend delegates the per-module code generation to an external
+// command, for build systems that farm ThinLTO backend jobs out to a remote
+// execution service. For each task it writes the sharded summary index (and,
+// optionally, the imports file) next to the module and runs
+//
+//   <command> <module path> <index path> <native object path>
+//
+// then ingests the native object the command produced. Jobs run on the
+// backend thread pool, so the link consumes results as the commands complete
+// rather than waiting on an external barrier around the linker.
+class OutOfProcessThinBackend : public ThinBackendProc {
+  AddStreamFn AddStream;
+  std::string Command;
+
+public:
+  OutOfProcessThinBackend(
+      const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+      ThreadPoolStrategy ThinLTOParallelism,
+      const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+      AddStreamFn AddStream, std::string Command,
+      lto::IndexWriteCallback OnWrite, bool ShouldEmitImportsFiles)
+      : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries,
+                        OnWrite, ShouldEmitImportsFiles, ThinLTOParallelism),
+        AddStream(std::move(AddStream)), Command(std::move(Command)) {}
+
+  Error start(
+      unsigned Task, BitcodeModule BM,
+      const FunctionImporter::ImportMapTy &ImportList,
+      const FunctionImporter::ExportSetTy &ExportList,
+      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+      MapVector<StringRef, BitcodeModule> &ModuleMap) override {
+    StringRef ModulePath = BM.getModuleIdentifier();
+    BackendThreadPool.async(
+        [this](unsigned Task, const StringRef ModulePath,
+               const FunctionImporter::ImportMapTy &ImportList) {
+          if (auto E = runJob(Task, ModulePath, ImportList)) {
+            std::unique_lock<std::mutex> L(ErrMu);
+            if (Err)
+              Err = joinErrors(std::move(*Err), std::move(E));
+            else
+              Err = std::move(E);
+          }
+        },
+        Task, ModulePath, ImportList);
+
+    if (OnWrite)
+      OnWrite(std::string(ModulePath));
+    return Error::success();
+  }
+
+private:
+  Error runJob(unsigned Task, StringRef ModulePath,
+               const FunctionImporter::ImportMapTy &ImportList) {
+    // Write the summary shard and imports next to the module, like the
+    // in-process backend does with ShouldEmitIndexFiles.
+    if (Error E = emitFiles(ImportList, ModulePath, std::string(ModulePath)))
+      return E;
+    SmallString<128> IndexPath(ModulePath);
+    IndexPath += ".thinlto.bc";
+    SmallString<128> ObjPath(ModulePath);
+    ObjPath += ".thinlto.o";
+
+    ErrorOr<std::string> Program = sys::findProgramByName(Command);
+    if (!Program)
+      return createFileError(Command, Program.getError());
+    std::string ErrMsg;
+    StringRef Args[] = {Command, ModulePath, IndexPath, ObjPath};
+    if (sys::ExecuteAndWait(*Program, Args, /*Env=*/std::nullopt,
+                            /*Redirects=*/{}, /*SecondsToWait=*/0,
+                            /*MemoryLimit=*/0, &ErrMsg))
+      return createStringError(inconvertibleErrorCode(),
+                               "ThinLTO backend command '" + Command +
+                                   "' failed for '" + ModulePath +
+                                   "': " + ErrMsg);
+
+    auto MBOrErr = MemoryBuffer::getFile(ObjPath, /*IsText=*/false,
+                                         /*RequiresNullTerminator=*/false);
+    if (!MBOrErr)
+      return createFileError(ObjPath, MBOrErr.getError());
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        AddStream(Task, ModulePath);
+    if (!StreamOrErr)
+      return StreamOrErr.takeError();
+    *(*StreamOrErr)->OS << (*MBOrErr)->getBuffer();
+    return Error::success();
+  }
+};
 } // end anonymous namespace
 
 ThinBackend lto::createWriteIndexesThinBackend(
@@ -1839,6 +1983,21 @@ ThinBackend lto::createWriteIndexesThinBackend(
   return ThinBackend(Func, Parallelism);
 }
 
+ThinBackend lto::createOutOfProcessThinBackend(ThreadPoolStrategy Parallelism,
+                                               std::string Command,
+                                               IndexWriteCallback OnWrite,
+                                               bool ShouldEmitImportsFiles) {
+  auto Func =
+      [=](const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+          const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+          AddStreamFn AddStream, FileCache Cache) {
+        return std::make_unique<OutOfProcessThinBackend>(
+            Conf, CombinedIndex, Parallelism, ModuleToDefinedGVSummaries,
+            std::move(AddStream), Command, OnWrite, ShouldEmitImportsFiles);
+      };
+  return ThinBackend(Func, Parallelism);
+}
+
 Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
                       const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols) {
   LLVM_DEBUG(dbgs() << "Running ThinLTO\n");
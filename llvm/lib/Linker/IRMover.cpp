@@ -64,6 +64,17 @@ class TypeMapTy : public ValueMapTypeRemapper {
   /// getting a body from the source module.
   SmallPtrSet<StructType *, 16> DstResolvedOpaqueTypes;
 
+  /// True if addTypeMapping() established a mapping between two distinct
+  /// types. Stays false in the common ThinLTO import case, where source and
+  /// destination share the context and every global lines up on the same
+  /// uniqued type.
+  bool SeenNonIdentityMapping = false;
+
+  /// When set, every source type maps to itself and get() returns its
+  /// argument unchanged. Enabled by computeTypeMapping() once it has proven
+  /// the mapping is an identity; see enableIdentityFastPath().
+  bool IdentityFastPath = false;
+
 public:
   TypeMapTy(IRMover::IdentifiedStructTypeSet &DstStructTypesSet)
       : DstStructTypesSet(DstStructTypesSet) {}
@@ -86,6 +97,14 @@ public:
     return cast<FunctionType>(get((Type *)T));
   }
 
+  bool hasNonIdentityMapping() const { return SeenNonIdentityMapping; }
+
+  /// Declare that the mapping is an identity: no source type needs to be
+  /// rewritten or registered against the destination's struct set, so get()
+  /// may return its argument without the recursive walk or the MappedTypes
+  /// bookkeeping. Only valid once all type equivalences have been discovered.
+  void enableIdentityFastPath() { IdentityFastPath = true; }
+
 private:
   Type *remapType(Type *SrcTy) override { return get(SrcTy); }
 
@@ -120,6 +139,8 @@ void TypeMapTy::addTypeMapping(Type *DstTy, Type *SrcTy) {
       if (auto *STy = dyn_cast<StructType>(Ty))
         if (STy->hasName())
           STy->setName("");
+    if (DstTy != SrcTy)
+      SeenNonIdentityMapping = true;
   }
   SpeculativeTypes.clear();
   SpeculativeDstOpaqueTypes.clear();
@@ -237,6 +258,11 @@ Type *TypeMapTy::get(Type *Ty) {
 }
 
 Type *TypeMapTy::get(Type *Ty, SmallPtrSet<StructType *, 8> &Visited) {
+  // The identity fast path: computeTypeMapping() proved that no source type
+  // can map to anything but itself, so skip the walk and the bookkeeping.
+  if (IdentityFastPath)
+    return Ty;
+
   // If we already have an entry for this type, return it.
   Type **Entry = &MappedTypes[Ty];
   if (*Entry)
@@ -863,6 +889,18 @@ void IRLinker::computeTypeMapping() {
   // Now that we have discovered all of the type equivalences, get a body for
   // any 'opaque' types in the dest module that are now resolved.
   setError(TypeMap.linkDefinedTypeBodies());
+
+  // Common fast path for importing: source and destination share the context,
+  // so uniqued types are already the same object. If no global forced a real
+  // mapping and the source module brings no identified struct types of its
+  // own that would need renaming or unification against the destination's
+  // set, then every type maps to itself and the remapper can return source
+  // types unchanged instead of rebuilding them through MappedTypes.
+  if (!TypeMap.hasNonIdentityMapping() &&
+      llvm::all_of(Types, [&](StructType *ST) {
+        return TypeMap.DstStructTypesSet.hasType(ST);
+      }))
+    TypeMap.enableIdentityFastPath();
 }
 
 static void getArrayElements(const Constant *C,
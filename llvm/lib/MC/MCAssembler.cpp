@@ -920,6 +920,15 @@ void MCAssembler::layout() {
     }
   }
 
+  // In fast-layout mode, relax every instruction that may need relaxation to
+  // its maximal form before iterating. With instruction sizes pinned at their
+  // upper bound, the remaining variable-size fragments (LEB128s, DWARF address
+  // deltas, boundary aligns) see only shrinking symbol distances and the loop
+  // below converges after very few iterations instead of chasing a fixpoint
+  // across the whole file.
+  if (FastLayout)
+    relaxInstructionsToMaxSize();
+
   // Layout until everything fits.
   this->HasLayout = true;
   while (layoutOnce()) {
@@ -1091,6 +1100,32 @@ bool MCAssembler::relaxInstruction(MCRelaxableFragment &F) {
   return true;
 }
 
+void MCAssembler::relaxInstructionsToMaxSize() {
+  assert(getEmitterPtr() &&
+         "Expected CodeEmitter defined for relaxInstruction");
+  for (MCSection &Sec : *this) {
+    for (MCFragment &Frag : Sec) {
+      auto *F = dyn_cast<MCRelaxableFragment>(&Frag);
+      if (!F ||
+          !getBackend().mayNeedRelaxation(F->getInst(), *F->getSubtargetInfo()))
+        continue;
+
+      ++stats::RelaxedInstructions;
+
+      MCInst Relaxed = F->getInst();
+      do
+        getBackend().relaxInstruction(Relaxed, *F->getSubtargetInfo());
+      while (getBackend().mayNeedRelaxation(Relaxed, *F->getSubtargetInfo()));
+
+      F->setInst(Relaxed);
+      F->getFixups().clear();
+      F->getContents().clear();
+      getEmitter().encodeInstruction(Relaxed, F->getContents(), F->getFixups(),
+                                     *F->getSubtargetInfo());
+    }
+  }
+}
+
 bool MCAssembler::relaxLEB(MCLEBFragment &LF) {
   const unsigned OldSize = static_cast<unsigned>(LF.getContents().size());
   unsigned PadTo = OldSize;
@@ -34,8 +34,12 @@ MCObjectStreamer::MCObjectStreamer(MCContext &Context,
       EmitEHFrame(true), EmitDebugFrame(false) {
   assert(Assembler->getBackendPtr() && Assembler->getEmitterPtr());
   setAllowAutoPadding(Assembler->getBackend().allowAutoPadding());
-  if (Context.getTargetOptions() && Context.getTargetOptions()->MCRelaxAll)
-    Assembler->setRelaxAll(true);
+  if (Context.getTargetOptions()) {
+    if (Context.getTargetOptions()->MCRelaxAll)
+      Assembler->setRelaxAll(true);
+    if (Context.getTargetOptions()->MCFastLayout)
+      Assembler->setFastLayout(true);
+  }
 }
 
 MCObjectStreamer::~MCObjectStreamer() = default;
@@ -123,8 +127,10 @@ void MCObjectStreamer::emitAbsoluteSymbolDiffAsULEB128(const MCSymbol *Hi,
 void MCObjectStreamer::reset() {
   if (Assembler) {
     Assembler->reset();
-    if (getContext().getTargetOptions())
+    if (getContext().getTargetOptions()) {
       Assembler->setRelaxAll(getContext().getTargetOptions()->MCRelaxAll);
+      Assembler->setFastLayout(getContext().getTargetOptions()->MCFastLayout);
+    }
   }
   EmitEHFrame = true;
   EmitDebugFrame = false;
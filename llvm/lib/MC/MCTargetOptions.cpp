@@ -12,7 +12,8 @@
 using namespace llvm;
 
 MCTargetOptions::MCTargetOptions()
-    : MCRelaxAll(false), MCNoExecStack(false), MCFatalWarnings(false),
+    : MCRelaxAll(false), MCFastLayout(false), MCNoExecStack(false),
+      MCFatalWarnings(false),
       MCNoWarn(false), MCNoDeprecatedWarn(false), MCNoTypeCheck(false),
       MCSaveTempLabels(false), MCIncrementalLinkerCompatible(false),
       FDPIC(false), ShowMCEncoding(false), ShowMCInst(false), AsmVerbose(false),
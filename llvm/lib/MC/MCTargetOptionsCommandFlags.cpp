@@ -35,6 +35,7 @@ using namespace llvm;
   }
 
 MCOPT_EXP(bool, RelaxAll)
+MCOPT(bool, FastLayout)
 MCOPT(bool, IncrementalLinkerCompatible)
 MCOPT(bool, FDPIC)
 MCOPT(int, DwarfVersion)
@@ -65,6 +66,13 @@ llvm::mc::RegisterMCTargetOptionsFlags::RegisterMCTargetOptionsFlags() {
                                "in the emitted object file"));
   MCBINDOPT(RelaxAll);
 
+  static cl::opt<bool> FastLayout(
+      "mc-fast-layout",
+      cl::desc("When used with filetype=obj, lay out sections with a single "
+               "pessimistic relaxation pass instead of iterating to a "
+               "fixpoint; faster on large inputs, slightly larger code"));
+  MCBINDOPT(FastLayout);
+
   static cl::opt<bool> IncrementalLinkerCompatible(
       "incremental-linker-compatible",
       cl::desc(
@@ -171,6 +179,7 @@ llvm::mc::RegisterMCTargetOptionsFlags::RegisterMCTargetOptionsFlags() {
 MCTargetOptions llvm::mc::InitMCTargetOptionsFromFlags() {
   MCTargetOptions Options;
   Options.MCRelaxAll = getRelaxAll();
+  Options.MCFastLayout = getFastLayout();
   Options.MCIncrementalLinkerCompatible = getIncrementalLinkerCompatible();
   Options.FDPIC = getFDPIC();
   Options.Dwarf64 = getDwarf64();
@@ -18,6 +18,7 @@
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstddef>
@@ -2108,15 +2109,20 @@ template <class ELFT> void ELFWriter<ELFT>::writeShdrs() {
 }
 
 template <class ELFT> Error ELFWriter<ELFT>::writeSectionData() {
+  // Segments are responsible for writing their contents, so only write the
+  // section data if the section is not in a segment. Note that this renders
+  // sections in segments effectively immutable.
+  SmallVector<SectionBase *, 32> SectionsToWrite;
   for (SectionBase &Sec : Obj.sections())
-    // Segments are responsible for writing their contents, so only write the
-    // section data if the section is not in a segment. Note that this renders
-    // sections in segments effectively immutable.
     if (Sec.ParentSegment == nullptr)
-      if (Error Err = Sec.accept(*SecWriter))
-        return Err;
+      SectionsToWrite.push_back(&Sec);
 
-  return Error::success();
+  // Each section writes only to its own [Offset, Offset + Size) slice of the
+  // output buffer, so both the plain content copies and the write-time
+  // transforms such as decompression can run in parallel.
+  return parallelForEachError(SectionsToWrite, [this](SectionBase *Sec) {
+    return Sec->accept(*SecWriter);
+  });
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -846,14 +847,71 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    // Parsing members into SymbolicFiles dominates symbol-table generation
+    // for large archives and is independent work per member, so spread it
+    // across the default executor. Bitcode members are skipped here and
+    // parsed in the serial sweep below because they all load into the shared
+    // LLVMContext, which is not thread-safe. Diagnostics are buffered per
+    // member and replayed in input order to keep them deterministic.
+    struct ParsedMember {
+      std::unique_ptr<SymbolicFile> File;
+      SmallVector<Error, 0> Warnings;
+      std::optional<Error> Err;
+      bool Done = false;
+    };
+    std::vector<ParsedMember> Parsed(NewMembers.size());
+    auto ConsumeRemainingDiags = [&] {
+      for (ParsedMember &P : Parsed) {
+        if (P.Err)
+          consumeError(std::move(*P.Err));
+        for (Error &E : P.Warnings)
+          consumeError(std::move(E));
+      }
+    };
+
+    parallelFor(0, NewMembers.size(), [&](size_t Index) {
+      MemoryBufferRef Buf = NewMembers[Index].Buf->getMemBufferRef();
+      if (identify_magic(Buf.getBuffer()) == file_magic::bitcode)
+        return;
+      ParsedMember &P = Parsed[Index];
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr = getSymbolicFile(
-          M.Buf->getMemBufferRef(), Context, Kind, [&](Error Err) {
-            Warn(createFileError(M.MemberName, std::move(Err)));
-          });
-      if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
+          Buf, Context, Kind,
+          [&](Error Err) { P.Warnings.push_back(std::move(Err)); });
+      if (SymFileOrErr)
+        P.File = std::move(*SymFileOrErr);
+      else
+        P.Err = SymFileOrErr.takeError();
+      P.Done = true;
+    });
+
+    SymFiles.resize(NewMembers.size());
+    for (uint32_t Index = 0; Index < NewMembers.size(); ++Index) {
+      const NewArchiveMember &M = NewMembers[Index];
+      ParsedMember &P = Parsed[Index];
+      if (!P.Done) {
+        // A bitcode member; parse it here where the LLVMContext is safe to
+        // use and warnings can be forwarded directly.
+        Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr = getSymbolicFile(
+            M.Buf->getMemBufferRef(), Context, Kind, [&](Error Err) {
+              Warn(createFileError(M.MemberName, std::move(Err)));
+            });
+        if (!SymFileOrErr) {
+          ConsumeRemainingDiags();
+          return createFileError(M.MemberName, SymFileOrErr.takeError());
+        }
+        SymFiles[Index] = std::move(*SymFileOrErr);
+        continue;
+      }
+      for (Error &E : P.Warnings)
+        Warn(createFileError(M.MemberName, std::move(E)));
+      P.Warnings.clear();
+      if (P.Err) {
+        Error Fatal = createFileError(M.MemberName, std::move(*P.Err));
+        P.Err.reset();
+        ConsumeRemainingDiags();
+        return std::move(Fatal);
+      }
+      SymFiles[Index] = std::move(P.File);
     }
   }
 
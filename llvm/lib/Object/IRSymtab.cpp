@@ -390,9 +390,16 @@ static Expected<FileContents> upgrade(ArrayRef<BitcodeModule> BMs) {
   std::vector<Module *> Mods;
   std::vector<std::unique_ptr<Module>> OwnedMods;
   for (auto BM : BMs) {
+    // Building the symbol table reads global symbols and a couple of named
+    // metadata nodes (linker options and dependent libraries), and the module
+    // is discarded afterwards. Loading in importing mode turns metadata
+    // materialization into on-demand index-based loading, so the debug-info
+    // graph of -g modules is never deserialized; the type shallowing that
+    // mode performs does not matter for a module that is only scanned for
+    // symbols.
     Expected<std::unique_ptr<Module>> MOrErr =
         BM.getLazyModule(Ctx, /*ShouldLazyLoadMetadata*/ true,
-                         /*IsImporting*/ false);
+                         /*IsImporting*/ true);
     if (!MOrErr)
       return MOrErr.takeError();
 
@@ -27,6 +27,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -796,9 +797,9 @@ public:
 
 } // namespace
 
-Error CoverageMapping::loadFunctionRecord(
-    const CoverageMappingRecord &Record,
-    IndexedInstrProfReader &ProfileReader) {
+Error CoverageMapping::prepareFunctionRecord(
+    const CoverageMappingRecord &Record, IndexedInstrProfReader &ProfileReader,
+    std::vector<PendingFunctionRecord> &Pending) {
   StringRef OrigFuncName = Record.FunctionName;
   if (OrigFuncName.empty())
     return make_error<CoverageMapError>(coveragemap_error::malformed,
@@ -824,7 +825,6 @@ Error CoverageMapping::loadFunctionRecord(
       return make_error<InstrProfError>(IPE);
     Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
   }
-  Ctx.setCounts(Counts);
 
   bool IsVersion11 =
       ProfileReader.getVersion() < IndexedInstrProf::ProfVersion::Version12;
@@ -842,7 +842,6 @@ Error CoverageMapping::loadFunctionRecord(
       return make_error<InstrProfError>(IPE);
     Bitmap = BitVector(getMaxBitmapSize(Record, IsVersion11));
   }
-  Ctx.setBitmap(std::move(Bitmap));
 
   assert(!Record.MappingRegions.empty() && "Function has no regions");
 
@@ -855,9 +854,26 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
+  // The function name and the filename strings are owned by the reader and
+  // outlive the pending record; the arrays are only valid until the next
+  // record is read, so copy them.
+  Pending.push_back({OrigFuncName,
+                     {Record.Filenames.begin(), Record.Filenames.end()},
+                     Record.Expressions.vec(), Record.MappingRegions.vec(),
+                     std::move(Counts), std::move(Bitmap)});
+  return Error::success();
+}
+
+std::optional<FunctionRecord>
+CoverageMapping::evaluatePendingRecord(PendingFunctionRecord &PR,
+                                       bool IsVersion11) {
+  CounterMappingContext Ctx(PR.Expressions);
+  Ctx.setCounts(PR.Counts);
+  Ctx.setBitmap(std::move(PR.Bitmap));
+
   MCDCDecisionRecorder MCDCDecisions;
-  FunctionRecord Function(OrigFuncName, Record.Filenames);
-  for (const auto &Region : Record.MappingRegions) {
+  FunctionRecord Function(PR.OrigFuncName, PR.Filenames);
+  for (const auto &Region : PR.MappingRegions) {
     // MCDCDecisionRegion should be handled first since it overlaps with
     // others inside.
     if (Region.Kind == CounterMappingRegion::MCDCDecisionRegion) {
@@ -867,12 +883,12 @@ Error CoverageMapping::loadFunctionRecord(
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
     if (auto E = ExecutionCount.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
     Expected<int64_t> AltExecutionCount = Ctx.evaluate(Region.FalseCount);
     if (auto E = AltExecutionCount.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
     Function.pushRegion(Region, *ExecutionCount, *AltExecutionCount);
 
@@ -900,35 +916,53 @@ Error CoverageMapping::loadFunctionRecord(
         Ctx.evaluateMCDCRegion(*MCDCDecision, MCDCBranches, IsVersion11);
     if (auto E = Record.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
 
     // Save the MC/DC Record so that it can be visualized later.
     Function.pushMCDCRecord(std::move(*Record));
   }
 
-  // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
+  return Function;
+}
 
-  Functions.push_back(std::move(Function));
-
-  // Performance optimization: keep track of the indices of the function records
-  // which correspond to each filename. This can be used to substantially speed
-  // up queries for coverage info in a file.
-  unsigned RecordIndex = Functions.size() - 1;
-  for (StringRef Filename : Record.Filenames) {
-    auto &RecordIndices = FilenameHash2RecordIndices[hash_value(Filename)];
-    // Note that there may be duplicates in the filename set for a function
-    // record, because of e.g. macro expansions in the function in which both
-    // the macro and the function are defined in the same file.
-    if (RecordIndices.empty() || RecordIndices.back() != RecordIndex)
-      RecordIndices.push_back(RecordIndex);
-  }
+void CoverageMapping::evaluateFunctionRecords(
+    MutableArrayRef<PendingFunctionRecord> Pending, bool IsVersion11) {
+  // Each record is evaluated against its own counts and bitmap only, so the
+  // records can be processed concurrently.
+  std::vector<std::optional<FunctionRecord>> Results(Pending.size());
+  parallelFor(0, Pending.size(), [&](size_t I) {
+    Results[I] = evaluatePendingRecord(Pending[I], IsVersion11);
+  });
 
-  return Error::success();
+  // Commit the results serially, preserving the on-disk record order.
+  for (auto [PR, Result] : zip(Pending, Results)) {
+    if (!Result)
+      continue;
+
+    // Don't create records for (filenames, function) pairs we've already seen.
+    auto FilenamesHash =
+        hash_combine_range(PR.Filenames.begin(), PR.Filenames.end());
+    if (!RecordProvenance[FilenamesHash]
+             .insert(hash_value(PR.OrigFuncName))
+             .second)
+      continue;
+
+    Functions.push_back(std::move(*Result));
+
+    // Performance optimization: keep track of the indices of the function
+    // records which correspond to each filename. This can be used to
+    // substantially speed up queries for coverage info in a file.
+    unsigned RecordIndex = Functions.size() - 1;
+    for (StringRef Filename : PR.Filenames) {
+      auto &RecordIndices = FilenameHash2RecordIndices[hash_value(Filename)];
+      // Note that there may be duplicates in the filename set for a function
+      // record, because of e.g. macro expansions in the function in which both
+      // the macro and the function are defined in the same file.
+      if (RecordIndices.empty() || RecordIndices.back() != RecordIndex)
+        RecordIndices.push_back(RecordIndex);
+    }
+  }
 }
 
 // This function is for memory optimization by shortening the lifetimes
@@ -939,14 +973,33 @@ Error CoverageMapping::loadFromReaders(
   assert(!Coverage.SingleByteCoverage ||
          *Coverage.SingleByteCoverage == ProfileReader.hasSingleByteCoverage());
   Coverage.SingleByteCoverage = ProfileReader.hasSingleByteCoverage();
+  bool IsVersion11 =
+      ProfileReader.getVersion() < IndexedInstrProf::ProfVersion::Version12;
+  // Decoding records and looking up their profile data must stay serial (the
+  // readers and the profile reader are stateful), but evaluating them is
+  // independent per record. Accumulate batches of owned records and evaluate
+  // each batch in parallel; the batch size bounds the extra memory spent on
+  // the owned copies.
+  constexpr size_t MaxBatchSize = 512;
+  std::vector<PendingFunctionRecord> Pending;
+  Pending.reserve(MaxBatchSize);
   for (const auto &CoverageReader : CoverageReaders) {
     for (auto RecordOrErr : *CoverageReader) {
       if (Error E = RecordOrErr.takeError())
         return E;
       const auto &Record = *RecordOrErr;
-      if (Error E = Coverage.loadFunctionRecord(Record, ProfileReader))
+      if (Error E =
+              Coverage.prepareFunctionRecord(Record, ProfileReader, Pending))
         return E;
+      if (Pending.size() >= MaxBatchSize) {
+        Coverage.evaluateFunctionRecords(Pending, IsVersion11);
+        Pending.clear();
+      }
     }
+    // Flush before this reader, which owns the strings the pending records
+    // point into, can be released.
+    Coverage.evaluateFunctionRecords(Pending, IsVersion11);
+    Pending.clear();
   }
   return Error::success();
 }
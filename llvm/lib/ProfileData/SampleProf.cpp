@@ -90,6 +90,8 @@ class SampleProfErrorCategoryType : public std::error_category {
       return "Zlib is unavailable";
     case sampleprof_error::hash_mismatch:
       return "Function hash mismatch";
+    case sampleprof_error::zstd_unavailable:
+      return "Zstd is unavailable";
     }
     llvm_unreachable("A value of sampleprof_error has no message.");
   }
@@ -1016,7 +1016,7 @@ std::error_code SampleProfileReaderExtBinaryBase::readProfileSymbolList() {
 }
 
 std::error_code SampleProfileReaderExtBinaryBase::decompressSection(
-    const uint8_t *SecStart, const uint64_t SecSize,
+    const uint8_t *SecStart, const uint64_t SecSize, bool IsZstd,
     const uint8_t *&DecompressBuf, uint64_t &DecompressBufSize) {
   Data = SecStart;
   End = SecStart + SecSize;
@@ -1029,13 +1029,19 @@ std::error_code SampleProfileReaderExtBinaryBase::decompressSection(
   if (std::error_code EC = CompressSize.getError())
     return EC;
 
-  if (!llvm::compression::zlib::isAvailable())
+  if (IsZstd) {
+    if (!llvm::compression::zstd::isAvailable())
+      return sampleprof_error::zstd_unavailable;
+  } else if (!llvm::compression::zlib::isAvailable())
     return sampleprof_error::zlib_unavailable;
 
   uint8_t *Buffer = Allocator.Allocate<uint8_t>(DecompressBufSize);
   size_t UCSize = DecompressBufSize;
-  llvm::Error E = compression::zlib::decompress(ArrayRef(Data, *CompressSize),
-                                                Buffer, UCSize);
+  llvm::Error E =
+      IsZstd ? compression::zstd::decompress(ArrayRef(Data, *CompressSize),
+                                             Buffer, UCSize)
+             : compression::zlib::decompress(ArrayRef(Data, *CompressSize),
+                                             Buffer, UCSize);
   if (E)
     return sampleprof_error::uncompress_failed;
   DecompressBuf = reinterpret_cast<const uint8_t *>(Buffer);
@@ -1064,10 +1070,11 @@ std::error_code SampleProfileReaderExtBinaryBase::readImpl() {
     // temporarily when reading the actual data.
     bool isCompressed = hasSecFlag(Entry, SecCommonFlags::SecFlagCompress);
     if (isCompressed) {
+      bool IsZstd = hasSecFlag(Entry, SecCommonFlags::SecFlagCompressZstd);
       const uint8_t *DecompressBuf;
       uint64_t DecompressBufSize;
       if (std::error_code EC = decompressSection(
-              SecStart, SecSize, DecompressBuf, DecompressBufSize))
+              SecStart, SecSize, IsZstd, DecompressBuf, DecompressBufSize))
         return EC;
       SecStart = DecompressBuf;
       SecSize = DecompressBufSize;
@@ -175,7 +175,10 @@ SampleProfileWriterExtBinaryBase::markSectionStart(SecType Type,
 }
 
 std::error_code SampleProfileWriterExtBinaryBase::compressAndOutput() {
-  if (!llvm::compression::zlib::isAvailable())
+  if (CompressWithZstd) {
+    if (!llvm::compression::zstd::isAvailable())
+      return sampleprof_error::zstd_unavailable;
+  } else if (!llvm::compression::zlib::isAvailable())
     return sampleprof_error::zlib_unavailable;
   std::string &UncompressedStrings =
       static_cast<raw_string_ostream *>(LocalBufStream.get())->str();
@@ -183,9 +186,14 @@ std::error_code SampleProfileWriterExtBinaryBase::compressAndOutput() {
     return sampleprof_error::success;
   auto &OS = *OutputStream;
   SmallVector<uint8_t, 128> CompressedStrings;
-  compression::zlib::compress(arrayRefFromStringRef(UncompressedStrings),
-                              CompressedStrings,
-                              compression::zlib::BestSizeCompression);
+  if (CompressWithZstd)
+    compression::zstd::compress(arrayRefFromStringRef(UncompressedStrings),
+                                CompressedStrings,
+                                compression::zstd::BestSizeCompression);
+  else
+    compression::zlib::compress(arrayRefFromStringRef(UncompressedStrings),
+                                CompressedStrings,
+                                compression::zlib::BestSizeCompression);
   encodeULEB128(UncompressedStrings.size(), OS);
   encodeULEB128(CompressedStrings.size(), OS);
   OS << toStringRef(CompressedStrings);
@@ -201,12 +209,17 @@ std::error_code SampleProfileWriterExtBinaryBase::addNewSection(
   assert(LayoutIdx < SectionHdrLayout.size() && "LayoutIdx out of range");
   const auto &Entry = SectionHdrLayout[LayoutIdx];
   assert(Entry.Type == Type && "Unexpected section type");
+  SecHdrTableEntry HdrEntry = Entry;
   if (hasSecFlag(Entry, SecCommonFlags::SecFlagCompress)) {
     LocalBufStream.swap(OutputStream);
     if (std::error_code EC = compressAndOutput())
       return EC;
+    // Record the codec in the section header so the reader knows how to
+    // decompress the payload.
+    if (CompressWithZstd)
+      addSecFlag(HdrEntry, SecCommonFlags::SecFlagCompressZstd);
   }
-  SecHdrTable.push_back({Type, Entry.Flags, SectionStart - FileStart,
+  SecHdrTable.push_back({Type, HdrEntry.Flags, SectionStart - FileStart,
                          OutputStream->tell() - SectionStart, LayoutIdx});
   return sampleprof_error::success;
 }
@@ -348,20 +348,42 @@ void Tracker::save() {
 void Tracker::revert() {
   assert(State == TrackerState::Record && "Forgot to save()!");
   State = TrackerState::Disabled;
-  for (auto &Change : reverse(Changes))
+  for (IRChangeBase *Change : reverse(Changes)) {
     Change->revert(*this);
+    Change->~IRChangeBase();
+  }
   Changes.clear();
+  ChangeAllocator.Reset();
 #if !defined(NDEBUG) && defined(EXPENSIVE_CHECKS)
   SnapshotChecker.expectNoDiff();
 #endif
 }
 
+void Tracker::revertToCheckpoint(CheckpointTy Chkpnt) {
+  assert(State == TrackerState::Record && "Forgot to save()!");
+  assert(Chkpnt <= Changes.size() && "Invalid checkpoint!");
+  // Disable tracking while reverting: the reverting changes must not record
+  // new changes themselves.
+  State = TrackerState::Disabled;
+  while (Changes.size() > Chkpnt) {
+    IRChangeBase *Change = Changes.pop_back_val();
+    Change->revert(*this);
+    // The pool memory of the discarded changes is only reclaimed when the
+    // whole transaction ends in accept() or revert().
+    Change->~IRChangeBase();
+  }
+  State = TrackerState::Record;
+}
+
 void Tracker::accept() {
   assert(State == TrackerState::Record && "Forgot to save()!");
   State = TrackerState::Disabled;
-  for (auto &Change : Changes)
+  for (IRChangeBase *Change : Changes) {
     Change->accept();
+    Change->~IRChangeBase();
+  }
   Changes.clear();
+  ChangeAllocator.Reset();
 }
 
 #ifndef NDEBUG
@@ -71,21 +71,38 @@ inline static unsigned getDigit(char cdigit, uint8_t radix) {
 }
 
 
+uint64_t *APInt::allocWords(bool Zero) {
+  if (isInlineStorage()) {
+    if (Zero)
+      memset(U.IVAL, 0, sizeof(U.IVAL));
+    return U.IVAL;
+  }
+  U.pVal = Zero ? getClearedMemory(getNumWords()) : getMemory(getNumWords());
+  return U.pVal;
+}
+
+APInt APInt::createUninitialized(unsigned numBits) {
+  APInt Result;
+  Result.BitWidth = numBits;
+  if (!Result.isInlineStorage())
+    Result.U.pVal = getMemory(Result.getNumWords());
+  return Result;
+}
+
 void APInt::initSlowCase(uint64_t val, bool isSigned) {
   if (isSigned && int64_t(val) < 0) {
-    U.pVal = getMemory(getNumWords());
-    U.pVal[0] = val;
-    memset(&U.pVal[1], 0xFF, APINT_WORD_SIZE * (getNumWords() - 1));
+    uint64_t *Words = allocWords(/*Zero=*/false);
+    Words[0] = val;
+    memset(&Words[1], 0xFF, APINT_WORD_SIZE * (getNumWords() - 1));
     clearUnusedBits();
   } else {
-    U.pVal = getClearedMemory(getNumWords());
-    U.pVal[0] = val;
+    allocWords(/*Zero=*/true)[0] = val;
   }
 }
 
 void APInt::initSlowCase(const APInt& that) {
-  U.pVal = getMemory(getNumWords());
-  memcpy(U.pVal, that.U.pVal, getNumWords() * APINT_WORD_SIZE);
+  memcpy(allocWords(/*Zero=*/false), that.wordsPtr(),
+         getNumWords() * APINT_WORD_SIZE);
 }
 
 void APInt::initFromArray(ArrayRef<uint64_t> bigVal) {
@@ -94,11 +111,11 @@ void APInt::initFromArray(ArrayRef<uint64_t> bigVal) {
     U.VAL = bigVal[0];
   else {
     // Get memory, cleared to 0
-    U.pVal = getClearedMemory(getNumWords());
+    uint64_t *Words = allocWords(/*Zero=*/true);
     // Calculate the number of words to copy
     unsigned words = std::min<unsigned>(bigVal.size(), getNumWords());
-    // Copy the words from bigVal to pVal
-    memcpy(U.pVal, bigVal.data(), words * APINT_WORD_SIZE);
+    // Copy the words from bigVal into place
+    memcpy(Words, bigVal.data(), words * APINT_WORD_SIZE);
   }
   // Make sure unused high bits are cleared
   clearUnusedBits();
@@ -126,14 +143,14 @@ void APInt::reallocate(unsigned NewBitWidth) {
   }
 
   // If we have an allocation, delete it.
-  if (!isSingleWord())
+  if (needsCleanup())
     delete [] U.pVal;
 
   // Update BitWidth.
   BitWidth = NewBitWidth;
 
   // If we are supposed to have an allocation, create it.
-  if (!isSingleWord())
+  if (!isInlineStorage())
     U.pVal = getMemory(getNumWords());
 }
 
@@ -149,7 +166,7 @@ void APInt::assignSlowCase(const APInt &RHS) {
   if (isSingleWord())
     U.VAL = RHS.U.VAL;
   else
-    memcpy(U.pVal, RHS.U.pVal, getNumWords() * APINT_WORD_SIZE);
+    memcpy(wordsPtr(), RHS.wordsPtr(), getNumWords() * APINT_WORD_SIZE);
 }
 
 /// This method 'profiles' an APInt for use with FoldingSet.
@@ -163,7 +180,7 @@ void APInt::Profile(FoldingSetNodeID& ID) const {
 
   unsigned NumWords = getNumWords();
   for (unsigned i = 0; i < NumWords; ++i)
-    ID.AddInteger(U.pVal[i]);
+    ID.AddInteger(wordsPtr()[i]);
 }
 
 bool APInt::isAligned(Align A) const {
@@ -179,7 +196,7 @@ APInt& APInt::operator++() {
   if (isSingleWord())
     ++U.VAL;
   else
-    tcIncrement(U.pVal, getNumWords());
+    tcIncrement(wordsPtr(), getNumWords());
   return clearUnusedBits();
 }
 
@@ -188,7 +205,7 @@ APInt& APInt::operator--() {
   if (isSingleWord())
     --U.VAL;
   else
-    tcDecrement(U.pVal, getNumWords());
+    tcDecrement(wordsPtr(), getNumWords());
   return clearUnusedBits();
 }
 
@@ -200,7 +217,7 @@ APInt& APInt::operator+=(const APInt& RHS) {
   if (isSingleWord())
     U.VAL += RHS.U.VAL;
   else
-    tcAdd(U.pVal, RHS.U.pVal, 0, getNumWords());
+    tcAdd(wordsPtr(), RHS.wordsPtr(), 0, getNumWords());
   return clearUnusedBits();
 }
 
@@ -208,7 +225,7 @@ APInt& APInt::operator+=(uint64_t RHS) {
   if (isSingleWord())
     U.VAL += RHS;
   else
-    tcAddPart(U.pVal, RHS, getNumWords());
+    tcAddPart(wordsPtr(), RHS, getNumWords());
   return clearUnusedBits();
 }
 
@@ -220,7 +237,7 @@ APInt& APInt::operator-=(const APInt& RHS) {
   if (isSingleWord())
     U.VAL -= RHS.U.VAL;
   else
-    tcSubtract(U.pVal, RHS.U.pVal, 0, getNumWords());
+    tcSubtract(wordsPtr(), RHS.wordsPtr(), 0, getNumWords());
   return clearUnusedBits();
 }
 
@@ -228,7 +245,7 @@ APInt& APInt::operator-=(uint64_t RHS) {
   if (isSingleWord())
     U.VAL -= RHS;
   else
-    tcSubtractPart(U.pVal, RHS, getNumWords());
+    tcSubtractPart(wordsPtr(), RHS, getNumWords());
   return clearUnusedBits();
 }
 
@@ -238,26 +255,29 @@ APInt APInt::operator*(const APInt& RHS) const {
     return APInt(BitWidth, U.VAL * RHS.U.VAL, /*isSigned=*/false,
                  /*implicitTrunc=*/true);
 
-  APInt Result(getMemory(getNumWords()), getBitWidth());
-  tcMultiply(Result.U.pVal, U.pVal, RHS.U.pVal, getNumWords());
+  APInt Result = createUninitialized(getBitWidth());
+  tcMultiply(Result.wordsPtr(), wordsPtr(), RHS.wordsPtr(), getNumWords());
   Result.clearUnusedBits();
   return Result;
 }
 
 void APInt::andAssignSlowCase(const APInt &RHS) {
-  WordType *dst = U.pVal, *rhs = RHS.U.pVal;
+  WordType *dst = wordsPtr();
+  const WordType *rhs = RHS.wordsPtr();
   for (size_t i = 0, e = getNumWords(); i != e; ++i)
     dst[i] &= rhs[i];
 }
 
 void APInt::orAssignSlowCase(const APInt &RHS) {
-  WordType *dst = U.pVal, *rhs = RHS.U.pVal;
+  WordType *dst = wordsPtr();
+  const WordType *rhs = RHS.wordsPtr();
   for (size_t i = 0, e = getNumWords(); i != e; ++i)
     dst[i] |= rhs[i];
 }
 
 void APInt::xorAssignSlowCase(const APInt &RHS) {
-  WordType *dst = U.pVal, *rhs = RHS.U.pVal;
+  WordType *dst = wordsPtr();
+  const WordType *rhs = RHS.wordsPtr();
   for (size_t i = 0, e = getNumWords(); i != e; ++i)
     dst[i] ^= rhs[i];
 }
@@ -272,13 +292,13 @@ APInt& APInt::operator*=(uint64_t RHS) {
     U.VAL *= RHS;
   } else {
     unsigned NumWords = getNumWords();
-    tcMultiplyPart(U.pVal, U.pVal, RHS, 0, NumWords, NumWords, false);
+    tcMultiplyPart(wordsPtr(), wordsPtr(), RHS, 0, NumWords, NumWords, false);
   }
   return clearUnusedBits();
 }
 
 bool APInt::equalSlowCase(const APInt &RHS) const {
-  return std::equal(U.pVal, U.pVal + getNumWords(), RHS.U.pVal);
+  return std::equal(wordsPtr(), wordsPtr() + getNumWords(), RHS.wordsPtr());
 }
 
 int APInt::compare(const APInt& RHS) const {
@@ -286,7 +306,7 @@ int APInt::compare(const APInt& RHS) const {
   if (isSingleWord())
     return U.VAL < RHS.U.VAL ? -1 : U.VAL > RHS.U.VAL;
 
-  return tcCompare(U.pVal, RHS.U.pVal, getNumWords());
+  return tcCompare(wordsPtr(), RHS.wordsPtr(), getNumWords());
 }
 
 int APInt::compareSigned(const APInt& RHS) const {
@@ -306,7 +326,7 @@ int APInt::compareSigned(const APInt& RHS) const {
 
   // Otherwise we can just use an unsigned comparison, because even negative
   // numbers compare correctly this way if both have the same signed-ness.
-  return tcCompare(U.pVal, RHS.U.pVal, getNumWords());
+  return tcCompare(wordsPtr(), RHS.wordsPtr(), getNumWords());
 }
 
 void APInt::setBitsSlowCase(unsigned loBit, unsigned hiBit) {
@@ -326,14 +346,14 @@ void APInt::setBitsSlowCase(unsigned loBit, unsigned hiBit) {
     if (hiWord == loWord)
       loMask &= hiMask;
     else
-      U.pVal[hiWord] |= hiMask;
+      wordsPtr()[hiWord] |= hiMask;
   }
   // Apply the mask to the low word.
-  U.pVal[loWord] |= loMask;
+  wordsPtr()[loWord] |= loMask;
 
   // Fill any words between loWord and hiWord with all ones.
   for (unsigned word = loWord + 1; word < hiWord; ++word)
-    U.pVal[word] = WORDTYPE_MAX;
+    wordsPtr()[word] = WORDTYPE_MAX;
 }
 
 // Complement a bignum in-place.
@@ -344,7 +364,7 @@ static void tcComplement(APInt::WordType *dst, unsigned parts) {
 
 /// Toggle every bit to its opposite value.
 void APInt::flipAllBitsSlowCase() {
-  tcComplement(U.pVal, getNumWords());
+  tcComplement(wordsPtr(), getNumWords());
   clearUnusedBits();
 }
 
@@ -396,8 +416,8 @@ void APInt::insertBits(const APInt &subBits, unsigned bitPosition) {
   // Insertion within a single word can be done as a direct bitmask.
   if (loWord == hi1Word) {
     uint64_t mask = WORDTYPE_MAX >> (APINT_BITS_PER_WORD - subBitWidth);
-    U.pVal[loWord] &= ~(mask << loBit);
-    U.pVal[loWord] |= (subBits.U.VAL << loBit);
+    wordsPtr()[loWord] &= ~(mask << loBit);
+    wordsPtr()[loWord] |= (subBits.U.VAL << loBit);
     return;
   }
 
@@ -405,15 +425,15 @@ void APInt::insertBits(const APInt &subBits, unsigned bitPosition) {
   if (loBit == 0) {
     // Direct copy whole words.
     unsigned numWholeSubWords = subBitWidth / APINT_BITS_PER_WORD;
-    memcpy(U.pVal + loWord, subBits.getRawData(),
+    memcpy(wordsPtr() + loWord, subBits.getRawData(),
            numWholeSubWords * APINT_WORD_SIZE);
 
     // Mask+insert remaining bits.
     unsigned remainingBits = subBitWidth % APINT_BITS_PER_WORD;
     if (remainingBits != 0) {
       uint64_t mask = WORDTYPE_MAX >> (APINT_BITS_PER_WORD - remainingBits);
-      U.pVal[hi1Word] &= ~mask;
-      U.pVal[hi1Word] |= subBits.getWord(subBitWidth - 1);
+      wordsPtr()[hi1Word] &= ~mask;
+      wordsPtr()[hi1Word] |= subBits.getWord(subBitWidth - 1);
     }
     return;
   }
@@ -438,18 +458,18 @@ void APInt::insertBits(uint64_t subBits, unsigned bitPosition, unsigned numBits)
   unsigned loWord = whichWord(bitPosition);
   unsigned hiWord = whichWord(bitPosition + numBits - 1);
   if (loWord == hiWord) {
-    U.pVal[loWord] &= ~(maskBits << loBit);
-    U.pVal[loWord] |= subBits << loBit;
+    wordsPtr()[loWord] &= ~(maskBits << loBit);
+    wordsPtr()[loWord] |= subBits << loBit;
     return;
   }
 
   static_assert(8 * sizeof(WordType) <= 64, "This code assumes only two words affected");
   unsigned wordBits = 8 * sizeof(WordType);
-  U.pVal[loWord] &= ~(maskBits << loBit);
-  U.pVal[loWord] |= subBits << loBit;
+  wordsPtr()[loWord] &= ~(maskBits << loBit);
+  wordsPtr()[loWord] |= subBits << loBit;
 
-  U.pVal[hiWord] &= ~(maskBits >> (wordBits - loBit));
-  U.pVal[hiWord] |= subBits >> (wordBits - loBit);
+  wordsPtr()[hiWord] &= ~(maskBits >> (wordBits - loBit));
+  wordsPtr()[hiWord] |= subBits >> (wordBits - loBit);
 }
 
 APInt APInt::extractBits(unsigned numBits, unsigned bitPosition) const {
@@ -466,24 +486,24 @@ APInt APInt::extractBits(unsigned numBits, unsigned bitPosition) const {
 
   // Single word result extracting bits from a single word source.
   if (loWord == hiWord)
-    return APInt(numBits, U.pVal[loWord] >> loBit, /*isSigned=*/false,
+    return APInt(numBits, wordsPtr()[loWord] >> loBit, /*isSigned=*/false,
                  /*implicitTrunc=*/true);
 
   // Extracting bits that start on a source word boundary can be done
   // as a fast memory copy.
   if (loBit == 0)
-    return APInt(numBits, ArrayRef(U.pVal + loWord, 1 + hiWord - loWord));
+    return APInt(numBits, ArrayRef(wordsPtr() + loWord, 1 + hiWord - loWord));
 
   // General case - shift + copy source words directly into place.
   APInt Result(numBits, 0);
   unsigned NumSrcWords = getNumWords();
   unsigned NumDstWords = Result.getNumWords();
 
-  uint64_t *DestPtr = Result.isSingleWord() ? &Result.U.VAL : Result.U.pVal;
+  uint64_t *DestPtr = Result.isSingleWord() ? &Result.U.VAL : Result.wordsPtr();
   for (unsigned word = 0; word < NumDstWords; ++word) {
-    uint64_t w0 = U.pVal[loWord + word];
+    uint64_t w0 = wordsPtr()[loWord + word];
     uint64_t w1 =
-        (loWord + word + 1) < NumSrcWords ? U.pVal[loWord + word + 1] : 0;
+        (loWord + word + 1) < NumSrcWords ? wordsPtr()[loWord + word + 1] : 0;
     DestPtr[word] = (w0 >> loBit) | (w1 << (APINT_BITS_PER_WORD - loBit));
   }
 
@@ -506,10 +526,10 @@ uint64_t APInt::extractBitsAsZExtValue(unsigned numBits,
   unsigned loWord = whichWord(bitPosition);
   unsigned hiWord = whichWord(bitPosition + numBits - 1);
   if (loWord == hiWord)
-    return (U.pVal[loWord] >> loBit) & maskBits;
+    return (wordsPtr()[loWord] >> loBit) & maskBits;
 
-  uint64_t retBits = U.pVal[loWord] >> loBit;
-  retBits |= U.pVal[hiWord] << (APINT_BITS_PER_WORD - loBit);
+  uint64_t retBits = wordsPtr()[loWord] >> loBit;
+  retBits |= wordsPtr()[hiWord] << (APINT_BITS_PER_WORD - loBit);
   retBits &= maskBits;
   return retBits;
 }
@@ -593,7 +613,7 @@ hash_code llvm::hash_value(const APInt &Arg) {
 
   return hash_combine(
       Arg.BitWidth,
-      hash_combine_range(Arg.U.pVal, Arg.U.pVal + Arg.getNumWords()));
+      hash_combine_range(Arg.wordsPtr(), Arg.wordsPtr() + Arg.getNumWords()));
 }
 
 unsigned DenseMapInfo<APInt, void>::getHashValue(const APInt &Key) {
@@ -634,7 +654,7 @@ APInt APInt::getSplat(unsigned NewLen, const APInt &V) {
 unsigned APInt::countLeadingZerosSlowCase() const {
   unsigned Count = 0;
   for (int i = getNumWords()-1; i >= 0; --i) {
-    uint64_t V = U.pVal[i];
+    uint64_t V = wordsPtr()[i];
     if (V == 0)
       Count += APINT_BITS_PER_WORD;
     else {
@@ -658,13 +678,13 @@ unsigned APInt::countLeadingOnesSlowCase() const {
     shift = APINT_BITS_PER_WORD - highWordBits;
   }
   int i = getNumWords() - 1;
-  unsigned Count = llvm::countl_one(U.pVal[i] << shift);
+  unsigned Count = llvm::countl_one(wordsPtr()[i] << shift);
   if (Count == highWordBits) {
     for (i--; i >= 0; --i) {
-      if (U.pVal[i] == WORDTYPE_MAX)
+      if (wordsPtr()[i] == WORDTYPE_MAX)
         Count += APINT_BITS_PER_WORD;
       else {
-        Count += llvm::countl_one(U.pVal[i]);
+        Count += llvm::countl_one(wordsPtr()[i]);
         break;
       }
     }
@@ -675,20 +695,20 @@ unsigned APInt::countLeadingOnesSlowCase() const {
 unsigned APInt::countTrailingZerosSlowCase() const {
   unsigned Count = 0;
   unsigned i = 0;
-  for (; i < getNumWords() && U.pVal[i] == 0; ++i)
+  for (; i < getNumWords() && wordsPtr()[i] == 0; ++i)
     Count += APINT_BITS_PER_WORD;
   if (i < getNumWords())
-    Count += llvm::countr_zero(U.pVal[i]);
+    Count += llvm::countr_zero(wordsPtr()[i]);
   return std::min(Count, BitWidth);
 }
 
 unsigned APInt::countTrailingOnesSlowCase() const {
   unsigned Count = 0;
   unsigned i = 0;
-  for (; i < getNumWords() && U.pVal[i] == WORDTYPE_MAX; ++i)
+  for (; i < getNumWords() && wordsPtr()[i] == WORDTYPE_MAX; ++i)
     Count += APINT_BITS_PER_WORD;
   if (i < getNumWords())
-    Count += llvm::countr_one(U.pVal[i]);
+    Count += llvm::countr_one(wordsPtr()[i]);
   assert(Count <= BitWidth);
   return Count;
 }
@@ -696,13 +716,13 @@ unsigned APInt::countTrailingOnesSlowCase() const {
 unsigned APInt::countPopulationSlowCase() const {
   unsigned Count = 0;
   for (unsigned i = 0; i < getNumWords(); ++i)
-    Count += llvm::popcount(U.pVal[i]);
+    Count += llvm::popcount(wordsPtr()[i]);
   return Count;
 }
 
 bool APInt::intersectsSlowCase(const APInt &RHS) const {
   for (unsigned i = 0, e = getNumWords(); i != e; ++i)
-    if ((U.pVal[i] & RHS.U.pVal[i]) != 0)
+    if ((wordsPtr()[i] & RHS.wordsPtr()[i]) != 0)
       return true;
 
   return false;
@@ -710,7 +730,7 @@ bool APInt::intersectsSlowCase(const APInt &RHS) const {
 
 bool APInt::isSubsetOfSlowCase(const APInt &RHS) const {
   for (unsigned i = 0, e = getNumWords(); i != e; ++i)
-    if ((U.pVal[i] & ~RHS.U.pVal[i]) != 0)
+    if ((wordsPtr()[i] & ~RHS.wordsPtr()[i]) != 0)
       return false;
 
   return true;
@@ -730,7 +750,7 @@ APInt APInt::byteSwap() const {
 
   APInt Result(getNumWords() * APINT_BITS_PER_WORD, 0);
   for (unsigned I = 0, N = getNumWords(); I != N; ++I)
-    Result.U.pVal[I] = llvm::byteswap<uint64_t>(U.pVal[N - I - 1]);
+    Result.wordsPtr()[I] = llvm::byteswap<uint64_t>(wordsPtr()[N - I - 1]);
   if (Result.BitWidth != BitWidth) {
     Result.lshrInPlace(Result.BitWidth - BitWidth);
     Result.BitWidth = BitWidth;
@@ -890,13 +910,13 @@ double APInt::roundToDouble(bool isSigned) const {
   uint64_t mantissa;
   unsigned hiWord = whichWord(n-1);
   if (hiWord == 0) {
-    mantissa = Tmp.U.pVal[0];
+    mantissa = Tmp.wordsPtr()[0];
     if (n > 52)
       mantissa >>= n - 52; // shift down, we want the top 52 bits.
   } else {
     assert(hiWord > 0 && "huh?");
-    uint64_t hibits = Tmp.U.pVal[hiWord] << (52 - n % APINT_BITS_PER_WORD);
-    uint64_t lobits = Tmp.U.pVal[hiWord-1] >> (11 + n % APINT_BITS_PER_WORD);
+    uint64_t hibits = Tmp.wordsPtr()[hiWord] << (52 - n % APINT_BITS_PER_WORD);
+    uint64_t lobits = Tmp.wordsPtr()[hiWord-1] >> (11 + n % APINT_BITS_PER_WORD);
     mantissa = hibits | lobits;
   }
 
@@ -917,17 +937,17 @@ APInt APInt::trunc(unsigned width) const {
   if (width == BitWidth)
     return *this;
 
-  APInt Result(getMemory(getNumWords(width)), width);
+  APInt Result = createUninitialized(width);
 
   // Copy full words.
   unsigned i;
   for (i = 0; i != width / APINT_BITS_PER_WORD; i++)
-    Result.U.pVal[i] = U.pVal[i];
+    Result.wordsPtr()[i] = wordsPtr()[i];
 
   // Truncate and copy any partial word.
   unsigned bits = (0 - width) % APINT_BITS_PER_WORD;
   if (bits != 0)
-    Result.U.pVal[i] = U.pVal[i] << bits >> bits;
+    Result.wordsPtr()[i] = wordsPtr()[i] << bits >> bits;
 
   return Result;
 }
@@ -965,18 +985,18 @@ APInt APInt::sext(unsigned Width) const {
   if (Width == BitWidth)
     return *this;
 
-  APInt Result(getMemory(getNumWords(Width)), Width);
+  APInt Result = createUninitialized(Width);
 
   // Copy words.
-  std::memcpy(Result.U.pVal, getRawData(), getNumWords() * APINT_WORD_SIZE);
+  std::memcpy(Result.wordsPtr(), getRawData(), getNumWords() * APINT_WORD_SIZE);
 
   // Sign extend the last word since there may be unused bits in the input.
-  Result.U.pVal[getNumWords() - 1] =
-      SignExtend64(Result.U.pVal[getNumWords() - 1],
+  Result.wordsPtr()[getNumWords() - 1] =
+      SignExtend64(Result.wordsPtr()[getNumWords() - 1],
                    ((BitWidth - 1) % APINT_BITS_PER_WORD) + 1);
 
   // Fill with sign bits.
-  std::memset(Result.U.pVal + getNumWords(), isNegative() ? -1 : 0,
+  std::memset(Result.wordsPtr() + getNumWords(), isNegative() ? -1 : 0,
               (Result.getNumWords() - getNumWords()) * APINT_WORD_SIZE);
   Result.clearUnusedBits();
   return Result;
@@ -992,13 +1012,13 @@ APInt APInt::zext(unsigned width) const {
   if (width == BitWidth)
     return *this;
 
-  APInt Result(getMemory(getNumWords(width)), width);
+  APInt Result = createUninitialized(width);
 
   // Copy words.
-  std::memcpy(Result.U.pVal, getRawData(), getNumWords() * APINT_WORD_SIZE);
+  std::memcpy(Result.wordsPtr(), getRawData(), getNumWords() * APINT_WORD_SIZE);
 
   // Zero remaining words.
-  std::memset(Result.U.pVal + getNumWords(), 0,
+  std::memset(Result.wordsPtr() + getNumWords(), 0,
               (Result.getNumWords() - getNumWords()) * APINT_WORD_SIZE);
 
   return Result;
@@ -1043,27 +1063,27 @@ void APInt::ashrSlowCase(unsigned ShiftAmt) {
   unsigned WordsToMove = getNumWords() - WordShift;
   if (WordsToMove != 0) {
     // Sign extend the last word to fill in the unused bits.
-    U.pVal[getNumWords() - 1] = SignExtend64(
-        U.pVal[getNumWords() - 1], ((BitWidth - 1) % APINT_BITS_PER_WORD) + 1);
+    wordsPtr()[getNumWords() - 1] = SignExtend64(
+        wordsPtr()[getNumWords() - 1], ((BitWidth - 1) % APINT_BITS_PER_WORD) + 1);
 
     // Fastpath for moving by whole words.
     if (BitShift == 0) {
-      std::memmove(U.pVal, U.pVal + WordShift, WordsToMove * APINT_WORD_SIZE);
+      std::memmove(wordsPtr(), wordsPtr() + WordShift, WordsToMove * APINT_WORD_SIZE);
     } else {
       // Move the words containing significant bits.
       for (unsigned i = 0; i != WordsToMove - 1; ++i)
-        U.pVal[i] = (U.pVal[i + WordShift] >> BitShift) |
-                    (U.pVal[i + WordShift + 1] << (APINT_BITS_PER_WORD - BitShift));
+        wordsPtr()[i] = (wordsPtr()[i + WordShift] >> BitShift) |
+                    (wordsPtr()[i + WordShift + 1] << (APINT_BITS_PER_WORD - BitShift));
 
       // Handle the last word which has no high bits to copy. Use an arithmetic
       // shift to preserve the sign bit.
-      U.pVal[WordsToMove - 1] =
-          (int64_t)U.pVal[WordShift + WordsToMove - 1] >> BitShift;
+      wordsPtr()[WordsToMove - 1] =
+          (int64_t)wordsPtr()[WordShift + WordsToMove - 1] >> BitShift;
     }
   }
 
   // Fill in the remainder based on the original sign.
-  std::memset(U.pVal + WordsToMove, Negative ? -1 : 0,
+  std::memset(wordsPtr() + WordsToMove, Negative ? -1 : 0,
               WordShift * APINT_WORD_SIZE);
   clearUnusedBits();
 }
@@ -1077,7 +1097,7 @@ void APInt::lshrInPlace(const APInt &shiftAmt) {
 /// Logical right-shift this APInt by shiftAmt.
 /// Logical right-shift function.
 void APInt::lshrSlowCase(unsigned ShiftAmt) {
-  tcShiftRight(U.pVal, getNumWords(), ShiftAmt);
+  tcShiftRight(wordsPtr(), getNumWords(), ShiftAmt);
 }
 
 /// Left-shift this APInt by shiftAmt.
@@ -1089,7 +1109,7 @@ APInt &APInt::operator<<=(const APInt &shiftAmt) {
 }
 
 void APInt::shlSlowCase(unsigned ShiftAmt) {
-  tcShiftLeft(U.pVal, getNumWords(), ShiftAmt);
+  tcShiftLeft(wordsPtr(), getNumWords(), ShiftAmt);
   clearUnusedBits();
 }
 
@@ -1187,7 +1207,7 @@ APInt APInt::sqrt() const {
       /* 21-30 */ 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
       /*    31 */ 6
     };
-    return APInt(BitWidth, results[ (isSingleWord() ? U.VAL : U.pVal[0]) ]);
+    return APInt(BitWidth, results[ (isSingleWord() ? U.VAL : wordsPtr()[0]) ]);
   }
 
   // If the magnitude of the value fits in less than 52 bits (the precision of
@@ -1197,7 +1217,7 @@ APInt APInt::sqrt() const {
   if (magnitude < 52) {
     return APInt(BitWidth,
                  uint64_t(::round(::sqrt(double(isSingleWord() ? U.VAL
-                                                               : U.pVal[0])))));
+                                                               : wordsPtr()[0])))));
   }
 
   // Okay, all the short cuts are exhausted. We must compute it. The following
@@ -1574,11 +1594,11 @@ APInt APInt::udiv(const APInt &RHS) const {
     return APInt(BitWidth, 1);
   if (lhsWords == 1) // rhsWords is 1 if lhsWords is 1.
     // All high words are zero, just use native divide
-    return APInt(BitWidth, this->U.pVal[0] / RHS.U.pVal[0]);
+    return APInt(BitWidth, this->wordsPtr()[0] / RHS.wordsPtr()[0]);
 
   // We have to compute it the hard way. Invoke the Knuth divide algorithm.
   APInt Quotient(BitWidth, 0); // to hold result.
-  divide(U.pVal, lhsWords, RHS.U.pVal, rhsWords, Quotient.U.pVal, nullptr);
+  divide(wordsPtr(), lhsWords, RHS.wordsPtr(), rhsWords, Quotient.wordsPtr(), nullptr);
   return Quotient;
 }
 
@@ -1607,11 +1627,11 @@ APInt APInt::udiv(uint64_t RHS) const {
     return APInt(BitWidth, 1);
   if (lhsWords == 1) // rhsWords is 1 if lhsWords is 1.
     // All high words are zero, just use native divide
-    return APInt(BitWidth, this->U.pVal[0] / RHS);
+    return APInt(BitWidth, this->wordsPtr()[0] / RHS);
 
   // We have to compute it the hard way. Invoke the Knuth divide algorithm.
   APInt Quotient(BitWidth, 0); // to hold result.
-  divide(U.pVal, lhsWords, &RHS, 1, Quotient.U.pVal, nullptr);
+  divide(wordsPtr(), lhsWords, &RHS, 1, Quotient.wordsPtr(), nullptr);
   return Quotient;
 }
 
@@ -1667,11 +1687,11 @@ APInt APInt::urem(const APInt &RHS) const {
     return APInt(BitWidth, 0);
   if (lhsWords == 1)
     // All high words are zero, just use native remainder
-    return APInt(BitWidth, U.pVal[0] % RHS.U.pVal[0]);
+    return APInt(BitWidth, wordsPtr()[0] % RHS.wordsPtr()[0]);
 
   // We have to compute it the hard way. Invoke the Knuth divide algorithm.
   APInt Remainder(BitWidth, 0);
-  divide(U.pVal, lhsWords, RHS.U.pVal, rhsWords, nullptr, Remainder.U.pVal);
+  divide(wordsPtr(), lhsWords, RHS.wordsPtr(), rhsWords, nullptr, Remainder.wordsPtr());
   return Remainder;
 }
 
@@ -1699,11 +1719,11 @@ uint64_t APInt::urem(uint64_t RHS) const {
     return 0;
   if (lhsWords == 1)
     // All high words are zero, just use native remainder
-    return U.pVal[0] % RHS;
+    return wordsPtr()[0] % RHS;
 
   // We have to compute it the hard way. Invoke the Knuth divide algorithm.
   uint64_t Remainder;
-  divide(U.pVal, lhsWords, &RHS, 1, nullptr, &Remainder);
+  divide(wordsPtr(), lhsWords, &RHS, 1, nullptr, &Remainder);
   return Remainder;
 }
 
@@ -1783,20 +1803,20 @@ void APInt::udivrem(const APInt &LHS, const APInt &RHS,
 
   if (lhsWords == 1) { // rhsWords is 1 if lhsWords is 1.
     // There is only one word to consider so use the native versions.
-    uint64_t lhsValue = LHS.U.pVal[0];
-    uint64_t rhsValue = RHS.U.pVal[0];
+    uint64_t lhsValue = LHS.wordsPtr()[0];
+    uint64_t rhsValue = RHS.wordsPtr()[0];
     Quotient = lhsValue / rhsValue;
     Remainder = lhsValue % rhsValue;
     return;
   }
 
   // Okay, lets do it the long way
-  divide(LHS.U.pVal, lhsWords, RHS.U.pVal, rhsWords, Quotient.U.pVal,
-         Remainder.U.pVal);
+  divide(LHS.wordsPtr(), lhsWords, RHS.wordsPtr(), rhsWords, Quotient.wordsPtr(),
+         Remainder.wordsPtr());
   // Clear the rest of the Quotient and Remainder.
-  std::memset(Quotient.U.pVal + lhsWords, 0,
+  std::memset(Quotient.wordsPtr() + lhsWords, 0,
               (getNumWords(BitWidth) - lhsWords) * APINT_WORD_SIZE);
-  std::memset(Remainder.U.pVal + rhsWords, 0,
+  std::memset(Remainder.wordsPtr() + rhsWords, 0,
               (getNumWords(BitWidth) - rhsWords) * APINT_WORD_SIZE);
 }
 
@@ -1848,16 +1868,16 @@ void APInt::udivrem(const APInt &LHS, uint64_t RHS, APInt &Quotient,
 
   if (lhsWords == 1) { // rhsWords is 1 if lhsWords is 1.
     // There is only one word to consider so use the native versions.
-    uint64_t lhsValue = LHS.U.pVal[0];
+    uint64_t lhsValue = LHS.wordsPtr()[0];
     Quotient = lhsValue / RHS;
     Remainder = lhsValue % RHS;
     return;
   }
 
   // Okay, lets do it the long way
-  divide(LHS.U.pVal, lhsWords, &RHS, 1, Quotient.U.pVal, &Remainder);
+  divide(LHS.wordsPtr(), lhsWords, &RHS, 1, Quotient.wordsPtr(), &Remainder);
   // Clear the rest of the Quotient.
-  std::memset(Quotient.U.pVal + lhsWords, 0,
+  std::memset(Quotient.wordsPtr() + lhsWords, 0,
               (getNumWords(BitWidth) - lhsWords) * APINT_WORD_SIZE);
 }
 
@@ -2109,7 +2129,7 @@ void APInt::fromString(unsigned numbits, StringRef str, uint8_t radix) {
   if (isSingleWord())
     U.VAL = 0;
   else
-    U.pVal = getClearedMemory(getNumWords());
+    (void)allocWords(/*Zero=*/true);
 
   // Figure out if we can shift instead of multiply
   unsigned shift = (radix == 16 ? 4 : radix == 8 ? 3 : radix == 2 ? 1 : 0);
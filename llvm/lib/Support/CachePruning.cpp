@@ -210,6 +210,23 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
   std::error_code EC;
   SmallString<128> CachePathNative;
   sys::path::native(Path, CachePathNative);
+  auto ProcessEntry = [&](StringRef EntryPath,
+                          const sys::fs::basic_file_status &Status) {
+    // If the file hasn't been used recently enough, delete it
+    const auto FileAccessTime = Status.getLastAccessedTime();
+    auto FileAge = CurrentTime - FileAccessTime;
+    if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
+      LLVM_DEBUG(dbgs() << "Remove " << EntryPath << " ("
+                        << duration_cast<seconds>(FileAge).count()
+                        << "s old)\n");
+      sys::fs::remove(EntryPath);
+      return;
+    }
+
+    // Leave it here for now, but add it to the list of size-based pruning.
+    TotalSize += Status.getSize();
+    FileInfos.insert({FileAccessTime, Status.getSize(), std::string(EntryPath)});
+  };
   // Walk all of the files within this directory.
   for (sys::fs::directory_iterator File(CachePathNative, EC), FileEnd;
        File != FileEnd && !EC; File.increment(EC)) {
@@ -229,20 +246,26 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
       continue;
     }
 
-    // If the file hasn't been used recently enough, delete it
-    const auto FileAccessTime = StatusOrErr->getLastAccessedTime();
-    auto FileAge = CurrentTime - FileAccessTime;
-    if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
-      LLVM_DEBUG(dbgs() << "Remove " << File->path() << " ("
-                        << duration_cast<seconds>(FileAge).count()
-                        << "s old)\n");
-      sys::fs::remove(File->path());
+    // Cache entries may be sharded into "llvmcache-"-prefixed subdirectories
+    // (see localCache() in lib/Support/Caching.cpp). Walk their contents with
+    // the same policy. The shard directories themselves are left in place;
+    // they are cheap and are recreated lazily by the cache anyway.
+    if (StatusOrErr->type() == sys::fs::file_type::directory_file) {
+      for (sys::fs::directory_iterator Sub(File->path(), EC), SubEnd;
+           Sub != SubEnd && !EC; Sub.increment(EC)) {
+        if (!sys::path::filename(Sub->path()).starts_with("llvmcache-"))
+          continue;
+        ErrorOr<sys::fs::basic_file_status> SubStatusOrErr = Sub->status();
+        if (!SubStatusOrErr) {
+          LLVM_DEBUG(dbgs() << "Ignore " << Sub->path() << " (can't stat)\n");
+          continue;
+        }
+        ProcessEntry(Sub->path(), *SubStatusOrErr);
+      }
       continue;
     }
 
-    // Leave it here for now, but add it to the list of size-based pruning.
-    TotalSize += StatusOrErr->getSize();
-    FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    ProcessEntry(File->path(), *StatusOrErr);
   }
 
   auto FileInfo = FileInfos.begin();
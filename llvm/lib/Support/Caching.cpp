@@ -37,30 +37,48 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
   TempFilePrefixRef.toVector(TempFilePrefix);
   CacheDirectoryPathRef.toVector(CacheDirectoryPath);
 
+  auto Stats = std::make_shared<FileCache::CacheStats>();
   auto Func = [=](unsigned Task, StringRef Key,
                   const Twine &ModuleName) -> Expected<AddStreamFn> {
-    // This choice of file name allows the cache to be pruned (see pruneCache()
-    // in include/llvm/Support/CachePruning.h).
+    // Entries are sharded into subdirectories keyed by the first two
+    // characters of the (hex) key so that lookups stay cheap when the cache
+    // holds millions of entries. This choice of file name allows the cache to
+    // be pruned (see pruneCache() in include/llvm/Support/CachePruning.h).
     SmallString<64> EntryPath;
-    sys::path::append(EntryPath, CacheDirectoryPath, "llvmcache-" + Key);
-    // First, see if we have a cache hit.
-    SmallString<64> ResultPath;
+    sys::path::append(EntryPath, CacheDirectoryPath,
+                      "llvmcache-" + Key.take_front(2), "llvmcache-" + Key);
+    // First, see if we have a cache hit. Entries written before the cache was
+    // sharded live directly in the cache directory; look there before
+    // declaring a miss.
+    SmallString<64> LegacyPath, ResultPath;
+    sys::path::append(LegacyPath, CacheDirectoryPath, "llvmcache-" + Key);
+    StringRef OpenedPath = EntryPath;
     Expected<sys::fs::file_t> FDOrErr = sys::fs::openNativeFileForRead(
         Twine(EntryPath), sys::fs::OF_UpdateAtime, &ResultPath);
     std::error_code EC;
+    if (!FDOrErr) {
+      EC = errorToErrorCode(FDOrErr.takeError());
+      if (EC == errc::no_such_file_or_directory ||
+          EC == errc::permission_denied) {
+        OpenedPath = LegacyPath;
+        FDOrErr = sys::fs::openNativeFileForRead(
+            Twine(LegacyPath), sys::fs::OF_UpdateAtime, &ResultPath);
+        if (!FDOrErr)
+          EC = errorToErrorCode(FDOrErr.takeError());
+      }
+    }
     if (FDOrErr) {
       ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
-          MemoryBuffer::getOpenFile(*FDOrErr, EntryPath,
+          MemoryBuffer::getOpenFile(*FDOrErr, OpenedPath,
                                     /*FileSize=*/-1,
                                     /*RequiresNullTerminator=*/false);
       sys::fs::closeFile(*FDOrErr);
       if (MBOrErr) {
+        Stats->Hits.fetch_add(1, std::memory_order_relaxed);
         AddBuffer(Task, ModuleName, std::move(*MBOrErr));
         return AddStreamFn();
       }
       EC = MBOrErr.getError();
-    } else {
-      EC = errorToErrorCode(FDOrErr.takeError());
     }
 
     // On Windows we can fail to open a cache file with a permission denied
@@ -139,15 +157,16 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       }
     };
 
+    Stats->Misses.fetch_add(1, std::memory_order_relaxed);
     return [=](size_t Task, const Twine &ModuleName)
                -> Expected<std::unique_ptr<CachedFileStream>> {
-      // Create the cache directory if not already done. Doing this lazily
-      // ensures the filesystem isn't mutated until the cache is.
+      // Create the cache and shard directories if not already done. Doing
+      // this lazily ensures the filesystem isn't mutated until the cache is.
+      StringRef ShardPath = sys::path::parent_path(EntryPath);
       if (std::error_code EC = sys::fs::create_directories(
-              CacheDirectoryPath, /*IgnoreExisting=*/true))
+              ShardPath, /*IgnoreExisting=*/true))
         return createStringError(EC, Twine("can't create cache directory ") +
-                                         CacheDirectoryPath + ": " +
-                                         EC.message());
+                                         ShardPath + ": " + EC.message());
 
       // Write to a temporary to avoid race condition
       SmallString<64> TempFilenameModel;
@@ -167,5 +186,5 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
           Task);
     };
   };
-  return FileCache(Func, CacheDirectoryPathRef.str());
+  return FileCache(Func, CacheDirectoryPathRef.str(), std::move(Stats));
 }
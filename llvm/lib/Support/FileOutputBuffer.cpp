@@ -76,9 +76,9 @@ private:
 class InMemoryBuffer : public FileOutputBuffer {
 public:
   InMemoryBuffer(StringRef Path, MemoryBlock Buf, std::size_t BufSize,
-                 unsigned Mode)
-      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize),
-        Mode(Mode) {}
+                 unsigned Mode, bool Sparse)
+      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize), Mode(Mode),
+        Sparse(Sparse) {}
 
   uint8_t *getBufferStart() const override { return (uint8_t *)Buffer.base(); }
 
@@ -102,7 +102,29 @@ public:
             openFileForWrite(FinalPath, FD, CD_CreateAlways, OF_None, Mode))
       return errorCodeToError(EC);
     raw_fd_ostream OS(FD, /*shouldClose=*/true, /*unbuffered=*/true);
-    OS << StringRef((const char *)Buffer.base(), BufferSize);
+    const char *Data = (const char *)Buffer.base();
+    if (Sparse && OS.supportsSeeking()) {
+      // Seek over all-zero chunks instead of writing them. The holes left
+      // behind read back as zeros and need neither I/O nor disk blocks. If
+      // the buffer ends in a hole, extend the file to its full size; the
+      // extension is itself a hole.
+      constexpr size_t ChunkSize = 1 << 20;
+      uint64_t End = 0;
+      for (size_t Pos = 0; Pos != BufferSize; Pos += ChunkSize) {
+        size_t Len = std::min(ChunkSize, BufferSize - Pos);
+        if (Data[Pos] == 0 && memcmp(Data + Pos, Data + Pos + 1, Len - 1) == 0)
+          continue;
+        if (OS.tell() != Pos)
+          OS.seek(Pos);
+        OS << StringRef(Data + Pos, Len);
+        End = Pos + Len;
+      }
+      if (End != BufferSize)
+        if (auto EC = sys::fs::resize_file(FD, BufferSize))
+          return errorCodeToError(EC);
+      return Error::success();
+    }
+    OS << StringRef(Data, BufferSize);
     return Error::success();
   }
 
@@ -111,21 +133,25 @@ private:
   OwningMemoryBlock Buffer;
   size_t BufferSize;
   unsigned Mode;
+  bool Sparse;
 };
 } // namespace
 
 static Expected<std::unique_ptr<InMemoryBuffer>>
-createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode,
+                     unsigned Flags) {
   std::error_code EC;
   MemoryBlock MB = Memory::allocateMappedMemory(
       Size, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
   if (EC)
     return errorCodeToError(EC);
-  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode);
+  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode,
+                                          Flags & FileOutputBuffer::F_sparse);
 }
 
 static Expected<std::unique_ptr<FileOutputBuffer>>
-createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode,
+                   unsigned Flags) {
   Expected<fs::TempFile> FileOrErr =
       fs::TempFile::create(Path + ".tmp%%%%%%%", Mode);
   if (!FileOrErr)
@@ -147,7 +173,7 @@ createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode) {
   // If that happens, we fall back to in-memory buffer as the last resort.
   if (EC) {
     consumeError(File.discard());
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, Flags);
   }
 
   return std::make_unique<OnDiskBuffer>(Path, std::move(File),
@@ -159,7 +185,7 @@ Expected<std::unique_ptr<FileOutputBuffer>>
 FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   // Handle "-" as stdout just like llvm::raw_ostream does.
   if (Path == "-")
-    return createInMemoryBuffer("-", Size, /*Mode=*/0);
+    return createInMemoryBuffer("-", Size, /*Mode=*/0, /*Flags=*/0);
 
   unsigned Mode = fs::all_read | fs::all_write;
   if (Flags & F_executable)
@@ -167,7 +193,7 @@ FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
 
   // If Size is zero, don't use mmap which will fail with EINVAL.
   if (Size == 0)
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, Flags);
 
   fs::file_status Stat;
   fs::status(Path, Stat);
@@ -187,10 +213,10 @@ FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   case fs::file_type::file_not_found:
   case fs::file_type::status_error:
     if (Flags & F_no_mmap)
-      return createInMemoryBuffer(Path, Size, Mode);
+      return createInMemoryBuffer(Path, Size, Mode, Flags);
     else
-      return createOnDiskBuffer(Path, Size, Mode);
+      return createOnDiskBuffer(Path, Size, Mode, Flags);
   default:
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, Flags);
   }
 }
@@ -12,7 +12,9 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -39,6 +41,7 @@ class Executor {
 public:
   virtual ~Executor() = default;
   virtual void add(std::function<void()> func) = 0;
+  virtual void addBatch(std::vector<std::function<void()>> funcs) = 0;
   virtual size_t getThreadCount() const = 0;
 
   static Executor *getDefaultExecutor();
@@ -46,10 +49,17 @@ public:
 
 /// An implementation of an Executor that runs closures on a thread pool
 ///   in filo order.
+///
+/// Each worker thread owns a deque of tasks. Submissions from a worker go to
+/// its own deque; external submissions are distributed round-robin. A worker
+/// services its own deque in LIFO order and, when that runs dry, steals the
+/// oldest task from another worker's deque, so skewed workloads get
+/// rebalanced instead of idling the pool behind one long-running task.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S) {
     ThreadCount = S.compute_thread_count();
+    Queues = std::make_unique<WorkQueue[]>(ThreadCount);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -98,33 +108,116 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    unsigned QueueID =
+        threadIndex < ThreadCount
+            ? threadIndex
+            : RoundRobin.fetch_add(1, std::memory_order_relaxed) % ThreadCount;
+    {
+      std::lock_guard<std::mutex> Lock(Queues[QueueID].Mutex);
+      Queues[QueueID].Tasks.push_back(std::move(F));
+    }
+    // Publish the new count while holding the mutex work() waits on;
+    // incrementing it unlocked would let a worker evaluate the wait predicate,
+    // see no tasks, and block just as the notification fires (lost wakeup).
     {
       std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push_back(std::move(F));
+      NumTasks.fetch_add(1, std::memory_order_release);
     }
     Cond.notify_one();
   }
 
+  void addBatch(std::vector<std::function<void()>> Fs) override {
+    if (Fs.empty())
+      return;
+    // Spread the batch over the workers' deques in contiguous slices so they
+    // can all start without first going through the steal path, taking each
+    // queue's lock only once.
+    unsigned NumQueues = std::min<size_t>(Fs.size(), ThreadCount);
+    size_t Begin = 0;
+    for (unsigned I = 0; I != NumQueues; ++I) {
+      size_t End = Fs.size() * (I + 1) / NumQueues;
+      unsigned QueueID =
+          RoundRobin.fetch_add(1, std::memory_order_relaxed) % ThreadCount;
+      std::lock_guard<std::mutex> Lock(Queues[QueueID].Mutex);
+      for (size_t J = Begin; J != End; ++J)
+        Queues[QueueID].Tasks.push_back(std::move(Fs[J]));
+      Begin = End;
+    }
+    // As in add(), publish the count under the waiters' mutex to avoid a lost
+    // wakeup.
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      NumTasks.fetch_add(Fs.size(), std::memory_order_release);
+    }
+    Cond.notify_all();
+  }
+
   size_t getThreadCount() const override { return ThreadCount; }
 
 private:
+  /// A per-worker task deque, padded to its own cache line so that pushes and
+  /// pops on different workers do not contend.
+  struct alignas(64) WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
+  /// Pop a task from the given deque: the newest one when the owner is
+  /// servicing its own deque, the oldest one when stealing. Stolen tasks are
+  /// the coldest in their owner's cache and the most likely to represent a
+  /// large unsplit piece of work.
+  std::function<void()> popTask(unsigned QueueID, bool Steal) {
+    WorkQueue &Q = Queues[QueueID];
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return nullptr;
+    std::function<void()> Task;
+    if (Steal) {
+      Task = std::move(Q.Tasks.front());
+      Q.Tasks.pop_front();
+    } else {
+      Task = std::move(Q.Tasks.back());
+      Q.Tasks.pop_back();
+    }
+    NumTasks.fetch_sub(1, std::memory_order_relaxed);
+    return Task;
+  }
+
+  /// Take the next task for \p ThreadID: its own deque first, then a steal
+  /// scan over the other workers' deques.
+  std::function<void()> takeTask(unsigned ThreadID) {
+    if (std::function<void()> Task = popTask(ThreadID, /*Steal=*/false))
+      return Task;
+    for (unsigned N = 1; N < ThreadCount; ++N)
+      if (std::function<void()> Task =
+              popTask((ThreadID + N) % ThreadCount, /*Steal=*/true))
+        return Task;
+    return nullptr;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
     while (true) {
+      if (std::function<void()> Task = takeTask(ThreadID)) {
+        Task();
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
+      Cond.wait(Lock,
+                [&] { return Stop || NumTasks.load(std::memory_order_acquire) >
+                                         0; });
       if (Stop)
         break;
-      auto Task = std::move(WorkStack.back());
-      WorkStack.pop_back();
-      Lock.unlock();
-      Task();
     }
   }
 
   std::atomic<bool> Stop{false};
-  std::vector<std::function<void()>> WorkStack;
+  // May be transiently negative: it is incremented after the corresponding
+  // push, so a concurrent pop on another worker can observe the task first.
+  std::atomic<int64_t> NumTasks{0};
+  std::atomic<unsigned> RoundRobin{0};
+  std::unique_ptr<WorkQueue[]> Queues;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
@@ -205,6 +298,28 @@ void TaskGroup::spawn(std::function<void()> F) {
   F();
 }
 
+void TaskGroup::spawnBatch(std::vector<std::function<void()>> Fs) {
+#if LLVM_ENABLE_THREADS
+  if (Parallel) {
+    // Take the latch up front for the whole batch and hand the executor one
+    // vector, so the pool is synchronized with once instead of per task.
+    std::vector<std::function<void()>> Wrapped;
+    Wrapped.reserve(Fs.size());
+    for (std::function<void()> &F : Fs) {
+      L.inc();
+      Wrapped.push_back([&, F = std::move(F)] {
+        F();
+        L.dec();
+      });
+    }
+    detail::Executor::getDefaultExecutor()->addBatch(std::move(Wrapped));
+    return;
+  }
+#endif
+  for (std::function<void()> &F : Fs)
+    F();
+}
+
 } // namespace parallel
 } // namespace llvm
 
@@ -212,26 +327,36 @@ void llvm::parallelFor(size_t Begin, size_t End,
                        llvm::function_ref<void(size_t)> Fn) {
 #if LLVM_ENABLE_THREADS
   if (parallel::strategy.ThreadsRequested != 1) {
-    auto NumItems = End - Begin;
-    // Limit the number of tasks to MaxTasksPerGroup to limit job scheduling
-    // overhead on large inputs.
-    auto TaskSize = NumItems / parallel::detail::MaxTasksPerGroup;
-    if (TaskSize == 0)
-      TaskSize = 1;
+    size_t NumItems = End - Begin;
+    size_t NumWorkers = std::min(parallel::getThreadCount(), NumItems);
 
+    // Rather than statically partitioning the range, have each worker claim
+    // chunks from a shared counter until the range is exhausted. Chunks are
+    // sized to half of a worker's even share of what remains ("guided"
+    // self-scheduling), so the first chunks are large but the tail of the
+    // loop is handed out at fine granularity and skewed iterations do not
+    // leave the other workers idle.
+    std::atomic<size_t> Next(Begin);
     parallel::TaskGroup TG;
-    for (; Begin + TaskSize < End; Begin += TaskSize) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin, E = Begin + TaskSize; I != E; ++I)
-          Fn(I);
-      });
-    }
-    if (Begin != End) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin; I != End; ++I)
-          Fn(I);
+    std::vector<std::function<void()>> Workers;
+    Workers.reserve(NumWorkers);
+    for (size_t W = 0; W != NumWorkers; ++W) {
+      Workers.push_back([&Fn, &Next, End, NumWorkers] {
+        while (true) {
+          size_t Cur = Next.load(std::memory_order_relaxed);
+          if (Cur >= End)
+            return;
+          size_t Chunk = std::max<size_t>((End - Cur) / (NumWorkers * 2), 1);
+          size_t ChunkBegin = Next.fetch_add(Chunk, std::memory_order_relaxed);
+          if (ChunkBegin >= End)
+            return;
+          for (size_t I = ChunkBegin, E = std::min(End, ChunkBegin + Chunk);
+               I != E; ++I)
+            Fn(I);
+        }
       });
     }
+    TG.spawnBatch(std::move(Workers));
     return;
   }
 #endif
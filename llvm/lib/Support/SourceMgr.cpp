@@ -22,6 +22,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/Locale.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/NewlineScanner.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/WithColor.h"
@@ -80,29 +81,57 @@ unsigned SourceMgr::FindBufferContainingLoc(SMLoc Loc) const {
   return 0;
 }
 
+namespace {
+
+/// Line-ending offsets for a buffer, extended on demand one chunk at a time
+/// so that a query near the start of a large buffer does not pay for
+/// scanning all of it.
+template <typename T> struct LineOffsetCache {
+  std::vector<T> Offsets;
+  /// All line endings at offsets < ScannedTo have been recorded.
+  size_t ScannedTo = 0;
+};
+
+} // end anonymous namespace
+
+/// How much of the buffer to index per scan. Chosen so that typical files
+/// are still indexed in one pass.
+static const size_t OffsetCacheChunkSize = 64 * 1024;
+
 template <typename T>
-static std::vector<T> &GetOrCreateOffsetCache(void *&OffsetCache,
-                                              MemoryBuffer *Buffer) {
-  if (OffsetCache)
-    return *static_cast<std::vector<T> *>(OffsetCache);
+static LineOffsetCache<T> &GetOrCreateOffsetCache(void *&OffsetCache,
+                                                  MemoryBuffer *Buffer) {
+  assert(Buffer->getBufferSize() <= std::numeric_limits<T>::max());
+  if (!OffsetCache)
+    OffsetCache = new LineOffsetCache<T>();
+  return *static_cast<LineOffsetCache<T> *>(OffsetCache);
+}
 
-  // Lazily fill in the offset cache.
-  auto *Offsets = new std::vector<T>();
+/// Extend \p Cache until all line endings at offsets < \p Target have been
+/// recorded, rounding the scan up to the next chunk boundary.
+template <typename T>
+static void ScanOffsetsUpTo(LineOffsetCache<T> &Cache, MemoryBuffer *Buffer,
+                            size_t Target) {
   size_t Sz = Buffer->getBufferSize();
-  assert(Sz <= std::numeric_limits<T>::max());
-  StringRef S = Buffer->getBuffer();
-  for (size_t N = 0; N < Sz; ++N) {
-    if (S[N] == '\n')
-      Offsets->push_back(static_cast<T>(N));
-  }
+  if (Cache.ScannedTo >= std::min(Target, Sz))
+    return;
 
-  OffsetCache = Offsets;
-  return *Offsets;
+  size_t StopAt =
+      std::min(Sz, (Target / OffsetCacheChunkSize + 1) * OffsetCacheChunkSize);
+  const char *Start = Buffer->getBufferStart();
+  const char *Ptr = Start + Cache.ScannedTo;
+  const char *Stop = Start + StopAt;
+  while ((Ptr = support::findNextLineTerminator(Ptr, Stop)) != Stop) {
+    if (*Ptr == '\n')
+      Cache.Offsets.push_back(static_cast<T>(Ptr - Start));
+    ++Ptr;
+  }
+  Cache.ScannedTo = StopAt;
 }
 
 template <typename T>
 unsigned SourceMgr::SrcBuffer::getLineNumberSpecialized(const char *Ptr) const {
-  std::vector<T> &Offsets =
+  LineOffsetCache<T> &Cache =
       GetOrCreateOffsetCache<T>(OffsetCache, Buffer.get());
 
   const char *BufStart = Buffer->getBufferStart();
@@ -112,9 +141,14 @@ unsigned SourceMgr::SrcBuffer::getLineNumberSpecialized(const char *Ptr) const {
          static_cast<size_t>(PtrDiff) <= std::numeric_limits<T>::max());
   T PtrOffset = static_cast<T>(PtrDiff);
 
+  // Only newlines before PtrOffset affect the answer, so the buffer does not
+  // need to be indexed past it.
+  ScanOffsetsUpTo(Cache, Buffer.get(), PtrOffset);
+
   // llvm::lower_bound gives the number of EOL before PtrOffset. Add 1 to get
   // the line number.
-  return llvm::lower_bound(Offsets, PtrOffset) - Offsets.begin() + 1;
+  return llvm::lower_bound(Cache.Offsets, PtrOffset) - Cache.Offsets.begin() +
+         1;
 }
 
 /// Look up a given \p Ptr in the buffer, determining which line it came
@@ -134,9 +168,16 @@ unsigned SourceMgr::SrcBuffer::getLineNumber(const char *Ptr) const {
 template <typename T>
 const char *SourceMgr::SrcBuffer::getPointerForLineNumberSpecialized(
     unsigned LineNo) const {
-  std::vector<T> &Offsets =
+  LineOffsetCache<T> &Cache =
       GetOrCreateOffsetCache<T>(OffsetCache, Buffer.get());
 
+  // Index forward until the requested line is covered or the buffer ends.
+  size_t Sz = Buffer->getBufferSize();
+  while (Cache.Offsets.size() < LineNo && Cache.ScannedTo < Sz)
+    ScanOffsetsUpTo(Cache, Buffer.get(), Cache.ScannedTo + 1);
+
+  std::vector<T> &Offsets = Cache.Offsets;
+
   // We start counting line and column numbers from 1.
   if (LineNo != 0)
     --LineNo;
@@ -177,13 +218,13 @@ SourceMgr::SrcBuffer::~SrcBuffer() {
   if (OffsetCache) {
     size_t Sz = Buffer->getBufferSize();
     if (Sz <= std::numeric_limits<uint8_t>::max())
-      delete static_cast<std::vector<uint8_t> *>(OffsetCache);
+      delete static_cast<LineOffsetCache<uint8_t> *>(OffsetCache);
     else if (Sz <= std::numeric_limits<uint16_t>::max())
-      delete static_cast<std::vector<uint16_t> *>(OffsetCache);
+      delete static_cast<LineOffsetCache<uint16_t> *>(OffsetCache);
     else if (Sz <= std::numeric_limits<uint32_t>::max())
-      delete static_cast<std::vector<uint32_t> *>(OffsetCache);
+      delete static_cast<LineOffsetCache<uint32_t> *>(OffsetCache);
     else
-      delete static_cast<std::vector<uint64_t> *>(OffsetCache);
+      delete static_cast<LineOffsetCache<uint64_t> *>(OffsetCache);
     OffsetCache = nullptr;
   }
 }
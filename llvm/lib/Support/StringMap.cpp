@@ -213,6 +213,20 @@ StringMapEntryBase *StringMapImpl::RemoveKey(StringRef Key) {
   return Result;
 }
 
+/// Grow the table so that it can hold at least \p NumEntries items before
+/// needing to rehash. Existing entries are redistributed using their cached
+/// hash values, so no key bytes are touched.
+void StringMapImpl::reserve(unsigned NumEntries) {
+  unsigned MinBuckets = getMinBucketToReserveForEntries(NumEntries);
+  if (MinBuckets <= NumBuckets)
+    return;
+  if (NumBuckets == 0) {
+    init(MinBuckets);
+    return;
+  }
+  (void)moveEntriesTo(MinBuckets, 0);
+}
+
 /// RehashTable - Grow the table, redistributing values into the buckets with
 /// the appropriate mod-of-hashtable-size.
 unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
@@ -229,6 +243,13 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
     return BucketNo;
   }
 
+  return moveEntriesTo(NewSize, BucketNo);
+}
+
+/// Redistribute the entries into a freshly allocated table of \p NewSize
+/// buckets using their cached hash values, and return the new position of the
+/// entry that used to live in bucket \p BucketNo.
+unsigned StringMapImpl::moveEntriesTo(unsigned NewSize, unsigned BucketNo) {
   unsigned NewBucketNo = BucketNo;
   auto **NewTableArray = createTable(NewSize);
   unsigned *NewHashArray = getHashTable(NewTableArray, NewSize);
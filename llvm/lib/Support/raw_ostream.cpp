@@ -38,6 +38,10 @@
 # include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #if defined(__CYGWIN__)
 #include <io.h>
 #endif
@@ -275,8 +279,20 @@ raw_ostream &raw_ostream::write(const char *Ptr, size_t Size) {
       return *this;
     }
 
-    // We don't have enough space in the buffer to fit the string in. Insert as
-    // much as possible, flush and start over with the remainder.
+    // We don't have enough space in the buffer to fit the string in. If the
+    // string would not fit in an empty buffer either, emit the buffered bytes
+    // and the string together with a single gathering write instead of
+    // copying part of the string just to flush it again.
+    if (Size >= size_t(OutBufEnd - OutBufStart)) {
+      StringRef Chunks[] = {StringRef(OutBufStart, OutBufCur - OutBufStart),
+                            StringRef(Ptr, Size)};
+      OutBufCur = OutBufStart;
+      write_vectored_impl(Chunks);
+      return *this;
+    }
+
+    // Otherwise insert as much as possible, flush and start over with the
+    // remainder.
     copy_to_buffer(Ptr, NumBytes);
     flush_nonempty();
     return write(Ptr + NumBytes, Size - NumBytes);
@@ -287,6 +303,12 @@ raw_ostream &raw_ostream::write(const char *Ptr, size_t Size) {
   return *this;
 }
 
+void raw_ostream::write_vectored_impl(ArrayRef<StringRef> Chunks) {
+  for (StringRef Chunk : Chunks)
+    if (!Chunk.empty())
+      write_impl(Chunk.data(), Chunk.size());
+}
+
 void raw_ostream::copy_to_buffer(const char *Ptr, size_t Size) {
   assert(Size <= size_t(OutBufEnd - OutBufCur) && "Buffer overrun!");
 
@@ -803,6 +825,75 @@ void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
   } while (Size > 0);
 }
 
+#ifndef _WIN32
+void raw_fd_ostream::write_vectored_impl(ArrayRef<StringRef> Chunks) {
+  // POSIX guarantees IOV_MAX is at least 16; stay within that so we never
+  // have to split the gather into multiple syscalls.
+  constexpr size_t MaxIOVCount = 16;
+
+  size_t Size = 0;
+  for (StringRef Chunk : Chunks)
+    Size += Chunk.size();
+  if (Size == 0)
+    return;
+
+  // Fall back to per-chunk writes when the chunks do not fit in a single
+  // writev; write_impl already knows how to split oversized writes.
+  if (Chunks.size() > MaxIOVCount || Size > size_t(INT32_MAX)) {
+    raw_ostream::write_vectored_impl(Chunks);
+    return;
+  }
+
+  if (TiedStream)
+    TiedStream->flush();
+
+  assert(FD >= 0 && "File already closed.");
+  pos += Size;
+
+  struct iovec IOVecs[MaxIOVCount];
+  int NumIOVecs = 0;
+  for (StringRef Chunk : Chunks) {
+    if (Chunk.empty())
+      continue;
+    IOVecs[NumIOVecs].iov_base = const_cast<char *>(Chunk.data());
+    IOVecs[NumIOVecs].iov_len = Chunk.size();
+    ++NumIOVecs;
+  }
+
+  struct iovec *IOV = IOVecs;
+  while (NumIOVecs > 0) {
+    ssize_t ret = ::writev(FD, IOV, NumIOVecs);
+
+    if (ret < 0) {
+      // Retry recoverable errors; see the comment in write_impl.
+      if (errno == EINTR || errno == EAGAIN
+#ifdef EWOULDBLOCK
+          || errno == EWOULDBLOCK
+#endif
+          )
+        continue;
+
+      // Otherwise it's a non-recoverable error. Note it and quit.
+      error_detected(errnoAsErrorCode());
+      break;
+    }
+
+    // The write may have been short. Drop the chunks that were written
+    // completely and trim a partially written one, then retry.
+    size_t Written = ret;
+    while (NumIOVecs > 0 && Written >= IOV->iov_len) {
+      Written -= IOV->iov_len;
+      ++IOV;
+      --NumIOVecs;
+    }
+    if (NumIOVecs > 0 && Written > 0) {
+      IOV->iov_base = static_cast<char *>(IOV->iov_base) + Written;
+      IOV->iov_len -= Written;
+    }
+  }
+}
+#endif
+
 void raw_fd_ostream::close() {
   assert(ShouldClose);
   ShouldClose = false;
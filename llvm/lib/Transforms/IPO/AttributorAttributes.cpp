@@ -8038,6 +8038,26 @@ struct AAMemoryBehaviorFunction final : public AAMemoryBehaviorImpl {
   AAMemoryBehaviorFunction(const IRPosition &IRP, Attributor &A)
       : AAMemoryBehaviorImpl(IRP, A) {}
 
+  /// See AbstractAttribute::initialize(...).
+  void initialize(Attributor &A) override {
+    AAMemoryBehaviorImpl::initialize(A);
+    if (!isValidState() || isAtFixpoint())
+      return;
+    // A single syntactic walk settles functions that touch no memory at all:
+    // if no instruction may read or write, readnone is already the best
+    // possible result and no fixpoint iteration is needed. Bodies with memory
+    // accesses are left to updateImpl, which can use liveness and call site
+    // information to do better than this scan.
+    const Function *F = getAnchorScope();
+    if (!F || F->isDeclaration())
+      return;
+    for (const BasicBlock &BB : *F)
+      for (const Instruction &I : BB)
+        if (I.mayReadFromMemory() || I.mayWriteToMemory())
+          return;
+    indicateOptimisticFixpoint();
+  }
+
   /// See AbstractAttribute::updateImpl(Attributor &A).
   ChangeStatus updateImpl(Attributor &A) override;
 
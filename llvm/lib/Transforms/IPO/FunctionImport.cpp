@@ -67,6 +67,8 @@ STATISTIC(NumImportedFunctions, "Number of functions imported in backend");
 STATISTIC(NumImportedGlobalVars,
           "Number of global variables imported in backend");
 STATISTIC(NumImportedModules, "Number of modules imported from");
+STATISTIC(NumImportModulesSkipped,
+          "Number of modules with no definitions to import skipped in backend");
 STATISTIC(NumDeadSymbols, "Number of dead stripped symbols in index");
 STATISTIC(NumLiveSymbols, "Number of live symbols in index");
 
@@ -1823,8 +1825,26 @@ Expected<bool> FunctionImporter::importFunctions(
 
   IRMover Mover(DestModule);
 
+  // First stage: walk the import list, which only involves summaries, and
+  // count the definitions requested from each source module. Source modules
+  // that contribute declarations alone need no IR at all here: declarations
+  // are materialized from the summaries by the bitcode reader, so loading and
+  // linking such a module would deserialize its metadata only to move an
+  // empty set of globals.
+  DenseMap<StringRef, unsigned> ModuleDefCounts;
+  for (const auto &[FromModule, GUID, ImportType] : ImportList)
+    if (ImportType == GlobalValueSummary::Definition)
+      ++ModuleDefCounts[FromModule];
+
   // Do the actual import of functions now, one Module at a time
   for (const auto &ModName : ImportList.getSourceModules()) {
+    if (!ModuleDefCounts.lookup(ModName)) {
+      LLVM_DEBUG(dbgs() << "Not loading " << ModName
+                        << ": no definitions to import\n");
+      NumImportModulesSkipped++;
+      continue;
+    }
+
     // Get the module for the import
     Expected<std::unique_ptr<Module>> SrcModuleOrErr = ModuleLoader(ModName);
     if (!SrcModuleOrErr)
@@ -5149,6 +5149,12 @@ bool InstCombinerImpl::run() {
       if (!EnableCodeSinking)
         return std::nullopt;
 
+      // Bail out early on instructions tryToSinkInstruction() is guaranteed to
+      // reject, before walking the use list and querying the dominator tree.
+      if (I->use_empty() || isa<PHINode>(I) || isa<AllocaInst>(I) ||
+          I->isEHPad() || I->isTerminator())
+        return std::nullopt;
+
       BasicBlock *BB = I->getParent();
       BasicBlock *UserParent = nullptr;
       unsigned NumUsers = 0;
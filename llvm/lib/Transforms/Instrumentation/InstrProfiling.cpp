@@ -144,6 +144,13 @@ cl::opt<bool> ConditionalCounterUpdate(
 cl::opt<bool> DoCounterPromotion("do-counter-promotion",
                                  cl::desc("Do counter register promotion"),
                                  cl::init(false));
+cl::opt<unsigned> ProfileCounterAlignment(
+    "profile-counter-align", cl::init(8),
+    cl::desc("Alignment of each function's counter region. Raising this to "
+             "the cache line size keeps threads hammering one function's hot "
+             "counters from invalidating neighboring functions' counters; "
+             "readers locate counters through the offsets recorded in the "
+             "profile data section, so the padding is format-transparent"));
 cl::opt<unsigned> MaxNumOfPromotionsPerLoop(
     "max-counter-promotions-per-loop", cl::init(20),
     cl::desc("Max number counter promotions per loop to avoid"
@@ -1674,7 +1681,7 @@ InstrLowerer::createRegionCounters(InstrProfCntrInstBase *Inc, StringRef Name,
     auto *CounterTy = ArrayType::get(Type::getInt64Ty(Ctx), NumCounters);
     GV = new GlobalVariable(M, CounterTy, false, Linkage,
                             Constant::getNullValue(CounterTy), Name);
-    GV->setAlignment(Align(8));
+    GV->setAlignment(Align(std::max(8u, ProfileCounterAlignment.getValue())));
   }
   return GV;
 }
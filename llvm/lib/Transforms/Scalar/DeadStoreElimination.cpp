@@ -909,6 +909,12 @@ struct DSEState {
   SmallVector<MemoryDef *, 64> MemDefs;
   // Any that should be skipped as they are already deleted
   SmallPtrSet<MemoryAccess *, 4> SkipStores;
+  // Memoized getUnderlyingObject results. The overwrite and terminator checks
+  // recompute the underlying object for the same pointers once per visited
+  // candidate pair; like the BatchAA cache above, the memo stays valid for the
+  // whole run because instructions are only removed, and removal of
+  // non-void-typed instructions is deferred to the end of the run.
+  DenseMap<const Value *, const Value *> UnderlyingObjects;
   // Keep track whether a given object is captured before return or not.
   DenseMap<const Value *, bool> CapturedBeforeReturn;
   // Keep track of all of the objects that are invisible to the caller after
@@ -1008,6 +1014,15 @@ struct DSEState {
     return Size;
   }
 
+  /// Memoizing wrapper around getUnderlyingObject; see the comment on the
+  /// UnderlyingObjects member for why the cache is valid for the whole run.
+  const Value *getUnderlyingObjectCached(const Value *Ptr) {
+    auto [It, Inserted] = UnderlyingObjects.try_emplace(Ptr);
+    if (Inserted)
+      It->second = getUnderlyingObject(Ptr);
+    return It->second;
+  }
+
   /// Return 'OW_Complete' if a store to the 'KillingLoc' location (by \p
   /// KillingI instruction) completely overwrites a store to the 'DeadLoc'
   /// location (by \p DeadI instruction).
@@ -1031,8 +1046,8 @@ struct DSEState {
         strengthenLocationSize(KillingI, KillingLoc.Size);
     const Value *DeadPtr = DeadLoc.Ptr->stripPointerCasts();
     const Value *KillingPtr = KillingLoc.Ptr->stripPointerCasts();
-    const Value *DeadUndObj = getUnderlyingObject(DeadPtr);
-    const Value *KillingUndObj = getUnderlyingObject(KillingPtr);
+    const Value *DeadUndObj = getUnderlyingObjectCached(DeadPtr);
+    const Value *KillingUndObj = getUnderlyingObjectCached(KillingPtr);
 
     // Check whether the killing store overwrites the whole object, in which
     // case the size/offset of the dead store does not matter.
@@ -1342,13 +1357,13 @@ struct DSEState {
 
     // If the terminator is a free-like call, all accesses to the underlying
     // object can be considered terminated.
-    if (getUnderlyingObject(Loc.Ptr) !=
-        getUnderlyingObject(MaybeTermLoc->first.Ptr))
+    if (getUnderlyingObjectCached(Loc.Ptr) !=
+        getUnderlyingObjectCached(MaybeTermLoc->first.Ptr))
       return false;
 
     auto TermLoc = MaybeTermLoc->first;
     if (MaybeTermLoc->second) {
-      const Value *LocUO = getUnderlyingObject(Loc.Ptr);
+      const Value *LocUO = getUnderlyingObjectCached(Loc.Ptr);
       return BatchAA.isMustAlias(TermLoc.Ptr, LocUO);
     }
     int64_t InstWriteOffset = 0;
@@ -1668,7 +1683,7 @@ struct DSEState {
       bool IsKillingDefFromInitAttr = false;
       if (IsInitializesAttrMemLoc) {
         if (KillingI == UseInst &&
-            KillingUndObj == getUnderlyingObject(MaybeDeadLoc.Ptr))
+            KillingUndObj == getUnderlyingObjectCached(MaybeDeadLoc.Ptr))
           IsKillingDefFromInitAttr = true;
       }
 
@@ -1934,7 +1949,7 @@ struct DSEState {
         // compile-time. In practice it appears the case with multiple
         // underlying objects is very uncommon. If it turns out to be important,
         // we can use getUnderlyingObjects here instead.
-        const Value *UO = getUnderlyingObject(DefLoc->Ptr);
+        const Value *UO = getUnderlyingObjectCached(DefLoc->Ptr);
         if (!isInvisibleToCallerAfterRet(UO))
           continue;
 
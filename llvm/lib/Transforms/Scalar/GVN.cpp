@@ -113,6 +113,8 @@ static cl::opt<bool>
 GVNEnableSplitBackedgeInLoadPRE("enable-split-backedge-in-load-pre",
                                 cl::init(false));
 static cl::opt<bool> GVNEnableMemDep("enable-gvn-memdep", cl::init(true));
+static cl::opt<bool> GVNEnableMemorySSA("enable-gvn-memoryssa",
+                                        cl::init(false));
 
 static cl::opt<uint32_t> MaxNumDeps(
     "gvn-max-num-deps", cl::Hidden, cl::init(100),
@@ -820,6 +822,10 @@ bool GVNPass::isMemDepEnabled() const {
   return Options.AllowMemDep.value_or(GVNEnableMemDep);
 }
 
+bool GVNPass::isMemorySSAEnabled() const {
+  return Options.AllowMemorySSA.value_or(GVNEnableMemorySSA);
+}
+
 PreservedAnalyses GVNPass::run(Function &F, FunctionAnalysisManager &AM) {
   // FIXME: The order of evaluation of these 'getResult' calls is very
   // significant! Re-ordering these variables will cause GVN when run alone to
@@ -833,6 +839,8 @@ PreservedAnalyses GVNPass::run(Function &F, FunctionAnalysisManager &AM) {
       isMemDepEnabled() ? &AM.getResult<MemoryDependenceAnalysis>(F) : nullptr;
   auto &LI = AM.getResult<LoopAnalysis>(F);
   auto *MSSA = AM.getCachedResult<MemorySSAAnalysis>(F);
+  if (isMemorySSAEnabled() && !MSSA)
+    MSSA = &AM.getResult<MemorySSAAnalysis>(F);
   auto &ORE = AM.getResult<OptimizationRemarkEmitterAnalysis>(F);
   bool Changed = runImpl(F, AC, DT, TLI, AA, MemDep, LI, &ORE,
                          MSSA ? &MSSA->getMSSA() : nullptr);
@@ -861,7 +869,9 @@ void GVNPass::printPipeline(
     OS << (*Options.AllowLoadPRESplitBackedge ? "" : "no-")
        << "split-backedge-load-pre;";
   if (Options.AllowMemDep != std::nullopt)
-    OS << (*Options.AllowMemDep ? "" : "no-") << "memdep";
+    OS << (*Options.AllowMemDep ? "" : "no-") << "memdep;";
+  if (Options.AllowMemorySSA != std::nullopt)
+    OS << (*Options.AllowMemorySSA ? "" : "no-") << "memoryssa";
   OS << '>';
 }
 
@@ -2151,6 +2161,55 @@ static void patchAndReplaceAllUsesWith(Instruction *I, Value *Repl) {
   I->replaceAllUsesWith(Repl);
 }
 
+MemDepResult GVNPass::getMemorySSADependency(LoadInst *L) const {
+  MemorySSA &MSSA = *MSSAU->getMemorySSA();
+  MemoryUseOrDef *LoadAccess = MSSA.getMemoryAccess(L);
+  MemoryAccess *Clobber =
+      MSSA.getWalker()->getClobberingMemoryAccess(LoadAccess);
+
+  // The walker skips MemoryUses, so a preceding load of the same pointer is
+  // never reported as the clobbering access. Recover load-to-load forwarding
+  // within the block by looking for a prior load guarded by the same clobber.
+  if (const MemorySSA::AccessList *Accesses =
+          MSSA.getBlockAccesses(L->getParent())) {
+    unsigned ScanLimit = MD->getDefaultBlockScanLimit();
+    LoadInst *PriorLoad = nullptr;
+    for (const MemoryAccess &MA : *Accesses) {
+      if (&MA == LoadAccess || ScanLimit-- == 0)
+        break;
+      if (const auto *Use = dyn_cast<MemoryUse>(&MA))
+        if (Use->getDefiningAccess() == Clobber)
+          if (auto *DepLI = dyn_cast<LoadInst>(Use->getMemoryInst()))
+            if (DepLI->isUnordered() &&
+                DepLI->getPointerOperand() == L->getPointerOperand())
+              PriorLoad = DepLI;
+    }
+    if (PriorLoad)
+      return MemDepResult::getDef(PriorLoad);
+  }
+
+  // Nothing in the function clobbers this load at all.
+  if (MSSA.isLiveOnEntryDef(Clobber))
+    return MemDepResult::getNonFuncLocal();
+
+  // A MemoryPhi or a MemoryDef in another block: let the caller fall back to
+  // the non-local machinery.
+  auto *Def = dyn_cast<MemoryDef>(Clobber);
+  if (!Def || Def->getBlock() != L->getParent())
+    return MemDepResult::getNonLocal();
+
+  // Classify must-aliased stores as defs so the availability analysis can
+  // take its exact-forwarding path; everything else is a clobber, which
+  // conservatively covers partial overlaps and memory intrinsics.
+  Instruction *DepInst = Def->getMemoryInst();
+  if (auto *DepSI = dyn_cast<StoreInst>(DepInst))
+    if (getAliasAnalysis()->alias(MemoryLocation::get(DepSI),
+                                  MemoryLocation::get(L)) ==
+        AliasResult::MustAlias)
+      return MemDepResult::getDef(DepInst);
+  return MemDepResult::getClobber(DepInst);
+}
+
 /// Attempt to eliminate a load, first by eliminating it
 /// locally, and then attempting non-local elimination if that fails.
 bool GVNPass::processLoad(LoadInst *L) {
@@ -2167,7 +2226,8 @@ bool GVNPass::processLoad(LoadInst *L) {
   }
 
   // ... to a pointer that has been loaded from before...
-  MemDepResult Dep = MD->getDependency(L);
+  MemDepResult Dep = isMemorySSAEnabled() && MSSAU ? getMemorySSADependency(L)
+                                                   : MD->getDependency(L);
 
   // If it is defined in another block, try harder.
   if (Dep.isNonLocal())
@@ -3323,6 +3383,8 @@ public:
     AU.addRequired<LoopInfoWrapperPass>();
     if (Impl.isMemDepEnabled())
       AU.addRequired<MemoryDependenceWrapperPass>();
+    if (Impl.isMemorySSAEnabled())
+      AU.addRequired<MemorySSAWrapperPass>();
     AU.addRequired<AAResultsWrapperPass>();
     AU.addPreserved<DominatorTreeWrapperPass>();
     AU.addPreserved<GlobalsAAWrapperPass>();
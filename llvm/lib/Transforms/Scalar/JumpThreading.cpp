@@ -327,12 +327,14 @@ bool JumpThreadingPass::runImpl(Function &F_, FunctionAnalysisManager *FAM_,
     for (auto &BB : *F) {
       if (Unreachable.count(&BB))
         continue;
+      bool BlockChanged = false;
       while (processBlock(&BB)) // Thread all of the branches we can over BB.
-        Changed = ChangedSinceLastAnalysisUpdate = true;
+        BlockChanged = Changed = ChangedSinceLastAnalysisUpdate = true;
 
       // Jump threading may have introduced redundant debug values into BB
-      // which should be removed.
-      if (Changed)
+      // which should be removed. Blocks that were not threaded cannot have
+      // picked up new debug values and do not need the scan.
+      if (BlockChanged)
         RemoveRedundantDbgInstrs(&BB);
 
       // Stop processing BB if it's the entry or is now deleted. The following
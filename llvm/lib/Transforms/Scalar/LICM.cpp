@@ -385,6 +385,25 @@ llvm::SinkAndHoistLICMFlags::SinkAndHoistLICMFlags(bool IsSink, Loop &L,
     : SinkAndHoistLICMFlags(SetLicmMssaOptCap, SetLicmMssaNoAccForPromotionCap,
                             IsSink, L, MSSA) {}
 
+const SmallPtrSetImpl<const BasicBlock *> &
+llvm::SinkAndHoistLICMFlags::getBlocksWithMemoryDefs(const Loop &L,
+                                                     MemorySSA &MSSA) {
+  // The set is keyed to a loop so that one flags object shared across a loop
+  // nest does not answer queries for one loop with another loop's blocks.
+  if (BlocksWithMemoryDefsLoop != &L) {
+    BlocksWithMemoryDefsLoop = &L;
+    BlocksWithMemoryDefs.clear();
+    for (const BasicBlock *BB : L.blocks())
+      if (const auto *Accesses = MSSA.getBlockDefs(BB))
+        for (const auto &MA : *Accesses)
+          if (isa<MemoryDef>(MA)) {
+            BlocksWithMemoryDefs.insert(BB);
+            break;
+          }
+  }
+  return BlocksWithMemoryDefs;
+}
+
 llvm::SinkAndHoistLICMFlags::SinkAndHoistLICMFlags(
     unsigned LicmMssaOptCap, unsigned LicmMssaNoAccForPromotionCap, bool IsSink,
     Loop &L, MemorySSA &MSSA)
@@ -2396,9 +2415,17 @@ static bool pointerInvalidatedByLoop(MemorySSA *MSSA, MemoryUse *MU,
   // FIXME: More precise: no Defs that alias this Use.
   if (Flags.tooManyMemoryAccesses())
     return true;
-  for (auto *BB : CurLoop->getBlocks())
-    if (pointerInvalidatedByBlock(*BB, *MSSA, *MU))
-      return true;
+  // A MemoryDef anywhere in the loop outside MU's own block invalidates the
+  // use outright; only defs in MU's block need the local dominance check.
+  // The set of def-containing blocks is cached in Flags so that repeated
+  // queries do not rescan the whole loop.
+  const auto &DefBlocks = Flags.getBlocksWithMemoryDefs(*CurLoop, *MSSA);
+  if (any_of(DefBlocks,
+             [&](const BasicBlock *BB) { return BB != MU->getBlock(); }))
+    return true;
+  if (DefBlocks.count(MU->getBlock()) &&
+      pointerInvalidatedByBlock(*MU->getBlock(), *MSSA, *MU))
+    return true;
   // When sinking, the source block may not be part of the loop so check it.
   if (!CurLoop->contains(&I))
     return pointerInvalidatedByBlock(*I.getParent(), *MSSA, *MU);
@@ -684,9 +684,16 @@ UnrollCostEstimator::UnrollCostEstimator(
     const Loop *L, const TargetTransformInfo &TTI,
     const SmallPtrSetImpl<const Value *> &EphValues, unsigned BEInsns) {
   CodeMetrics Metrics;
-  for (BasicBlock *BB : L->blocks())
+  for (BasicBlock *BB : L->blocks()) {
     Metrics.analyzeBasicBlock(BB, TTI, EphValues, /* PrepareForLTO= */ false,
                               L);
+    // Once a property is found that makes canUnroll() fail, the size of the
+    // rest of the loop does not matter; every consumer checks canUnroll()
+    // before using the size estimate.
+    if (Metrics.notDuplicatable ||
+        Metrics.Convergence == ConvergenceKind::ExtendedLoop)
+      break;
+  }
   NumInlineCandidates = Metrics.NumInlineCandidates;
   NotDuplicatable = Metrics.notDuplicatable;
   Convergence = Metrics.Convergence;
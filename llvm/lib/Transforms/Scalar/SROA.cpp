@@ -249,7 +249,8 @@ private:
   AllocaInst *rewritePartition(AllocaInst &AI, AllocaSlices &AS, Partition &P);
   bool splitAlloca(AllocaInst &AI, AllocaSlices &AS);
   bool propagateStoredValuesToLoads(AllocaInst &AI, AllocaSlices &AS);
-  std::pair<bool /*Changed*/, bool /*CFGChanged*/> runOnAlloca(AllocaInst &AI);
+  std::pair<bool /*Changed*/, bool /*CFGChanged*/> runOnAlloca(AllocaInst &AI,
+                                                               AllocaSlices &AS);
   void clobberUse(Use &U);
   bool deleteDeadInstructions(SmallPtrSetImpl<AllocaInst *> &DeletedAllocas);
   bool promoteAllocas(Function &F);
@@ -593,8 +594,14 @@ public:
 /// starting at a particular offset before splittable slices.
 class AllocaSlices {
 public:
-  /// Construct the slices of a particular alloca.
-  AllocaSlices(const DataLayout &DL, AllocaInst &AI);
+  AllocaSlices() = default;
+
+  /// Compute the slices of a particular alloca.
+  ///
+  /// Any previous analysis is discarded, but its heap buffers are kept so
+  /// that one AllocaSlices object can be reused across a whole worklist of
+  /// allocas without reallocating per alloca.
+  void analyze(const DataLayout &DL, AllocaInst &AI);
 
   /// Test whether a pointer to the allocation escapes our analysis.
   ///
@@ -674,7 +681,7 @@ private:
 
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
   /// Handle to alloca instruction to simplify method interfaces.
-  AllocaInst &AI;
+  AllocaInst *AI = nullptr;
 #endif
 
   /// The instruction responsible for this alloca not having a known set
@@ -683,8 +690,8 @@ private:
   /// When an instruction (potentially) escapes the pointer to the alloca, we
   /// store a pointer to that here and abort trying to form slices of the
   /// alloca. This will be null if the alloca slices are analyzed successfully.
-  Instruction *PointerEscapingInstr;
-  Instruction *PointerEscapingInstrReadOnly;
+  Instruction *PointerEscapingInstr = nullptr;
+  Instruction *PointerEscapingInstrReadOnly = nullptr;
 
   /// The slices of the alloca.
   ///
@@ -1410,12 +1417,18 @@ private:
   }
 };
 
-AllocaSlices::AllocaSlices(const DataLayout &DL, AllocaInst &AI)
-    :
+void AllocaSlices::analyze(const DataLayout &DL, AllocaInst &AI) {
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
-      AI(AI),
+  this->AI = &AI;
 #endif
-      PointerEscapingInstr(nullptr), PointerEscapingInstrReadOnly(nullptr) {
+  PointerEscapingInstr = nullptr;
+  PointerEscapingInstrReadOnly = nullptr;
+  // Clear without shrinking so repeated analyses reuse the buffers.
+  Slices.clear();
+  DeadUsers.clear();
+  DeadUseIfPromotable.clear();
+  DeadOperands.clear();
+
   SliceBuilder PB(DL, AI, *this);
   SliceBuilder::PtrInfo PtrI = PB.visitPtr(AI);
   if (PtrI.isEscaped() || PtrI.isAborted()) {
@@ -1458,7 +1471,7 @@ void AllocaSlices::printUse(raw_ostream &OS, const_iterator I,
 
 void AllocaSlices::print(raw_ostream &OS) const {
   if (PointerEscapingInstr) {
-    OS << "Can't analyze slices for alloca: " << AI << "\n"
+    OS << "Can't analyze slices for alloca: " << *AI << "\n"
        << "  A pointer to this alloca escaped by:\n"
        << "  " << *PointerEscapingInstr << "\n";
     return;
@@ -1467,7 +1480,7 @@ void AllocaSlices::print(raw_ostream &OS) const {
   if (PointerEscapingInstrReadOnly)
     OS << "Escapes into ReadOnly: " << *PointerEscapingInstrReadOnly << "\n";
 
-  OS << "Slices of alloca: " << AI << "\n";
+  OS << "Slices of alloca: " << *AI << "\n";
   for (const_iterator I = begin(), E = end(); I != E; ++I)
     print(OS, I);
 }
@@ -5564,7 +5577,7 @@ bool SROA::propagateStoredValuesToLoads(AllocaInst &AI, AllocaSlices &AS) {
 /// the slices of the alloca, and then hands it off to be split and
 /// rewritten as needed.
 std::pair<bool /*Changed*/, bool /*CFGChanged*/>
-SROA::runOnAlloca(AllocaInst &AI) {
+SROA::runOnAlloca(AllocaInst &AI, AllocaSlices &AS) {
   bool Changed = false;
   bool CFGChanged = false;
 
@@ -5593,7 +5606,7 @@ SROA::runOnAlloca(AllocaInst &AI) {
   Changed |= AggRewriter.rewrite(AI);
 
   // Build the slices using a recursive instruction-visiting builder.
-  AllocaSlices AS(DL, AI);
+  AS.analyze(DL, AI);
   LLVM_DEBUG(AS.print(dbgs()));
   if (AS.isEscaped())
     return {Changed, CFGChanged};
@@ -5731,10 +5744,14 @@ std::pair<bool /*Changed*/, bool /*CFGChanged*/> SROA::runSROA(Function &F) {
   // the list of promotable allocas.
   SmallPtrSet<AllocaInst *, 4> DeletedAllocas;
 
+  // One slice analysis shared across the whole worklist so that its buffers
+  // are allocated once rather than per alloca.
+  AllocaSlices AS;
+
   do {
     while (!Worklist.empty()) {
       auto [IterationChanged, IterationCFGChanged] =
-          runOnAlloca(*Worklist.pop_back_val());
+          runOnAlloca(*Worklist.pop_back_val(), AS);
       Changed |= IterationChanged;
       CFGChanged |= IterationCFGChanged;
 
@@ -85,6 +85,12 @@ static cl::opt<bool> UserSpeculateUnpredictables(
     "speculate-unpredictables", cl::Hidden, cl::init(false),
     cl::desc("Speculate unpredictable branches (default = false)"));
 
+static cl::opt<bool> UserRevisitChangedOnly(
+    "simplifycfg-revisit-changed-only", cl::Hidden, cl::init(false),
+    cl::desc("After the first fixpoint iteration, only revisit blocks "
+             "adjacent to a change, with a final unrestricted iteration to "
+             "confirm the fixpoint (default = false)"));
+
 STATISTIC(NumSimpl, "Number of blocks simplified");
 
 static bool
@@ -243,11 +249,18 @@ static bool iterativelySimplifyCFG(Function &F, const TargetTransformInfo &TTI,
   SmallVector<WeakVH, 16> LoopHeaders(UniqueLoopHeaders.begin(),
                                       UniqueLoopHeaders.end());
 
+  // Blocks to revisit on the next fixpoint iteration when only changed
+  // regions are re-examined. Entries may point to blocks that have since been
+  // deleted; they are only compared against live blocks, never dereferenced.
+  SmallPtrSet<const BasicBlock *, 16> WorkSet;
+  bool RestrictToWorkSet = false;
+
   unsigned IterCnt = 0;
   (void)IterCnt;
   while (LocalChange) {
     assert(IterCnt++ < 1000 && "Iterative simplification didn't converge!");
     LocalChange = false;
+    SmallPtrSet<const BasicBlock *, 16> NextWorkSet;
 
     // Loop over all of the basic blocks and remove them if they are unneeded.
     for (Function::iterator BBIt = F.begin(); BBIt != F.end(); ) {
@@ -261,12 +274,38 @@ static bool iterativelySimplifyCFG(Function &F, const TargetTransformInfo &TTI,
         while (BBIt != F.end() && DTU->isBBPendingDeletion(&*BBIt))
           ++BBIt;
       }
+      if (RestrictToWorkSet && !WorkSet.count(&BB))
+        continue;
+      // Capture the neighborhood of BB up front; simplifyCFG may erase BB.
+      SmallVector<const BasicBlock *, 8> Neighborhood;
+      if (UserRevisitChangedOnly) {
+        Neighborhood.push_back(&BB);
+        for (const BasicBlock *Pred : predecessors(&BB))
+          Neighborhood.push_back(Pred);
+        for (const BasicBlock *Succ : successors(&BB))
+          Neighborhood.push_back(Succ);
+      }
       if (simplifyCFG(&BB, TTI, DTU, Options, LoopHeaders)) {
         LocalChange = true;
         ++NumSimpl;
+        NextWorkSet.insert(Neighborhood.begin(), Neighborhood.end());
       }
     }
     Changed |= LocalChange;
+
+    if (UserRevisitChangedOnly) {
+      if (LocalChange) {
+        // A simplification can only expose opportunities in the neighborhood
+        // of the change, so it is enough to revisit those blocks next time.
+        WorkSet = std::move(NextWorkSet);
+        RestrictToWorkSet = true;
+      } else if (RestrictToWorkSet) {
+        // The restricted iterations converged; run one unrestricted iteration
+        // to confirm the fixpoint over the whole function.
+        RestrictToWorkSet = false;
+        LocalChange = true;
+      }
+    }
   }
   return Changed;
 }
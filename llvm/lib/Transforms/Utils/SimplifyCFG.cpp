@@ -94,10 +94,11 @@ using namespace PatternMatch;
 #define DEBUG_TYPE "simplifycfg"
 
 cl::opt<bool> llvm::RequireAndPreserveDomTree(
-    "simplifycfg-require-and-preserve-domtree", cl::Hidden,
+    "simplifycfg-require-and-preserve-domtree", cl::Hidden, cl::init(true),
 
-    cl::desc("Temorary development switch used to gradually uplift SimplifyCFG "
-             "into preserving DomTree,"));
+    cl::desc("Have SimplifyCFG require and incrementally maintain DomTree "
+             "through DomTreeUpdater, instead of invalidating it and forcing "
+             "downstream passes to recompute dominators from scratch"));
 
 // Chosen as 2 so as to be cheap, but still to have enough power to fold
 // a select, so the "clamp" idiom (of a min followed by a max) will be caught.
@@ -393,6 +393,12 @@ class LoopVectorizationPlanner {
   /// A builder used to construct the current plan.
   VPBuilder Builder;
 
+  /// Per-recipe costs, keyed on (recipe, VF), shared by all cost evaluations
+  /// for this planner's plans. Evaluating several VF/IC combinations and
+  /// emitting cost remarks revisit the same recipes; the cache makes each
+  /// recipe's cost computed at most once per VF.
+  mutable VPCostContext::RecipeCostsTy RecipeCosts;
+
   /// Computes the cost of \p Plan for vectorization factor \p VF.
   ///
   /// The current implementation requires access to the
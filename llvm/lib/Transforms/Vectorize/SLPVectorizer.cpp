@@ -2910,6 +2910,16 @@ public:
   void analyzedReductionVals(ArrayRef<Value *> VL) {
     AnalyzedReductionVals.insert(hash_value(VL));
   }
+  /// Checks if the provided operand bundle was already analyzed for list
+  /// vectorization and found unprofitable.
+  bool areAnalyzedNonProfitableVals(ArrayRef<Value *> VL) const {
+    return AnalyzedNonProfitableVals.contains(hash_value(VL));
+  }
+  /// Registers the operand bundle as analyzed for list vectorization and found
+  /// unprofitable.
+  void analyzedNonProfitableVals(ArrayRef<Value *> VL) {
+    AnalyzedNonProfitableVals.insert(hash_value(VL));
+  }
   /// Clear the list of the analyzed reduction root instructions.
   void clearReductionData() {
     AnalyzedReductionsRoots.clear();
@@ -3833,6 +3843,11 @@ private:
   /// Set of hashes for the list of reduction values already being analyzed.
   DenseSet<size_t> AnalyzedReductionVals;
 
+  /// Set of hashes for the operand bundles already analyzed for list
+  /// vectorization and found unprofitable. Cleared whenever a tree gets
+  /// vectorized, since the IR change may alter the verdicts.
+  DenseSet<size_t> AnalyzedNonProfitableVals;
+
   /// Values, already been analyzed for mininmal bitwidth and found to be
   /// non-profitable.
   DenseSet<Value *> AnalyzedMinBWVals;
@@ -16249,6 +16264,9 @@ Value *BoUpSLP::vectorizeTree() {
 Value *
 BoUpSLP::vectorizeTree(const ExtraValueToDebugLocsMap &ExternallyUsedValues,
                        Instruction *ReductionRoot) {
+  // The IR is about to change, which may change the cost of bundles rejected
+  // earlier - drop the memoized verdicts.
+  AnalyzedNonProfitableVals.clear();
   // All blocks must be scheduled before any instructions are inserted.
   for (auto &BSIter : BlocksSchedules) {
     scheduleBlock(BSIter.second.get());
@@ -19169,9 +19187,17 @@ bool SLPVectorizerPass::tryToVectorizeList(ArrayRef<Value *> VL, BoUpSLP &R,
       LLVM_DEBUG(dbgs() << "SLP: Analyzing " << ActualVF << " operations "
                         << "\n");
 
+      // Skip bundles that were analyzed already in this traversal, or by an
+      // earlier seed, and found unprofitable. The set is invalidated on every
+      // successful vectorization.
+      if (R.areAnalyzedNonProfitableVals(Ops))
+        continue;
+
       R.buildTree(Ops);
-      if (R.isTreeTinyAndNotFullyVectorizable())
+      if (R.isTreeTinyAndNotFullyVectorizable()) {
+        R.analyzedNonProfitableVals(Ops);
         continue;
+      }
       R.reorderTopToBottom();
       R.reorderBottomToTop(
           /*IgnoreReorder=*/!isa<InsertElementInst>(Ops.front()) &&
@@ -19199,6 +19225,8 @@ bool SLPVectorizerPass::tryToVectorizeList(ArrayRef<Value *> VL, BoUpSLP &R,
         I += VF - 1;
         NextInst = I + 1;
         Changed = true;
+      } else {
+        R.analyzedNonProfitableVals(Ops);
       }
     }
   }
@@ -755,10 +755,24 @@ void VPRegionBlock::execute(VPTransformState *State) {
   State->Lane.reset();
 }
 
+InstructionCost VPCostContext::getRecipeCost(VPRecipeBase &R,
+                                             ElementCount VF) {
+  if (!RecipeCosts)
+    return R.cost(VF, *this);
+  auto Key = std::make_pair(&R, VF);
+  auto It = RecipeCosts->find(Key);
+  if (It != RecipeCosts->end())
+    return It->second;
+  // Compute before inserting; costing a recipe must not invalidate iterators
+  // into the cache.
+  InstructionCost Cost = R.cost(VF, *this);
+  return RecipeCosts->try_emplace(Key, Cost).first->second;
+}
+
 InstructionCost VPBasicBlock::cost(ElementCount VF, VPCostContext &Ctx) {
   InstructionCost Cost = 0;
   for (VPRecipeBase &R : Recipes)
-    Cost += R.cost(VF, Ctx);
+    Cost += Ctx.getRecipeCost(R, VF);
   return Cost;
 }
 
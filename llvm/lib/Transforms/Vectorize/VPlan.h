@@ -43,6 +43,7 @@
 #include "llvm/IR/FMF.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/Support/InstructionCost.h"
+#include "llvm/Support/TypeSize.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
@@ -680,17 +681,29 @@ public:
 
 /// Struct to hold various analysis needed for cost computations.
 struct VPCostContext {
+  /// Cache of per-recipe costs, keyed on (recipe, VF). Owned by the planner
+  /// and shared across the contexts created while evaluating the candidate
+  /// VFs of a plan, so each recipe is costed at most once per VF.
+  using RecipeCostsTy =
+      DenseMap<std::pair<const VPRecipeBase *, ElementCount>, InstructionCost>;
+
   const TargetTransformInfo &TTI;
   const TargetLibraryInfo &TLI;
   VPTypeAnalysis Types;
   LLVMContext &LLVMCtx;
   LoopVectorizationCostModel &CM;
   SmallPtrSet<Instruction *, 8> SkipCostComputation;
+  RecipeCostsTy *RecipeCosts;
 
   VPCostContext(const TargetTransformInfo &TTI, const TargetLibraryInfo &TLI,
-                Type *CanIVTy, LoopVectorizationCostModel &CM)
+                Type *CanIVTy, LoopVectorizationCostModel &CM,
+                RecipeCostsTy *RecipeCosts = nullptr)
       : TTI(TTI), TLI(TLI), Types(CanIVTy), LLVMCtx(CanIVTy->getContext()),
-        CM(CM) {}
+        CM(CM), RecipeCosts(RecipeCosts) {}
+
+  /// Return the cost of \p R at \p VF, consulting and updating the shared
+  /// per-recipe cost cache if one is attached to this context.
+  InstructionCost getRecipeCost(VPRecipeBase &R, ElementCount VF);
 
   /// Return the cost for \p UI with \p VF using the legacy cost model as
   /// fallback until computing the cost of all recipes migrates to VPlan.
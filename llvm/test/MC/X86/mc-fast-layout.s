@@ -0,0 +1,53 @@
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.normal.o
+# RUN: llvm-objdump -d %t.normal.o | FileCheck %s --check-prefix=NORMAL
+# RUN: llvm-readobj -r %t.normal.o | FileCheck %s --check-prefix=RELOC
+# RUN: llvm-mc -filetype=obj -triple=x86_64 -mc-fast-layout %s -o %t.fast.o
+# RUN: llvm-objdump -d %t.fast.o | FileCheck %s --check-prefix=FAST
+# RUN: llvm-readobj -r %t.fast.o | FileCheck %s --check-prefix=RELOC
+
+## Fast layout widens every relaxable branch to its near form up front instead
+## of iterating relaxation: the in-range jcc that iterative layout keeps short
+## is re-encoded to rel32, while branches that iterative layout must relax
+## anyway (out-of-range target, undefined symbol) get the same encoding on
+## both paths. The re-encoded fixups must still resolve to the right targets,
+## and the relocations against the undefined symbol must be identical in both
+## modes.
+
+## In range for a short jcc: stays 2 bytes normally, rel32 under fast layout,
+## and both resolve to near_target.
+# NORMAL:      <foo>:
+# NORMAL-NEXT: 7d 01 {{.*}}jge{{.*}}<near_target>
+# FAST:        <foo>:
+# FAST-NEXT:   0f 8d 01 00 00 00 {{.*}}jge{{.*}}<near_target>
+
+## Out of range for a short jmp: rel32 on both paths, same encoding.
+# NORMAL:      <near_target>:
+# NORMAL-NEXT: e9 c8 00 00 00 {{.*}}jmp{{.*}}<far_target>
+# FAST:        <near_target>:
+# FAST-NEXT:   e9 c8 00 00 00 {{.*}}jmp{{.*}}<far_target>
+
+## Branches to an undefined symbol relocate identically on both paths.
+# NORMAL:      <far_target>:
+# NORMAL-NEXT: e8 00 00 00 00 {{.*}}call
+# NORMAL-NEXT: e9 00 00 00 00 {{.*}}jmp
+# FAST:        <far_target>:
+# FAST-NEXT:   e8 00 00 00 00 {{.*}}call
+# FAST-NEXT:   e9 00 00 00 00 {{.*}}jmp
+
+# RELOC:      Section ({{.*}}) .rela.text {
+# RELOC-NEXT: 0x{{[0-9A-F]+}} R_X86_64_PLT32 ext 0x{{[0-9A-F]+}}
+# RELOC-NEXT: 0x{{[0-9A-F]+}} R_X86_64_PLT32 ext 0x{{[0-9A-F]+}}
+# RELOC-NEXT: }
+
+.text
+.globl foo
+foo:
+  jge near_target
+  nop
+near_target:
+  jmp far_target
+  .space 200
+far_target:
+  call ext
+  jmp ext
+  retq
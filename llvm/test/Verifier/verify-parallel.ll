@@ -0,0 +1,33 @@
+; RUN: not opt -passes=verify -disable-output %s 2> %t.serial
+; RUN: not opt -passes=verify -verify-parallel -disable-output %s 2> %t.parallel
+; RUN: diff %t.serial %t.parallel
+; RUN: FileCheck %s < %t.parallel
+
+;; Broken IR in several functions plus broken module-level metadata: the
+;; sharded verifier must produce the same verdict and byte-identical
+;; diagnostics in the same order as the serial one, with the function-level
+;; errors preceding the module-level one.
+
+; CHECK:      Only PHI nodes may reference their own value!
+; CHECK-NEXT: %x = add i32 %x, 1
+; CHECK:      Only PHI nodes may reference their own value!
+; CHECK-NEXT: %y = add i32 %y, 2
+; CHECK:      incorrect number of operands in module flag
+; CHECK:      Broken module found, compilation aborted!
+
+define i32 @f1() {
+  %x = add i32 %x, 1
+  ret i32 %x
+}
+
+define i32 @f2() {
+  %y = add i32 %y, 2
+  ret i32 %y
+}
+
+define i32 @ok() {
+  ret i32 0
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 1}
@@ -32,6 +32,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
@@ -950,6 +951,10 @@ int CodeCoverageTool::run(Command Cmd, int argc, const char **argv) {
     ViewOpts.ShowInstantiationSummary = InstantiationSummary;
     ViewOpts.ExportSummaryOnly = SummaryOnly;
     ViewOpts.NumThreads = NumThreads;
+    // Honor -num-threads in the parallel evaluation of coverage mappings,
+    // which runs on the default parallel executor rather than the report
+    // thread pools created below.
+    parallel::strategy = hardware_concurrency(NumThreads);
     ViewOpts.CompilationDirectory = CompilationDirectory;
 
     return 0;
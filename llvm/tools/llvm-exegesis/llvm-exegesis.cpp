@@ -26,6 +26,7 @@
 #include "lib/Target.h"
 #include "lib/TargetSelect.h"
 #include "lib/ValidationEvent.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/MC/MCInstBuilder.h"
@@ -65,6 +66,13 @@ static cl::opt<std::string> SnippetsFile("snippets-file",
                                          cl::cat(BenchmarkOptions),
                                          cl::init(""));
 
+static cl::opt<std::string> SkipMeasuredFile(
+    "skip-measured-file",
+    cl::desc("benchmark results file from a previous run; opcodes that "
+             "already have successful results there for the same mode and "
+             "CPU are not re-measured"),
+    cl::cat(BenchmarkOptions), cl::init(""));
+
 static cl::opt<std::string>
     BenchmarkFile("benchmarks-file",
                   cl::desc("File to read (analysis mode) or write "
@@ -397,6 +405,36 @@ generateSnippets(const LLVMState &State, unsigned Opcode,
   return Benchmarks;
 }
 
+// Support for incremental runs: drop every opcode that already has a
+// successful result for the current mode and CPU in the file given by
+// -skip-measured-file, so only new or previously failed entries get
+// re-measured.
+static void filterAlreadyMeasuredOpcodes(const LLVMState &State,
+                                         std::vector<unsigned> &Opcodes) {
+  auto MemBuf = ExitOnFileError(
+      SkipMeasuredFile, errorOrToExpected(MemoryBuffer::getFile(
+                            SkipMeasuredFile, /*IsText=*/true)));
+  const std::vector<Benchmark> Previous =
+      ExitOnFileError(SkipMeasuredFile, Benchmark::readYamls(State, *MemBuf));
+  const StringRef CpuName = State.getTargetMachine().getTargetCPU();
+  DenseSet<unsigned> Measured;
+  for (const Benchmark &B : Previous) {
+    if (B.Mode != BenchmarkMode || B.CpuName != CpuName)
+      continue;
+    // Entries that errored out or carry no measurements are stale and should
+    // be re-measured.
+    if (!B.Error.empty() || B.Measurements.empty())
+      continue;
+    if (!B.Key.Instructions.empty())
+      Measured.insert(B.keyInstruction().getOpcode());
+  }
+  const size_t NumRequested = Opcodes.size();
+  llvm::erase_if(Opcodes,
+                 [&](unsigned Opcode) { return Measured.contains(Opcode); });
+  errs() << "skipping " << (NumRequested - Opcodes.size())
+         << " opcode(s) already measured in '" << SkipMeasuredFile << "'\n";
+}
+
 static void runBenchmarkConfigurations(
     const LLVMState &State, ArrayRef<BenchmarkCode> Configurations,
     ArrayRef<std::unique_ptr<const SnippetRepetitor>> Repetitors,
@@ -517,7 +555,14 @@ void benchmarkMain() {
     ExitWithError("cannot create benchmark runner");
   }
 
-  const auto Opcodes = getOpcodesOrDie(State);
+  std::vector<unsigned> Opcodes = getOpcodesOrDie(State);
+  if (!SkipMeasuredFile.empty() && !Opcodes.empty()) {
+    filterAlreadyMeasuredOpcodes(State, Opcodes);
+    if (Opcodes.empty()) {
+      errs() << "all requested opcodes are already measured\n";
+      return;
+    }
+  }
   std::vector<BenchmarkCode> Configurations;
 
   unsigned LoopRegister =
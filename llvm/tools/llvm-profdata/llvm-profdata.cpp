@@ -202,6 +202,12 @@ cl::opt<bool> CompressAllSections(
     cl::sub(MergeSubcommand),
     cl::desc("Compress all sections when writing the profile (only "
              "meaningful for -extbinary)"));
+cl::opt<bool> CompressWithZstd(
+    "compress-zstd", cl::init(false), cl::Hidden, cl::sub(MergeSubcommand),
+    cl::desc("Use zstd instead of zlib for compressed sections. Decompresses "
+             "faster when the profile is loaded, but the output cannot be "
+             "read by readers without zstd support (only meaningful with "
+             "-compress-all-sections)"));
 cl::opt<bool> SampleMergeColdContext(
     "sample-merge-cold-context", cl::init(false), cl::Hidden,
     cl::sub(MergeSubcommand),
@@ -872,6 +878,11 @@ static void mergeWriterContexts(WriterContext *Dst, WriterContext *Src) {
     if (firstTime)
       warn(toString(make_error<InstrProfError>(ErrorCode, Msg)));
   });
+
+  // The merged-from context stays alive until the end of the merge, but its
+  // records have been moved out; release the name table and record shells now
+  // so peak memory does not hold every intermediate context's storage.
+  Src->Writer.getProfileData().clear();
 }
 
 static StringRef
@@ -1559,8 +1570,14 @@ static void handleExtBinaryWriter(sampleprof::SampleProfileWriter &Writer,
   if (CompressAllSections) {
     if (OutputFormat != PF_Ext_Binary)
       warn("-compress-all-section is ignored. Specify -extbinary to enable it");
-    else
+    else {
       Writer.setToCompressAllSections();
+      if (CompressWithZstd)
+        Writer.setUseZstdCompression();
+    }
+  } else if (CompressWithZstd) {
+    warn("-compress-zstd is ignored. Specify -compress-all-sections to "
+         "enable it");
   }
   if (UseMD5) {
     if (OutputFormat != PF_Ext_Binary)
@@ -55,6 +55,14 @@ int TestRunner::run(StringRef Filename) const {
   return !Result;
 }
 
+StringRef TestRunner::getProgramBitcode() const {
+  if (ProgramBC.empty()) {
+    raw_svector_ostream BCOS(ProgramBC);
+    Program->writeBitcode(BCOS);
+  }
+  return ProgramBC;
+}
+
 void TestRunner::writeOutput(StringRef Message) {
   std::error_code EC;
   raw_fd_ostream Out(OutputFilename, EC,
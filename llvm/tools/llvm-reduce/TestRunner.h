@@ -10,6 +10,7 @@
 #define LLVM_TOOLS_LLVM_REDUCE_TESTRUNNER_H
 
 #include "ReducerWorkItem.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
@@ -40,8 +41,16 @@ public:
   void setProgram(std::unique_ptr<ReducerWorkItem> &&P) {
     assert(P && "Setting null program?");
     Program = std::move(P);
+    // The cached serialization no longer matches the program.
+    ProgramBC.clear();
   }
 
+  /// Returns the current program serialized as bitcode. The result is cached
+  /// and only regenerated after the program has been replaced with
+  /// setProgram(), so repeated queries within and across delta passes are
+  /// free.
+  StringRef getProgramBitcode() const;
+
   const TargetMachine *getTargetMachine() const { return TM.get(); }
 
   StringRef getToolName() const { return ToolName; }
@@ -61,6 +70,7 @@ private:
   StringRef OutputFilename;
   const bool InputIsBitcode;
   bool EmitBitcode;
+  mutable SmallString<0> ProgramBC;
 };
 
 } // namespace llvm
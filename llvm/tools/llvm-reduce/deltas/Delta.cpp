@@ -94,7 +94,8 @@ CheckChunk(const Chunk ChunkToCheckForUninterestingness,
            std::unique_ptr<ReducerWorkItem> Clone, const TestRunner &Test,
            ReductionFunc ExtractChunksFromModule,
            const DenseSet<Chunk> &UninterestingChunks,
-           const std::vector<Chunk> &ChunksStillConsideredInteresting) {
+           const std::vector<Chunk> &ChunksStillConsideredInteresting,
+           const std::atomic<bool> *AnyReduced) {
   // Take all of ChunksStillConsideredInteresting chunks, except those we've
   // already deemed uninteresting (UninterestingChunks) but didn't remove
   // from ChunksStillConsideredInteresting yet, and additionally ignore
@@ -134,6 +135,13 @@ CheckChunk(const Chunk ChunkToCheckForUninterestingness,
     errs() << "\n";
   }
 
+  // When running speculatively in parallel, another task may have already
+  // found a reduction with the current chunk set. The winning result is going
+  // to be accepted and the remaining futures discarded, so don't bother
+  // launching our interestingness test.
+  if (AnyReduced && *AnyReduced)
+    return nullptr;
+
   if (!Clone->isReduced(Test)) {
     // Program became non-reduced, so this chunk appears to be interesting.
     if (Verbose)
@@ -158,7 +166,7 @@ static SmallString<0> ProcessChunkFromSerializedBitcode(
   if (std::unique_ptr<ReducerWorkItem> ChunkResult =
           CheckChunk(ChunkToCheckForUninterestingness, std::move(CloneMMM),
                      Test, ExtractChunksFromModule, UninterestingChunks,
-                     ChunksStillConsideredInteresting)) {
+                     ChunksStillConsideredInteresting, &AnyReduced)) {
     raw_svector_ostream BCOS(Result);
     ChunkResult->writeBitcode(BCOS);
     // Communicate that the task reduced a chunk.
@@ -225,20 +233,21 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
     ChunkThreadPoolPtr =
         std::make_unique<DefaultThreadPool>(hardware_concurrency(NumJobs));
 
+  // When running with more than one thread, the tasks work from the serialized
+  // bitcode of the original program. The program does not change for the
+  // duration of this pass (candidate reductions are applied to clones), so
+  // fetch the cached serialization once up front instead of re-serializing at
+  // every granularity level.
+  StringRef OriginalBC;
+  if (NumJobs > 1)
+    OriginalBC = Test.getProgramBitcode();
+
   bool FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity;
   do {
     FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity = false;
 
     DenseSet<Chunk> UninterestingChunks;
 
-    // When running with more than one thread, serialize the original bitcode
-    // to OriginalBC.
-    SmallString<0> OriginalBC;
-    if (NumJobs > 1) {
-      raw_svector_ostream BCOS(OriginalBC);
-      Test.getProgram().writeBitcode(BCOS);
-    }
-
     SharedTaskQueue TaskQueue;
     for (auto I = ChunksStillConsideredInteresting.rbegin(),
               E = ChunksStillConsideredInteresting.rend();
@@ -305,10 +314,9 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         }
 
         // If we broke out of the loop, we still need to wait for everything to
-        // avoid race access to the chunk set.
-        //
-        // TODO: Create a way to kill remaining items we're ignoring; they could
-        // take a long time.
+        // avoid race access to the chunk set. Losing tasks that have not yet
+        // launched their interestingness test observe AnyReduced and bail
+        // early; only tests that are already in flight run to completion.
         ChunkThreadPoolPtr->wait();
         TaskQueue.clear();
 
@@ -318,7 +326,8 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         Result =
             CheckChunk(*I, Test.getProgram().clone(Test.getTargetMachine()),
                        Test, ExtractChunksFromModule, UninterestingChunks,
-                       ChunksStillConsideredInteresting);
+                       ChunksStillConsideredInteresting,
+                       /*AnyReduced=*/nullptr);
       }
 
       if (!Result)
@@ -0,0 +1,75 @@
+//===- RemarkMerge.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Merge multiple remark files into a single, uniqued, standalone remark file.
+//
+//===----------------------------------------------------------------------===//
+
+#include "RemarkUtilHelpers.h"
+#include "RemarkUtilRegistry.h"
+#include "llvm/Remarks/RemarkLinker.h"
+
+using namespace llvm;
+using namespace remarks;
+using namespace llvm::remarkutil;
+
+static cl::SubCommand Merge("merge",
+                            "Merge multiple remark files into one file");
+
+namespace merge {
+static cl::list<std::string> InputFileNames(cl::Positional, cl::OneOrMore,
+                                            cl::desc("<input files>"),
+                                            cl::sub(Merge));
+static cl::opt<std::string> OutputFileName("o", cl::init("-"),
+                                           cl::desc("Output"),
+                                           cl::value_desc("filename"),
+                                           cl::sub(Merge));
+INPUT_FORMAT_COMMAND_LINE_OPTIONS(Merge)
+static cl::opt<Format> OutputFormat(
+    "serializer", cl::desc("Output remark format to serialize"),
+    cl::init(Format::Bitstream),
+    cl::values(clEnumValN(Format::YAML, "yaml", "YAML"),
+               clEnumValN(Format::Bitstream, "bitstream", "Bitstream")),
+    cl::sub(Merge));
+static cl::opt<bool> KeepAllRemarks(
+    "keep-all-remarks",
+    cl::desc("Keep remarks without debug locations in the merged output"),
+    cl::init(true), cl::sub(Merge));
+
+/// Link all remarks from the input files into a single uniqued set, then
+/// serialize the result to the output file.
+/// \returns Error::success() on success, and an Error otherwise.
+static Error tryMerge() {
+  // If no parser format is explicitly requested, let the linker deduce it
+  // from each input file.
+  std::optional<Format> MaybeInputFormat;
+  if (InputFormat.getNumOccurrences())
+    MaybeInputFormat = InputFormat;
+
+  RemarkLinker RL;
+  RL.setKeepAllRemarks(KeepAllRemarks);
+  for (StringRef InputFileName : InputFileNames) {
+    auto MaybeBuf = getInputMemoryBuffer(InputFileName);
+    if (!MaybeBuf)
+      return MaybeBuf.takeError();
+    if (Error E = RL.link((*MaybeBuf)->getBuffer(), MaybeInputFormat))
+      return E;
+  }
+
+  auto MaybeOF = getOutputFileForRemarks(OutputFileName, OutputFormat);
+  if (!MaybeOF)
+    return MaybeOF.takeError();
+  auto OF = std::move(*MaybeOF);
+  if (Error E = RL.serialize(OF->os(), OutputFormat))
+    return E;
+  OF->keep();
+  return Error::success();
+}
+} // namespace merge
+
+static CommandRegistration MergeReg(&Merge, merge::tryMerge);
@@ -310,4 +310,65 @@ TEST(ConcurrentHashTableTest, AddStringEntriesParallelWithResize) {
               std::string::npos);
 }
 
+TEST(ConcurrentHashTableTest, LookupAndEraseStringEntries) {
+  PerThreadBumpPtrAllocator Allocator;
+  const size_t NumElements = 5000;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 100);
+
+  // PerThreadBumpPtrAllocator should be accessed from threads created by
+  // ThreadPoolExecutor. Use TaskGroup to run on ThreadPoolExecutor threads.
+  parallel::TaskGroup tg;
+
+  tg.spawn([&]() {
+    for (size_t I = 0; I < NumElements; I++) {
+      std::string StringForElement = formatv("{0}", I);
+      EXPECT_EQ(HashTable.lookup(StringForElement), nullptr);
+      std::pair<String *, bool> Entry = HashTable.insert(StringForElement);
+      EXPECT_TRUE(Entry.second);
+      // Check lookup returns the inserted entry without creating a new one.
+      EXPECT_EQ(HashTable.lookup(StringForElement), Entry.first);
+    }
+
+    // Erase every other entry.
+    for (size_t I = 0; I < NumElements; I += 2) {
+      std::string StringForElement = formatv("{0}", I);
+      EXPECT_TRUE(HashTable.erase(StringForElement));
+      // Check the entry cannot be erased twice.
+      EXPECT_FALSE(HashTable.erase(StringForElement));
+    }
+
+    // Check remaining entries are still reachable after the removals
+    // reshuffled their probe clusters.
+    for (size_t I = 0; I < NumElements; I++) {
+      std::string StringForElement = formatv("{0}", I);
+      String *Entry = HashTable.lookup(StringForElement);
+      if (I % 2 == 0) {
+        EXPECT_EQ(Entry, nullptr);
+      } else {
+        ASSERT_TRUE(Entry != nullptr);
+        EXPECT_TRUE(Entry->getKey() == StringForElement);
+      }
+    }
+
+    // Check erased keys may be inserted again.
+    for (size_t I = 0; I < NumElements; I += 2) {
+      std::string StringForElement = formatv("{0}", I);
+      std::pair<String *, bool> Entry = HashTable.insert(StringForElement);
+      EXPECT_TRUE(Entry.second);
+      EXPECT_TRUE(Entry.first->getKey() == StringForElement);
+    }
+
+    // Check statistic.
+    std::string StatisticString;
+    raw_string_ostream StatisticStream(StatisticString);
+    HashTable.printStatistic(StatisticStream);
+
+    EXPECT_TRUE(StatisticString.find("Overall number of entries = 5000\n") !=
+                std::string::npos);
+  });
+}
+
 } // namespace
@@ -789,4 +789,28 @@ TEST(DenseMapCustomTest, PairPrinting) {
   EXPECT_EQ(R"({ (1, "one"), (2, "two") })", ::testing::PrintToString(Map));
 }
 
+// Mixed insert/erase traffic that repeatedly crosses the control-group
+// boundaries of the group-probed representation, leaving long tombstone runs
+// behind so probe sequences span several groups.
+TEST(DenseMapCustomTest, GroupProbeTombstoneChurn) {
+  DenseMap<unsigned, unsigned> Map;
+  for (unsigned Round = 0; Round != 4; ++Round) {
+    for (unsigned I = 1; I <= 512; ++I)
+      Map[I * 37] = I;
+    for (unsigned I = 1; I <= 512; I += 2)
+      EXPECT_TRUE(Map.erase(I * 37));
+    for (unsigned I = 1; I <= 512; ++I) {
+      auto It = Map.find(I * 37);
+      if (I % 2) {
+        EXPECT_TRUE(It == Map.end());
+      } else {
+        ASSERT_TRUE(It != Map.end());
+        EXPECT_EQ(It->second, I);
+      }
+    }
+    EXPECT_EQ(Map.size(), 256u);
+    Map.clear();
+  }
+}
+
 } // namespace
@@ -150,6 +150,29 @@ TEST_F(StringMapTest, EraseValueTest) {
   assertEmptyMap();
 }
 
+// Test reserve() method.
+TEST_F(StringMapTest, ReserveTest) {
+  // Reserving on an empty map allocates up front; no rehash may happen while
+  // inserting up to the reserved count.
+  testMap.reserve(100);
+  unsigned Buckets = testMap.getNumBuckets();
+  for (int I = 0; I < 100; ++I)
+    testMap[std::to_string(I)] = I;
+  EXPECT_EQ(Buckets, testMap.getNumBuckets());
+  EXPECT_EQ(100u, testMap.size());
+
+  // Reserving over a populated map keeps the entries findable.
+  testMap.reserve(1000);
+  EXPECT_GT(testMap.getNumBuckets(), Buckets);
+  for (int I = 0; I < 100; ++I)
+    EXPECT_EQ(I, testMap.lookup(std::to_string(I)));
+
+  // A smaller hint is a no-op.
+  unsigned GrownBuckets = testMap.getNumBuckets();
+  testMap.reserve(10);
+  EXPECT_EQ(GrownBuckets, testMap.getNumBuckets());
+}
+
 // Test inserting two values and erasing one.
 TEST_F(StringMapTest, InsertAndEraseTest) {
   testMap[testKey] = testValue;
@@ -8,6 +8,7 @@
 
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/KnownBitsCache.h"
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/IR/ConstantRange.h"
 #include "llvm/IR/Dominators.h"
@@ -1275,6 +1276,37 @@ TEST_F(ComputeKnownBitsTest, ComputeKnownMulBits) {
   expectKnownBits(/*zero*/ 95u, /*one*/ 32u);
 }
 
+TEST_F(ComputeKnownBitsTest, KnownBitsCacheHitAndFlush) {
+  parseAssembly(
+      "define i32 @test(i32 %a, i32 %b) {\n"
+      "  %or = or i32 %a, 16\n"
+      "  %A = and i32 %or, 48\n"
+      "  ret i32 %A\n"
+      "}\n");
+  const DataLayout &DL = M->getDataLayout();
+  KnownBitsCache KBC;
+  SimplifyQuery Q = SimplifyQuery(DL).getWithKnownBitsCache(&KBC);
+
+  KnownBits Known = computeKnownBits(A, /*Depth=*/0, Q);
+  EXPECT_EQ(Known.One.getZExtValue(), 16u);
+  EXPECT_TRUE(KBC.lookup(A, nullptr).has_value());
+  // A cached repeat query returns the same result.
+  KnownBits Again = computeKnownBits(A, /*Depth=*/0, Q);
+  EXPECT_EQ(Known.One, Again.One);
+  EXPECT_EQ(Known.Zero, Again.Zero);
+
+  // Replacing a cached value's uses flushes the cache.
+  Instruction *Or = A->getPrevNode();
+  KnownBits OrKnown = computeKnownBits(Or, /*Depth=*/0, Q);
+  EXPECT_TRUE(KBC.lookup(Or, nullptr).has_value());
+  IRBuilder<> Builder(A);
+  Value *NewOr = Builder.CreateOr(Or->getOperand(0), Or->getOperand(1));
+  Or->replaceAllUsesWith(NewOr);
+  EXPECT_FALSE(KBC.lookup(A, nullptr).has_value());
+  EXPECT_FALSE(KBC.lookup(Or, nullptr).has_value());
+  (void)OrKnown;
+}
+
 TEST_F(ComputeKnownFPClassTest, SelectPos0) {
   parseAssembly(
       "define float @test(i1 %cond) {\n"
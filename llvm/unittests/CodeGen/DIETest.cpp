@@ -172,4 +172,21 @@ INSTANTIATE_TEST_SUITE_P(
         DIETestParams{4, dwarf::DWARF64, dwarf::DW_FORM_data8, 8u},
         DIETestParams{4, dwarf::DWARF64, dwarf::DW_FORM_sec_offset, 8u}));
 
+TEST(DIEProfileAbbrevTest, MatchesGeneratedAbbrev) {
+  BumpPtrAllocator Alloc;
+  DIE &Die = *DIE::get(Alloc, dwarf::DW_TAG_subprogram);
+  Die.addValue(Alloc, dwarf::DW_AT_name, dwarf::DW_FORM_strp, DIEInteger(7));
+  Die.addValue(Alloc, dwarf::DW_AT_decl_file, dwarf::DW_FORM_implicit_const,
+               DIEInteger(1));
+  Die.addChild(DIE::get(Alloc, dwarf::DW_TAG_formal_parameter));
+
+  FoldingSetNodeID DirectID;
+  Die.profileAbbrev(DirectID);
+
+  FoldingSetNodeID MaterializedID;
+  Die.generateAbbrev().Profile(MaterializedID);
+
+  EXPECT_EQ(DirectID, MaterializedID);
+}
+
 } // end namespace
@@ -15,6 +15,7 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/ReplaceConstant.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
@@ -310,6 +311,45 @@ TEST(ConstantsTest, ConstantExprReplaceWithConstant) {
   ASSERT_EQ(Int2, Ref->getInitializer());
 }
 
+TEST(ConstantsTest, ReplaceConstantsInModule) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M(new Module("MyModule", Context));
+
+  Type *IntTy = Type::getInt8Ty(Context);
+  Constant *G1 = new GlobalVariable(*M, IntTy, false,
+                                    GlobalValue::ExternalLinkage, nullptr);
+  Constant *G2 = new GlobalVariable(*M, IntTy, false,
+                                    GlobalValue::ExternalLinkage, nullptr);
+
+  // An initializer reaching G1 through a constant expression, and an
+  // instruction operand reaching it through a constant aggregate.
+  Constant *Int1 = ConstantExpr::getPtrToInt(G1, IntTy);
+  GlobalVariable *Ref =
+      new GlobalVariable(*M, IntTy, false, GlobalValue::ExternalLinkage, Int1);
+
+  ArrayType *ArrayTy = ArrayType::get(IntTy, 2);
+  Constant *AVals[2] = {ConstantInt::get(IntTy, 7), Int1};
+  Constant *Agg = ConstantArray::get(ArrayTy, AVals);
+
+  FunctionType *FTy = FunctionType::get(ArrayTy, false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", *M);
+  BasicBlock *BB = BasicBlock::Create(Context, "entry", F);
+  Instruction *Ret = ReturnInst::Create(Context, Agg, BB);
+
+  DenseMap<Constant *, Constant *> Replacements;
+  Replacements[G1] = G2;
+  EXPECT_TRUE(replaceConstantsInModule(*M, Replacements));
+
+  Constant *Int2 = ConstantExpr::getPtrToInt(G2, IntTy);
+  EXPECT_EQ(Int2, Ref->getInitializer());
+  Constant *NewAgg = cast<Constant>(Ret->getOperand(0));
+  EXPECT_EQ(Int2, NewAgg->getAggregateElement(1u));
+  EXPECT_EQ(ConstantInt::get(IntTy, 7), NewAgg->getAggregateElement(0u));
+
+  // Nothing left to do on a second pass.
+  EXPECT_FALSE(replaceConstantsInModule(*M, Replacements));
+}
+
 TEST(ConstantsTest, GEPReplaceWithConstant) {
   LLVMContext Context;
   std::unique_ptr<Module> M(new Module("MyModule", Context));
@@ -71,6 +71,51 @@ define void @foo(ptr %ptr) {
   EXPECT_EQ(Ld->getOperand(0), Gep0);
 }
 
+TEST_F(TrackerTest, RevertToCheckpoint) {
+  parseIR(C, R"IR(
+define void @foo(ptr %ptr) {
+  %gep0 = getelementptr float, ptr %ptr, i32 0
+  %gep1 = getelementptr float, ptr %ptr, i32 1
+  %ld0 = load float, ptr %gep0
+  store float undef, ptr %gep0
+  ret void
+}
+)IR");
+  Function &LLVMF = *M->getFunction("foo");
+  sandboxir::Context Ctx(C);
+  auto *F = Ctx.createFunction(&LLVMF);
+  auto *BB = &*F->begin();
+  auto &Tracker = Ctx.getTracker();
+  Tracker.save();
+  auto It = BB->begin();
+  auto *Gep0 = &*It++;
+  auto *Gep1 = &*It++;
+  auto *Ld = &*It++;
+  auto *St = &*It++;
+  // Changes made before the checkpoint should survive revertToCheckpoint().
+  St->setOperand(1, Gep1);
+  sandboxir::Tracker::CheckpointTy Chkpnt = Tracker.getCheckpoint();
+  // Changes made after the checkpoint should get reverted.
+  Ld->setOperand(0, Gep1);
+  St->setOperand(0, Ld);
+  EXPECT_EQ(Ld->getOperand(0), Gep1);
+  EXPECT_EQ(St->getOperand(0), Ld);
+
+  Tracker.revertToCheckpoint(Chkpnt);
+  EXPECT_EQ(Ld->getOperand(0), Gep0);
+  EXPECT_NE(St->getOperand(0), Ld);
+  EXPECT_EQ(St->getOperand(1), Gep1);
+  EXPECT_TRUE(Tracker.isTracking());
+
+  // Reverting to the same checkpoint again is a no-op.
+  Tracker.revertToCheckpoint(Chkpnt);
+  EXPECT_EQ(St->getOperand(1), Gep1);
+
+  // A full revert() still undoes the pre-checkpoint changes.
+  Tracker.revert();
+  EXPECT_EQ(St->getOperand(1), Gep0);
+}
+
 TEST_F(TrackerTest, SetUse) {
   parseIR(C, R"IR(
 define void @foo(ptr %ptr, i8 %arg) {
@@ -0,0 +1,79 @@
+//===- ThreadSafeBumpPtrAllocatorTest.cpp ---------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadSafeBumpPtrAllocator.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ThreadSafeBumpPtrAllocatorTest, Simple) {
+  ThreadSafeBumpPtrAllocator Allocator;
+
+  uint64_t *Var =
+      (uint64_t *)Allocator.Allocate(sizeof(uint64_t), alignof(uint64_t));
+  *Var = 0xFE;
+  EXPECT_EQ(0xFEul, *Var);
+  EXPECT_EQ(sizeof(uint64_t), Allocator.getBytesAllocated());
+  EXPECT_TRUE(Allocator.getBytesAllocated() <= Allocator.getTotalMemory());
+
+  // Oversized allocations get their own slab.
+  char *Big = (char *)Allocator.Allocate(
+      ThreadSafeBumpPtrAllocator::SlabSize, 1);
+  Big[0] = 1;
+  Big[ThreadSafeBumpPtrAllocator::SlabSize - 1] = 2;
+}
+
+TEST(ThreadSafeBumpPtrAllocatorTest, ParallelAllocation) {
+  ThreadSafeBumpPtrAllocator Allocator;
+
+  constexpr size_t NumThreads = 8;
+  constexpr size_t NumAllocations = 10000;
+  std::vector<std::vector<uint64_t *>> Ptrs(NumThreads);
+
+  std::vector<std::thread> Threads;
+  for (size_t T = 0; T < NumThreads; ++T)
+    Threads.emplace_back([&, T] {
+      for (size_t I = 0; I < NumAllocations; ++I) {
+        uint64_t *Ptr =
+            (uint64_t *)Allocator.Allocate(sizeof(uint64_t), alignof(uint64_t));
+        *Ptr = T * NumAllocations + I;
+        Ptrs[T].push_back(Ptr);
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  for (size_t T = 0; T < NumThreads; ++T)
+    for (size_t I = 0; I < NumAllocations; ++I)
+      EXPECT_EQ(T * NumAllocations + I, *Ptrs[T][I]);
+
+  EXPECT_EQ(NumThreads * NumAllocations * sizeof(uint64_t),
+            Allocator.getBytesAllocated());
+}
+
+TEST(ThreadSafeBumpPtrAllocatorTest, ResetRecyclesSlabs) {
+  ThreadSafeBumpPtrAllocator Allocator;
+
+  for (size_t I = 0; I < 100000; ++I)
+    (void)Allocator.Allocate(64, 8);
+  size_t MemoryAfterFirstRound = Allocator.getTotalMemory();
+
+  Allocator.Reset();
+  EXPECT_EQ(0u, Allocator.getBytesAllocated());
+
+  // A second identical round must be served from the recycled slabs.
+  for (size_t I = 0; I < 100000; ++I)
+    (void)Allocator.Allocate(64, 8);
+  EXPECT_EQ(MemoryAfterFirstRound, Allocator.getTotalMemory());
+}
+
+} // namespace
@@ -2015,6 +2015,7 @@ TreePatternNodePtr TreePatternNode::clone() const {
 void TreePatternNode::RemoveAllTypes() {
   // Reset to unknown type.
   std::fill(Types.begin(), Types.end(), TypeSetByHwMode());
+  TypesAreSettled = false;
   if (isLeaf())
     return;
   for (TreePatternNode &Child : children())
@@ -2433,6 +2434,46 @@ static void emitTooFewOperandsError(TreePattern &TP, StringRef InstName,
 /// this node and its children in the tree.  This returns true if it makes a
 /// change, false otherwise.  If a type contradiction is found, flag an error.
 bool TreePatternNode::ApplyTypeConstraints(TreePattern &TP, bool NotRegisters) {
+  // Once the subtree has settled, reapplying the constraints cannot change
+  // anything: it could only flag a contradiction, which would already have
+  // been flagged when the last type settled. Skip the walk so that each
+  // iteration of the inference fixed-point loop only revisits the parts of
+  // the pattern that are still unresolved.
+  if (TypesAreSettled)
+    return false;
+
+  bool MadeChange = ApplyTypeConstraintsImpl(TP, NotRegisters);
+  if (MadeChange || TP.hasError())
+    return MadeChange;
+
+  // With a single HW mode a settled type can never change again: merging in
+  // any other type information either leaves it untouched or empties the
+  // set, which is a type contradiction. With multiple HW modes a simple set
+  // can still legitimately change shape when merged with a mode-dependent
+  // type, so don't cache in that case.
+  if (TP.getDAGPatterns().getTargetInfo().getHwModes().getNumModeIds() != 1)
+    return false;
+
+  auto TypeIsSettled = [](const TypeSetByHwMode &VTS) {
+    if (!VTS.isMachineValueType())
+      return false;
+    // iPTR and the overloaded types can still be narrowed to a specific
+    // type by a later merge.
+    MVT T = VTS.getMachineValueType();
+    return !T.isOverloaded() && T != MVT::iPTR;
+  };
+
+  if (all_of(Types, TypeIsSettled) &&
+      all_of(Children, [](const TreePatternNodePtr &Child) {
+        return Child->TypesAreSettled;
+      }))
+    TypesAreSettled = true;
+
+  return false;
+}
+
+bool TreePatternNode::ApplyTypeConstraintsImpl(TreePattern &TP,
+                                               bool NotRegisters) {
   if (TP.hasError())
     return false;
 
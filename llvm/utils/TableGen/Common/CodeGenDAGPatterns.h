@@ -656,6 +656,13 @@ class TreePatternNode : public RefCountedBase<TreePatternNode> {
   /// from "GISelFlags": the original Record derived from GISelFlags.
   const Record *GISelFlags = nullptr;
 
+  /// Set once type inference for the subtree rooted at this node has settled:
+  /// every result type in the subtree is a single concrete type that no
+  /// further constraint application can change. Lets ApplyTypeConstraints
+  /// skip settled subtrees on later iterations of the inference fixed-point
+  /// loop instead of re-walking the whole pattern each time.
+  bool TypesAreSettled = false;
+
 public:
   TreePatternNode(const Record *Op, std::vector<TreePatternNodePtr> Ch,
                   unsigned NumResults)
@@ -697,7 +704,10 @@ public:
     return Types[ResNo];
   }
   TypeSetByHwMode &getExtType(unsigned ResNo) { return Types[ResNo]; }
-  void setType(unsigned ResNo, const TypeSetByHwMode &T) { Types[ResNo] = T; }
+  void setType(unsigned ResNo, const TypeSetByHwMode &T) {
+    Types[ResNo] = T;
+    TypesAreSettled = false;
+  }
   MVT::SimpleValueType getSimpleType(unsigned ResNo) const {
     return Types[ResNo].getMachineValueType().SimpleTy;
   }
@@ -869,6 +879,9 @@ public: // Higher level manipulation routines.
   /// target, fill in Reason and return false.  Otherwise, return true.
   bool canPatternMatch(std::string &Reason,
                        const CodeGenDAGPatterns &CDP) const;
+
+private:
+  bool ApplyTypeConstraintsImpl(TreePattern &TP, bool NotRegisters);
 };
 
 inline raw_ostream &operator<<(raw_ostream &OS, const TreePatternNode &TPN) {
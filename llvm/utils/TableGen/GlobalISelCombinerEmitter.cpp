@@ -2376,6 +2376,13 @@ class GICombinerEmitter final : public GlobalISelMatchTableExecutorEmitter {
   // the same rule twice.
   StringSet<> RulesSeen;
 
+  // Sorted, deduplicated list of opcodes that can root at least one rule,
+  // used to emit a pre-screen in the CombineAll method. Empty if some rule's
+  // root carries no opcode predicate, in which case no pre-screen is emitted.
+  std::vector<std::string> RuleRootOpcodes;
+
+  void gatherRuleRootOpcodes(MutableArrayRef<RuleMatcher> Rules);
+
   MatchTable buildMatchTable(MutableArrayRef<RuleMatcher> Rules);
 
   void emitRuleConfigImpl(raw_ostream &OS);
@@ -2523,10 +2530,52 @@ void GICombinerEmitter::emitRuleConfigImpl(raw_ostream &OS) {
      << "}\n\n";
 }
 
+void GICombinerEmitter::gatherRuleRootOpcodes(
+    MutableArrayRef<RuleMatcher> Rules) {
+  // Must run before buildMatchTable: the match table optimizations move
+  // leading predicates out of the individual rules into group matchers.
+  std::set<std::string> Opcodes;
+  for (RuleMatcher &RM : Rules) {
+    InstructionOpcodeMatcher *OpMatcher = nullptr;
+    if (!RM.insnmatchers_empty()) {
+      for (const auto &P : RM.insnmatchers_front().predicates()) {
+        if ((OpMatcher = dyn_cast<InstructionOpcodeMatcher>(P.get())))
+          break;
+      }
+    }
+    // A root without an opcode predicate can match any instruction; no
+    // pre-screen is possible.
+    if (!OpMatcher)
+      return;
+    for (const CodeGenInstruction *I : OpMatcher->getAlternativeOpcodes())
+      Opcodes.insert((Twine(I->Namespace) + "::" + I->TheDef->getName()).str());
+  }
+  RuleRootOpcodes.assign(Opcodes.begin(), Opcodes.end());
+}
+
 void GICombinerEmitter::emitAdditionalImpl(raw_ostream &OS) {
+  if (!RuleRootOpcodes.empty()) {
+    OS << "// Returns true if the opcode can root at least one rule. Built at\n"
+       << "// TableGen time so " << getCombineAllMethodName()
+       << " can skip the match table executor\n"
+       << "// for instructions no rule can match.\n"
+       << "static bool is" << getClassName() << "RootOpcode(unsigned Opcode) {\n"
+       << "  switch (Opcode) {\n";
+    for (const std::string &Opcode : RuleRootOpcodes)
+      OS << "  case " << Opcode << ":\n";
+    OS << "    return true;\n"
+       << "  default:\n"
+       << "    return false;\n"
+       << "  }\n"
+       << "}\n\n";
+  }
+
   OS << "bool " << getClassName() << "::" << getCombineAllMethodName()
-     << "(MachineInstr &I) const {\n"
-     << "  const TargetSubtargetInfo &ST = MF.getSubtarget();\n"
+     << "(MachineInstr &I) const {\n";
+  if (!RuleRootOpcodes.empty())
+    OS << "  if (!is" << getClassName() << "RootOpcode(I.getOpcode()))\n"
+       << "    return false;\n";
+  OS << "  const TargetSubtargetInfo &ST = MF.getSubtarget();\n"
      << "  const PredicateBitset AvailableFeatures = "
         "getAvailableFeatures();\n"
      << "  B.setInstrAndDebugLoc(I);\n"
@@ -2742,6 +2791,8 @@ void GICombinerEmitter::run(raw_ostream &OS) {
     return false;
   });
 
+  gatherRuleRootOpcodes(Rules);
+
   const MatchTable Table = buildMatchTable(Rules);
 
   Timer.startTimer("Emit combiner");
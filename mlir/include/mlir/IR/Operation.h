@@ -939,6 +939,17 @@ public:
   llvm::hash_code hashProperties();
 
 private:
+  /// Create a new Operation, reserving inline storage for at least
+  /// `operandCapacity` operands even when `operands` holds fewer values. This
+  /// is used when cloning an operation whose operands are patched in
+  /// afterwards, so that the later setOperands() call does not have to grow
+  /// into a separately allocated operand storage.
+  static Operation *create(Location location, OperationName name,
+                           TypeRange resultTypes, ValueRange operands,
+                           DictionaryAttr attributes,
+                           OpaqueProperties properties, BlockRange successors,
+                           unsigned numRegions, unsigned operandCapacity);
+
   //===--------------------------------------------------------------------===//
   // Ordering
   //===--------------------------------------------------------------------===//
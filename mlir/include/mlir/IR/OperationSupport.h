@@ -1078,8 +1078,12 @@ namespace detail {
 /// stored either in a trailing array, or a dynamically resizable vector.
 class alignas(8) OperandStorage {
 public:
+  /// Construct a storage holding `values`, with inline space in
+  /// `trailingOperands` for `inlineCapacity` operands. `inlineCapacity` may
+  /// exceed `values.size()` when the creator intends to fill in the remaining
+  /// operands afterwards, e.g. while cloning.
   OperandStorage(Operation *owner, OpOperand *trailingOperands,
-                 ValueRange values);
+                 ValueRange values, unsigned inlineCapacity);
   ~OperandStorage();
 
   /// Replace the operands contained in the storage with the ones provided in
@@ -24,6 +24,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <cstddef>
 #include <list>
@@ -101,6 +102,10 @@ public:
   /// Returns the remaining size of the bytecode.
   size_t size() const { return buffer.end() - dataIt; }
 
+  /// Returns the remaining bytes of the section, without advancing the reader
+  /// position.
+  ArrayRef<uint8_t> getRemainingData() const { return {dataIt, buffer.end()}; }
+
   /// Align the current reader position to the specified alignment.
   LogicalResult alignTo(unsigned alignment) {
     if (!llvm::isPowerOf2_32(alignment))
@@ -602,8 +607,12 @@ public:
       return failure();
 
     // If we have an extendable reference to the buffer owner, we don't need to
-    // allocate a new buffer for the data, and can use the data directly.
-    if (bufferOwnerRef) {
+    // allocate a new buffer for the data, and can use the data directly. The
+    // bytecode writer aligns blobs relative to the start of the file, so this
+    // is only safe when the buffer itself was loaded at a compatible address;
+    // otherwise fall through and copy into properly aligned memory.
+    if (bufferOwnerRef &&
+        llvm::isAddrAligned(llvm::Align(alignment), data.data())) {
       ArrayRef<char> charData(reinterpret_cast<const char *>(data.data()),
                               data.size());
 
@@ -1353,6 +1362,11 @@ public:
 
   /// Materialize all operations.
   LogicalResult materializeAll() {
+    // Every pending region will be parsed; hint all of their backing bytes up
+    // front so page-in proceeds in the background while the regions
+    // materialize in order.
+    for (auto &it : lazyLoadableOps)
+      prefetchRegionData(it.second.reader->getRemainingData());
     while (!lazyLoadableOpsMap.empty()) {
       if (failed(materialize(lazyLoadableOpsMap.begin())))
         return failure();
@@ -1389,6 +1403,7 @@ private:
     regionStack.push_back(std::move(it->getSecond()->second));
     lazyLoadableOps.erase(it->getSecond());
     lazyLoadableOpsMap.erase(it);
+    prefetchRegionData(regionStack.back().reader->getRemainingData());
 
     while (!regionStack.empty())
       if (failed(parseRegions(regionStack, regionStack.back())))
@@ -1396,6 +1411,25 @@ private:
     return success();
   }
 
+  /// Hint that the given lazy region bytes are about to be parsed, by touching
+  /// one byte per page on the context's thread pool. For an mmap'ed bytecode
+  /// file this overlaps the major page faults with materialization instead of
+  /// taking every fault serially on the parsing thread.
+  void prefetchRegionData(ArrayRef<uint8_t> data) {
+    constexpr size_t kPageSize = 4096;
+    MLIRContext *ctx = getContext();
+    if (data.size() < 4 * kPageSize || !ctx->isMultithreadingEnabled())
+      return;
+    if (!prefetchTasks)
+      prefetchTasks.emplace(ctx->getThreadPool());
+    prefetchTasks->async([data] {
+      volatile uint8_t sink = 0;
+      for (size_t i = 0, e = data.size(); i < e; i += kPageSize)
+        sink += data[i];
+      (void)sink;
+    });
+  }
+
   /// Return the context for this config.
   MLIRContext *getContext() const { return config.getContext(); }
 
@@ -1576,6 +1610,11 @@ private:
   LazyLoadableOpsMap lazyLoadableOpsMap;
   llvm::function_ref<bool(Operation *)> lazyOpsCallback;
 
+  /// Tracks outstanding page-touch prefetch tasks scheduled for lazy region
+  /// bytes; its destruction waits for them, so the tasks never outlive the
+  /// bytecode buffer.
+  std::optional<llvm::ThreadPoolTaskGroup> prefetchTasks;
+
   /// The reader used to process attribute and types within the bytecode.
   AttrTypeReader attrTypeReader;
 
@@ -100,6 +100,17 @@ static inline void aliasIntoMemref(DataSizeT size, T *data,
   ref.strides[0] = 1;
 }
 
+/// Packs the overhead and primary type signature of a sparse tensor creation
+/// request into a single integer, so that the creation dispatch can switch
+/// over all instantiated combinations in constant time instead of testing
+/// each combination in sequence. Workloads that create many tensors with the
+/// same (effectively monomorphic) signature pay the dispatch on every call.
+static constexpr uint64_t packTypeKey(OverheadType posTp, OverheadType crdTp,
+                                      PrimaryType valTp) {
+  return (static_cast<uint64_t>(posTp) << 16) |
+         (static_cast<uint64_t>(crdTp) << 8) | static_cast<uint64_t>(valTp);
+}
+
 } // anonymous namespace
 
 extern "C" {
@@ -112,7 +123,7 @@ extern "C" {
 //===----------------------------------------------------------------------===//
 
 #define CASE(p, c, v, P, C, V)                                                 \
-  if (posTp == (p) && crdTp == (c) && valTp == (v)) {                          \
+  case packTypeKey(p, c, v): {                                                 \
     switch (action) {                                                          \
     case Action::kEmpty: {                                                     \
       return SparseTensorStorage<P, C, V>::newEmpty(                           \
@@ -181,6 +192,7 @@ void *_mlir_ciface_newSparseTensor( // NOLINT
   if (crdTp == OverheadType::kIndex)
     crdTp = OverheadType::kU64;
 
+  switch (packTypeKey(posTp, crdTp, valTp)) {
   // Double matrices with all combinations of overhead storage.
   CASE(OverheadType::kU64, OverheadType::kU64, PrimaryType::kF64, uint64_t,
        uint64_t, double);
@@ -280,6 +292,9 @@ void *_mlir_ciface_newSparseTensor( // NOLINT
   // Complex matrices with wide overhead.
   CASE_SECSAME(OverheadType::kU64, PrimaryType::kC64, uint64_t, complex64);
   CASE_SECSAME(OverheadType::kU64, PrimaryType::kC32, uint64_t, complex32);
+  default:
+    break;
+  }
 
   // Unsupported case (add above if needed).
   fprintf(stderr, "unsupported combination of types: <P=%d, C=%d, V=%d>\n",
@@ -84,6 +84,17 @@ Operation *Operation::create(Location location, OperationName name,
                              DictionaryAttr attributes,
                              OpaqueProperties properties, BlockRange successors,
                              unsigned numRegions) {
+  return create(location, name, resultTypes, operands, attributes, properties,
+                successors, numRegions, /*operandCapacity=*/operands.size());
+}
+
+/// Overload of create that additionally reserves inline storage for operands
+/// that are filled in after creation.
+Operation *Operation::create(Location location, OperationName name,
+                             TypeRange resultTypes, ValueRange operands,
+                             DictionaryAttr attributes,
+                             OpaqueProperties properties, BlockRange successors,
+                             unsigned numRegions, unsigned operandCapacity) {
   assert(llvm::all_of(resultTypes, [](Type t) { return t; }) &&
          "unexpected null result type");
 
@@ -97,8 +108,10 @@ Operation *Operation::create(Location location, OperationName name,
 
   // If the operation is known to have no operands, don't allocate an operand
   // storage.
-  bool needsOperandStorage =
-      operands.empty() ? !name.hasTrait<OpTrait::ZeroOperands>() : true;
+  operandCapacity = std::max(operandCapacity, numOperands);
+  bool needsOperandStorage = operandCapacity == 0
+                                 ? !name.hasTrait<OpTrait::ZeroOperands>()
+                                 : true;
 
   // Compute the byte size for the operation and the operand storage. This takes
   // into account the size of the operation, its trailing objects, and its
@@ -107,7 +120,7 @@ Operation *Operation::create(Location location, OperationName name,
       totalSizeToAlloc<detail::OperandStorage, detail::OpProperties,
                        BlockOperand, Region, OpOperand>(
           needsOperandStorage ? 1 : 0, opPropertiesAllocSize, numSuccessors,
-          numRegions, numOperands);
+          numRegions, operandCapacity);
   size_t prefixByteSize = llvm::alignTo(
       Operation::prefixAllocSize(numTrailingResults, numInlineResults),
       alignof(Operation));
@@ -138,7 +151,7 @@ Operation *Operation::create(Location location, OperationName name,
   // Initialize the operands.
   if (needsOperandStorage) {
     new (&op->getOperandStorage()) detail::OperandStorage(
-        op, op->getTrailingObjects<OpOperand>(), operands);
+        op, op->getTrailingObjects<OpOperand>(), operands, operandCapacity);
   }
 
   // Initialize the successors.
@@ -730,9 +743,13 @@ Operation *Operation::clone(IRMapping &mapper, CloneOptions options) {
   for (Block *successor : getSuccessors())
     successors.push_back(mapper.lookupOrDefault(successor));
 
-  // Create the new operation.
-  auto *newOp = create(getLoc(), getName(), getResultTypes(), operands, attrs,
-                       getPropertiesStorage(), successors, getNumRegions());
+  // Create the new operation. When the operands are patched in later (e.g. by
+  // Region::cloneInto once all referenced values have been mapped), reserve
+  // inline storage for them now so that the patching does not reallocate.
+  auto *newOp =
+      create(getLoc(), getName(), getResultTypes(), operands, attrs,
+             getPropertiesStorage(), successors, getNumRegions(),
+             /*operandCapacity=*/getNumOperands());
   mapper.map(this, newOp);
 
   // Clone the regions.
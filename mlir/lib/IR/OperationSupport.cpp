@@ -238,9 +238,13 @@ void OperationState::addRegions(
 
 detail::OperandStorage::OperandStorage(Operation *owner,
                                        OpOperand *trailingOperands,
-                                       ValueRange values)
+                                       ValueRange values,
+                                       unsigned inlineCapacity)
     : isStorageDynamic(false), operandStorage(trailingOperands) {
-  numOperands = capacity = values.size();
+  assert(inlineCapacity >= values.size() &&
+         "expected the inline capacity to cover the initial operands");
+  numOperands = values.size();
+  capacity = inlineCapacity;
   for (unsigned i = 0; i < numOperands; ++i)
     new (&operandStorage[i]) OpOperand(owner, values[i]);
 }
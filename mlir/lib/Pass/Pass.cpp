@@ -962,16 +962,23 @@ void detail::NestedAnalysisMap::invalidate(
     return;
   }
 
-  // Otherwise, invalidate each child analysis map.
-  SmallVector<NestedAnalysisMap *, 8> mapsToInvalidate(1, this);
-  while (!mapsToInvalidate.empty()) {
-    auto *map = mapsToInvalidate.pop_back_val();
-    for (auto &analysisPair : map->childAnalyses) {
-      analysisPair.second->invalidate(pa);
-      if (!analysisPair.second->childAnalyses.empty())
+  // Otherwise, invalidate each child analysis map. The maps of sibling
+  // subtrees are disjoint, so they can be processed concurrently. This takes
+  // the invalidation of large nested analysis caches off the critical path
+  // between two passes.
+  MLIRContext *context = getOperation()->getContext();
+  parallelForEach(context, childAnalyses, [&](auto &childEntry) {
+    // Walk the subtree iteratively, invalidating the analyses of each map
+    // exactly once.
+    SmallVector<NestedAnalysisMap *, 8> mapsToInvalidate(
+        1, childEntry.second.get());
+    while (!mapsToInvalidate.empty()) {
+      NestedAnalysisMap *map = mapsToInvalidate.pop_back_val();
+      map->analyses.invalidate(pa);
+      for (auto &analysisPair : map->childAnalyses)
         mapsToInvalidate.push_back(analysisPair.second.get());
     }
-  }
+  });
 }
 
 //===----------------------------------------------------------------------===//
@@ -195,6 +195,7 @@ public:
             SmallVectorImpl<ByteCodeField> &matcherByteCode,
             SmallVectorImpl<ByteCodeField> &rewriterByteCode,
             SmallVectorImpl<PDLByteCodePattern> &patterns,
+            std::vector<DenseMap<OperationName, size_t>> &opNameSwitchTables,
             ByteCodeField &maxValueMemoryIndex,
             ByteCodeField &maxOpRangeMemoryIndex,
             ByteCodeField &maxTypeRangeMemoryIndex,
@@ -205,6 +206,7 @@ public:
             const DenseMap<Operation *, PDLPatternConfigSet *> &configMap)
       : ctx(ctx), uniquedData(uniquedData), matcherByteCode(matcherByteCode),
         rewriterByteCode(rewriterByteCode), patterns(patterns),
+        opNameSwitchTables(opNameSwitchTables),
         maxValueMemoryIndex(maxValueMemoryIndex),
         maxOpRangeMemoryIndex(maxOpRangeMemoryIndex),
         maxTypeRangeMemoryIndex(maxTypeRangeMemoryIndex),
@@ -332,6 +334,7 @@ private:
   SmallVectorImpl<ByteCodeField> &matcherByteCode;
   SmallVectorImpl<ByteCodeField> &rewriterByteCode;
   SmallVectorImpl<PDLByteCodePattern> &patterns;
+  std::vector<DenseMap<OperationName, size_t>> &opNameSwitchTables;
   ByteCodeField &maxValueMemoryIndex;
   ByteCodeField &maxOpRangeMemoryIndex;
   ByteCodeField &maxTypeRangeMemoryIndex;
@@ -1028,11 +1031,19 @@ void Generator::generate(pdl_interp::SwitchOperandCountOp op,
 }
 void Generator::generate(pdl_interp::SwitchOperationNameOp op,
                          ByteCodeWriter &writer) {
-  auto cases = llvm::map_range(op.getCaseValuesAttr(), [&](Attribute attr) {
-    return OperationName(cast<StringAttr>(attr).getValue(), ctx);
-  });
-  writer.append(OpCode::SwitchOperationName, op.getInputOp(), cases,
-                op.getSuccessors());
+  // Operation name switches tend to be the widest switches in a matcher (the
+  // root dispatch of the combined matcher has a case per distinct root op
+  // name), so instead of encoding the cases inline for a linear scan at
+  // execution time, build a lookup table from case value to successor index.
+  // The first case name wins on duplicates, matching the scan semantics.
+  DenseMap<OperationName, size_t> table;
+  for (const auto &it : llvm::enumerate(op.getCaseValuesAttr()))
+    table.try_emplace(
+        OperationName(cast<StringAttr>(it.value()).getValue(), ctx),
+        it.index() + 1);
+  writer.append(OpCode::SwitchOperationName, op.getInputOp(),
+                ByteCodeField(opNameSwitchTables.size()), op.getSuccessors());
+  opNameSwitchTables.push_back(std::move(table));
 }
 void Generator::generate(pdl_interp::SwitchResultCountOp op,
                          ByteCodeWriter &writer) {
@@ -1059,9 +1070,10 @@ PDLByteCode::PDLByteCode(
     llvm::StringMap<PDLRewriteFunction> rewriteFns)
     : configs(std::move(configs)) {
   Generator generator(module.getContext(), uniquedData, matcherByteCode,
-                      rewriterByteCode, patterns, maxValueMemoryIndex,
-                      maxOpRangeCount, maxTypeRangeCount, maxValueRangeCount,
-                      maxLoopLevel, constraintFns, rewriteFns, configMap);
+                      rewriterByteCode, patterns, opNameSwitchTables,
+                      maxValueMemoryIndex, maxOpRangeCount, maxTypeRangeCount,
+                      maxValueRangeCount, maxLoopLevel, constraintFns,
+                      rewriteFns, configMap);
   generator.generate(module);
 
   // Initialize the external functions.
@@ -1125,7 +1137,8 @@ public:
       ArrayRef<PatternBenefit> currentPatternBenefits,
       ArrayRef<PDLByteCodePattern> patterns,
       ArrayRef<PDLConstraintFunction> constraintFunctions,
-      ArrayRef<PDLRewriteFunction> rewriteFunctions)
+      ArrayRef<PDLRewriteFunction> rewriteFunctions,
+      ArrayRef<DenseMap<OperationName, size_t>> opNameSwitchTables)
       : curCodeIt(curCodeIt), memory(memory), opRangeMemory(opRangeMemory),
         typeRangeMemory(typeRangeMemory),
         allocatedTypeRangeMemory(allocatedTypeRangeMemory),
@@ -1134,7 +1147,8 @@ public:
         loopIndex(loopIndex), uniquedMemory(uniquedMemory), code(code),
         currentPatternBenefits(currentPatternBenefits), patterns(patterns),
         constraintFunctions(constraintFunctions),
-        rewriteFunctions(rewriteFunctions) {}
+        rewriteFunctions(rewriteFunctions),
+        opNameSwitchTables(opNameSwitchTables) {}
 
   /// Start executing the code at the current bytecode index. `matches` is an
   /// optional field provided when this function is executed in a matching
@@ -1419,6 +1433,7 @@ private:
   ArrayRef<PDLByteCodePattern> patterns;
   ArrayRef<PDLConstraintFunction> constraintFunctions;
   ArrayRef<PDLRewriteFunction> rewriteFunctions;
+  ArrayRef<DenseMap<OperationName, size_t>> opNameSwitchTables;
 };
 } // namespace
 
@@ -2112,31 +2127,18 @@ void ByteCodeExecutor::executeSwitchOperandCount() {
 void ByteCodeExecutor::executeSwitchOperationName() {
   LLVM_DEBUG(llvm::dbgs() << "Executing SwitchOperationName:\n");
   OperationName value = read<Operation *>()->getName();
-  size_t caseCount = read();
+  const DenseMap<OperationName, size_t> &table = opNameSwitchTables[read()];
 
-  // The operation names are stored in-line, so to print them out for
-  // debugging purposes we need to read the array before executing the
-  // switch so that we can display all of the possible values.
   LLVM_DEBUG({
-    const ByteCodeField *prevCodeIt = curCodeIt;
     llvm::dbgs() << "  * Value: " << value << "\n"
                  << "  * Cases: ";
-    llvm::interleaveComma(
-        llvm::map_range(llvm::seq<size_t>(0, caseCount),
-                        [&](size_t) { return read<OperationName>(); }),
-        llvm::dbgs());
+    llvm::interleaveComma(llvm::make_first_range(table), llvm::dbgs());
     llvm::dbgs() << "\n";
-    curCodeIt = prevCodeIt;
   });
 
-  // Try to find the switch value within any of the cases.
-  for (size_t i = 0; i != caseCount; ++i) {
-    if (read<OperationName>() == value) {
-      curCodeIt += (caseCount - i - 1);
-      return selectJump(i + 1);
-    }
-  }
-  selectJump(size_t(0));
+  // Look the switch value up in the case table.
+  auto it = table.find(value);
+  selectJump(it == table.end() ? size_t(0) : it->second);
 }
 
 void ByteCodeExecutor::executeSwitchResultCount() {
@@ -2336,7 +2338,7 @@ void PDLByteCode::match(Operation *op, PatternRewriter &rewriter,
       state.typeRangeMemory, state.allocatedTypeRangeMemory,
       state.valueRangeMemory, state.allocatedValueRangeMemory, state.loopIndex,
       uniquedData, matcherByteCode, state.currentPatternBenefits, patterns,
-      constraintFunctions, rewriteFunctions);
+      constraintFunctions, rewriteFunctions, opNameSwitchTables);
   LogicalResult executeResult = executor.execute(rewriter, &matches);
   (void)executeResult;
   assert(succeeded(executeResult) && "unexpected matcher execution failure");
@@ -2365,7 +2367,7 @@ LogicalResult PDLByteCode::rewrite(PatternRewriter &rewriter,
       state.allocatedTypeRangeMemory, state.valueRangeMemory,
       state.allocatedValueRangeMemory, state.loopIndex, uniquedData,
       rewriterByteCode, state.currentPatternBenefits, patterns,
-      constraintFunctions, rewriteFunctions);
+      constraintFunctions, rewriteFunctions, opNameSwitchTables);
   LogicalResult result =
       executor.execute(rewriter, /*matches=*/nullptr, match.location);
 
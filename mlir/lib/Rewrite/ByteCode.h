@@ -201,6 +201,12 @@ private:
   /// A vector containing the generated bytecode for the matcher.
   SmallVector<ByteCodeField, 64> matcherByteCode;
 
+  /// Lookup tables for the operation name switches within the matcher
+  /// bytecode. Each SwitchOperationName instruction refers to one of these
+  /// tables by index and maps the name of the input operation to the index of
+  /// the successor to take, with 0 being the default successor.
+  std::vector<DenseMap<OperationName, size_t>> opNameSwitchTables;
+
   /// A vector containing the generated bytecode for all of the rewriters.
   SmallVector<ByteCodeField, 64> rewriterByteCode;
 
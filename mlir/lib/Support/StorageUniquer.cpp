@@ -85,6 +85,24 @@ private:
 #if LLVM_ENABLE_THREADS != 0
     /// A mutex to keep uniquing thread-safe.
     llvm::sys::SmartRWMutex<true> mutex;
+
+    /// An immutable snapshot of `instances` that readers may search without
+    /// taking the mutex. Published by writers with release semantics; storage
+    /// instances reachable through the snapshot are fully constructed.
+    std::atomic<StorageTypeSet *> snapshot{nullptr};
+
+    /// The size of `instances` when `snapshot` was last published. Guarded by
+    /// `mutex`.
+    size_t snapshotSize = 0;
+
+    /// Previously published snapshots. Readers may still be searching an old
+    /// snapshot when a new one is published, so reclamation is deferred until
+    /// the shard is destroyed. The geometric publishing policy bounds the
+    /// retired memory by a constant factor of the live set. Guarded by
+    /// `mutex`.
+    std::vector<std::unique_ptr<StorageTypeSet>> retiredSnapshots;
+
+    ~Shard() { delete snapshot.load(std::memory_order_relaxed); }
 #endif
   };
 
@@ -145,6 +163,16 @@ public:
     if (localInst)
       return localInst;
 
+    // Check the published read-only snapshot of the shard. The snapshot is
+    // immutable, so no lock is needed; instances created after it was
+    // published are only findable through the locked paths below.
+    if (StorageTypeSet *snapshot =
+            shard.snapshot.load(std::memory_order_acquire)) {
+      auto it = snapshot->find_as(lookupKey);
+      if (it != snapshot->end())
+        return localInst = it->storage;
+    }
+
     // Check for an existing instance in read-only mode.
     {
       llvm::sys::SmartScopedReader<true> typeLock(shard.mutex);
@@ -156,7 +184,20 @@ public:
     // Acquire a writer-lock so that we can safely create the new storage
     // instance.
     llvm::sys::SmartScopedWriter<true> typeLock(shard.mutex);
-    return localInst = getOrCreateUnsafe(shard, lookupKey, ctorFn);
+    localInst = getOrCreateUnsafe(shard, lookupKey, ctorFn);
+
+    // Republish the snapshot once the live set has grown enough since the
+    // last publication. Doubling amortizes the copy to a constant cost per
+    // insertion and bounds the memory retired over the lifetime of the shard.
+    size_t numInstances = shard.instances.size();
+    if (numInstances >= 16 && numInstances >= 2 * shard.snapshotSize) {
+      auto *newSnapshot = new StorageTypeSet(shard.instances);
+      StorageTypeSet *oldSnapshot =
+          shard.snapshot.exchange(newSnapshot, std::memory_order_acq_rel);
+      shard.retiredSnapshots.emplace_back(oldSnapshot);
+      shard.snapshotSize = numInstances;
+    }
+    return localInst;
   }
 
   /// Run a mutation function on the provided storage object in a thread-safe
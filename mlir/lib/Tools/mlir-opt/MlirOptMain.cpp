@@ -38,6 +38,7 @@
 #include "mlir/Tools/Plugins/DialectPlugin.h"
 #include "mlir/Tools/Plugins/PassPlugin.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Alignment.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/InitLLVM.h"
@@ -653,9 +654,12 @@ LogicalResult mlir::MlirOptMain(int argc, char **argv,
     llvm::errs() << "(processing input from stdin now, hit ctrl-c/ctrl-d to "
                     "interrupt)\n";
 
-  // Set up the input file.
+  // Set up the input file. Open it with an alignment suitable for referencing
+  // bytecode resource blobs in place (e.g. as mmap-backed dense element
+  // payloads consumed directly by vectorized code), instead of copying them
+  // into the context.
   std::string errorMessage;
-  auto file = openInputFile(inputFilename, &errorMessage);
+  auto file = openInputFile(inputFilename, llvm::Align(64), &errorMessage);
   if (!file) {
     llvm::errs() << errorMessage << "\n";
     return failure();
@@ -16,9 +16,11 @@
 #include "mlir/IR/Iterators.h"
 #include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -325,6 +327,11 @@ public:
 
   static bool classof(const IRRewrite *rewrite) { return true; }
 
+  /// The size of the derived rewrite object's allocation. Set when the rewrite
+  /// is created and used to recycle the memory when the rewrite is discarded
+  /// during rollback.
+  size_t allocSize = 0;
+
 protected:
   IRRewrite(Kind kind, ConversionPatternRewriterImpl &rewriterImpl)
       : kind(kind), rewriterImpl(rewriterImpl) {}
@@ -821,7 +828,7 @@ private:
 template <typename RewriteTy, typename R>
 static bool hasRewrite(R &&rewrites, Operation *op) {
   return any_of(std::forward<R>(rewrites), [&](auto &rewrite) {
-    auto *rewriteTy = dyn_cast<RewriteTy>(rewrite.get());
+    auto *rewriteTy = dyn_cast<RewriteTy>(rewrite);
     return rewriteTy && rewriteTy->getOperation() == op;
   });
 }
@@ -831,7 +838,7 @@ static bool hasRewrite(R &&rewrites, Operation *op) {
 template <typename RewriteTy, typename R>
 static bool hasRewrite(R &&rewrites, Block *block) {
   return any_of(std::forward<R>(rewrites), [&](auto &rewrite) {
-    auto *rewriteTy = dyn_cast<RewriteTy>(rewrite.get());
+    auto *rewriteTy = dyn_cast<RewriteTy>(rewrite);
     return rewriteTy && rewriteTy->getBlock() == block;
   });
 }
@@ -847,6 +854,13 @@ struct ConversionPatternRewriterImpl : public RewriterBase::Listener {
                                          const ConversionConfig &config)
       : context(ctx), eraseRewriter(ctx), config(config) {}
 
+  ~ConversionPatternRewriterImpl() override {
+    // The rewrites are arena-allocated; their destructors do not run when the
+    // allocator releases the underlying memory.
+    for (IRRewrite *rewrite : rewrites)
+      rewrite->~IRRewrite();
+  }
+
   //===--------------------------------------------------------------------===//
   // State Management
   //===--------------------------------------------------------------------===//
@@ -865,8 +879,29 @@ struct ConversionPatternRewriterImpl : public RewriterBase::Listener {
   /// failure.
   template <typename RewriteTy, typename... Args>
   void appendRewrite(Args &&...args) {
-    rewrites.push_back(
-        std::make_unique<RewriteTy>(*this, std::forward<Args>(args)...));
+    // Prefer reusing the allocation of a previously discarded rewrite of the
+    // same size over growing the arena.
+    void *mem = nullptr;
+    auto it = freeRewriteMemory.find(sizeof(RewriteTy));
+    if (it != freeRewriteMemory.end() && !it->second.empty())
+      mem = it->second.pop_back_val();
+    else
+      mem = rewriteAllocator.Allocate(sizeof(RewriteTy),
+                                      alignof(std::max_align_t));
+    auto *rewrite = new (mem) RewriteTy(*this, std::forward<Args>(args)...);
+    rewrite->allocSize = sizeof(RewriteTy);
+    rewrites.push_back(rewrite);
+  }
+
+  /// Destroy the given rewrite and make its allocation available for reuse by
+  /// a subsequent rewrite of the same size. Pattern applications that fail
+  /// legalization roll back and discard their rewrites at a high rate; without
+  /// recycling, the arena would grow with the number of attempted rewrites
+  /// instead of the number of surviving ones.
+  void recycleRewrite(IRRewrite *rewrite) {
+    size_t size = rewrite->allocSize;
+    rewrite->~IRRewrite();
+    freeRewriteMemory[size].push_back(rewrite);
   }
 
   /// Undo the rewrites (motions, splits) one by one in reverse order until
@@ -1021,8 +1056,19 @@ struct ConversionPatternRewriterImpl : public RewriterBase::Listener {
   // replacing a value with one of a different type.
   ConversionValueMapping mapping;
 
-  /// Ordered list of block operations (creations, splits, motions).
-  SmallVector<std::unique_ptr<IRRewrite>> rewrites;
+  /// Allocator for the IRRewrite objects. Rewrites are created at a very high
+  /// rate during a conversion and all share the lifetime of this rewriter, so
+  /// they are allocated from one arena instead of with individual mallocs.
+  llvm::BumpPtrAllocator rewriteAllocator;
+
+  /// Allocations of discarded rewrites, bucketed by size and available for
+  /// reuse by `appendRewrite`.
+  llvm::SmallDenseMap<size_t, SmallVector<void *>> freeRewriteMemory;
+
+  /// Ordered list of block operations (creations, splits, motions). The
+  /// pointees are owned by `rewriteAllocator`; destructors are run explicitly
+  /// when rewrites are discarded.
+  SmallVector<IRRewrite *> rewrites;
 
   /// A set of operations that should no longer be considered for legalization.
   /// E.g., ops that are recursively legal. Ops that were replaced/erased are
@@ -1187,9 +1233,13 @@ void ConversionPatternRewriterImpl::applyRewrites() {
   for (size_t i = 0; i < rewrites.size(); ++i)
     rewrites[i]->commit(rewriter);
 
-  // Clean up all rewrites.
-  for (auto &rewrite : rewrites)
+  // Clean up all rewrites. The arena keeps the underlying memory alive until
+  // this rewriter is destroyed, but the destructors must be run here.
+  for (IRRewrite *rewrite : rewrites)
     rewrite->cleanup(eraseRewriter);
+  for (IRRewrite *rewrite : rewrites)
+    rewrite->~IRRewrite();
+  rewrites.clear();
 }
 
 //===----------------------------------------------------------------------===//
@@ -1212,9 +1262,11 @@ void ConversionPatternRewriterImpl::resetState(RewriterState state) {
 }
 
 void ConversionPatternRewriterImpl::undoRewrites(unsigned numRewritesToKeep) {
-  for (auto &rewrite :
-       llvm::reverse(llvm::drop_begin(rewrites, numRewritesToKeep)))
+  for (IRRewrite *rewrite :
+       llvm::reverse(llvm::drop_begin(rewrites, numRewritesToKeep))) {
     rewrite->rollback();
+    recycleRewrite(rewrite);
+  }
   rewrites.resize(numRewritesToKeep);
 }
 
@@ -1815,13 +1867,14 @@ void ConversionPatternRewriter::cancelOpModification(Operation *op) {
          "operation did not have a pending in-place update");
 #endif
   // Erase the last update for this operation.
-  auto it = llvm::find_if(
-      llvm::reverse(impl->rewrites), [&](std::unique_ptr<IRRewrite> &rewrite) {
-        auto *modifyRewrite = dyn_cast<ModifyOperationRewrite>(rewrite.get());
+  auto it =
+      llvm::find_if(llvm::reverse(impl->rewrites), [&](IRRewrite *rewrite) {
+        auto *modifyRewrite = dyn_cast<ModifyOperationRewrite>(rewrite);
         return modifyRewrite && modifyRewrite->getOperation() == op;
       });
   assert(it != impl->rewrites.rend() && "no root update started on op");
   (*it)->rollback();
+  impl->recycleRewrite(*it);
   int updateIdx = std::prev(impl->rewrites.rend()) - it;
   impl->rewrites.erase(impl->rewrites.begin() + updateIdx);
 }
@@ -2110,7 +2163,7 @@ OperationLegalizer::legalizeWithFold(Operation *op,
   for (unsigned i = curState.numRewrites, e = rewriterImpl.rewrites.size();
        i != e; ++i) {
     auto *createOp =
-        dyn_cast<CreateOperationRewrite>(rewriterImpl.rewrites[i].get());
+        dyn_cast<CreateOperationRewrite>(rewriterImpl.rewrites[i]);
     if (!createOp)
       continue;
     if (failed(legalize(createOp->getOperation(), rewriter))) {
@@ -2242,7 +2295,7 @@ LogicalResult OperationLegalizer::legalizePatternBlockRewrites(
   // If the pattern moved or created any blocks, make sure the types of block
   // arguments get legalized.
   for (int i = state.numRewrites, e = newState.numRewrites; i != e; ++i) {
-    BlockRewrite *rewrite = dyn_cast<BlockRewrite>(impl.rewrites[i].get());
+    BlockRewrite *rewrite = dyn_cast<BlockRewrite>(impl.rewrites[i]);
     if (!rewrite)
       continue;
     Block *block = rewrite->getBlock();
@@ -2276,7 +2329,7 @@ LogicalResult OperationLegalizer::legalizePatternBlockRewrites(
       for (unsigned i = state.numRewrites, e = impl.rewrites.size(); i != e;
            ++i) {
         auto *createOp =
-            dyn_cast<CreateOperationRewrite>(impl.rewrites[i].get());
+            dyn_cast<CreateOperationRewrite>(impl.rewrites[i]);
         if (!createOp)
           continue;
         operationsToIgnore.insert(createOp->getOperation());
@@ -2299,7 +2352,7 @@ LogicalResult OperationLegalizer::legalizePatternCreatedOperations(
     ConversionPatternRewriter &rewriter, ConversionPatternRewriterImpl &impl,
     RewriterState &state, RewriterState &newState) {
   for (int i = state.numRewrites, e = newState.numRewrites; i != e; ++i) {
-    auto *createOp = dyn_cast<CreateOperationRewrite>(impl.rewrites[i].get());
+    auto *createOp = dyn_cast<CreateOperationRewrite>(impl.rewrites[i]);
     if (!createOp)
       continue;
     Operation *op = createOp->getOperation();
@@ -2317,7 +2370,7 @@ LogicalResult OperationLegalizer::legalizePatternRootUpdates(
     ConversionPatternRewriter &rewriter, ConversionPatternRewriterImpl &impl,
     RewriterState &state, RewriterState &newState) {
   for (int i = state.numRewrites, e = newState.numRewrites; i != e; ++i) {
-    auto *rewrite = dyn_cast<ModifyOperationRewrite>(impl.rewrites[i].get());
+    auto *rewrite = dyn_cast<ModifyOperationRewrite>(impl.rewrites[i]);
     if (!rewrite)
       continue;
     Operation *op = rewrite->getOperation();
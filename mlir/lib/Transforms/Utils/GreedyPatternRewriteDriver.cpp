@@ -15,6 +15,7 @@
 #include "mlir/Config/mlir-config.h"
 #include "mlir/IR/Action.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
@@ -28,6 +29,8 @@
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <atomic>
+
 #ifdef MLIR_GREEDY_REWRITE_RANDOMIZER_SEED
 #include <random>
 #endif // MLIR_GREEDY_REWRITE_RANDOMIZER_SEED
@@ -790,15 +793,66 @@ public:
   LogicalResult simplify(bool *changed) &&;
 
 private:
+  /// The pattern set, kept around so that independent sub-rewrites can be
+  /// spawned for nested isolated-from-above ops.
+  const FrozenRewritePatternSet &patterns;
+
   /// The region that is simplified.
   Region &region;
 };
 } // namespace
 
+/// Collect the topmost ops nested under `region` that are isolated from above
+/// and have a non-empty region. The body of such an op cannot refer to values
+/// defined outside of it, so it can be simplified independently of (and
+/// concurrently with) the rest of `region`.
+static void collectShardRoots(Region &region,
+                              SmallVectorImpl<Operation *> &shardRoots) {
+  region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+    if (op->hasTrait<OpTrait::IsIsolatedFromAbove>() &&
+        llvm::any_of(op->getRegions(),
+                     [](Region &r) { return !r.empty(); })) {
+      shardRoots.push_back(op);
+      return WalkResult::skip();
+    }
+    return WalkResult::advance();
+  });
+}
+
+/// Visit `op` and all ops nested within it, except for the bodies of the
+/// given shard root ops. `callback` returns whether the regions of an op
+/// should be visited (pre-order walks only).
+static void
+walkSkippingShardBodies(Operation *op,
+                        const llvm::SmallDenseSet<Operation *, 4> &shardRoots,
+                        bool preOrder,
+                        function_ref<bool(Operation *)> callback) {
+  if (preOrder && !callback(op))
+    return;
+  if (!shardRoots.contains(op))
+    for (Region &region : op->getRegions())
+      for (Block &block : region)
+        for (Operation &nested : llvm::make_early_inc_range(block))
+          walkSkippingShardBodies(&nested, shardRoots, preOrder, callback);
+  if (!preOrder)
+    callback(op);
+}
+
+static void
+walkSkippingShardBodies(Region &region,
+                        const llvm::SmallDenseSet<Operation *, 4> &shardRoots,
+                        bool preOrder,
+                        function_ref<bool(Operation *)> callback) {
+  for (Block &block : region)
+    for (Operation &op : llvm::make_early_inc_range(block))
+      walkSkippingShardBodies(&op, shardRoots, preOrder, callback);
+}
+
 RegionPatternRewriteDriver::RegionPatternRewriteDriver(
     MLIRContext *ctx, const FrozenRewritePatternSet &patterns,
     const GreedyRewriteConfig &config, Region &region)
-    : GreedyPatternRewriteDriver(ctx, patterns, config), region(region) {
+    : GreedyPatternRewriteDriver(ctx, patterns, config), patterns(patterns),
+      region(region) {
   // Populate strict mode ops.
   if (config.strictMode != GreedyRewriteStrictness::AnyOp) {
     region.walk([&](Operation *op) { strictModeFilteredOps.insert(op); });
@@ -827,6 +881,46 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
   bool continueRewrites = false;
   int64_t iteration = 0;
   MLIRContext *ctx = rewriter.getContext();
+
+  // Shard the rewrite at isolated-from-above boundaries: the body of an op
+  // that is isolated from above cannot interact with the surrounding IR other
+  // than through the op itself, so it can be brought to a fixpoint by an
+  // independent greedy rewrite that runs concurrently with the rewrites of the
+  // sibling shards. The worklist population of the first iteration then skips
+  // the shard bodies; any shard op that is touched by a later rewrite is
+  // re-enqueued through the usual listener notifications. Sharding is not
+  // attempted when a listener is attached (it would be notified from multiple
+  // threads) or in strict mode (the filter set is op-based, not region-based).
+  bool shardsChanged = false;
+  bool shardsConverged = true;
+  llvm::SmallDenseSet<Operation *, 4> shardRoots;
+  if (ctx->isMultithreadingEnabled() && !config.listener &&
+      config.strictMode == GreedyRewriteStrictness::AnyOp) {
+    SmallVector<Operation *> roots;
+    collectShardRoots(region, roots);
+    if (roots.size() > 1) {
+      std::atomic<bool> anyShardChanged(false);
+      std::atomic<bool> anyShardDiverged(false);
+      parallelForEach(ctx, roots, [&](Operation *root) {
+        for (Region &shard : root->getRegions()) {
+          if (shard.empty())
+            continue;
+          GreedyRewriteConfig shardConfig = config;
+          shardConfig.scope = &shard;
+          bool shardChanged = false;
+          if (failed(applyPatternsGreedily(shard, patterns, shardConfig,
+                                           &shardChanged)))
+            anyShardDiverged = true;
+          if (shardChanged)
+            anyShardChanged = true;
+        }
+      });
+      shardsChanged = anyShardChanged;
+      shardsConverged = !anyShardDiverged;
+      shardRoots.insert(roots.begin(), roots.end());
+    }
+  }
+
   do {
     // Check if the iteration limit was reached.
     if (++iteration > config.maxIterations &&
@@ -849,21 +943,40 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
       return false;
     };
 
+    // The bodies of the shards are already at a fixpoint; skip them when
+    // populating the worklist of the first iteration. Later iterations walk
+    // the entire region again: region simplification may have modified shard
+    // bodies without re-enqueuing the affected ops.
+    bool skipShardBodies = iteration == 1 && !shardRoots.empty();
     if (!config.useTopDownTraversal) {
       // Add operations to the worklist in postorder.
-      region.walk([&](Operation *op) {
+      auto visitPostOrder = [&](Operation *op) {
         if (!config.cseConstants || !insertKnownConstant(op))
           addToWorklist(op);
-      });
+        return true;
+      };
+      if (skipShardBodies)
+        walkSkippingShardBodies(region, shardRoots, /*preOrder=*/false,
+                                visitPostOrder);
+      else
+        region.walk([&](Operation *op) { visitPostOrder(op); });
     } else {
       // Add all nested operations to the worklist in preorder.
-      region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+      auto visitPreOrder = [&](Operation *op) {
         if (!config.cseConstants || !insertKnownConstant(op)) {
           addToWorklist(op);
-          return WalkResult::advance();
+          return true;
         }
-        return WalkResult::skip();
-      });
+        return false;
+      };
+      if (skipShardBodies)
+        walkSkippingShardBodies(region, shardRoots, /*preOrder=*/true,
+                                visitPreOrder);
+      else
+        region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+          return visitPreOrder(op) ? WalkResult::advance()
+                                   : WalkResult::skip();
+        });
 
       // Reverse the list so our pop-back loop processes them in-order.
       worklist.reverse();
@@ -887,10 +1000,10 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
   } while (continueRewrites);
 
   if (changed)
-    *changed = iteration > 1;
+    *changed = iteration > 1 || shardsChanged;
 
   // Whether the rewrite converges, i.e. wasn't changed in the last iteration.
-  return success(!continueRewrites);
+  return success(!continueRewrites && shardsConverged);
 }
 
 LogicalResult
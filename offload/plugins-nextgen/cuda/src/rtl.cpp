@@ -12,7 +12,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <cuda.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -259,7 +261,10 @@ struct CUDADeviceTy : public GenericDeviceTy {
   // Create a CUDA device with a device id and the default CUDA grid values.
   CUDADeviceTy(GenericPluginTy &Plugin, int32_t DeviceId, int32_t NumDevices)
       : GenericDeviceTy(Plugin, DeviceId, NumDevices, NVPTXGridValues),
-        CUDAStreamManager(*this), CUDAEventManager(*this) {}
+        CUDAStreamManager(*this), CUDAEventManager(*this),
+        OMPX_MaxStagingCopyBytes("LIBOMPTARGET_CUDA_MAX_STAGING_COPY_BYTES",
+                                 1024 * 1024),
+        OMPX_NumStagingBuffers("LIBOMPTARGET_CUDA_NUM_STAGING_BUFFERS", 16) {}
 
   ~CUDADeviceTy() {}
 
@@ -358,6 +363,11 @@ struct CUDADeviceTy : public GenericDeviceTy {
         return Err;
     }
 
+    // Release the staging buffers before tearing down the stream manager;
+    // any copy they staged has been synchronized by now.
+    if (auto Err = StagingBuffers.deinit())
+      return Err;
+
     // Deinitialize the stream manager.
     if (auto Err = CUDAStreamManager.deinit())
       return Err;
@@ -809,6 +819,28 @@ struct CUDADeviceTy : public GenericDeviceTy {
     if (auto Err = getStream(AsyncInfoWrapper, Stream))
       return Err;
 
+    // Stage small copies through a page-locked buffer. An asynchronous copy
+    // from pageable host memory forces the driver to stage the transfer
+    // internally and often to synchronize, which serializes fragmented small
+    // submits; a copy from pinned memory stays truly asynchronous.
+    if (Size <= (int64_t)OMPX_MaxStagingCopyBytes) {
+      if (auto *Buffer = StagingBuffers.acquire(OMPX_MaxStagingCopyBytes,
+                                                OMPX_NumStagingBuffers)) {
+        std::memcpy(Buffer->HstPtr, HstPtr, Size);
+        CUresult Res =
+            cuMemcpyHtoDAsync((CUdeviceptr)TgtPtr, Buffer->HstPtr, Size, Stream);
+        if (auto Err = Plugin::check(Res, "Error in cuMemcpyHtoDAsync: %s")) {
+          StagingBuffers.release(Buffer);
+          return Err;
+        }
+        // The buffer may be handed out again once this event has fired.
+        Res = cuEventRecord(Buffer->Event, Stream);
+        StagingBuffers.release(Buffer);
+        return Plugin::check(Res, "Error in cuEventRecord: %s");
+      }
+      // No staging buffer ready; fall back to the direct copy.
+    }
+
     CUresult Res = cuMemcpyHtoDAsync((CUdeviceptr)TgtPtr, HstPtr, Size, Stream);
     return Plugin::check(Res, "Error in cuMemcpyHtoDAsync: %s");
   }
@@ -1249,6 +1281,88 @@ private:
   /// Event manager for CUDA events.
   CUDAEventManagerTy CUDAEventManager;
 
+  /// A pool of page-locked buffers used to stage small host-to-device copies
+  /// (see dataSubmitImpl). Each buffer owns an event recorded right after its
+  /// copy is enqueued; a buffer is only handed out again once that event has
+  /// fired, so a pending transfer can never read a recycled buffer.
+  struct CUDAStagingBufferPoolTy {
+    struct BufferTy {
+      void *HstPtr;
+      CUevent Event;
+    };
+
+    /// Take a buffer whose previous copy (if any) has completed. Returns
+    /// nullptr if no buffer is ready and the pool already holds MaxNumBuffers
+    /// buffers; the caller then falls back to a direct copy.
+    BufferTy *acquire(size_t BufferSize, uint32_t MaxNumBuffers) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      for (size_t I = 0, E = Available.size(); I < E; ++I) {
+        // A buffer that was never recorded reports completion as well.
+        if (cuEventQuery(Available[I]->Event) == CUDA_SUCCESS) {
+          BufferTy *Buffer = Available[I];
+          Available[I] = Available.back();
+          Available.pop_back();
+          return Buffer;
+        }
+      }
+      if (AllBuffers.size() >= MaxNumBuffers)
+        return nullptr;
+
+      auto Buffer = std::make_unique<BufferTy>();
+      if (cuMemAllocHost(&Buffer->HstPtr, BufferSize) != CUDA_SUCCESS)
+        return nullptr;
+      if (cuEventCreate(&Buffer->Event, CU_EVENT_DEFAULT) != CUDA_SUCCESS) {
+        cuMemFreeHost(Buffer->HstPtr);
+        return nullptr;
+      }
+      AllBuffers.push_back(std::move(Buffer));
+      return AllBuffers.back().get();
+    }
+
+    /// Return a buffer to the pool. The caller must have recorded the
+    /// buffer's event after enqueuing the copy, or left the copy unissued.
+    void release(BufferTy *Buffer) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Available.push_back(Buffer);
+    }
+
+    /// Destroy all buffers. Requires the device context to be set and all
+    /// pending copies to have completed.
+    Error deinit() {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      for (auto &Buffer : AllBuffers) {
+        CUresult Res = cuEventDestroy(Buffer->Event);
+        if (auto Err = Plugin::check(Res, "Error in cuEventDestroy: %s"))
+          return Err;
+        Res = cuMemFreeHost(Buffer->HstPtr);
+        if (auto Err = Plugin::check(Res, "Error in cuMemFreeHost: %s"))
+          return Err;
+      }
+      AllBuffers.clear();
+      Available.clear();
+      return Plugin::success();
+    }
+
+  private:
+    /// Mutex guarding both buffer lists.
+    std::mutex Mutex;
+
+    /// Buffers currently not handed out to a transfer.
+    llvm::SmallVector<BufferTy *> Available;
+
+    /// All buffers ever created, for cleanup.
+    llvm::SmallVector<std::unique_ptr<BufferTy>> AllBuffers;
+  };
+
+  /// Staging buffers for small host-to-device copies.
+  CUDAStagingBufferPoolTy StagingBuffers;
+
+  /// Largest copy routed through the staging buffers; also their size.
+  UInt32Envar OMPX_MaxStagingCopyBytes;
+
+  /// Maximum number of staging buffers per device.
+  UInt32Envar OMPX_NumStagingBuffers;
+
   /// The device's context. This context should be set before performing
   /// operations on the device.
   CUcontext Context = nullptr;
@@ -2829,6 +2829,9 @@ typedef struct kmp_base_thread_data {
 
 #define TASK_DEQUE_SIZE(td) ((td).td_deque_size)
 #define TASK_DEQUE_MASK(td) ((td).td_deque_size - 1)
+// Upper bound on the number of extra tasks a thief moves to its own deque per
+// steal (see __kmp_steal_task)
+#define TASK_STEAL_BATCH_MAX 8
 
 typedef union KMP_ALIGN_CACHE kmp_thread_data {
   kmp_base_thread_data_t td;
@@ -3440,6 +3443,7 @@ extern int __kmp_env_stksize; /* was KMP_STACKSIZE specified? */
 extern int __kmp_env_blocktime; /* was KMP_BLOCKTIME specified? */
 extern int __kmp_env_checks; /* was KMP_CHECKS specified?    */
 extern int __kmp_env_consistency_check; // was KMP_CONSISTENCY_CHECK specified?
+extern int __kmp_env_barrier_pattern; // was KMP_*_BARRIER_PATTERN specified?
 extern int __kmp_generate_warnings; /* should we issue warnings? */
 extern int __kmp_reserve_warn; /* have we issued reserve_threads warning? */
 
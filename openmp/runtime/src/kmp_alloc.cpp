@@ -1618,7 +1618,12 @@ void *__kmp_alloc(int gtid, size_t algn, size_t size,
       } else if (allocator == omp_large_cap_mem_alloc && mk_dax_kmem_all) {
         ptr = kmp_mk_alloc(*mk_dax_kmem_all, desc.size_a);
       } else {
-        ptr = kmp_mk_alloc(*mk_default, desc.size_a);
+        // Default memory space: prefer the per-thread bget arena over
+        // memkind's global default kind. The arena is only ever touched by
+        // its owning thread, so with affinity enabled its pages land on the
+        // thread's NUMA node, and the hot path hits a thread-local free list
+        // instead of a shared heap.
+        ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
       }
     } else if (al->pool_size > 0) {
       // custom allocator with pool size requested
@@ -1629,7 +1634,7 @@ void *__kmp_alloc(int gtid, size_t algn, size_t size,
         KMP_TEST_THEN_ADD64((kmp_int64 *)&al->pool_used, -desc.size_a);
         if (al->fb == omp_atv_default_mem_fb) {
           al = (kmp_allocator_t *)omp_default_mem_alloc;
-          ptr = kmp_mk_alloc(*mk_default, desc.size_a);
+          ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
         } else if (al->fb == omp_atv_abort_fb) {
           KMP_ASSERT(0); // abort fallback requested
         } else if (al->fb == omp_atv_allocator_fb) {
@@ -1646,7 +1651,7 @@ void *__kmp_alloc(int gtid, size_t algn, size_t size,
         if (ptr == NULL) {
           if (al->fb == omp_atv_default_mem_fb) {
             al = (kmp_allocator_t *)omp_default_mem_alloc;
-            ptr = kmp_mk_alloc(*mk_default, desc.size_a);
+            ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
           } else if (al->fb == omp_atv_abort_fb) {
             KMP_ASSERT(0); // abort fallback requested
           } else if (al->fb == omp_atv_allocator_fb) {
@@ -1665,7 +1670,7 @@ void *__kmp_alloc(int gtid, size_t algn, size_t size,
       if (ptr == NULL) {
         if (al->fb == omp_atv_default_mem_fb) {
           al = (kmp_allocator_t *)omp_default_mem_alloc;
-          ptr = kmp_mk_alloc(*mk_default, desc.size_a);
+          ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
         } else if (al->fb == omp_atv_abort_fb) {
           KMP_ASSERT(0); // abort fallback requested
         } else if (al->fb == omp_atv_allocator_fb) {
@@ -1872,7 +1877,9 @@ void ___kmpc_free(int gtid, void *ptr, omp_allocator_handle_t allocator) {
       } else if (oal == omp_large_cap_mem_alloc && mk_dax_kmem_all) {
         kmp_mk_free(*mk_dax_kmem_all, desc.ptr_alloc);
       } else {
-        kmp_mk_free(*mk_default, desc.ptr_alloc);
+        // Default memory space blocks come from the per-thread bget arena
+        // (see __kmp_alloc); a foreign block is queued back to its owner.
+        __kmp_thread_free(__kmp_thread_from_gtid(gtid), desc.ptr_alloc);
       }
     } else {
       if (al->pool_size > 0) { // custom allocator with pool size requested
@@ -1756,6 +1756,30 @@ template <> struct is_cancellable<false> {
   constexpr operator bool() const { return false; }
 };
 
+// Teams of up to this many threads synchronize faster through the linear
+// pattern's single set of flags than through the tree/hyper patterns, whose
+// extra flag traffic only pays off on larger teams.
+#define KMP_BARRIER_LINEAR_MAX_NPROC 4
+
+// Adaptive barrier pattern selection for the plain and reduction barriers:
+// downgrade the tree/hyper patterns to linear for small teams. An explicit
+// KMP_*_BARRIER_PATTERN setting is always honored as given. The result must
+// depend only on the configured pattern and the team size so that every
+// thread of a team agrees on the algorithm; this is also why the fork/join
+// barrier is not adapted -- workers arrive at the fork barrier before their
+// th_team pointer is valid and cannot know the new team's size. The dist and
+// hierarchical patterns require per-team setup at team allocation time, so
+// they are never changed here either.
+static kmp_bar_pat_e __kmp_select_barrier_pattern(kmp_bar_pat_e pattern,
+                                                  int nproc) {
+  if (__kmp_env_barrier_pattern)
+    return pattern;
+  if ((pattern == bp_tree_bar || pattern == bp_hyper_bar) &&
+      nproc <= KMP_BARRIER_LINEAR_MAX_NPROC)
+    return bp_linear_bar;
+  return pattern;
+}
+
 // Internal function to do a barrier.
 /* If is_split is true, do a split barrier, otherwise, do a plain barrier
    If reduce is non-NULL, do a split reduction barrier, otherwise, do a split
@@ -1883,7 +1907,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
       cancelled = __kmp_linear_barrier_gather_cancellable(
           bt, this_thr, gtid, tid, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
     } else {
-      switch (__kmp_barrier_gather_pattern[bt]) {
+      switch (__kmp_select_barrier_pattern(__kmp_barrier_gather_pattern[bt],
+                                           team->t.t_nproc)) {
       case bp_dist_bar: {
         __kmp_dist_barrier_gather(bt, this_thr, gtid, tid,
                                   reduce USE_ITT_BUILD_ARG(itt_sync_obj));
@@ -2001,7 +2026,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
         cancelled = __kmp_linear_barrier_release_cancellable(
             bt, this_thr, gtid, tid, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
       } else {
-        switch (__kmp_barrier_release_pattern[bt]) {
+        switch (__kmp_select_barrier_pattern(__kmp_barrier_release_pattern[bt],
+                                             team->t.t_nproc)) {
         case bp_dist_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
@@ -2138,7 +2164,8 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
 
   if (!team->t.t_serialized) {
     if (KMP_MASTER_GTID(gtid)) {
-      switch (__kmp_barrier_release_pattern[bt]) {
+      switch (__kmp_select_barrier_pattern(__kmp_barrier_release_pattern[bt],
+                                           team->t.t_nproc)) {
       case bp_dist_bar: {
         __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
                                    FALSE USE_ITT_BUILD_ARG(NULL));
@@ -2193,7 +2193,8 @@ int __kmp_fork_call(ident_t *loc, int gtid,
 #endif
                                  proc_bind, &new_icvs,
                                  argc USE_NESTED_HOT_ARG(master_th));
-      if (__kmp_barrier_release_pattern[bs_forkjoin_barrier] == bp_dist_bar)
+      if (__kmp_barrier_release_pattern[bs_forkjoin_barrier] == bp_dist_bar &&
+          memcmp(team->t.b->team_icvs, &new_icvs, sizeof(new_icvs)) != 0)
         copy_icvs((kmp_internal_control_t *)team->t.b->team_icvs, &new_icvs);
     } else {
       /* allocate a new parallel team */
@@ -2205,7 +2206,9 @@ int __kmp_fork_call(ident_t *loc, int gtid,
                                  proc_bind,
                                  &master_th->th.th_current_task->td_icvs,
                                  argc USE_NESTED_HOT_ARG(master_th));
-      if (__kmp_barrier_release_pattern[bs_forkjoin_barrier] == bp_dist_bar)
+      if (__kmp_barrier_release_pattern[bs_forkjoin_barrier] == bp_dist_bar &&
+          memcmp(team->t.b->team_icvs, &master_th->th.th_current_task->td_icvs,
+                 sizeof(kmp_internal_control_t)) != 0)
         copy_icvs((kmp_internal_control_t *)team->t.b->team_icvs,
                   &master_th->th.th_current_task->td_icvs);
     }
@@ -4731,9 +4734,14 @@ static void __kmp_reinitialize_team(kmp_team_t *team,
   KMP_CHECK_UPDATE(team->t.t_ident, loc);
 
   KMP_CHECK_UPDATE(team->t.t_id, KMP_GEN_TEAM_ID());
-  // Copy ICVs to the primary thread's implicit taskdata
+  // Copy ICVs to the primary thread's implicit taskdata. Tight fork/join
+  // loops re-form the hot team with identical ICVs every region; only do the
+  // copy if something changed, so the implicit task's cache line stays clean
+  // for the workers that read it at the fork barrier.
   __kmp_init_implicit_task(loc, team->t.t_threads[0], team, 0, FALSE);
-  copy_icvs(&team->t.t_implicit_task_taskdata[0].td_icvs, new_icvs);
+  if (memcmp(&team->t.t_implicit_task_taskdata[0].td_icvs, new_icvs,
+             sizeof(*new_icvs)) != 0)
+    copy_icvs(&team->t.t_implicit_task_taskdata[0].td_icvs, new_icvs);
 
   KF_TRACE(10, ("__kmp_reinitialize_team: exit this_thread=%p team=%p\n",
                 team->t.t_threads[0], team));
@@ -1769,6 +1769,9 @@ static void __kmp_stg_parse_barrier_pattern(char const *name, char const *value,
     if ((strcmp(var, name) == 0) && (value != 0)) {
       int j;
       char *comma = CCAST(char *, strchr(value, ','));
+      // An explicit pattern setting disables the adaptive pattern selection
+      // done in __kmp_barrier (see __kmp_select_barrier_pattern).
+      __kmp_env_barrier_pattern = TRUE;
 
       /* handle first parameter: gather pattern */
       for (j = bp_linear_bar; j < bp_last_bar; j++) {
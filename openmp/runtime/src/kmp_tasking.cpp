@@ -3236,7 +3236,9 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
   kmp_task_t *task;
   kmp_taskdata_t *taskdata;
   kmp_taskdata_t *current;
-  kmp_thread_data_t *victim_td, *threads_data;
+  kmp_thread_data_t *victim_td, *self_td, *threads_data;
+  kmp_taskdata_t *batch[TASK_STEAL_BATCH_MAX];
+  kmp_int32 nbatch = 0;
   kmp_int32 target;
   kmp_info_t *victim_thr;
 
@@ -3286,6 +3288,28 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
     // Bump head pointer and Wrap.
     victim_td->td.td_deque_head =
         (victim_td->td.td_deque_head + 1) & TASK_DEQUE_MASK(victim_td->td);
+    // Steal-half batching: while the victim's lock is held, also claim up to
+    // half of the remaining tasks (bounded by TASK_STEAL_BATCH_MAX) for our
+    // own deque. Taking several tasks per lock acquisition keeps a crowd of
+    // thieves from serializing on a busy victim's deque lock. The claimed
+    // tasks are re-queued on our deque only after the victim's lock has been
+    // dropped; taking our own deque lock while still holding the victim's
+    // could deadlock with a thread stealing in the opposite direction.
+    self_td = &threads_data[__kmp_tid_from_gtid(gtid)];
+    if (TCR_PTR(self_td->td.td_deque) != NULL) {
+      kmp_int32 max_batch = (ntasks - 1) / 2;
+      if (max_batch > TASK_STEAL_BATCH_MAX)
+        max_batch = TASK_STEAL_BATCH_MAX;
+      while (nbatch < max_batch) {
+        kmp_taskdata_t *next =
+            victim_td->td.td_deque[victim_td->td.td_deque_head];
+        if (!__kmp_task_is_allowed(gtid, is_constrained, next, current))
+          break;
+        batch[nbatch++] = next;
+        victim_td->td.td_deque_head =
+            (victim_td->td.td_deque_head + 1) & TASK_DEQUE_MASK(victim_td->td);
+      }
+    }
   } else {
     if (!task_team->tt.tt_untied_task_encountered) {
       // The TSC does not allow to steal victim task
@@ -3344,10 +3368,29 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
          gtid, count + 1, task_team));
     *thread_finished = FALSE;
   }
-  TCW_4(victim_td->td.td_deque_ntasks, ntasks - 1);
+  TCW_4(victim_td->td.td_deque_ntasks, ntasks - 1 - nbatch);
 
   __kmp_release_bootstrap_lock(&victim_td->td.td_deque_lock);
 
+  if (nbatch > 0) {
+    // Re-queue the batched tasks on our own deque; they stay visible to other
+    // thieves there, exactly as they were on the victim's deque.
+    __kmp_acquire_bootstrap_lock(&self_td->td.td_deque_lock);
+    for (kmp_int32 i = 0; i < nbatch; ++i) {
+      if (TCR_4(self_td->td.td_deque_ntasks) >= TASK_DEQUE_SIZE(self_td->td))
+        __kmp_realloc_task_deque(__kmp_threads[gtid], self_td);
+      self_td->td.td_deque[self_td->td.td_deque_tail] = batch[i];
+      self_td->td.td_deque_tail =
+          (self_td->td.td_deque_tail + 1) & TASK_DEQUE_MASK(self_td->td);
+      TCW_4(self_td->td.td_deque_ntasks,
+            TCR_4(self_td->td.td_deque_ntasks) + 1);
+    }
+    __kmp_release_bootstrap_lock(&self_td->td.td_deque_lock);
+    KA_TRACE(10, ("__kmp_steal_task: T#%d moved %d extra tasks from T#%d to "
+                  "its own deque\n",
+                  gtid, nbatch, __kmp_gtid_from_thread(victim_thr)));
+  }
+
   KMP_COUNT_BLOCK(TASK_stolen);
   KA_TRACE(10,
            ("__kmp_steal_task(exit #5): T#%d stole task %p from T#%d: "
@@ -52,14 +52,17 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Support/CommandLine.h"
 #include "isl/options.h"
+#include <mutex>
 
 using namespace llvm;
 using namespace polly;
@@ -104,6 +107,12 @@ static cl::opt<int>
                        cl::Hidden, cl::init(300000), cl::ZeroOrMore,
                        cl::cat(PollyCategory));
 
+static cl::opt<bool> CacheSchedules(
+    "polly-opt-cache-schedules",
+    cl::desc("Reuse isl schedules computed earlier in this process for "
+             "identical scheduling problems (domain and dependences)"),
+    cl::Hidden, cl::init(false), cl::cat(PollyCategory));
+
 static cl::opt<bool>
     GreedyFusion("polly-loopfusion-greedy",
                  cl::desc("Aggressively try to fuse everything"), cl::Hidden,
@@ -200,6 +209,8 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScheduleCacheHits,
+          "Number of schedules reused from the schedule cache");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -714,6 +725,29 @@ static void walkScheduleTreeForStatistics(isl::schedule Schedule, int Version) {
       &Version);
 }
 
+namespace {
+/// Process-wide cache of isl schedules, keyed by the textual form of the
+/// scheduling problem they were computed from.
+///
+/// Template instantiation tends to produce many SCoPs that are structurally
+/// identical: statement names are derived from basic block names and array
+/// names from LLVM value names, so such SCoPs print to identical domains and
+/// dependences. Computing a schedule is by far the most expensive step of the
+/// optimizer while printing and re-reading isl objects is cheap, so identical
+/// scheduling problems can share one computation. The schedules are stored as
+/// strings because every SCoP lives in its own isl_ctx and isl objects must
+/// not travel between contexts.
+struct ScheduleCacheTy {
+  std::mutex Lock;
+  llvm::StringMap<std::string> Schedules;
+};
+} // namespace
+
+static ScheduleCacheTy &getScheduleCache() {
+  static ScheduleCacheTy Cache;
+  return Cache;
+}
+
 static void runIslScheduleOptimizer(
     Scop &S,
     function_ref<const Dependences &(Dependences::AnalysisLevel)> GetDeps,
@@ -869,13 +903,43 @@ static void runIslScheduleOptimizer(
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
 
-    {
-      IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
-      Schedule = SC.compute_schedule();
+    // Look up the scheduling problem in the schedule cache. The isl scheduler
+    // options set above take part in the key so that runs with different
+    // flags do not share schedules.
+    std::string CacheKey;
+    bool CacheHit = false;
+    if (CacheSchedules) {
+      raw_string_ostream KeyOS(CacheKey);
+      KeyOS << IslOuterCoincidence << ':' << IslMaximizeBands << ':'
+            << MaxConstantTerm << ':' << MaxCoefficient << ';'
+            << stringFromIslObj(Domain) << ';' << stringFromIslObj(Validity)
+            << ';' << stringFromIslObj(Proximity);
+      ScheduleCacheTy &Cache = getScheduleCache();
+      std::lock_guard<std::mutex> Guard(Cache.Lock);
+      auto It = Cache.Schedules.find(CacheKey);
+      if (It != Cache.Schedules.end()) {
+        Schedule = isl::schedule(S.getIslCtx(), It->second);
+        CacheHit = true;
+        ScheduleCacheHits++;
+        POLLY_DEBUG(dbgs() << "Reusing cached schedule\n");
+      }
+    }
 
-      if (MaxOpGuard.hasQuotaExceeded())
-        POLLY_DEBUG(
-            dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+    if (!CacheHit) {
+      {
+        IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+        Schedule = SC.compute_schedule();
+
+        if (MaxOpGuard.hasQuotaExceeded())
+          POLLY_DEBUG(
+              dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+      }
+
+      if (CacheSchedules && !Schedule.is_null()) {
+        ScheduleCacheTy &Cache = getScheduleCache();
+        std::lock_guard<std::mutex> Guard(Cache.Lock);
+        Cache.Schedules.try_emplace(CacheKey, stringFromIslObj(Schedule));
+      }
     }
 
     isl_options_set_on_error(Ctx, OnErrorStatus);